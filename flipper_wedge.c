@@ -61,6 +61,7 @@ FlipperWedge* flipper_wedge_app_alloc() {
 
     // Set defaults
     app->output_mode = FlipperWedgeOutputUsb;  // Default: USB HID
+    app->usb_nkro = false;  // Default: firmware 6KRO keyboard
     app->usb_debug_mode = false;  // Deprecated: kept for backward compatibility
 
     // Scanning defaults
@@ -72,15 +73,28 @@ FlipperWedge* flipper_wedge_app_alloc() {
     app->vibration_level = FlipperWedgeVibrationMedium;  // Default: Medium vibration
     app->ndef_max_len = FlipperWedgeNdefMaxLen250;  // Default: 250 char limit (fast typing)
     app->log_to_sd = false;  // Default: Logging disabled for privacy/performance
+    app->rfid_protocols = FlipperWedgeRfidProtocolsAll;  // Default: every LF protocol
+    app->field_windows = FlipperWedgeFieldWindows250x750;
+    app->idle_poll = FlipperWedgeIdlePollOff;  // Default: always poll at full rate
+    app->batch_separator = FlipperWedgeBatchSeparatorEnter;
+    app->lookup_enabled = false;  // Default: type UIDs
+    app->access_mode = FlipperWedgeAccessModeOff;  // Default: every tag is output
+    app->macro_enabled = false;  // Default: output followed by Append Enter
+    app->feedback_profile = FlipperWedgeFeedbackProfileStandard;  // Default: feedback gates the next scan
+    app->unicode_method = FlipperWedgeUnicodeMethodAscii;  // Default: transliterate, no OS input method
+    app->classic_sector = FLIPPER_WEDGE_CLASSIC_SECTOR_OFF;  // Default: Classic tags give their UID
     app->restart_pending = false;  // Deprecated field, no longer used
     app->output_switch_pending = false;
     app->output_switch_target = FlipperWedgeOutputUsb;
 
     // Clear scanned data
-    app->nfc_uid_len = 0;
-    app->rfid_uid_len = 0;
-    app->ndef_text[0] = '\0';
+    memset(&app->nfc_scan, 0, sizeof(app->nfc_scan));
+    memset(&app->rfid_scan, 0, sizeof(app->rfid_scan));
+    app->ndef_streamed_len = 0;
     app->output_buffer[0] = '\0';
+    app->feedback = NULL;
+    app->feedback_step = 0;
+    memset(&app->feedback_repeat, 0, sizeof(app->feedback_repeat));
 
     // Used for File Browser
     app->dialogs = furi_record_open(RECORD_DIALOGS);
@@ -88,26 +102,85 @@ FlipperWedge* flipper_wedge_app_alloc() {
 
     // Allocate keyboard layout (default to QWERTY)
     app->keyboard_layout = flipper_wedge_keyboard_layout_alloc();
+    app->layout_index = flipper_wedge_layout_index_alloc();
+
+    // Allocate output template (empty until loaded from settings)
+    app->output_template = flipper_wedge_template_alloc();
 
     // Load configs BEFORE initializing HID (so we respect output_mode setting)
     // This also loads keyboard layout settings
     flipper_wedge_read_settings(app);
 
+    // Non-ASCII input sequences depend on the loaded method and layout
+    app->unicode = flipper_wedge_unicode_alloc();
+    flipper_wedge_unicode_configure(app->unicode, app->unicode_method, app->keyboard_layout);
+
     // Allocate HID worker (manages HID interface in separate thread)
     app->hid_worker = flipper_wedge_hid_worker_alloc();
 
     // Start HID worker with loaded output mode (like Bad USB pattern)
     flipper_wedge_debug_log("App", "Starting HID worker in %s mode",
-                        app->output_mode == FlipperWedgeOutputUsb ? "USB" : "BLE");
-    FlipperWedgeHidWorkerMode worker_mode = (app->output_mode == FlipperWedgeOutputUsb) ?
-        FlipperWedgeHidWorkerModeUsb : FlipperWedgeHidWorkerModeBle;
-    flipper_wedge_hid_worker_start(app->hid_worker, worker_mode);
+                        flipper_wedge_output_name(app->output_mode));
+    flipper_wedge_hid_set_usb_nkro(flipper_wedge_get_hid(app), app->usb_nkro);
+    flipper_wedge_hid_worker_start(
+        app->hid_worker, flipper_wedge_output_to_worker_mode(app->output_mode));
+
+    // Scan timing, stamped by the readers, the HID output and the start screen
+    app->latency = flipper_wedge_latency_alloc();
+    flipper_wedge_hid_set_latency(flipper_wedge_get_hid(app), app->latency);
+    flipper_wedge_hid_set_unicode(flipper_wedge_get_hid(app), app->unicode);
+
+    // Reads on their way from the readers to the start screen
+    app->scan_queue = flipper_wedge_scan_queue_alloc(FLIPPER_WEDGE_SCAN_QUEUE_DEPTH);
 
     // Allocate NFC module
     app->nfc = flipper_wedge_nfc_alloc();
+    flipper_wedge_nfc_set_latency(app->nfc, app->latency);
 
     // Allocate RFID module
     app->rfid = flipper_wedge_rfid_alloc();
+    flipper_wedge_rfid_set_protocols(app->rfid, app->rfid_protocols);
+
+    // Allocate field scheduler
+    app->scheduler = flipper_wedge_scheduler_alloc(app->nfc, app->rfid);
+    flipper_wedge_scheduler_set_windows(app->scheduler, app->field_windows);
+    flipper_wedge_scheduler_set_idle_poll(app->scheduler, app->idle_poll);
+
+    // Tags seen by NFC-V Presence mode
+    app->iso15693_presence = flipper_wedge_iso15693_presence_alloc();
+    flipper_wedge_iso15693_benchmark();
+
+    // Lookup table, indexed on first load after the CSV changes
+    app->lookup = flipper_wedge_lookup_alloc();
+    flipper_wedge_lookup_benchmark();
+    if(app->lookup_enabled) {
+        flipper_wedge_lookup_load(
+            app->lookup, FLIPPER_WEDGE_LOOKUP_CSV_PATH, FLIPPER_WEDGE_LOOKUP_INDEX_PATH);
+    }
+
+    // Access list, Bloom filter built on load
+    app->access = flipper_wedge_access_alloc();
+    flipper_wedge_access_benchmark();
+    if(app->access_mode != FlipperWedgeAccessModeOff) {
+        flipper_wedge_access_load(
+            app->access, FLIPPER_WEDGE_ACCESS_LIST_PATH, FLIPPER_WEDGE_ACCESS_INDEX_PATH);
+    }
+
+    // Post-scan macro, compiled for the loaded keyboard layout
+    app->macro = flipper_wedge_macro_alloc();
+    if(app->macro_enabled &&
+       !flipper_wedge_macro_load(app->macro, FLIPPER_WEDGE_MACRO_PATH, app->keyboard_layout)) {
+        // Settings shows OFF rather than a macro that never runs
+        FURI_LOG_E(TAG, "Macro disabled: %s", flipper_wedge_macro_get_error(app->macro));
+        app->macro_enabled = false;
+    }
+
+    // Classic key set, the cache remembers which key opened each UID's sector
+    app->classic_keys = flipper_wedge_classic_keys_alloc();
+    if(app->classic_sector != FLIPPER_WEDGE_CLASSIC_SECTOR_OFF) {
+        flipper_wedge_classic_keys_load(
+            app->classic_keys, FLIPPER_WEDGE_CLASSIC_KEYS_PATH, FLIPPER_WEDGE_CLASSIC_CACHE_PATH);
+    }
 
     // Timers will be created as needed
     app->timeout_timer = NULL;
@@ -144,6 +217,30 @@ FlipperWedge* flipper_wedge_app_alloc() {
     return app;
 }
 
+FlipperWedgeHidWorkerMode flipper_wedge_output_to_worker_mode(FlipperWedgeOutput output) {
+    switch(output) {
+    case FlipperWedgeOutputBle:
+        return FlipperWedgeHidWorkerModeBle;
+    case FlipperWedgeOutputSerial:
+        return FlipperWedgeHidWorkerModeSerial;
+    case FlipperWedgeOutputUsb:
+    default:
+        return FlipperWedgeHidWorkerModeUsb;
+    }
+}
+
+const char* flipper_wedge_output_name(FlipperWedgeOutput output) {
+    switch(output) {
+    case FlipperWedgeOutputBle:
+        return "BLE";
+    case FlipperWedgeOutputSerial:
+        return "USB Serial";
+    case FlipperWedgeOutputUsb:
+    default:
+        return "USB";
+    }
+}
+
 void flipper_wedge_switch_output_mode(FlipperWedge* app, FlipperWedgeOutput new_mode) {
     furi_assert(app);
 
@@ -170,7 +267,7 @@ void flipper_wedge_switch_output_mode(FlipperWedge* app, FlipperWedgeOutput new_
 
     // STEP 2: Stop HID worker (deinits HID in worker thread, waits for exit)
     flipper_wedge_debug_log(TAG, "Step 2: Stopping HID worker (old mode=%s)",
-                        app->output_mode == FlipperWedgeOutputUsb ? "USB" : "BLE");
+                        flipper_wedge_output_name(app->output_mode));
     flipper_wedge_hid_worker_stop(app->hid_worker);
     flipper_wedge_debug_log(TAG, "HID worker stopped");
 
@@ -184,10 +281,9 @@ void flipper_wedge_switch_output_mode(FlipperWedge* app, FlipperWedgeOutput new_
 
     // STEP 5: Start HID worker with new mode (inits HID in worker thread)
     flipper_wedge_debug_log(TAG, "Step 5: Starting HID worker (new mode=%s)",
-                        new_mode == FlipperWedgeOutputUsb ? "USB" : "BLE");
-    FlipperWedgeHidWorkerMode worker_mode = (new_mode == FlipperWedgeOutputUsb) ?
-        FlipperWedgeHidWorkerModeUsb : FlipperWedgeHidWorkerModeBle;
-    flipper_wedge_hid_worker_start(app->hid_worker, worker_mode);
+                        flipper_wedge_output_name(new_mode));
+    flipper_wedge_hid_set_usb_nkro(flipper_wedge_get_hid(app), app->usb_nkro);
+    flipper_wedge_hid_worker_start(app->hid_worker, flipper_wedge_output_to_worker_mode(new_mode));
     flipper_wedge_debug_log(TAG, "HID worker started");
 
     // STEP 6: Restart NFC/RFID workers if they were running
@@ -223,12 +319,37 @@ void flipper_wedge_app_free(FlipperWedge* app) {
         app->display_timer = NULL;
     }
 
+    // Free field scheduler (stops the readers)
+    flipper_wedge_scheduler_free(app->scheduler);
+    app->scheduler = NULL;
+
+    flipper_wedge_iso15693_presence_free(app->iso15693_presence);
+    app->iso15693_presence = NULL;
+
+    flipper_wedge_lookup_free(app->lookup);
+    app->lookup = NULL;
+
+    flipper_wedge_access_free(app->access);
+    app->access = NULL;
+
+    flipper_wedge_macro_free(app->macro);
+    app->macro = NULL;
+
+    flipper_wedge_classic_keys_free(app->classic_keys);
+    app->classic_keys = NULL;
+
     // Free RFID module
     if(app->rfid) {
         flipper_wedge_rfid_free(app->rfid);
         app->rfid = NULL;
     }
 
+    // Release NDEF text before its pool goes away with the NFC module
+    flipper_wedge_scan_record_clear(&app->nfc_scan);
+    flipper_wedge_scan_record_clear(&app->rfid_scan);
+    flipper_wedge_scan_queue_free(app->scan_queue);
+    app->scan_queue = NULL;
+
     // Free NFC module
     if(app->nfc) {
         flipper_wedge_nfc_free(app->nfc);
@@ -238,11 +359,21 @@ void flipper_wedge_app_free(FlipperWedge* app) {
     // Free HID worker (stops thread and cleans up HID)
     flipper_wedge_hid_worker_free(app->hid_worker);
 
+    flipper_wedge_latency_free(app->latency);
+    app->latency = NULL;
+
     // Free keyboard layout
     if(app->keyboard_layout) {
         flipper_wedge_keyboard_layout_free(app->keyboard_layout);
         app->keyboard_layout = NULL;
     }
+    flipper_wedge_layout_index_free(app->layout_index);
+    app->layout_index = NULL;
+    flipper_wedge_unicode_free(app->unicode);
+    app->unicode = NULL;
+
+    // Free output template
+    flipper_wedge_template_free(app->output_template);
 
     // Scene manager
     scene_manager_free(app->scene_manager);
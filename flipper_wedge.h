@@ -20,11 +20,23 @@
 #include "helpers/flipper_wedge_storage.h"
 #include "helpers/flipper_wedge_hid.h"
 #include "helpers/flipper_wedge_keyboard_layout.h"
+#include "helpers/flipper_wedge_layout_index.h"
+#include "helpers/flipper_wedge_unicode.h"
 #include "helpers/flipper_wedge_hid_worker.h"
 #include "helpers/flipper_wedge_nfc.h"
 #include "helpers/flipper_wedge_rfid.h"
+#include "helpers/flipper_wedge_scan_queue.h"
+#include "helpers/flipper_wedge_scheduler.h"
+#include "helpers/flipper_wedge_iso15693.h"
 #include "helpers/flipper_wedge_format.h"
+#include "helpers/flipper_wedge_template.h"
 #include "helpers/flipper_wedge_log.h"
+#include "helpers/flipper_wedge_lookup.h"
+#include "helpers/flipper_wedge_access.h"
+#include "helpers/flipper_wedge_macro.h"
+#include "helpers/flipper_wedge_latency.h"
+#include "helpers/flipper_wedge_feedback.h"
+#include "helpers/flipper_wedge_classic_keys.h"
 #include "flipper_wedge_icons.h"
 
 #define TAG "FlipperWedge"
@@ -34,6 +46,8 @@
 #define FLIPPER_WEDGE_TEXT_STORE_COUNT 3
 #define FLIPPER_WEDGE_DELIMITER_MAX_LEN 8
 #define FLIPPER_WEDGE_OUTPUT_MAX_LEN 1200  // Increased to support large NDEF text (1024) + UIDs + delimiters
+#define FLIPPER_WEDGE_CLASSIC_SECTOR_OFF 0xFF  // Classic tags are read for their UID only
+#define FLIPPER_WEDGE_CLASSIC_SECTOR_COUNT 40  // Sectors of a Classic 4K
 
 // Scan modes
 typedef enum {
@@ -42,6 +56,10 @@ typedef enum {
     FlipperWedgeModeNdef,          // NDEF only (text records)
     FlipperWedgeModeNfcThenRfid,   // NFC -> RFID combo
     FlipperWedgeModeRfidThenNfc,   // RFID -> NFC combo
+    FlipperWedgeModeNfcOrRfid,     // Whichever tag is read first (HF/LF windows alternate)
+    FlipperWedgeModeNfcAndRfid,    // NFC + RFID combo, tags in any order
+    FlipperWedgeModeInventory,     // Every ISO14443-A tag in the field, one batch
+    FlipperWedgeModePresence,      // ISO15693 tags arriving and leaving, continuous
     FlipperWedgeModeCount,
 } FlipperWedgeMode;
 
@@ -53,6 +71,10 @@ typedef enum {
     FlipperWedgeModeStartupDefaultNdef,    // Always start with NDEF mode
     FlipperWedgeModeStartupDefaultNfcRfid, // Always start with NFC+RFID mode
     FlipperWedgeModeStartupDefaultRfidNfc, // Always start with RFID+NFC mode
+    FlipperWedgeModeStartupDefaultNfcOrRfid,  // Always start with NFC|RFID mode
+    FlipperWedgeModeStartupDefaultNfcAndRfid, // Always start with NFC&RFID (any order) mode
+    FlipperWedgeModeStartupDefaultInventory,  // Always start with NFC inventory mode
+    FlipperWedgeModeStartupDefaultPresence,   // Always start with NFC-V presence mode
     FlipperWedgeModeStartupCount,
 } FlipperWedgeModeStartup;
 
@@ -60,6 +82,7 @@ typedef enum {
 typedef enum {
     FlipperWedgeOutputUsb,      // USB HID only
     FlipperWedgeOutputBle,      // Bluetooth LE HID only
+    FlipperWedgeOutputSerial,   // USB CDC structured records (one JSON line per scan)
     FlipperWedgeOutputCount,
 } FlipperWedgeOutput;
 
@@ -85,10 +108,29 @@ typedef enum {
 typedef enum {
     FlipperWedgeNdefMaxLen250,      // 250 characters (recommended for fast typing)
     FlipperWedgeNdefMaxLen500,      // 500 characters (covers most use cases)
-    FlipperWedgeNdefMaxLen1000,     // 1000 characters (maximum, may take several seconds to type)
+    FlipperWedgeNdefMaxLen1000,     // 1000 characters (may take several seconds to type)
+    FlipperWedgeNdefMaxLenUnlimited, // No limit: text is typed in chunks while the tag is read
     FlipperWedgeNdefMaxLenCount,
 } FlipperWedgeNdefMaxLen;
 
+// Separator between UIDs of an inventory batch
+typedef enum {
+    FlipperWedgeBatchSeparatorEnter,  // One UID per line
+    FlipperWedgeBatchSeparatorTab,
+    FlipperWedgeBatchSeparatorSpace,
+    FlipperWedgeBatchSeparatorComma,
+    FlipperWedgeBatchSeparatorSemicolon,
+    FlipperWedgeBatchSeparatorCount,
+} FlipperWedgeBatchSeparator;
+
+// How the access list gates scanned tags
+typedef enum {
+    FlipperWedgeAccessModeOff,
+    FlipperWedgeAccessModeAllow,  // Only listed tags are output
+    FlipperWedgeAccessModeDeny,   // Listed tags are rejected
+    FlipperWedgeAccessModeCount,
+} FlipperWedgeAccessMode;
+
 typedef struct {
     Gui* gui;
     NotificationApp* notification;
@@ -108,29 +150,54 @@ typedef struct {
     // HID module (managed by worker thread)
     FlipperWedgeHidWorker* hid_worker;
     FlipperWedgeOutput output_mode;
+    bool usb_nkro;        // USB output uses the NKRO keyboard interface
     bool usb_debug_mode;  // Deprecated: kept for backward compatibility reading only
 
     // Keyboard layout for HID output
     FlipperWedgeKeyboardLayout* keyboard_layout;
 
+    // Custom layouts on SD (loaded while the settings scene is shown)
+    FlipperWedgeLayoutIndex* layout_index;
+
+    // Input sequences for non-ASCII characters (method and layout from settings)
+    FlipperWedgeUnicode* unicode;
+
     // NFC module
     FlipperWedgeNfc* nfc;
 
     // RFID module
     FlipperWedgeRfid* rfid;
 
+    // Starts/stops the readers, alternates HF and LF windows in dual modes
+    FlipperWedgeScheduler* scheduler;
+
+    // UID -> value table from SD (loaded while lookup_enabled)
+    FlipperWedgeLookup* lookup;
+
+    // Allowlist/denylist from SD (loaded while access_mode is not Off)
+    FlipperWedgeAccess* access;
+
+    // Post-scan keystroke program from SD (loaded while macro_enabled)
+    FlipperWedgeMacro* macro;
+
+    // Classic key set and per-UID key cache from SD (loaded while classic_sector is set)
+    FlipperWedgeClassicKeys* classic_keys;
+
+    // Per-stage scan timing, shown by the Statistics scene
+    FlipperWedgeLatency* latency;
+
     // Scan mode and state
     FlipperWedgeMode mode;
     FlipperWedgeModeStartup mode_startup_behavior;
     FlipperWedgeScanState scan_state;
 
-    // Scanned data
-    uint8_t nfc_uid[FLIPPER_WEDGE_NFC_UID_MAX_LEN];
-    uint8_t nfc_uid_len;
-    char ndef_text[FLIPPER_WEDGE_NDEF_MAX_LEN];
-    FlipperWedgeNfcError nfc_error;
-    uint8_t rfid_uid[FLIPPER_WEDGE_RFID_UID_MAX_LEN];
-    uint8_t rfid_uid_len;
+    // Scanned data: the readers only put records in scan_queue, the GUI thread
+    // takes them into the current scan
+    FlipperWedgeScanQueue* scan_queue;
+    FlipperWedgeScanRecord nfc_scan;   // NFC read of the current scan (uid_len 0 if none)
+    FlipperWedgeScanRecord rfid_scan;  // RFID read of the current scan (uid_len 0 if none)
+    size_t ndef_streamed_len;          // Characters typed from the NDEF stream
+    FlipperWedgeIso15693Presence* iso15693_presence;  // Tags present in NFC-V Presence mode
 
     // Settings
     char delimiter[FLIPPER_WEDGE_DELIMITER_MAX_LEN];
@@ -138,6 +205,17 @@ typedef struct {
     FlipperWedgeVibration vibration_level;
     FlipperWedgeNdefMaxLen ndef_max_len;  // Maximum NDEF text length to type
     bool log_to_sd;        // Log scanned UIDs to SD card
+    FlipperWedgeTemplate* output_template;  // Custom UID output format (empty: built-in format)
+    FlipperWedgeRfidProtocols rfid_protocols;  // LF protocols to scan for
+    FlipperWedgeFieldWindows field_windows;    // HF/LF window lengths in dual modes
+    FlipperWedgeIdlePoll idle_poll;            // Max idle latency (slow polling when idle)
+    FlipperWedgeBatchSeparator batch_separator;  // Between UIDs in inventory mode
+    bool lookup_enabled;   // Type the lookup table value instead of the UID
+    FlipperWedgeAccessMode access_mode;  // Allowlist/denylist gating of scanned tags
+    bool macro_enabled;    // Type scans with the macro instead of output + Enter
+    FlipperWedgeFeedbackProfile feedback_profile;  // Feedback after a scan, and whether it gates the next one
+    FlipperWedgeUnicodeMethod unicode_method;  // How non-ASCII characters are typed
+    uint8_t classic_sector;  // Classic sector read as the tag's text, or FLIPPER_WEDGE_CLASSIC_SECTOR_OFF
     bool restart_pending;  // True if output mode changed and restart is required
 
     // Output mode switching (async to avoid UI thread blocking on bt_profile_start)
@@ -148,6 +226,11 @@ typedef struct {
     FuriTimer* timeout_timer;
     FuriTimer* display_timer;
 
+    // Feedback timeline played by display_timer (NULL when done)
+    const FlipperWedgeFeedbackTimeline* feedback;
+    uint8_t feedback_step;
+    FlipperWedgeFeedbackRepeat feedback_repeat;  // Last output, for the repeat window
+
     // Output buffer
     char output_buffer[FLIPPER_WEDGE_OUTPUT_MAX_LEN];
 } FlipperWedge;
@@ -159,6 +242,7 @@ typedef enum {
     FlipperWedgeViewIdNumberInput,
     FlipperWedgeViewIdSettings,
     FlipperWedgeViewIdBtPair,
+    FlipperWedgeViewIdStatistics,
     FlipperWedgeViewIdOutputRestart,  // Deprecated: no longer used (dynamic switching works)
 } FlipperWedgeViewId;
 
@@ -171,6 +255,20 @@ typedef enum {
  */
 void flipper_wedge_switch_output_mode(FlipperWedge* app, FlipperWedgeOutput new_mode);
 
+/** Map an output mode to the HID worker mode that serves it
+ *
+ * @param output Output mode
+ * @return HID worker mode
+ */
+FlipperWedgeHidWorkerMode flipper_wedge_output_to_worker_mode(FlipperWedgeOutput output);
+
+/** Get display name of an output mode
+ *
+ * @param output Output mode
+ * @return Static string name
+ */
+const char* flipper_wedge_output_name(FlipperWedgeOutput output);
+
 /** Get HID instance from worker
  * Helper macro to access HID interface managed by worker thread
  */
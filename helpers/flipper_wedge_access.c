@@ -0,0 +1,214 @@
+#include "flipper_wedge_access.h"
+
+#define TAG "FlipperWedgeAccess"
+
+struct FlipperWedgeAccess {
+    FlipperWedgeLookup* list;
+    FlipperWedgeBloom* bloom;  // NULL while not loaded
+};
+
+static void flipper_wedge_access_add_uid(const uint8_t* uid, uint8_t uid_len, void* context) {
+    FlipperWedgeBloom* bloom = context;
+    flipper_wedge_bloom_add(bloom, uid, uid_len);
+}
+
+FlipperWedgeAccess* flipper_wedge_access_alloc(void) {
+    FlipperWedgeAccess* access = malloc(sizeof(FlipperWedgeAccess));
+    access->list = flipper_wedge_lookup_alloc();
+    access->bloom = NULL;
+    return access;
+}
+
+void flipper_wedge_access_free(FlipperWedgeAccess* access) {
+    furi_assert(access);
+    flipper_wedge_access_unload(access);
+    flipper_wedge_lookup_free(access->list);
+    free(access);
+}
+
+bool flipper_wedge_access_load(FlipperWedgeAccess* access, const char* list_path, const char* index_path) {
+    furi_assert(access);
+
+    flipper_wedge_access_unload(access);
+    if(!flipper_wedge_lookup_load(access->list, list_path, index_path)) {
+        return false;
+    }
+
+    uint32_t start = furi_get_tick();
+    uint32_t count = flipper_wedge_lookup_get_count(access->list);
+    FlipperWedgeBloom* bloom = flipper_wedge_bloom_alloc(count, FLIPPER_WEDGE_ACCESS_BLOOM_MAX_BYTES);
+    if(!flipper_wedge_lookup_foreach(access->list, flipper_wedge_access_add_uid, bloom)) {
+        flipper_wedge_bloom_free(bloom);
+        flipper_wedge_lookup_unload(access->list);
+        return false;
+    }
+    access->bloom = bloom;
+
+    FURI_LOG_I(
+        TAG,
+        "Loaded %lu UIDs, Bloom filter %zu bytes built in %lu ms, expected false positives %lu.%02lu%%",
+        count,
+        flipper_wedge_bloom_get_size(bloom),
+        furi_get_tick() - start,
+        (uint32_t)(flipper_wedge_bloom_get_fp_rate(bloom) * 100),
+        (uint32_t)(flipper_wedge_bloom_get_fp_rate(bloom) * 10000) % 100);
+    return true;
+}
+
+void flipper_wedge_access_unload(FlipperWedgeAccess* access) {
+    furi_assert(access);
+    if(access->bloom) {
+        flipper_wedge_bloom_free(access->bloom);
+        access->bloom = NULL;
+    }
+    flipper_wedge_lookup_unload(access->list);
+}
+
+bool flipper_wedge_access_is_loaded(FlipperWedgeAccess* access) {
+    furi_assert(access);
+    return access->bloom != NULL;
+}
+
+bool flipper_wedge_access_contains(FlipperWedgeAccess* access, const uint8_t* uid, uint8_t uid_len) {
+    furi_assert(access);
+    furi_assert(uid);
+    if(!access->bloom) return false;
+
+    // Fast negative from RAM, only "maybe" answers go to the SD index
+    if(!flipper_wedge_bloom_check(access->bloom, uid, uid_len)) {
+        return false;
+    }
+
+    char value[1];
+    bool listed = flipper_wedge_lookup_find(access->list, uid, uid_len, value, sizeof(value));
+    if(!listed) {
+        FURI_LOG_D(TAG, "Bloom filter false positive");
+    }
+    return listed;
+}
+
+#ifdef FURI_DEBUG
+#define ACCESS_BENCH_MARKER_PATH APP_DATA_PATH("access_bench")
+#define ACCESS_BENCH_LIST_PATH APP_DATA_PATH("access_bench.txt")
+#define ACCESS_BENCH_INDEX_PATH APP_DATA_PATH("access_bench.idx")
+#define ACCESS_BENCH_UID_LEN 7
+
+// Pseudo-random 7-byte UID, listed UIDs start with 04, unlisted ones with 08
+static void flipper_wedge_access_bench_uid(uint32_t i, bool listed, uint8_t* uid) {
+    uint32_t x = i * 2654435761UL;
+    uint32_t y = (i ^ 0x5BD1E995UL) * 40503UL;
+    uid[0] = listed ? 0x04 : 0x08;
+    uid[1] = x >> 24;
+    uid[2] = x >> 16;
+    uid[3] = x >> 8;
+    uid[4] = x;
+    uid[5] = y >> 8;
+    uid[6] = y;
+}
+
+static bool flipper_wedge_access_bench_write(Storage* storage, uint32_t entries) {
+    File* file = storage_file_alloc(storage);
+    bool ok = storage_file_open(file, ACCESS_BENCH_LIST_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    char* buf = malloc(FLIPPER_WEDGE_LOOKUP_PAGE_SIZE);
+    size_t len = 0;
+
+    for(uint32_t i = 0; ok && i < entries; i++) {
+        uint8_t uid[ACCESS_BENCH_UID_LEN];
+        flipper_wedge_access_bench_uid(i, true, uid);
+        if(len + ACCESS_BENCH_UID_LEN * 2 + 1 > FLIPPER_WEDGE_LOOKUP_PAGE_SIZE) {
+            ok = storage_file_write(file, buf, len) == len;
+            len = 0;
+        }
+        for(size_t b = 0; b < ACCESS_BENCH_UID_LEN; b++) {
+            len += snprintf(buf + len, 3, "%02X", uid[b]);
+        }
+        buf[len++] = '\n';
+    }
+    if(ok && len > 0) {
+        ok = storage_file_write(file, buf, len) == len;
+    }
+
+    free(buf);
+    storage_file_close(file);
+    storage_file_free(file);
+    return ok;
+}
+#endif
+
+void flipper_wedge_access_benchmark(void) {
+#ifdef FURI_DEBUG
+    const uint32_t list_sizes[] = {10000, 100000};
+    const uint32_t negatives = 10000;
+    const uint32_t positives = 200;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    // Writes several MB to SD, only run when asked for
+    if(!storage_file_exists(storage, ACCESS_BENCH_MARKER_PATH)) {
+        furi_record_close(RECORD_STORAGE);
+        return;
+    }
+
+    FlipperWedgeAccess* access = flipper_wedge_access_alloc();
+    uint8_t uid[ACCESS_BENCH_UID_LEN];
+
+    for(size_t s = 0; s < COUNT_OF(list_sizes); s++) {
+        uint32_t entries = list_sizes[s];
+        if(!flipper_wedge_access_bench_write(storage, entries) ||
+           !flipper_wedge_access_load(access, ACCESS_BENCH_LIST_PATH, ACCESS_BENCH_INDEX_PATH)) {
+            FURI_LOG_E(TAG, "Benchmark: failed to set up %lu UID list", entries);
+            break;
+        }
+
+        // Unlisted tags: Bloom filter alone, then the full check
+        uint32_t false_positives = 0;
+        uint32_t start = furi_get_tick();
+        for(uint32_t i = 0; i < negatives; i++) {
+            flipper_wedge_access_bench_uid(i, false, uid);
+            false_positives += flipper_wedge_bloom_check(access->bloom, uid, sizeof(uid));
+        }
+        uint32_t bloom_ms = furi_get_tick() - start;
+
+        uint32_t wrong = 0;
+        start = furi_get_tick();
+        for(uint32_t i = 0; i < negatives; i++) {
+            flipper_wedge_access_bench_uid(i, false, uid);
+            wrong += flipper_wedge_access_contains(access, uid, sizeof(uid));
+        }
+        uint32_t negative_ms = furi_get_tick() - start;
+
+        // Listed tags always go to the SD index
+        start = furi_get_tick();
+        for(uint32_t i = 0; i < positives; i++) {
+            flipper_wedge_access_bench_uid((i * 7919) % entries, true, uid);
+            wrong += !flipper_wedge_access_contains(access, uid, sizeof(uid));
+        }
+        uint32_t positive_ms = furi_get_tick() - start;
+
+        FURI_LOG_I(
+            TAG,
+            "Benchmark: %lu UIDs, Bloom %zu bytes, false positives %lu/%lu (expected %lu.%02lu%%)",
+            entries,
+            flipper_wedge_bloom_get_size(access->bloom),
+            false_positives,
+            negatives,
+            (uint32_t)(flipper_wedge_bloom_get_fp_rate(access->bloom) * 100),
+            (uint32_t)(flipper_wedge_bloom_get_fp_rate(access->bloom) * 10000) % 100);
+        FURI_LOG_I(
+            TAG,
+            "Benchmark: %lu unlisted: Bloom only %lu ms, full check %lu ms; %lu listed: %lu ms; %lu wrong answers",
+            negatives,
+            bloom_ms,
+            negative_ms,
+            positives,
+            positive_ms,
+            wrong);
+
+        flipper_wedge_access_unload(access);
+    }
+
+    flipper_wedge_access_free(access);
+    storage_common_remove(storage, ACCESS_BENCH_LIST_PATH);
+    storage_common_remove(storage, ACCESS_BENCH_INDEX_PATH);
+    furi_record_close(RECORD_STORAGE);
+#endif
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <furi.h>
+#include "flipper_wedge_lookup.h"
+#include "flipper_wedge_bloom.h"
+
+// Access list: a set of tag UIDs used as allowlist or denylist
+//
+// The list is a text file with one hex UID per line (the lookup table CSV
+// format, values are ignored). Membership is exact, from the list's sorted
+// on-disk index, with a Bloom filter in RAM in front of it so that most
+// tags that are not listed are answered without touching the SD card.
+
+#define FLIPPER_WEDGE_ACCESS_LIST_PATH APP_DATA_PATH("access_list.txt")
+#define FLIPPER_WEDGE_ACCESS_INDEX_PATH APP_DATA_PATH("access_list.idx")
+#define FLIPPER_WEDGE_ACCESS_BLOOM_MAX_BYTES (32 * 1024)  // ~1% false positives up to 26k tags
+
+typedef struct FlipperWedgeAccess FlipperWedgeAccess;
+
+/** Allocate access list (not loaded)
+ *
+ * @return FlipperWedgeAccess instance
+ */
+FlipperWedgeAccess* flipper_wedge_access_alloc(void);
+
+/** Free access list
+ *
+ * @param access FlipperWedgeAccess instance
+ */
+void flipper_wedge_access_free(FlipperWedgeAccess* access);
+
+/** Load a UID list and build its Bloom filter
+ *
+ * @param access FlipperWedgeAccess instance
+ * @param list_path UID list file
+ * @param index_path Index file for the list
+ * @return true if the list is ready
+ */
+bool flipper_wedge_access_load(FlipperWedgeAccess* access, const char* list_path, const char* index_path);
+
+/** Drop the list and its Bloom filter
+ *
+ * @param access FlipperWedgeAccess instance
+ */
+void flipper_wedge_access_unload(FlipperWedgeAccess* access);
+
+/** Check if a list is loaded
+ *
+ * @param access FlipperWedgeAccess instance
+ * @return true if flipper_wedge_access_contains() can be used
+ */
+bool flipper_wedge_access_is_loaded(FlipperWedgeAccess* access);
+
+/** Check if a UID is on the list
+ *
+ * @param access FlipperWedgeAccess instance
+ * @param uid UID bytes
+ * @param uid_len Length of UID
+ * @return true if the UID is listed
+ */
+bool flipper_wedge_access_contains(FlipperWedgeAccess* access, const uint8_t* uid, uint8_t uid_len);
+
+/** Log Bloom filter false positive rate and lookup time for generated lists of 10k and 100k UIDs
+ * Only active in debug firmware builds (FURI_DEBUG), no-op otherwise.
+ * Runs only if the file access_bench exists in the app data folder,
+ * writes and removes temporary lists there.
+ */
+void flipper_wedge_access_benchmark(void);
@@ -0,0 +1,91 @@
+#include "flipper_wedge_bloom.h"
+#include <math.h>
+
+struct FlipperWedgeBloom {
+    uint8_t* bits;
+    uint32_t bit_count;
+    uint32_t entries;  // Entries the filter was sized for
+    uint8_t hashes;
+};
+
+// FNV-1a, then a murmur3 finalizer for the second hash: k bit positions
+// are h1 + i * h2 (double hashing), so each key is only hashed once
+static void flipper_wedge_bloom_hash(const uint8_t* key, size_t key_len, uint32_t* h1, uint32_t* h2) {
+    uint32_t h = 2166136261UL;
+    for(size_t i = 0; i < key_len; i++) {
+        h ^= key[i];
+        h *= 16777619UL;
+    }
+    *h1 = h;
+
+    h ^= h >> 16;
+    h *= 0x85EBCA6BUL;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35UL;
+    h ^= h >> 16;
+    *h2 = h | 1;  // Odd, so the positions do not repeat early
+}
+
+FlipperWedgeBloom* flipper_wedge_bloom_alloc(uint32_t expected_entries, size_t max_bytes) {
+    FlipperWedgeBloom* bloom = malloc(sizeof(FlipperWedgeBloom));
+    uint32_t entries = MAX(expected_entries, 1UL);
+
+    uint64_t bits = (uint64_t)entries * FLIPPER_WEDGE_BLOOM_BITS_PER_ENTRY;
+    bits = MIN(bits, (uint64_t)max_bytes * 8);
+    bits = MAX(bits, (uint64_t)8);
+    size_t bytes = (bits + 7) / 8;
+
+    bloom->bits = malloc(bytes);
+    memset(bloom->bits, 0, bytes);
+    bloom->bit_count = bytes * 8;
+    bloom->entries = entries;
+
+    // Optimal hash count for this many bits per entry: ln(2) * m / n
+    uint32_t hashes = (uint32_t)((float)bloom->bit_count / entries * 0.693f + 0.5f);
+    bloom->hashes = CLAMP(hashes, (uint32_t)FLIPPER_WEDGE_BLOOM_MAX_HASHES, 1UL);
+
+    return bloom;
+}
+
+void flipper_wedge_bloom_free(FlipperWedgeBloom* bloom) {
+    furi_assert(bloom);
+    free(bloom->bits);
+    free(bloom);
+}
+
+void flipper_wedge_bloom_add(FlipperWedgeBloom* bloom, const uint8_t* key, size_t key_len) {
+    furi_assert(bloom);
+    furi_assert(key);
+
+    uint32_t h1, h2;
+    flipper_wedge_bloom_hash(key, key_len, &h1, &h2);
+    for(uint8_t i = 0; i < bloom->hashes; i++) {
+        uint32_t bit = (h1 + i * h2) % bloom->bit_count;
+        bloom->bits[bit / 8] |= 1 << (bit % 8);
+    }
+}
+
+bool flipper_wedge_bloom_check(const FlipperWedgeBloom* bloom, const uint8_t* key, size_t key_len) {
+    furi_assert(bloom);
+    furi_assert(key);
+
+    uint32_t h1, h2;
+    flipper_wedge_bloom_hash(key, key_len, &h1, &h2);
+    for(uint8_t i = 0; i < bloom->hashes; i++) {
+        uint32_t bit = (h1 + i * h2) % bloom->bit_count;
+        if(!(bloom->bits[bit / 8] & (1 << (bit % 8)))) return false;
+    }
+    return true;
+}
+
+float flipper_wedge_bloom_get_fp_rate(const FlipperWedgeBloom* bloom) {
+    furi_assert(bloom);
+    // (1 - e^(-k * n / m))^k
+    float k = bloom->hashes;
+    return powf(1.0f - expf(-k * bloom->entries / bloom->bit_count), k);
+}
+
+size_t flipper_wedge_bloom_get_size(const FlipperWedgeBloom* bloom) {
+    furi_assert(bloom);
+    return bloom->bit_count / 8;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <furi.h>
+
+// Bloom filter over byte strings
+//
+// Answers "definitely not in the set" or "maybe in the set" from RAM. The
+// bit count follows the expected entry count up to a memory cap; past the
+// cap the false positive rate grows instead of the memory.
+
+#define FLIPPER_WEDGE_BLOOM_BITS_PER_ENTRY 10  // About 1% false positives
+#define FLIPPER_WEDGE_BLOOM_MAX_HASHES 8
+
+typedef struct FlipperWedgeBloom FlipperWedgeBloom;
+
+/** Allocate an empty Bloom filter
+ *
+ * @param expected_entries Number of keys that will be added
+ * @param max_bytes Upper limit for the bit array
+ * @return FlipperWedgeBloom instance
+ */
+FlipperWedgeBloom* flipper_wedge_bloom_alloc(uint32_t expected_entries, size_t max_bytes);
+
+/** Free Bloom filter
+ *
+ * @param bloom FlipperWedgeBloom instance
+ */
+void flipper_wedge_bloom_free(FlipperWedgeBloom* bloom);
+
+/** Add a key
+ *
+ * @param bloom FlipperWedgeBloom instance
+ * @param key Key bytes
+ * @param key_len Length of key
+ */
+void flipper_wedge_bloom_add(FlipperWedgeBloom* bloom, const uint8_t* key, size_t key_len);
+
+/** Check a key
+ *
+ * @param bloom FlipperWedgeBloom instance
+ * @param key Key bytes
+ * @param key_len Length of key
+ * @return false if the key was never added, true if it may have been
+ */
+bool flipper_wedge_bloom_check(const FlipperWedgeBloom* bloom, const uint8_t* key, size_t key_len);
+
+/** Get the expected false positive rate for the entries it was sized for
+ *
+ * @param bloom FlipperWedgeBloom instance
+ * @return Probability (0-1) that check() is true for a key never added
+ */
+float flipper_wedge_bloom_get_fp_rate(const FlipperWedgeBloom* bloom);
+
+/** Get the size of the bit array
+ *
+ * @param bloom FlipperWedgeBloom instance
+ * @return Size in bytes
+ */
+size_t flipper_wedge_bloom_get_size(const FlipperWedgeBloom* bloom);
@@ -0,0 +1,394 @@
+#include "flipper_wedge_classic_keys.h"
+
+#define TAG "FlipperWedgeClassicKeys"
+
+#define CLASSIC_CACHE_MAGIC 0x434D5746  // "FWMC"
+#define CLASSIC_CACHE_VERSION 1
+#define CLASSIC_KEY_HEX_LEN (FLIPPER_WEDGE_CLASSIC_KEY_LEN * 2)
+#define CLASSIC_LINE_MAX 64
+#define CLASSIC_READ_CHUNK 128
+
+// One UID and sector with the key that opened it
+typedef struct {
+    uint8_t uid[FLIPPER_WEDGE_CLASSIC_UID_MAX_LEN];
+    uint8_t uid_len;
+    uint8_t sector;
+    uint8_t key_type;
+    uint8_t key[FLIPPER_WEDGE_CLASSIC_KEY_LEN];
+    uint8_t reserved;
+} __attribute__((packed)) FlipperWedgeClassicCacheEntry;
+
+_Static_assert(sizeof(FlipperWedgeClassicCacheEntry) == 20, "Classic cache entry must stay 20 bytes");
+
+// Cache file header, entries follow most recently used first
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entry_size;
+    uint32_t count;
+    uint8_t reserved[4];
+} __attribute__((packed)) FlipperWedgeClassicCacheHeader;
+
+_Static_assert(sizeof(FlipperWedgeClassicCacheHeader) == 16, "Classic cache header must stay 16 bytes");
+
+struct FlipperWedgeClassicKeys {
+    uint8_t keys[FLIPPER_WEDGE_CLASSIC_KEYS_MAX][FLIPPER_WEDGE_CLASSIC_KEY_LEN];
+    size_t count;
+
+    FlipperWedgeClassicCacheEntry cache[FLIPPER_WEDGE_CLASSIC_CACHE_SIZE];
+    size_t cache_count;
+    bool cache_dirty;
+    FuriString* cache_path;  // Empty until loaded
+
+    FlipperWedgeClassicKeysStats stats;
+};
+
+// Factory transport keys and the common defaults of access control systems
+static const uint8_t classic_builtin_keys[][FLIPPER_WEDGE_CLASSIC_KEY_LEN] = {
+    {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+    {0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5},
+    {0xD3, 0xF7, 0xD3, 0xF7, 0xD3, 0xF7},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    {0xB0, 0xB1, 0xB2, 0xB3, 0xB4, 0xB5},
+    {0x4D, 0x3A, 0x99, 0xC3, 0x51, 0xDD},
+    {0x1A, 0x98, 0x2C, 0x7E, 0x45, 0x9A},
+    {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF},
+};
+
+static void flipper_wedge_classic_keys_set_builtin(FlipperWedgeClassicKeys* keys) {
+    memcpy(keys->keys, classic_builtin_keys, sizeof(classic_builtin_keys));
+    keys->count = COUNT_OF(classic_builtin_keys);
+}
+
+static int flipper_wedge_classic_keys_hex_digit(char c) {
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// One key set line: 12 hex digits, optionally followed by spaces or a comment
+// Returns false for lines without a key (blank, comment or malformed)
+static bool flipper_wedge_classic_keys_parse_line(const char* line, uint8_t* key, bool* malformed) {
+    *malformed = false;
+    while(*line == ' ' || *line == '\t') line++;
+    if(*line == '\0' || *line == '#') return false;
+
+    for(size_t i = 0; i < FLIPPER_WEDGE_CLASSIC_KEY_LEN; i++) {
+        int high = flipper_wedge_classic_keys_hex_digit(line[i * 2]);
+        int low = high < 0 ? -1 : flipper_wedge_classic_keys_hex_digit(line[i * 2 + 1]);
+        if(low < 0) {
+            *malformed = true;
+            return false;
+        }
+        key[i] = (high << 4) | low;
+    }
+    char end = line[CLASSIC_KEY_HEX_LEN];
+    if(end != '\0' && end != ' ' && end != '\t' && end != '#') {
+        *malformed = true;
+        return false;
+    }
+    return true;
+}
+
+static void flipper_wedge_classic_keys_add_line(
+    FlipperWedgeClassicKeys* keys,
+    const char* line,
+    uint32_t line_number,
+    bool* full) {
+    uint8_t key[FLIPPER_WEDGE_CLASSIC_KEY_LEN];
+    bool malformed;
+    if(!flipper_wedge_classic_keys_parse_line(line, key, &malformed)) {
+        if(malformed) FURI_LOG_W(TAG, "Line %lu: not a 12 hex digit key, skipped", line_number);
+        return;
+    }
+    for(size_t i = 0; i < keys->count; i++) {
+        if(memcmp(keys->keys[i], key, sizeof(key)) == 0) return;
+    }
+    if(keys->count == FLIPPER_WEDGE_CLASSIC_KEYS_MAX) {
+        if(!*full) FURI_LOG_W(TAG, "Key set is limited to %d keys, rest ignored", FLIPPER_WEDGE_CLASSIC_KEYS_MAX);
+        *full = true;
+        return;
+    }
+    memcpy(keys->keys[keys->count++], key, sizeof(key));
+}
+
+static bool flipper_wedge_classic_keys_read_set(FlipperWedgeClassicKeys* keys, Storage* storage, const char* path) {
+    File* file = storage_file_alloc(storage);
+    if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        storage_file_free(file);
+        return false;
+    }
+
+    char chunk[CLASSIC_READ_CHUNK];
+    char line[CLASSIC_LINE_MAX];
+    size_t line_len = 0;
+    uint32_t line_number = 1;
+    bool full = false;
+    size_t read;
+    keys->count = 0;
+    while((read = storage_file_read(file, chunk, sizeof(chunk))) > 0) {
+        for(size_t i = 0; i < read; i++) {
+            if(chunk[i] == '\n' || chunk[i] == '\r') {
+                line[line_len] = '\0';
+                flipper_wedge_classic_keys_add_line(keys, line, line_number, &full);
+                if(chunk[i] == '\n') line_number++;
+                line_len = 0;
+            } else if(line_len < sizeof(line) - 1) {
+                line[line_len++] = chunk[i];
+            }
+        }
+    }
+    line[line_len] = '\0';
+    flipper_wedge_classic_keys_add_line(keys, line, line_number, &full);
+
+    storage_file_close(file);
+    storage_file_free(file);
+    return true;
+}
+
+static bool flipper_wedge_classic_keys_read_cache(FlipperWedgeClassicKeys* keys, Storage* storage, const char* path) {
+    File* file = storage_file_alloc(storage);
+    bool success = false;
+    FlipperWedgeClassicCacheHeader header;
+
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+       storage_file_read(file, &header, sizeof(header)) == sizeof(header) &&
+       header.magic == CLASSIC_CACHE_MAGIC && header.version == CLASSIC_CACHE_VERSION &&
+       header.entry_size == sizeof(FlipperWedgeClassicCacheEntry) &&
+       header.count <= FLIPPER_WEDGE_CLASSIC_CACHE_SIZE &&
+       storage_file_size(file) == sizeof(header) + header.count * sizeof(FlipperWedgeClassicCacheEntry)) {
+        size_t size = header.count * sizeof(FlipperWedgeClassicCacheEntry);
+        success = storage_file_read(file, keys->cache, size) == size;
+    }
+    keys->cache_count = success ? header.count : 0;
+
+    storage_file_close(file);
+    storage_file_free(file);
+    return success;
+}
+
+static FlipperWedgeClassicCacheEntry* flipper_wedge_classic_keys_find(
+    FlipperWedgeClassicKeys* keys,
+    const uint8_t* uid,
+    uint8_t uid_len,
+    uint8_t sector) {
+    for(size_t i = 0; i < keys->cache_count; i++) {
+        FlipperWedgeClassicCacheEntry* entry = &keys->cache[i];
+        if(entry->sector == sector && entry->uid_len == uid_len && memcmp(entry->uid, uid, uid_len) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Move an entry to the front, the last entry is the least recently used
+static FlipperWedgeClassicCacheEntry*
+    flipper_wedge_classic_keys_to_front(FlipperWedgeClassicKeys* keys, FlipperWedgeClassicCacheEntry* entry) {
+    FlipperWedgeClassicCacheEntry moved = *entry;
+    memmove(&keys->cache[1], &keys->cache[0], (entry - keys->cache) * sizeof(FlipperWedgeClassicCacheEntry));
+    keys->cache[0] = moved;
+    return &keys->cache[0];
+}
+
+FlipperWedgeClassicKeys* flipper_wedge_classic_keys_alloc(void) {
+    FlipperWedgeClassicKeys* keys = malloc(sizeof(FlipperWedgeClassicKeys));
+    flipper_wedge_classic_keys_set_builtin(keys);
+    keys->cache_count = 0;
+    keys->cache_dirty = false;
+    keys->cache_path = furi_string_alloc();
+    memset(&keys->stats, 0, sizeof(keys->stats));
+    return keys;
+}
+
+void flipper_wedge_classic_keys_free(FlipperWedgeClassicKeys* keys) {
+    furi_assert(keys);
+    flipper_wedge_classic_keys_save(keys);
+    furi_string_free(keys->cache_path);
+    free(keys);
+}
+
+size_t flipper_wedge_classic_keys_load(
+    FlipperWedgeClassicKeys* keys,
+    const char* keys_path,
+    const char* cache_path) {
+    furi_assert(keys);
+    furi_assert(keys_path);
+    furi_assert(cache_path);
+
+    // Entries learned under the previous path are not carried over
+    flipper_wedge_classic_keys_save(keys);
+    furi_string_set_str(keys->cache_path, cache_path);
+    keys->cache_dirty = false;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!flipper_wedge_classic_keys_read_set(keys, storage, keys_path)) {
+        FURI_LOG_I(TAG, "No key set at %s, using %zu built-in keys", keys_path, COUNT_OF(classic_builtin_keys));
+        flipper_wedge_classic_keys_set_builtin(keys);
+    } else if(keys->count == 0) {
+        FURI_LOG_W(TAG, "No keys in %s, using %zu built-in keys", keys_path, COUNT_OF(classic_builtin_keys));
+        flipper_wedge_classic_keys_set_builtin(keys);
+    }
+    if(!flipper_wedge_classic_keys_read_cache(keys, storage, cache_path)) {
+        FURI_LOG_I(TAG, "Starting with an empty key cache");
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    FURI_LOG_I(TAG, "%zu keys, %zu cached sectors", keys->count, keys->cache_count);
+    return keys->count;
+}
+
+bool flipper_wedge_classic_keys_save(FlipperWedgeClassicKeys* keys) {
+    furi_assert(keys);
+    if(!keys->cache_dirty || furi_string_size(keys->cache_path) == 0) return true;
+
+    FlipperWedgeClassicCacheHeader header = {
+        .magic = CLASSIC_CACHE_MAGIC,
+        .version = CLASSIC_CACHE_VERSION,
+        .entry_size = sizeof(FlipperWedgeClassicCacheEntry),
+        .count = keys->cache_count,
+    };
+    size_t size = keys->cache_count * sizeof(FlipperWedgeClassicCacheEntry);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool success = storage_file_open(
+                       file, furi_string_get_cstr(keys->cache_path), FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                   storage_file_write(file, &header, sizeof(header)) == sizeof(header) &&
+                   storage_file_write(file, keys->cache, size) == size;
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    if(success) {
+        keys->cache_dirty = false;
+    } else {
+        FURI_LOG_E(TAG, "Failed to write %s", furi_string_get_cstr(keys->cache_path));
+    }
+    return success;
+}
+
+void flipper_wedge_classic_keys_clear_cache(FlipperWedgeClassicKeys* keys) {
+    furi_assert(keys);
+    if(keys->cache_count == 0) return;
+    keys->cache_count = 0;
+    keys->cache_dirty = true;
+}
+
+size_t flipper_wedge_classic_keys_get_count(FlipperWedgeClassicKeys* keys) {
+    furi_assert(keys);
+    return keys->count;
+}
+
+void flipper_wedge_classic_keys_walk_start(
+    FlipperWedgeClassicKeys* keys,
+    FlipperWedgeClassicWalk* walk,
+    const uint8_t* uid,
+    uint8_t uid_len,
+    uint8_t sector) {
+    furi_assert(keys);
+    furi_assert(walk);
+    furi_assert(uid);
+
+    memset(walk, 0, sizeof(FlipperWedgeClassicWalk));
+    walk->uid_len = MIN(uid_len, FLIPPER_WEDGE_CLASSIC_UID_MAX_LEN);
+    memcpy(walk->uid, uid, walk->uid_len);
+    walk->sector = sector;
+
+    const FlipperWedgeClassicCacheEntry* entry =
+        flipper_wedge_classic_keys_find(keys, walk->uid, walk->uid_len, sector);
+    if(entry) {
+        walk->has_cached = true;
+        memcpy(walk->cached.data, entry->key, FLIPPER_WEDGE_CLASSIC_KEY_LEN);
+        walk->cached.type = entry->key_type;
+    }
+    keys->stats.walks++;
+}
+
+bool flipper_wedge_classic_keys_walk_next(
+    FlipperWedgeClassicKeys* keys,
+    FlipperWedgeClassicWalk* walk,
+    FlipperWedgeClassicKey* key) {
+    furi_assert(keys);
+    furi_assert(walk);
+    furi_assert(key);
+
+    if(walk->position == 0) {
+        walk->position = 1;
+        if(walk->has_cached) {
+            *key = walk->cached;
+            keys->stats.attempts++;
+            return true;
+        }
+    } else if(walk->position == 1 && walk->has_cached) {
+        // The cached key no longer opens the sector (rekeyed or replaced card)
+        FlipperWedgeClassicCacheEntry* entry =
+            flipper_wedge_classic_keys_find(keys, walk->uid, walk->uid_len, walk->sector);
+        if(entry) {
+            memmove(entry, entry + 1, (&keys->cache[keys->cache_count] - (entry + 1)) * sizeof(*entry));
+            keys->cache_count--;
+            keys->cache_dirty = true;
+        }
+    }
+
+    // Every key as key A, then every key as key B, minus the cached key that failed
+    while(walk->position <= 2 * keys->count) {
+        size_t index = walk->position - 1;
+        walk->position++;
+        memcpy(key->data, keys->keys[index % keys->count], FLIPPER_WEDGE_CLASSIC_KEY_LEN);
+        key->type = index < keys->count ? FlipperWedgeClassicKeyTypeA : FlipperWedgeClassicKeyTypeB;
+        if(walk->has_cached && key->type == walk->cached.type &&
+           memcmp(key->data, walk->cached.data, FLIPPER_WEDGE_CLASSIC_KEY_LEN) == 0) {
+            continue;
+        }
+        keys->stats.attempts++;
+        return true;
+    }
+    return false;
+}
+
+void flipper_wedge_classic_keys_walk_found(
+    FlipperWedgeClassicKeys* keys,
+    FlipperWedgeClassicWalk* walk,
+    const FlipperWedgeClassicKey* key) {
+    furi_assert(keys);
+    furi_assert(walk);
+    furi_assert(key);
+
+    FlipperWedgeClassicCacheEntry* entry =
+        flipper_wedge_classic_keys_find(keys, walk->uid, walk->uid_len, walk->sector);
+    if(entry) {
+        // A new order is saved too, or the next start would evict by the old one
+        if(entry != &keys->cache[0]) keys->cache_dirty = true;
+        entry = flipper_wedge_classic_keys_to_front(keys, entry);
+        if(walk->has_cached && walk->position == 1) {
+            keys->stats.hits++;
+            return;
+        }
+    } else {
+        if(keys->cache_count < FLIPPER_WEDGE_CLASSIC_CACHE_SIZE) {
+            keys->cache_count++;
+        }
+        // The least recently used entry falls off the end when full
+        entry = flipper_wedge_classic_keys_to_front(keys, &keys->cache[keys->cache_count - 1]);
+        memset(entry, 0, sizeof(FlipperWedgeClassicCacheEntry));
+        memcpy(entry->uid, walk->uid, walk->uid_len);
+        entry->uid_len = walk->uid_len;
+        entry->sector = walk->sector;
+    }
+    memcpy(entry->key, key->data, FLIPPER_WEDGE_CLASSIC_KEY_LEN);
+    entry->key_type = key->type;
+    keys->cache_dirty = true;
+}
+
+void flipper_wedge_classic_keys_get_stats(
+    FlipperWedgeClassicKeys* keys,
+    FlipperWedgeClassicKeysStats* stats,
+    bool reset) {
+    furi_assert(keys);
+    furi_assert(stats);
+    *stats = keys->stats;
+    if(reset) {
+        memset(&keys->stats, 0, sizeof(keys->stats));
+    }
+}
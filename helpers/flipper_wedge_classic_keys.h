@@ -0,0 +1,155 @@
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+
+// MIFARE Classic key set and per-tag key cache
+//
+// A sector can only be read after authenticating with its key A or key B,
+// and a failed authentication drops the card out of the session, so every
+// wrong key costs a new activation. Trying a whole key set on each scan
+// takes hundreds of milliseconds; instead the key that opened a sector is
+// remembered per UID and sector, and a repeat scan tries it first. A card
+// whose keys changed walks the key set again and the entry is replaced.
+//
+// The key set is a text file in the Flipper dictionary format, one key of
+// 12 hex digits per line, '#' starts a comment. Without the file a few
+// well-known transport keys are used. Each key is tried as key A, then each
+// as key B.
+//
+// The cache is a fixed table of FLIPPER_WEDGE_CLASSIC_CACHE_SIZE entries,
+// most recently used first, saved to SD only when a key was learned or
+// dropped or the order changed, so scanning the same card again does not
+// write.
+
+#define FLIPPER_WEDGE_CLASSIC_KEYS_PATH APP_DATA_PATH("classic_keys.txt")
+#define FLIPPER_WEDGE_CLASSIC_CACHE_PATH APP_DATA_PATH("classic_keys.cache")
+#define FLIPPER_WEDGE_CLASSIC_KEY_LEN 6
+#define FLIPPER_WEDGE_CLASSIC_UID_MAX_LEN 10
+#define FLIPPER_WEDGE_CLASSIC_KEYS_MAX 64    // Keys read from the key set file
+#define FLIPPER_WEDGE_CLASSIC_CACHE_SIZE 64  // UID/sector entries kept
+
+typedef enum {
+    FlipperWedgeClassicKeyTypeA,
+    FlipperWedgeClassicKeyTypeB,
+} FlipperWedgeClassicKeyType;
+
+typedef struct {
+    uint8_t data[FLIPPER_WEDGE_CLASSIC_KEY_LEN];
+    FlipperWedgeClassicKeyType type;
+} FlipperWedgeClassicKey;
+
+// Keys to try for one sector of one tag, see flipper_wedge_classic_keys_walk_start()
+typedef struct {
+    uint8_t uid[FLIPPER_WEDGE_CLASSIC_UID_MAX_LEN];
+    uint8_t uid_len;
+    uint8_t sector;
+    bool has_cached;      // The cache had a key for this sector
+    FlipperWedgeClassicKey cached;
+    uint16_t position;    // Next candidate: 0 is the cached key, then the key set
+} FlipperWedgeClassicWalk;
+
+typedef struct {
+    uint32_t walks;     // Sectors looked up
+    uint32_t hits;      // Sectors opened by their cached key
+    uint32_t attempts;  // Keys handed out, one authentication each
+} FlipperWedgeClassicKeysStats;
+
+typedef struct FlipperWedgeClassicKeys FlipperWedgeClassicKeys;
+
+/** Allocate key set with the built-in keys and an empty cache
+ *
+ * @return FlipperWedgeClassicKeys instance
+ */
+FlipperWedgeClassicKeys* flipper_wedge_classic_keys_alloc(void);
+
+/** Free key set, saving the cache if it changed
+ *
+ * @param keys FlipperWedgeClassicKeys instance
+ */
+void flipper_wedge_classic_keys_free(FlipperWedgeClassicKeys* keys);
+
+/** Load the key set and the cache
+ * A missing key set file keeps the built-in keys, a missing or damaged
+ * cache file starts an empty cache.
+ *
+ * @param keys FlipperWedgeClassicKeys instance
+ * @param keys_path Key set file
+ * @param cache_path Cache file, also where flipper_wedge_classic_keys_save() writes
+ * @return Number of keys in the set
+ */
+size_t flipper_wedge_classic_keys_load(
+    FlipperWedgeClassicKeys* keys,
+    const char* keys_path,
+    const char* cache_path);
+
+/** Write the cache if a key was learned or dropped since the last save
+ *
+ * @param keys FlipperWedgeClassicKeys instance
+ * @return false if the file could not be written
+ */
+bool flipper_wedge_classic_keys_save(FlipperWedgeClassicKeys* keys);
+
+/** Drop every cached key
+ *
+ * @param keys FlipperWedgeClassicKeys instance
+ */
+void flipper_wedge_classic_keys_clear_cache(FlipperWedgeClassicKeys* keys);
+
+/** Get the number of keys in the set
+ *
+ * @param keys FlipperWedgeClassicKeys instance
+ * @return Key count
+ */
+size_t flipper_wedge_classic_keys_get_count(FlipperWedgeClassicKeys* keys);
+
+/** Start trying keys for a sector, cached key first
+ *
+ * @param keys FlipperWedgeClassicKeys instance
+ * @param walk Walk to start
+ * @param uid UID bytes
+ * @param uid_len Length of UID
+ * @param sector Sector number
+ */
+void flipper_wedge_classic_keys_walk_start(
+    FlipperWedgeClassicKeys* keys,
+    FlipperWedgeClassicWalk* walk,
+    const uint8_t* uid,
+    uint8_t uid_len,
+    uint8_t sector);
+
+/** Get the next key to authenticate with
+ * Asking again means the previous key failed: a cached key that failed is
+ * dropped from the cache.
+ *
+ * @param keys FlipperWedgeClassicKeys instance
+ * @param walk Started walk
+ * @param key Receives the key
+ * @return false once every key was tried
+ */
+bool flipper_wedge_classic_keys_walk_next(
+    FlipperWedgeClassicKeys* keys,
+    FlipperWedgeClassicWalk* walk,
+    FlipperWedgeClassicKey* key);
+
+/** Remember the key that opened the sector
+ *
+ * @param keys FlipperWedgeClassicKeys instance
+ * @param walk Walk the key came from
+ * @param key Key that authenticated
+ */
+void flipper_wedge_classic_keys_walk_found(
+    FlipperWedgeClassicKeys* keys,
+    FlipperWedgeClassicWalk* walk,
+    const FlipperWedgeClassicKey* key);
+
+/** Get lookup counters since the last reset
+ *
+ * @param keys FlipperWedgeClassicKeys instance
+ * @param stats Receives the counters
+ * @param reset Start counting again from zero
+ */
+void flipper_wedge_classic_keys_get_stats(
+    FlipperWedgeClassicKeys* keys,
+    FlipperWedgeClassicKeysStats* stats,
+    bool reset);
@@ -9,8 +9,7 @@ typedef enum {
     FlipperWedgeCustomEventTestType,
 
     // Scan events
-    FlipperWedgeCustomEventNfcDetected,
-    FlipperWedgeCustomEventRfidDetected,
+    FlipperWedgeCustomEventScanQueued,  // A reader put a record in the scan queue
     FlipperWedgeCustomEventScanTimeout,
     FlipperWedgeCustomEventDisplayDone,
     FlipperWedgeCustomEventCooldownDone,
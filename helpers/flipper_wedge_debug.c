@@ -1,6 +1,7 @@
 #include "flipper_wedge_debug.h"
 #include <storage/storage.h>
 #include <stdarg.h>
+#include <inttypes.h>
 
 #define DEBUG_LOG_PATH APP_DATA_PATH("debug.log")
 #define DEBUG_LOG_MAX_SIZE (50 * 1024)  // 50KB max log size
@@ -106,7 +107,7 @@ void flipper_wedge_debug_log(const char* tag, const char* format, ...) {
     seconds = seconds % 60;
 
     char timestamp[32];
-    snprintf(timestamp, sizeof(timestamp), "[%02lu:%02lu.%03lu]", minutes, seconds, millis);
+    snprintf(timestamp, sizeof(timestamp), "[%02" PRIu32 ":%02" PRIu32 ".%03" PRIu32 "]", minutes, seconds, millis);
 
     // Write timestamp and tag
     storage_file_write(debug_file, timestamp, strlen(timestamp));
@@ -130,6 +131,19 @@ void flipper_wedge_debug_log(const char* tag, const char* format, ...) {
     furi_mutex_release(debug_mutex);
 }
 
+void flipper_wedge_debug_log_stack(const char* tag, const char* where) {
+#ifdef FURI_DEBUG
+    FuriThreadId thread_id = furi_thread_get_current_id();
+    uint32_t free_bytes = furi_thread_get_stack_space(thread_id);
+    const char* thread_name = furi_thread_get_name(thread_id);
+    FURI_LOG_D(tag, "Stack %s: %s min free %lu bytes", where, thread_name ? thread_name : "?", free_bytes);
+    flipper_wedge_debug_log(tag, "Stack %s: %s min free %lu bytes", where, thread_name ? thread_name : "?", free_bytes);
+#else
+    UNUSED(tag);
+    UNUSED(where);
+#endif
+}
+
 void flipper_wedge_debug_close(void) {
     if(!debug_mutex) return;
 
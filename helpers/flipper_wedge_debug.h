@@ -20,6 +20,14 @@ void flipper_wedge_debug_init(void);
  */
 void flipper_wedge_debug_log(const char* tag, const char* format, ...);
 
+/** Log the stack high-water mark of the calling thread
+ * Only active in debug firmware builds (FURI_DEBUG), no-op otherwise
+ *
+ * @param tag Tag/module name
+ * @param where Short description of the call site
+ */
+void flipper_wedge_debug_log_stack(const char* tag, const char* where);
+
 /** Close debug logging and flush buffers
  */
 void flipper_wedge_debug_close(void);
@@ -0,0 +1,117 @@
+#include "flipper_wedge_feedback.h"
+
+// Result 200ms, "Sent" with vibration 200ms, cooldown 300ms
+static const FlipperWedgeFeedbackStep feedback_standard_sent[] = {
+    {FlipperWedgeFeedbackShowResult, FlipperWedgeFeedbackLedGreen, false, 200},
+    {FlipperWedgeFeedbackShowSent, FlipperWedgeFeedbackLedKeep, true, 200},
+    {FlipperWedgeFeedbackShowIdle, FlipperWedgeFeedbackLedOff, false, 300},
+};
+
+// Error 500ms, cooldown 300ms (no "Sent")
+static const FlipperWedgeFeedbackStep feedback_standard_error[] = {
+    {FlipperWedgeFeedbackShowResult, FlipperWedgeFeedbackLedRed, false, 500},
+    {FlipperWedgeFeedbackShowIdle, FlipperWedgeFeedbackLedOff, false, 300},
+};
+
+// Same sequence without the cooldown, played while the next tag is read
+static const FlipperWedgeFeedbackStep feedback_throughput_sent[] = {
+    {FlipperWedgeFeedbackShowResult, FlipperWedgeFeedbackLedGreen, false, 200},
+    {FlipperWedgeFeedbackShowSent, FlipperWedgeFeedbackLedKeep, true, 200},
+    {FlipperWedgeFeedbackShowIdle, FlipperWedgeFeedbackLedOff, false, 0},
+};
+
+static const FlipperWedgeFeedbackStep feedback_throughput_error[] = {
+    {FlipperWedgeFeedbackShowResult, FlipperWedgeFeedbackLedRed, false, 500},
+    {FlipperWedgeFeedbackShowIdle, FlipperWedgeFeedbackLedOff, false, 0},
+};
+
+// Rearm -1: after the last step
+#define FEEDBACK_TIMELINE(steps, rearm) \
+    {steps, COUNT_OF(steps), (rearm) < 0 ? (uint8_t)COUNT_OF(steps) : (uint8_t)(rearm)}
+
+static const FlipperWedgeFeedbackTimeline
+    feedback_timelines[FlipperWedgeFeedbackProfileCount][FlipperWedgeFeedbackOutcomeCount] = {
+        [FlipperWedgeFeedbackProfileStandard] =
+            {
+                [FlipperWedgeFeedbackOutcomeSent] = FEEDBACK_TIMELINE(feedback_standard_sent, -1),
+                [FlipperWedgeFeedbackOutcomeError] = FEEDBACK_TIMELINE(feedback_standard_error, -1),
+            },
+        [FlipperWedgeFeedbackProfileThroughput] =
+            {
+                [FlipperWedgeFeedbackOutcomeSent] = FEEDBACK_TIMELINE(feedback_throughput_sent, 0),
+                [FlipperWedgeFeedbackOutcomeError] = FEEDBACK_TIMELINE(feedback_throughput_error, 0),
+            },
+};
+
+// A tag left on the reader repeats no faster than with the standard gate
+static const uint16_t feedback_repeat_ms[FlipperWedgeFeedbackProfileCount] = {
+    0,
+    700,
+};
+
+static const char* const feedback_profile_names[FlipperWedgeFeedbackProfileCount] = {
+    "Standard",
+    "Fast",
+};
+
+const FlipperWedgeFeedbackTimeline*
+    flipper_wedge_feedback_get_timeline(FlipperWedgeFeedbackProfile profile, FlipperWedgeFeedbackOutcome outcome) {
+    if(profile >= FlipperWedgeFeedbackProfileCount) profile = FlipperWedgeFeedbackProfileStandard;
+    furi_assert(outcome < FlipperWedgeFeedbackOutcomeCount);
+    return &feedback_timelines[profile][outcome];
+}
+
+uint32_t flipper_wedge_feedback_gate_ms(const FlipperWedgeFeedbackTimeline* timeline) {
+    furi_assert(timeline);
+
+    uint32_t gate_ms = 0;
+    for(uint8_t step = 0; step < timeline->rearm_step; step++) {
+        gate_ms += timeline->steps[step].duration_ms;
+    }
+    return gate_ms;
+}
+
+uint32_t flipper_wedge_feedback_repeat_ms(FlipperWedgeFeedbackProfile profile) {
+    if(profile >= FlipperWedgeFeedbackProfileCount) return 0;
+    return feedback_repeat_ms[profile];
+}
+
+const char* flipper_wedge_feedback_profile_name(FlipperWedgeFeedbackProfile profile) {
+    if(profile >= FlipperWedgeFeedbackProfileCount) return "Unknown";
+    return feedback_profile_names[profile];
+}
+
+// Length-prefixed so an NFC+RFID pair cannot match a different split of the same bytes
+static uint8_t flipper_wedge_feedback_key_add(uint8_t* key, uint8_t key_len, const uint8_t* uid, uint8_t uid_len) {
+    uid_len = MIN(uid_len, (uint8_t)(FLIPPER_WEDGE_FEEDBACK_KEY_MAX_LEN / 2 - 1));
+    key[key_len++] = uid_len;
+    if(uid_len > 0) {
+        memcpy(&key[key_len], uid, uid_len);
+    }
+    return key_len + uid_len;
+}
+
+bool flipper_wedge_feedback_check_repeat(
+    FlipperWedgeFeedbackRepeat* repeat,
+    const uint8_t* nfc_uid,
+    uint8_t nfc_uid_len,
+    const uint8_t* rfid_uid,
+    uint8_t rfid_uid_len,
+    uint32_t now,
+    uint32_t window_ms) {
+    furi_assert(repeat);
+
+    uint8_t key[FLIPPER_WEDGE_FEEDBACK_KEY_MAX_LEN];
+    uint8_t key_len = flipper_wedge_feedback_key_add(key, 0, nfc_uid, nfc_uid_len);
+    key_len = flipper_wedge_feedback_key_add(key, key_len, rfid_uid, rfid_uid_len);
+
+    if(window_ms > 0 && repeat->key_len == key_len && memcmp(repeat->key, key, key_len) == 0 &&
+       now - repeat->tick < window_ms) {
+        return true;
+    }
+
+    memcpy(repeat->key, key, key_len);
+    repeat->key_len = key_len;
+    repeat->tick = now;
+    return false;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <furi.h>
+
+// Scan feedback timelines
+//
+// What the start screen shows after a scan is a fixed list of steps per
+// profile and outcome: each step sets the display, the LED and the vibration,
+// then holds for its duration. The scene plays the steps from its display
+// timer; nothing here blocks.
+//
+// The rearm step is where scanning restarts. The standard profile rearms
+// after the last step, so the whole timeline gates the next scan. The
+// throughput profile rearms at step 0: feedback plays while the next tag is
+// read, and a new result restarts the timeline. With no gate a tag left on
+// the reader would be typed on every read, so the throughput profile ignores
+// the same tag(s) again for a while after they were output.
+
+#define FLIPPER_WEDGE_FEEDBACK_KEY_MAX_LEN 24  // Length-prefixed NFC and RFID UIDs
+
+typedef enum {
+    FlipperWedgeFeedbackProfileStandard,    // Default: result, "Sent", cooldown, then scan again
+    FlipperWedgeFeedbackProfileThroughput,  // Scan again at once, feedback overlaps the next read
+    FlipperWedgeFeedbackProfileCount,
+} FlipperWedgeFeedbackProfile;
+
+typedef enum {
+    FlipperWedgeFeedbackOutcomeSent,   // Output typed or sent
+    FlipperWedgeFeedbackOutcomeError,  // Nothing output, the status text says why
+    FlipperWedgeFeedbackOutcomeCount,
+} FlipperWedgeFeedbackOutcome;
+
+typedef enum {
+    FlipperWedgeFeedbackShowResult,  // Output (or error) with its status text
+    FlipperWedgeFeedbackShowSent,    // "Sent"
+    FlipperWedgeFeedbackShowIdle,    // Mode selector, status cleared
+} FlipperWedgeFeedbackShow;
+
+typedef enum {
+    FlipperWedgeFeedbackLedKeep,
+    FlipperWedgeFeedbackLedGreen,
+    FlipperWedgeFeedbackLedRed,
+    FlipperWedgeFeedbackLedOff,
+} FlipperWedgeFeedbackLed;
+
+typedef struct {
+    FlipperWedgeFeedbackShow show;
+    FlipperWedgeFeedbackLed led;
+    bool bump;             // Vibrate (at the vibration setting) when the step starts
+    uint16_t duration_ms;  // Hold before the next step
+} FlipperWedgeFeedbackStep;
+
+typedef struct {
+    const FlipperWedgeFeedbackStep* steps;
+    uint8_t step_count;
+    uint8_t rearm_step;  // Scanning restarts entering this step, step_count: after the last one
+} FlipperWedgeFeedbackTimeline;
+
+// Last output, for the repeat window
+typedef struct {
+    uint8_t key[FLIPPER_WEDGE_FEEDBACK_KEY_MAX_LEN];
+    uint8_t key_len;
+    uint32_t tick;
+} FlipperWedgeFeedbackRepeat;
+
+/** Get the timeline of a profile and outcome
+ *
+ * @param profile Feedback profile
+ * @param outcome Scan outcome
+ * @return Static timeline
+ */
+const FlipperWedgeFeedbackTimeline*
+    flipper_wedge_feedback_get_timeline(FlipperWedgeFeedbackProfile profile, FlipperWedgeFeedbackOutcome outcome);
+
+/** Time the timeline holds the reader before scanning restarts
+ *
+ * @param timeline Timeline
+ * @return Sum of the step durations before the rearm step, in ms
+ */
+uint32_t flipper_wedge_feedback_gate_ms(const FlipperWedgeFeedbackTimeline* timeline);
+
+/** Time the same tag(s) are ignored after they were output
+ *
+ * @param profile Feedback profile
+ * @return Repeat window in ms, 0 if repeats are not filtered
+ */
+uint32_t flipper_wedge_feedback_repeat_ms(FlipperWedgeFeedbackProfile profile);
+
+/** Get display name of a profile
+ *
+ * @param profile Feedback profile
+ * @return Static string name
+ */
+const char* flipper_wedge_feedback_profile_name(FlipperWedgeFeedbackProfile profile);
+
+/** Check a scan against the last output and remember it if it is new
+ * A scan is a repeat if it has the same NFC and RFID UIDs as the last output
+ * and comes within window_ms of it. A repeat does not extend the window.
+ *
+ * @param repeat Last output, zeroed before the first scan
+ * @param nfc_uid NFC UID (can be NULL if nfc_uid_len is 0)
+ * @param nfc_uid_len NFC UID length
+ * @param rfid_uid RFID UID (can be NULL if rfid_uid_len is 0)
+ * @param rfid_uid_len RFID UID length
+ * @param now Current furi_get_tick()
+ * @param window_ms Repeat window, 0 never reports a repeat
+ * @return true if the scan is a repeat and should be ignored
+ */
+bool flipper_wedge_feedback_check_repeat(
+    FlipperWedgeFeedbackRepeat* repeat,
+    const uint8_t* nfc_uid,
+    uint8_t nfc_uid_len,
+    const uint8_t* rfid_uid,
+    uint8_t rfid_uid_len,
+    uint32_t now,
+    uint32_t window_ms);
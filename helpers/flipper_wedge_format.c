@@ -119,6 +119,64 @@ void flipper_wedge_format_output(
     output[pos] = '\0';
 }
 
+size_t flipper_wedge_utf8_decode(const char* str, uint32_t* code_point) {
+    const uint8_t* bytes = (const uint8_t*)str;
+    uint8_t lead = bytes[0];
+    *code_point = FLIPPER_WEDGE_UTF8_INVALID;
+
+    if(lead == 0) return 0;
+    if(lead < 0x80) {
+        *code_point = lead;
+        return 1;
+    }
+
+    size_t len;
+    uint32_t value;
+    uint32_t min;
+    if((lead & 0xE0) == 0xC0) {
+        len = 2;
+        value = lead & 0x1F;
+        min = 0x80;
+    } else if((lead & 0xF0) == 0xE0) {
+        len = 3;
+        value = lead & 0x0F;
+        min = 0x800;
+    } else if((lead & 0xF8) == 0xF0) {
+        len = 4;
+        value = lead & 0x07;
+        min = 0x10000;
+    } else {
+        return 1;  // Continuation byte or invalid lead
+    }
+
+    for(size_t i = 1; i < len; i++) {
+        // Also stops at the terminating NUL of a cut sequence
+        if((bytes[i] & 0xC0) != 0x80) return 1;
+        value = (value << 6) | (bytes[i] & 0x3F);
+    }
+
+    // Overlong forms, UTF-16 surrogates and values past U+10FFFF are not text
+    if(value < min || (value >= 0xD800 && value <= 0xDFFF) || value > 0x10FFFF) return 1;
+
+    *code_point = value;
+    return len;
+}
+
+size_t flipper_wedge_utf8_tail_len(const char* text, size_t len) {
+    const uint8_t* bytes = (const uint8_t*)text;
+
+    // Walk back over at most 3 continuation bytes to the lead byte
+    for(size_t back = 1; back <= 3 && back <= len; back++) {
+        uint8_t byte = bytes[len - back];
+        if((byte & 0xC0) == 0x80) continue;
+        if(byte < 0xC0) return 0;  // ASCII: nothing pending
+
+        size_t need = (byte & 0xE0) == 0xC0 ? 2 : (byte & 0xF0) == 0xE0 ? 3 : 4;
+        return need > back ? back : 0;
+    }
+    return 0;
+}
+
 size_t flipper_wedge_sanitize_text(
     const char* input,
     char* output,
@@ -134,27 +192,167 @@ size_t flipper_wedge_sanitize_text(
 
     size_t out_pos = 0;
     size_t in_pos = 0;
+    size_t chars = 0;
     size_t effective_max = (max_len == 0) ? output_size - 1 : max_len;
 
-    // Ensure we don't exceed output buffer
-    if(effective_max >= output_size) {
-        effective_max = output_size - 1;
-    }
-
-    // Copy only printable ASCII characters (0x20-0x7E)
-    while(input[in_pos] != '\0' && out_pos < effective_max) {
+    // Copy printable characters, counting each UTF-8 sequence as one
+    while(input[in_pos] != '\0' && chars < effective_max) {
         char c = input[in_pos];
 
         // Allow printable ASCII: space (0x20) through tilde (0x7E)
         // Also allow tab (0x09) and newline (0x0A) which HID can handle
         if((c >= 0x20 && c <= 0x7E) || c == '\t' || c == '\n') {
+            if(out_pos + 1 >= output_size) break;
             output[out_pos++] = c;
+            chars++;
+            in_pos++;
+            continue;
         }
-        // Skip non-printable characters (including control chars and extended ASCII)
 
-        in_pos++;
+        // Non-ASCII: keep well-formed sequences of printable code points (not
+        // the C1 controls), the HID output types them with the Unicode setting
+        uint32_t code_point;
+        size_t len = flipper_wedge_utf8_decode(&input[in_pos], &code_point);
+        if(code_point != FLIPPER_WEDGE_UTF8_INVALID && code_point >= 0xA0) {
+            // Never cut a sequence at the end of the buffer
+            if(out_pos + len >= output_size) break;
+            for(size_t i = 0; i < len; i++) {
+                output[out_pos++] = input[in_pos + i];
+            }
+            chars++;
+        }
+        // Skip control chars and bytes that are not UTF-8
+
+        in_pos += len;
     }
 
     output[out_pos] = '\0';
-    return out_pos;
+    return chars;
+}
+
+// Append a JSON-escaped string (without quotes). Returns false if it did not fit.
+static bool flipper_wedge_format_json_escape(
+    const char* str,
+    char* output,
+    size_t output_size,
+    size_t* pos) {
+    for(const char* c = str; *c != '\0'; c++) {
+        char esc = 0;
+        switch(*c) {
+        case '"': esc = '"'; break;
+        case '\\': esc = '\\'; break;
+        case '\n': esc = 'n'; break;
+        case '\r': esc = 'r'; break;
+        case '\t': esc = 't'; break;
+        default: break;
+        }
+
+        if(esc) {
+            if(*pos + 2 >= output_size) return false;
+            output[(*pos)++] = '\\';
+            output[(*pos)++] = esc;
+        } else if((uint8_t)*c < 0x20) {
+            if(*pos + 6 >= output_size) return false;
+            snprintf(output + *pos, output_size - *pos, "\\u%04x", (uint8_t)*c);
+            *pos += 6;
+        } else {
+            if(*pos + 1 >= output_size) return false;
+            output[(*pos)++] = *c;
+        }
+    }
+    return true;
+}
+
+// Append ,"key":"value" (escaped). Returns false if it did not fit.
+static bool flipper_wedge_format_json_field(
+    const char* key,
+    const char* value,
+    char* output,
+    size_t output_size,
+    size_t* pos) {
+    int written = snprintf(output + *pos, output_size - *pos, ",\"%s\":\"", key);
+    if(written < 0 || *pos + written >= output_size) return false;
+    *pos += written;
+
+    if(!flipper_wedge_format_json_escape(value, output, output_size, pos)) return false;
+
+    if(*pos + 1 >= output_size) return false;
+    output[(*pos)++] = '"';
+    return true;
+}
+
+size_t flipper_wedge_format_record_json(
+    uint32_t timestamp,
+    const uint8_t* nfc_uid,
+    uint8_t nfc_uid_len,
+    const char* nfc_protocol,
+    const uint8_t* rfid_uid,
+    uint8_t rfid_uid_len,
+    const char* rfid_protocol,
+    const FlipperWedgeRfidDecoded* rfid_decoded,
+    const char* ndef_text,
+    const char* event,
+    char* output,
+    size_t output_size) {
+
+    if(!output || output_size == 0) {
+        return 0;
+    }
+
+    size_t pos = 0;
+    char uid_buf[64];
+    bool ok = true;
+
+    int written = snprintf(output, output_size, "{\"ts\":%lu", (unsigned long)timestamp);
+    if(written < 0 || (size_t)written >= output_size) ok = false;
+    if(ok) pos = written;
+
+    if(ok && nfc_uid && nfc_uid_len > 0) {
+        // Records always use the compact form, independent of the typing delimiter
+        flipper_wedge_format_uid(nfc_uid, nfc_uid_len, "", uid_buf, sizeof(uid_buf));
+        ok = flipper_wedge_format_json_field("nfc_uid", uid_buf, output, output_size, &pos);
+        if(ok && nfc_protocol && nfc_protocol[0] != '\0') {
+            ok = flipper_wedge_format_json_field("nfc_proto", nfc_protocol, output, output_size, &pos);
+        }
+    }
+
+    if(ok && rfid_uid && rfid_uid_len > 0) {
+        flipper_wedge_format_uid(rfid_uid, rfid_uid_len, "", uid_buf, sizeof(uid_buf));
+        ok = flipper_wedge_format_json_field("rfid_uid", uid_buf, output, output_size, &pos);
+        if(ok && rfid_protocol && rfid_protocol[0] != '\0') {
+            ok = flipper_wedge_format_json_field("rfid_proto", rfid_protocol, output, output_size, &pos);
+        }
+        if(ok && rfid_decoded && (rfid_decoded->fields & FlipperWedgeRfidFieldNumber)) {
+            ok = flipper_wedge_format_json_field("rfid_num", rfid_decoded->number, output, output_size, &pos);
+        }
+        if(ok && rfid_decoded && (rfid_decoded->fields & FlipperWedgeRfidFieldFacility)) {
+            written = snprintf(output + pos, output_size - pos, ",\"rfid_fc\":%lu", (unsigned long)rfid_decoded->facility);
+            if(written < 0 || pos + written >= output_size) ok = false;
+            if(ok) pos += written;
+        }
+        if(ok && rfid_decoded && (rfid_decoded->fields & FlipperWedgeRfidFieldCard)) {
+            written = snprintf(output + pos, output_size - pos, ",\"rfid_card\":%lu", (unsigned long)rfid_decoded->card);
+            if(written < 0 || pos + written >= output_size) ok = false;
+            if(ok) pos += written;
+        }
+    }
+
+    if(ok && ndef_text && ndef_text[0] != '\0') {
+        ok = flipper_wedge_format_json_field("ndef", ndef_text, output, output_size, &pos);
+    }
+
+    if(ok && event && event[0] != '\0') {
+        ok = flipper_wedge_format_json_field("event", event, output, output_size, &pos);
+    }
+
+    // Close object and terminate the frame
+    if(ok && pos + 2 < output_size) {
+        output[pos++] = '}';
+        output[pos++] = '\n';
+        output[pos] = '\0';
+        return pos;
+    }
+
+    output[0] = '\0';
+    return 0;
 }
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <furi.h>
+#include "flipper_wedge_rfid.h"
 
 #define FLIPPER_WEDGE_FORMAT_MAX_LEN 128
+#define FLIPPER_WEDGE_UTF8_INVALID UINT32_MAX
 
 /** Format UID bytes to hex string with delimiter
  *
@@ -42,17 +44,71 @@ void flipper_wedge_format_output(
     char* output,
     size_t output_size);
 
+/** Decode one UTF-8 character
+ *
+ * @param str NUL-terminated text
+ * @param code_point Receives the code point, FLIPPER_WEDGE_UTF8_INVALID for a
+ *        byte that does not start a well-formed sequence
+ * @return Bytes used (1 for an invalid byte), 0 at the end of the text
+ */
+size_t flipper_wedge_utf8_decode(const char* str, uint32_t* code_point);
+
+/** Length of a UTF-8 sequence cut off at the end of a buffer
+ * Used to carry the start of a character over to the next chunk of text.
+ *
+ * @param text Text bytes
+ * @param len Number of bytes
+ * @return Bytes of the incomplete last sequence, 0 if the text ends on a character
+ */
+size_t flipper_wedge_utf8_tail_len(const char* text, size_t len);
+
 /** Sanitize text for HID keyboard typing
- * Removes non-printable characters and truncates to max length
+ * Removes non-printable characters and bytes that are not UTF-8, keeps
+ * printable non-ASCII characters whole, and truncates to max length
  *
  * @param input Input text (may contain binary data)
- * @param output Output buffer for sanitized text
+ * @param output Output buffer for sanitized text (may be input)
  * @param output_size Size of output buffer
  * @param max_len Maximum characters to keep (0 = no limit)
- * @return Number of characters in sanitized output
+ * @return Number of characters (not bytes) in sanitized output
  */
 size_t flipper_wedge_sanitize_text(
     const char* input,
     char* output,
     size_t output_size,
     size_t max_len);
+
+/** Format one scan as a structured record for the USB serial output
+ * Produces a single newline-terminated JSON object (NDJSON framing), e.g.
+ * {"ts":1718000000,"nfc_uid":"04A1B2C3","nfc_proto":"ISO14443-3A","ndef":"hi"}
+ * Decoded RFID fields are added as "rfid_num" (string), "rfid_fc" and "rfid_card" (numbers).
+ * Presence tracking adds "event" ("arrive" or "depart").
+ * Fields for absent data are omitted. Strings are JSON-escaped.
+ *
+ * @param timestamp Unix timestamp of the scan
+ * @param nfc_uid NFC UID bytes (can be NULL)
+ * @param nfc_uid_len Length of NFC UID
+ * @param nfc_protocol NFC protocol name (can be NULL or empty)
+ * @param rfid_uid RFID UID bytes (can be NULL)
+ * @param rfid_uid_len Length of RFID UID
+ * @param rfid_protocol RFID protocol name (can be NULL or empty)
+ * @param rfid_decoded Decoded RFID fields (can be NULL)
+ * @param ndef_text NDEF text payload (can be NULL or empty)
+ * @param event Presence event (can be NULL)
+ * @param output Output buffer
+ * @param output_size Size of output buffer
+ * @return Length of the record, 0 if it did not fit
+ */
+size_t flipper_wedge_format_record_json(
+    uint32_t timestamp,
+    const uint8_t* nfc_uid,
+    uint8_t nfc_uid_len,
+    const char* nfc_protocol,
+    const uint8_t* rfid_uid,
+    uint8_t rfid_uid_len,
+    const char* rfid_protocol,
+    const FlipperWedgeRfidDecoded* rfid_decoded,
+    const char* ndef_text,
+    const char* event,
+    char* output,
+    size_t output_size);
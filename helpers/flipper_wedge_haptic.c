@@ -44,3 +44,46 @@ void flipper_wedge_play_long_bump(void* context) {
         furi_thread_flags_wait(0, FuriFlagWaitAny, 100);
     }
 }
+
+// The notification service times these, so the caller does not wait
+static const NotificationSequence sequence_happy_bump_low = {
+    &message_vibro_on,
+    &message_delay_10,
+    &message_delay_10,
+    &message_delay_10,
+    &message_vibro_off,
+    NULL,
+};
+
+static const NotificationSequence sequence_happy_bump_medium = {
+    &message_vibro_on,
+    &message_delay_50,
+    &message_delay_10,
+    &message_vibro_off,
+    NULL,
+};
+
+static const NotificationSequence sequence_happy_bump_high = {
+    &message_vibro_on,
+    &message_delay_100,
+    &message_vibro_off,
+    NULL,
+};
+
+void flipper_wedge_play_happy_bump_async(void* context) {
+    FlipperWedge* app = context;
+
+    switch(app->vibration_level) {
+        case FlipperWedgeVibrationOff:
+            return;
+        case FlipperWedgeVibrationMedium:
+            notification_message(app->notification, &sequence_happy_bump_medium);
+            break;
+        case FlipperWedgeVibrationHigh:
+            notification_message(app->notification, &sequence_happy_bump_high);
+            break;
+        default:
+            notification_message(app->notification, &sequence_happy_bump_low);
+            break;
+    }
+}
@@ -2,6 +2,9 @@
 
 void flipper_wedge_play_happy_bump(void* context);
 
+// Same bump without waiting for it to end
+void flipper_wedge_play_happy_bump_async(void* context);
+
 void flipper_wedge_play_bad_bump(void* context);
 
 void flipper_wedge_play_long_bump(void* context);
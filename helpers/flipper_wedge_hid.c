@@ -1,29 +1,64 @@
 #include "flipper_wedge_hid.h"
 #include "flipper_wedge_keyboard_layout.h"
 #include "flipper_wedge_debug.h"
+#include "flipper_wedge_usb_nkro.h"
+#include "flipper_wedge_format.h"
 #include <storage/storage.h>
+#include <cli/cli.h>
+#include <cli/cli_vcp.h>
 
 #define TAG "FlipperWedgeHid"
 
 #define HID_TYPE_DELAY_MS 2
+#define HID_NKRO_BATCH_MAX 32  // Keys per NKRO report when typing strings
 
 // MAC address XOR to make Flipper appear as different device in HID mode
 #define HID_BT_MAC_XOR 0xF1D0  // "FliD" in hex - unique identifier
 
+// BLE connection parameters requested by the HID profile (units of 1.25 ms / 10 ms)
+// Short interval so keystroke notifications go out quickly while typing; slave
+// latency lets the link skip connection events when idle instead of renegotiating.
+#define HID_BT_CONN_INT_MIN 0x09        // 11.25 ms
+#define HID_BT_CONN_INT_MAX 0x0C        // 15 ms
+#define HID_BT_SLAVE_LATENCY 4          // Up to 75 ms between events when idle
+#define HID_BT_SUPERVISOR_TIMEOUT 400   // 4 s
+
+// USB serial (CDC) output
+#define HID_SERIAL_IF_NUM 0
+#define HID_SERIAL_PACKET_SIZE 64      // CDC_DATA_SZ (full-speed bulk endpoint)
+#define HID_SERIAL_TX_TIMEOUT_MS 100   // Give up if host stops reading
+
 struct FlipperWedgeHid {
     // USB HID
     FuriHalUsbInterface* usb_mode_prev;  // Save previous USB mode for restoration
     bool usb_initialized;
+    bool usb_nkro;         // Use the NKRO interface on next USB init
+    bool usb_nkro_active;  // NKRO interface is the current USB config
 
     // Bluetooth HID
     Bt* bt;
     FuriHalBleProfileBase* ble_hid_profile;
     bool bt_initialized;
     bool bt_connected;
+    uint32_t ble_wait_start;  // Tick when we started waiting for a (re)connection
+    FlipperWedgeHidBleStats ble_stats;
+
+    // USB serial (CDC)
+    bool serial_initialized;
+    volatile bool serial_connected;
+    FuriSemaphore* serial_tx_done;
+    CdcCallbacks serial_callbacks;
 
     // Callback
     FlipperWedgeHidConnectionCallback connection_callback;
     void* connection_callback_context;
+
+    FlipperWedgeLatency* latency;  // First/last key stamps (can be NULL)
+
+    // Non-ASCII characters
+    FlipperWedgeUnicode* unicode;  // Input sequences (NULL: skipped)
+    uint8_t nkro_modifiers;        // Modifiers held in NKRO reports while typing a sequence
+    uint32_t unicode_typed;        // Non-ASCII characters in the current string
 };
 
 static void flipper_wedge_hid_bt_status_callback(BtStatus status, void* context) {
@@ -36,23 +71,95 @@ static void flipper_wedge_hid_bt_status_callback(BtStatus status, void* context)
 
     FURI_LOG_I(TAG, "BT status: %d (prev=%d, new=%d)", status, prev_connected, connected);
 
+    if(connected && !prev_connected) {
+        instance->ble_stats.connect_ms = furi_get_tick() - instance->ble_wait_start;
+        instance->ble_stats.connect_count++;
+        FURI_LOG_I(TAG, "BLE connected after %lu ms", instance->ble_stats.connect_ms);
+        flipper_wedge_debug_log(TAG, "BLE connected after %lu ms", instance->ble_stats.connect_ms);
+    } else if(!connected && prev_connected) {
+        instance->ble_wait_start = furi_get_tick();
+    }
+
     if(instance->connection_callback) {
         bool usb_connected = flipper_wedge_hid_is_usb_connected(instance);
         instance->connection_callback(usb_connected, connected, instance->connection_callback_context);
     }
 }
 
+static void flipper_wedge_hid_serial_tx_callback(void* context) {
+    FlipperWedgeHid* instance = context;
+    // Called from USB interrupt once the host has taken the packet
+    furi_semaphore_release(instance->serial_tx_done);
+}
+
+static void flipper_wedge_hid_serial_state_callback(void* context, CdcState state) {
+    FlipperWedgeHid* instance = context;
+    if(state == CdcStateDisconnected) {
+        instance->serial_connected = false;
+    }
+}
+
+static void flipper_wedge_hid_serial_ctrl_line_callback(void* context, CdcCtrlLine ctrl_lines) {
+    FlipperWedgeHid* instance = context;
+    // Host terminal programs raise DTR when they open the port
+    instance->serial_connected = (ctrl_lines & CdcCtrlLineDTR) != 0;
+}
+
+static FuriHalBleProfileBase* flipper_wedge_hid_ble_profile_start(FuriHalBleProfileParams profile_params) {
+    return ble_profile_hid->start(profile_params);
+}
+
+static void flipper_wedge_hid_ble_profile_stop(FuriHalBleProfileBase* profile) {
+    ble_profile_hid->stop(profile);
+}
+
+static void flipper_wedge_hid_ble_profile_get_gap_config(
+    GapConfig* config,
+    FuriHalBleProfileParams profile_params) {
+    ble_profile_hid->get_gap_config(config, profile_params);
+    config->conn_param.conn_int_min = HID_BT_CONN_INT_MIN;
+    config->conn_param.conn_int_max = HID_BT_CONN_INT_MAX;
+    config->conn_param.slave_latency = HID_BT_SLAVE_LATENCY;
+    config->conn_param.supervisor_timeout = HID_BT_SUPERVISOR_TIMEOUT;
+}
+
+// Stock HID profile with our connection parameters. The started profile is
+// still a ble_profile_hid instance, so the ble_profile_hid_kb_* calls accept it.
+static const FuriHalBleProfileTemplate flipper_wedge_hid_ble_profile = {
+    .start = flipper_wedge_hid_ble_profile_start,
+    .stop = flipper_wedge_hid_ble_profile_stop,
+    .get_gap_config = flipper_wedge_hid_ble_profile_get_gap_config,
+};
+
 FlipperWedgeHid* flipper_wedge_hid_alloc(void) {
     FlipperWedgeHid* instance = malloc(sizeof(FlipperWedgeHid));
 
     instance->usb_mode_prev = NULL;
     instance->usb_initialized = false;
+    instance->usb_nkro = false;
+    instance->usb_nkro_active = false;
     instance->bt = NULL;
     instance->ble_hid_profile = NULL;
     instance->bt_initialized = false;
     instance->bt_connected = false;
+    instance->ble_wait_start = 0;
+    memset(&instance->ble_stats, 0, sizeof(instance->ble_stats));
+    instance->serial_initialized = false;
+    instance->serial_connected = false;
+    instance->serial_tx_done = furi_semaphore_alloc(1, 0);
+    instance->serial_callbacks = (CdcCallbacks){
+        .tx_ep_callback = flipper_wedge_hid_serial_tx_callback,
+        .rx_ep_callback = NULL,
+        .state_callback = flipper_wedge_hid_serial_state_callback,
+        .ctrl_line_callback = flipper_wedge_hid_serial_ctrl_line_callback,
+        .config_callback = NULL,
+    };
     instance->connection_callback = NULL;
     instance->connection_callback_context = NULL;
+    instance->latency = NULL;
+    instance->unicode = NULL;
+    instance->nkro_modifiers = 0;
+    instance->unicode_typed = 0;
 
     return instance;
 }
@@ -67,7 +174,11 @@ void flipper_wedge_hid_free(FlipperWedgeHid* instance) {
     if(instance->bt_initialized) {
         flipper_wedge_hid_deinit_ble(instance);
     }
+    if(instance->serial_initialized) {
+        flipper_wedge_hid_deinit_serial(instance);
+    }
 
+    furi_semaphore_free(instance->serial_tx_done);
     free(instance);
 }
 
@@ -79,13 +190,18 @@ void flipper_wedge_hid_init_usb(FlipperWedgeHid* instance) {
         return;
     }
 
-    FURI_LOG_I(TAG, "Initializing USB HID");
-    flipper_wedge_debug_log(TAG, "Init USB HID");
+    FURI_LOG_I(TAG, "Initializing USB HID (%s)", instance->usb_nkro ? "NKRO" : "6KRO");
+    flipper_wedge_debug_log(TAG, "Init USB HID (%s)", instance->usb_nkro ? "NKRO" : "6KRO");
 
     // Save current USB mode for restoration (like Bad USB)
     instance->usb_mode_prev = furi_hal_usb_get_config();
     furi_hal_usb_unlock();
-    furi_check(furi_hal_usb_set_config(&usb_hid, NULL) == true);
+    if(instance->usb_nkro) {
+        furi_check(furi_hal_usb_set_config(&flipper_wedge_usb_nkro, NULL) == true);
+    } else {
+        furi_check(furi_hal_usb_set_config(&usb_hid, NULL) == true);
+    }
+    instance->usb_nkro_active = instance->usb_nkro;
     instance->usb_initialized = true;
 
     FURI_LOG_I(TAG, "USB HID initialized");
@@ -114,6 +230,7 @@ void flipper_wedge_hid_deinit_usb(FlipperWedgeHid* instance) {
         furi_hal_usb_set_config(instance->usb_mode_prev, NULL);
     }
     instance->usb_initialized = false;
+    instance->usb_nkro_active = false;
 
     FURI_LOG_I(TAG, "USB HID deinitialized");
 
@@ -124,6 +241,145 @@ void flipper_wedge_hid_deinit_usb(FlipperWedgeHid* instance) {
     }
 }
 
+void flipper_wedge_hid_set_usb_nkro(FlipperWedgeHid* instance, bool nkro) {
+    furi_assert(instance);
+    instance->usb_nkro = nkro;
+}
+
+void flipper_wedge_hid_set_latency(FlipperWedgeHid* instance, FlipperWedgeLatency* latency) {
+    furi_assert(instance);
+    instance->latency = latency;
+}
+
+void flipper_wedge_hid_set_unicode(FlipperWedgeHid* instance, FlipperWedgeUnicode* unicode) {
+    furi_assert(instance);
+    instance->unicode = unicode;
+}
+
+// A key report went out: the first one of an output and, until another follows, the last
+static void flipper_wedge_hid_mark_key(FlipperWedgeHid* instance) {
+    flipper_wedge_latency_mark(instance->latency, FlipperWedgeLatencyStageFirstKey);
+    flipper_wedge_latency_mark(instance->latency, FlipperWedgeLatencyStageLastKey);
+}
+
+void flipper_wedge_hid_init_serial(FlipperWedgeHid* instance) {
+    furi_assert(instance);
+
+    if(instance->serial_initialized) {
+        FURI_LOG_W(TAG, "USB serial already initialized");
+        return;
+    }
+
+    FURI_LOG_I(TAG, "Initializing USB serial");
+    flipper_wedge_debug_log(TAG, "Init USB serial (CDC)");
+
+    // Interface 0 belongs to the CLI: close its session before taking it over,
+    // as the USB-UART bridge does, so the CLI does not read the port too
+    Cli* cli = furi_record_open(RECORD_CLI);
+    cli_session_close(cli);
+    furi_record_close(RECORD_CLI);
+
+    // Save current USB mode for restoration (same as USB HID)
+    instance->usb_mode_prev = furi_hal_usb_get_config();
+    furi_hal_usb_unlock();
+    furi_check(furi_hal_usb_set_config(&usb_cdc_single, NULL) == true);
+    furi_hal_cdc_set_callbacks(HID_SERIAL_IF_NUM, &instance->serial_callbacks, instance);
+
+    // Port may already be open on the host side
+    instance->serial_connected =
+        (furi_hal_cdc_get_ctrl_line_state(HID_SERIAL_IF_NUM) & CdcCtrlLineDTR) != 0;
+    instance->serial_initialized = true;
+
+    FURI_LOG_I(TAG, "USB serial initialized");
+
+    // Notify connection callback
+    if(instance->connection_callback) {
+        instance->connection_callback(
+            instance->serial_connected,
+            flipper_wedge_hid_is_bt_connected(instance),
+            instance->connection_callback_context);
+    }
+}
+
+void flipper_wedge_hid_deinit_serial(FlipperWedgeHid* instance) {
+    furi_assert(instance);
+
+    if(!instance->serial_initialized) {
+        FURI_LOG_W(TAG, "USB serial not initialized");
+        return;
+    }
+
+    FURI_LOG_I(TAG, "Deinitializing USB serial");
+    flipper_wedge_debug_log(TAG, "Deinit USB serial (CDC)");
+
+    furi_hal_cdc_set_callbacks(HID_SERIAL_IF_NUM, NULL, NULL);
+    if(instance->usb_mode_prev) {
+        furi_hal_usb_set_config(instance->usb_mode_prev, NULL);
+    }
+
+    // Hand interface 0 back to the CLI
+    Cli* cli = furi_record_open(RECORD_CLI);
+    cli_session_open(cli, &cli_vcp);
+    furi_record_close(RECORD_CLI);
+
+    instance->serial_initialized = false;
+    instance->serial_connected = false;
+
+    FURI_LOG_I(TAG, "USB serial deinitialized");
+
+    // Notify connection callback
+    if(instance->connection_callback) {
+        bool bt_connected = flipper_wedge_hid_is_bt_connected(instance);
+        instance->connection_callback(false, bt_connected, instance->connection_callback_context);
+    }
+}
+
+bool flipper_wedge_hid_is_serial_connected(FlipperWedgeHid* instance) {
+    furi_assert(instance);
+    if(!instance->serial_initialized) return false;
+    return instance->serial_connected;
+}
+
+bool flipper_wedge_hid_send_serial(FlipperWedgeHid* instance, const uint8_t* data, size_t len) {
+    furi_assert(instance);
+    furi_assert(data);
+
+    if(!flipper_wedge_hid_is_serial_connected(instance)) {
+        return false;
+    }
+
+    // Drop any stale completion left over from a previous send
+    furi_semaphore_acquire(instance->serial_tx_done, 0);
+
+    size_t sent = 0;
+    bool needs_zlp = false;
+    while(sent < len) {
+        size_t chunk = len - sent;
+        if(chunk > HID_SERIAL_PACKET_SIZE) chunk = HID_SERIAL_PACKET_SIZE;
+
+        furi_hal_cdc_send(HID_SERIAL_IF_NUM, (uint8_t*)&data[sent], chunk);
+        if(furi_semaphore_acquire(
+               instance->serial_tx_done, furi_ms_to_ticks(HID_SERIAL_TX_TIMEOUT_MS)) !=
+           FuriStatusOk) {
+            FURI_LOG_W(TAG, "USB serial TX timeout at %zu/%zu bytes", sent, len);
+            return false;
+        }
+
+        sent += chunk;
+        needs_zlp = (chunk == HID_SERIAL_PACKET_SIZE);
+        flipper_wedge_latency_mark(instance->latency, FlipperWedgeLatencyStageFirstKey);
+    }
+
+    // A transfer ending on a full packet needs a zero-length packet to flush on the host
+    if(needs_zlp) {
+        furi_hal_cdc_send(HID_SERIAL_IF_NUM, NULL, 0);
+        furi_semaphore_acquire(instance->serial_tx_done, furi_ms_to_ticks(HID_SERIAL_TX_TIMEOUT_MS));
+    }
+
+    flipper_wedge_latency_mark(instance->latency, FlipperWedgeLatencyStageLastKey);
+    return true;
+}
+
 void flipper_wedge_hid_init_ble(FlipperWedgeHid* instance) {
     furi_assert(instance);
 
@@ -135,16 +391,23 @@ void flipper_wedge_hid_init_ble(FlipperWedgeHid* instance) {
     FURI_LOG_I(TAG, "Initializing BLE HID");
     flipper_wedge_debug_log(TAG, "Init BLE HID - opening BT record");
 
+    instance->ble_wait_start = furi_get_tick();
+
     instance->bt = furi_record_open(RECORD_BT);
     flipper_wedge_debug_log(TAG, "BT record opened");
 
     // Disconnect from any existing connection before profile switch
-    flipper_wedge_debug_log(TAG, "Disconnecting BT...");
-    bt_disconnect(instance->bt);
-    flipper_wedge_debug_log(TAG, "BT disconnected, waiting 200ms for NVM sync");
-    // Wait 200ms for 2nd core to update NVM storage (CRITICAL!)
-    furi_delay_ms(200);
-    flipper_wedge_debug_log(TAG, "NVM sync complete");
+    if(furi_hal_bt_is_connected()) {
+        flipper_wedge_debug_log(TAG, "Disconnecting BT...");
+        bt_disconnect(instance->bt);
+        flipper_wedge_debug_log(TAG, "BT disconnected, waiting 200ms for NVM sync");
+        // Wait 200ms for 2nd core to update NVM storage (CRITICAL!)
+        furi_delay_ms(200);
+        flipper_wedge_debug_log(TAG, "NVM sync complete");
+    } else {
+        // No link, so no bonding data pending for NVM
+        flipper_wedge_debug_log(TAG, "BT not connected, skipping disconnect/NVM wait");
+    }
 
     // Set up key storage path
     flipper_wedge_debug_log(TAG, "Setting up BT key storage");
@@ -159,7 +422,8 @@ void flipper_wedge_hid_init_ble(FlipperWedgeHid* instance) {
         .device_name_prefix = "HID",  // Must be <8 chars per firmware limitation
         .mac_xor = HID_BT_MAC_XOR,  // XOR MAC to appear as different device
     };
-    instance->ble_hid_profile = bt_profile_start(instance->bt, ble_profile_hid, &hid_params);
+    instance->ble_hid_profile =
+        bt_profile_start(instance->bt, &flipper_wedge_hid_ble_profile, &hid_params);
     flipper_wedge_debug_log(TAG, "bt_profile_start returned: %p", (void*)instance->ble_hid_profile);
 
     if(!instance->ble_hid_profile) {
@@ -187,7 +451,7 @@ void flipper_wedge_hid_init_ble(FlipperWedgeHid* instance) {
 void flipper_wedge_hid_deinit_ble(FlipperWedgeHid* instance) {
     furi_assert(instance);
 
-    if(!instance->bt_initialized || !instance->bt) {
+    if(!instance->bt) {
         FURI_LOG_W(TAG, "BLE HID not initialized");
         return;
     }
@@ -224,6 +488,12 @@ void flipper_wedge_hid_deinit_ble(FlipperWedgeHid* instance) {
     }
 }
 
+void flipper_wedge_hid_get_ble_stats(FlipperWedgeHid* instance, FlipperWedgeHidBleStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+    *stats = instance->ble_stats;
+}
+
 void flipper_wedge_hid_set_connection_callback(
     FlipperWedgeHid* instance,
     FlipperWedgeHidConnectionCallback callback,
@@ -235,7 +505,9 @@ void flipper_wedge_hid_set_connection_callback(
 
 bool flipper_wedge_hid_is_usb_connected(FlipperWedgeHid* instance) {
     furi_assert(instance);
+    if(instance->serial_initialized) return instance->serial_connected;
     if(!instance->usb_initialized) return false;
+    if(instance->usb_nkro_active) return flipper_wedge_usb_nkro_is_connected();
     return furi_hal_hid_is_connected();
 }
 
@@ -249,39 +521,199 @@ bool flipper_wedge_hid_is_connected(FlipperWedgeHid* instance) {
     return flipper_wedge_hid_is_usb_connected(instance) || flipper_wedge_hid_is_bt_connected(instance);
 }
 
-void flipper_wedge_hid_type_char(FlipperWedgeHid* instance, FlipperWedgeKeyboardLayout* layout, char c) {
-    furi_assert(instance);
-
-    uint16_t keycode;
+static uint16_t flipper_wedge_hid_get_keycode(FlipperWedgeKeyboardLayout* layout, char c) {
     if(layout) {
-        keycode = flipper_wedge_keyboard_layout_get_keycode(layout, c);
+        return flipper_wedge_keyboard_layout_get_keycode(layout, c);
+    }
+    return HID_ASCII_TO_KEY(c);
+}
+
+static void flipper_wedge_hid_usb_press_release(FlipperWedgeHid* instance, uint16_t keycode) {
+    if(instance->usb_nkro_active) {
+        uint8_t key = keycode & 0xFF;
+        flipper_wedge_usb_nkro_send(keycode >> 8, &key, 1);
+        flipper_wedge_usb_nkro_send(0, NULL, 0);
     } else {
-        keycode = HID_ASCII_TO_KEY(c);
+        furi_hal_hid_kb_press(keycode);
+        furi_hal_hid_kb_release(keycode);
+    }
+}
+
+// Press or release one key on every connected output, leaving other keys down
+static void flipper_wedge_hid_key(FlipperWedgeHid* instance, uint16_t keycode, bool press) {
+    if(instance->usb_initialized && flipper_wedge_hid_is_usb_connected(instance)) {
+        if(instance->usb_nkro_active) {
+            // NKRO reports carry the whole state; sequences have at most one key down
+            uint8_t key = keycode & 0xFF;
+            if(press) {
+                instance->nkro_modifiers |= keycode >> 8;
+                flipper_wedge_usb_nkro_send(instance->nkro_modifiers, &key, key ? 1 : 0);
+            } else {
+                instance->nkro_modifiers &= ~(keycode >> 8);
+                flipper_wedge_usb_nkro_send(instance->nkro_modifiers, NULL, 0);
+            }
+        } else if(press) {
+            furi_hal_hid_kb_press(keycode);
+        } else {
+            furi_hal_hid_kb_release(keycode);
+        }
+    }
+
+    if(instance->bt_initialized && flipper_wedge_hid_is_bt_connected(instance) && instance->ble_hid_profile) {
+        bool sent = press ? ble_profile_hid_kb_press(instance->ble_hid_profile, keycode) :
+                            ble_profile_hid_kb_release(instance->ble_hid_profile, keycode);
+        if(sent) {
+            instance->ble_stats.notify_count++;
+        }
     }
+}
+
+// Tap a key while the hold modifier stays down
+static void flipper_wedge_hid_tap(FlipperWedgeHid* instance, uint16_t keycode, uint16_t hold) {
+    flipper_wedge_hid_key(instance, keycode | hold, true);
+    flipper_wedge_hid_key(instance, keycode & ~hold, false);
+    flipper_wedge_hid_mark_key(instance);
+    furi_delay_ms(HID_TYPE_DELAY_MS);
+}
+
+// Type the UTF-8 character at str with the Unicode input sequence, returns its length
+static size_t flipper_wedge_hid_type_utf8(FlipperWedgeHid* instance, const char* str) {
+    uint32_t code_point;
+    size_t len = flipper_wedge_utf8_decode(str, &code_point);
+    if(code_point == FLIPPER_WEDGE_UTF8_INVALID || !instance->unicode) return len;
+
+    const FlipperWedgeUnicodeSequence* sequence =
+        flipper_wedge_unicode_get_sequence(instance->unicode, code_point);
+    if(!sequence) return len;
+
+    if(sequence->prefix != HID_KEYBOARD_NONE) {
+        flipper_wedge_hid_tap(instance, sequence->prefix, 0);
+    }
+    if(sequence->hold) {
+        flipper_wedge_hid_key(instance, sequence->hold, true);
+    }
+    for(size_t i = 0; i < sequence->key_count; i++) {
+        flipper_wedge_hid_tap(instance, sequence->keys[i], sequence->hold);
+    }
+    if(sequence->hold) {
+        flipper_wedge_hid_key(instance, sequence->hold, false);
+        flipper_wedge_hid_mark_key(instance);
+    }
+    if(sequence->suffix != HID_KEYBOARD_NONE) {
+        flipper_wedge_hid_tap(instance, sequence->suffix, 0);
+    }
+
+    instance->unicode_typed++;
+    return len;
+}
+
+// Type a string over the NKRO interface, several characters per report
+// (batching rules in flipper_wedge_nkro_batch.h)
+static void flipper_wedge_hid_type_string_nkro(
+    FlipperWedgeHid* instance,
+    FlipperWedgeKeyboardLayout* layout,
+    const char* str) {
+    uint8_t keys[HID_NKRO_BATCH_MAX];
+    size_t max_keys = flipper_wedge_usb_nkro_max_keys();
+    if(max_keys > HID_NKRO_BATCH_MAX) max_keys = HID_NKRO_BATCH_MAX;
+
+    while(*str) {
+        uint8_t modifiers;
+        size_t count = flipper_wedge_nkro_batch_next(layout, &str, max_keys, &modifiers, keys);
+
+        if(count == 0) {
+            if((uint8_t)*str >= 0x80) {
+                str += flipper_wedge_hid_type_utf8(instance, str);
+            }
+            continue;
+        }
+
+        if(!flipper_wedge_usb_nkro_send(modifiers, keys, count) ||
+           !flipper_wedge_usb_nkro_send(0, NULL, 0)) {
+            FURI_LOG_W(TAG, "NKRO report not sent, host disconnected");
+            return;
+        }
+        flipper_wedge_hid_mark_key(instance);
+        furi_delay_ms(HID_TYPE_DELAY_MS);
+    }
+}
+
+void flipper_wedge_hid_press_key(FlipperWedgeHid* instance, uint16_t keycode) {
+    furi_assert(instance);
+
     if(keycode == HID_KEYBOARD_NONE) return;
 
     // Send to USB HID if initialized
     if(instance->usb_initialized && flipper_wedge_hid_is_usb_connected(instance)) {
-        furi_hal_hid_kb_press(keycode);
-        furi_hal_hid_kb_release(keycode);
+        flipper_wedge_hid_usb_press_release(instance, keycode);
     }
 
     // Send to BT HID if initialized
     if(instance->bt_initialized && flipper_wedge_hid_is_bt_connected(instance) && instance->ble_hid_profile) {
-        ble_profile_hid_kb_press(instance->ble_hid_profile, keycode);
-        ble_profile_hid_kb_release(instance->ble_hid_profile, keycode);
+        if(ble_profile_hid_kb_press(instance->ble_hid_profile, keycode)) {
+            instance->ble_stats.notify_count++;
+        }
+        if(ble_profile_hid_kb_release(instance->ble_hid_profile, keycode)) {
+            instance->ble_stats.notify_count++;
+        }
     }
 
+    flipper_wedge_hid_mark_key(instance);
     furi_delay_ms(HID_TYPE_DELAY_MS);
 }
 
+void flipper_wedge_hid_type_char(FlipperWedgeHid* instance, FlipperWedgeKeyboardLayout* layout, char c) {
+    furi_assert(instance);
+    flipper_wedge_hid_press_key(instance, flipper_wedge_hid_get_keycode(layout, c));
+}
+
 void flipper_wedge_hid_type_string(FlipperWedgeHid* instance, FlipperWedgeKeyboardLayout* layout, const char* str) {
     furi_assert(instance);
     furi_assert(str);
 
-    while(*str) {
-        flipper_wedge_hid_type_char(instance, layout, *str);
-        str++;
+    uint32_t tick_start = furi_get_tick();
+    instance->unicode_typed = 0;
+
+    // NKRO interface: batch keys into shared reports (USB only, BLE is never active with it)
+    if(instance->usb_nkro_active && !instance->bt_initialized &&
+       flipper_wedge_hid_is_usb_connected(instance)) {
+        flipper_wedge_hid_type_string_nkro(instance, layout, str);
+    } else {
+        bool measure_ble = flipper_wedge_hid_is_bt_connected(instance);
+        uint32_t notify_start = instance->ble_stats.notify_count;
+
+        while(*str) {
+            if((uint8_t)*str >= 0x80) {
+                str += flipper_wedge_hid_type_utf8(instance, str);
+                continue;
+            }
+            flipper_wedge_hid_type_char(instance, layout, *str);
+            str++;
+        }
+
+        if(measure_ble) {
+            uint32_t notifications = instance->ble_stats.notify_count - notify_start;
+            uint32_t elapsed_ms = furi_get_tick() - tick_start;
+            if(notifications > 0 && elapsed_ms > 0) {
+                instance->ble_stats.notify_per_sec = notifications * 1000 / elapsed_ms;
+                FURI_LOG_I(
+                    TAG,
+                    "BLE typed %lu notifications in %lu ms (%lu/s)",
+                    notifications,
+                    elapsed_ms,
+                    instance->ble_stats.notify_per_sec);
+            }
+        }
+    }
+
+    if(instance->unicode_typed > 0) {
+        uint32_t elapsed_ms = furi_get_tick() - tick_start;
+        FURI_LOG_I(
+            TAG,
+            "Typed %lu non-ASCII chars (%s input) in %lu ms",
+            instance->unicode_typed,
+            flipper_wedge_unicode_method_name(flipper_wedge_unicode_get_method(instance->unicode)),
+            elapsed_ms);
     }
 }
 
@@ -292,15 +724,20 @@ void flipper_wedge_hid_press_enter(FlipperWedgeHid* instance) {
 
     // Send to USB HID if initialized
     if(instance->usb_initialized && flipper_wedge_hid_is_usb_connected(instance)) {
-        furi_hal_hid_kb_press(keycode);
-        furi_hal_hid_kb_release(keycode);
+        flipper_wedge_hid_usb_press_release(instance, keycode);
     }
 
     // Send to BT HID if initialized
     if(instance->bt_initialized && flipper_wedge_hid_is_bt_connected(instance) && instance->ble_hid_profile) {
-        ble_profile_hid_kb_press(instance->ble_hid_profile, keycode);
-        ble_profile_hid_kb_release(instance->ble_hid_profile, keycode);
+        if(ble_profile_hid_kb_press(instance->ble_hid_profile, keycode)) {
+            instance->ble_stats.notify_count++;
+        }
+        if(ble_profile_hid_kb_release(instance->ble_hid_profile, keycode)) {
+            instance->ble_stats.notify_count++;
+        }
     }
+
+    flipper_wedge_hid_mark_key(instance);
 }
 
 void flipper_wedge_hid_release_all(FlipperWedgeHid* instance) {
@@ -308,7 +745,11 @@ void flipper_wedge_hid_release_all(FlipperWedgeHid* instance) {
 
     // Release all keys on USB HID if initialized
     if(instance->usb_initialized && flipper_wedge_hid_is_usb_connected(instance)) {
-        furi_hal_hid_kb_release_all();
+        if(instance->usb_nkro_active) {
+            flipper_wedge_usb_nkro_send(0, NULL, 0);
+        } else {
+            furi_hal_hid_kb_release_all();
+        }
     }
 
     // Release all keys on BT HID if initialized
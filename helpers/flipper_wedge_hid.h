@@ -4,14 +4,24 @@
 #include <furi_hal.h>
 #include <furi_hal_usb.h>
 #include <furi_hal_usb_hid.h>
+#include <furi_hal_usb_cdc.h>
 #include <bt/bt_service/bt.h>
 #include <extra_profiles/hid_profile.h>
 #include "flipper_wedge_keyboard_layout.h"
+#include "flipper_wedge_latency.h"
+#include "flipper_wedge_unicode.h"
 
 #define FLIPPER_WEDGE_BT_KEYS_STORAGE_NAME ".flipper_wedge_bt.keys"
 
 typedef struct FlipperWedgeHid FlipperWedgeHid;
 
+typedef struct {
+    uint32_t connect_ms;      // Time from BLE init or last disconnect to connected
+    uint32_t connect_count;   // Connections seen since app start
+    uint32_t notify_count;    // Keyboard notifications accepted by the BLE stack
+    uint32_t notify_per_sec;  // Rate achieved by the last typed string
+} FlipperWedgeHidBleStats;
+
 typedef void (*FlipperWedgeHidConnectionCallback)(bool usb_connected, bool bt_connected, void* context);
 
 /** Allocate HID helper
@@ -40,6 +50,29 @@ void flipper_wedge_hid_init_usb(FlipperWedgeHid* instance);
  */
 void flipper_wedge_hid_deinit_usb(FlipperWedgeHid* instance);
 
+/** Select the USB keyboard interface used by the next flipper_wedge_hid_init_usb()
+ * NKRO uses the app's own descriptor (see flipper_wedge_usb_nkro.h) so
+ * flipper_wedge_hid_type_string() can send several characters per report.
+ *
+ * @param instance FlipperWedgeHid instance
+ * @param nkro true for the NKRO interface, false for the firmware 6KRO keyboard
+ */
+void flipper_wedge_hid_set_usb_nkro(FlipperWedgeHid* instance, bool nkro);
+
+/** Timestamp the first and last key report of each output
+ *
+ * @param instance FlipperWedgeHid instance
+ * @param latency FlipperWedgeLatency instance, NULL to stop timestamping
+ */
+void flipper_wedge_hid_set_latency(FlipperWedgeHid* instance, FlipperWedgeLatency* latency);
+
+/** Type non-ASCII characters of strings with Unicode input sequences
+ *
+ * @param instance FlipperWedgeHid instance
+ * @param unicode FlipperWedgeUnicode instance, NULL to skip non-ASCII characters
+ */
+void flipper_wedge_hid_set_unicode(FlipperWedgeHid* instance, FlipperWedgeUnicode* unicode);
+
 /** Initialize BLE HID interface
  * Like Bad USB pattern - call at app start or when switching to BLE mode
  *
@@ -54,6 +87,45 @@ void flipper_wedge_hid_init_ble(FlipperWedgeHid* instance);
  */
 void flipper_wedge_hid_deinit_ble(FlipperWedgeHid* instance);
 
+/** Get BLE connection and throughput measurements
+ *
+ * @param instance FlipperWedgeHid instance
+ * @param stats Filled with current values
+ */
+void flipper_wedge_hid_get_ble_stats(FlipperWedgeHid* instance, FlipperWedgeHidBleStats* stats);
+
+/** Initialize USB serial (CDC) interface for structured output
+ * Replaces the USB HID config with a single CDC ACM port. Each scan is
+ * then sent as one framed record instead of being typed as keystrokes.
+ *
+ * @param instance FlipperWedgeHid instance
+ */
+void flipper_wedge_hid_init_serial(FlipperWedgeHid* instance);
+
+/** Deinitialize USB serial (CDC) interface
+ * Restores the previous USB config
+ *
+ * @param instance FlipperWedgeHid instance
+ */
+void flipper_wedge_hid_deinit_serial(FlipperWedgeHid* instance);
+
+/** Check if USB serial output is active and a host has the port open (DTR set)
+ *
+ * @param instance FlipperWedgeHid instance
+ * @return true if connected
+ */
+bool flipper_wedge_hid_is_serial_connected(FlipperWedgeHid* instance);
+
+/** Send raw bytes over the USB serial (CDC) interface
+ * Splits data into CDC packets and waits for each one to be taken by the host
+ *
+ * @param instance FlipperWedgeHid instance
+ * @param data Bytes to send
+ * @param len Number of bytes
+ * @return true if all bytes were sent
+ */
+bool flipper_wedge_hid_send_serial(FlipperWedgeHid* instance, const uint8_t* data, size_t len);
+
 /** Set connection status callback
  *
  * @param instance FlipperWedgeHid instance
@@ -65,7 +137,7 @@ void flipper_wedge_hid_set_connection_callback(
     FlipperWedgeHidConnectionCallback callback,
     void* context);
 
-/** Check if USB HID is connected
+/** Check if USB HID (or USB serial in serial mode) is connected
  *
  * @param instance FlipperWedgeHid instance
  * @return true if connected
@@ -95,6 +167,13 @@ bool flipper_wedge_hid_is_connected(FlipperWedgeHid* instance);
  */
 void flipper_wedge_hid_type_string(FlipperWedgeHid* instance, FlipperWedgeKeyboardLayout* layout, const char* str);
 
+/** Press and release one key or chord via HID keyboard
+ *
+ * @param instance FlipperWedgeHid instance
+ * @param keycode HID keycode, modifiers in the upper 8 bits
+ */
+void flipper_wedge_hid_press_key(FlipperWedgeHid* instance, uint16_t keycode);
+
 /** Type a single character via HID keyboard
  *
  * @param instance FlipperWedgeHid instance
@@ -22,6 +22,8 @@ static int32_t flipper_wedge_hid_worker_thread(void* context) {
     // Initialize HID interface in worker thread context
     if(worker->mode == FlipperWedgeHidWorkerModeUsb) {
         flipper_wedge_hid_init_usb(worker->hid);
+    } else if(worker->mode == FlipperWedgeHidWorkerModeSerial) {
+        flipper_wedge_hid_init_serial(worker->hid);
     } else {
         flipper_wedge_hid_init_ble(worker->hid);
     }
@@ -46,6 +48,8 @@ static int32_t flipper_wedge_hid_worker_thread(void* context) {
     // Deinitialize HID interface in worker thread context
     if(worker->mode == FlipperWedgeHidWorkerModeUsb) {
         flipper_wedge_hid_deinit_usb(worker->hid);
+    } else if(worker->mode == FlipperWedgeHidWorkerModeSerial) {
+        flipper_wedge_hid_deinit_serial(worker->hid);
     } else {
         flipper_wedge_hid_deinit_ble(worker->hid);
     }
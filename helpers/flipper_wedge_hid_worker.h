@@ -8,6 +8,7 @@ typedef struct FlipperWedgeHidWorker FlipperWedgeHidWorker;
 typedef enum {
     FlipperWedgeHidWorkerModeUsb,
     FlipperWedgeHidWorkerModeBle,
+    FlipperWedgeHidWorkerModeSerial,
 } FlipperWedgeHidWorkerMode;
 
 /** Allocate HID worker
@@ -28,7 +29,7 @@ void flipper_wedge_hid_worker_free(FlipperWedgeHidWorker* worker);
  * Creates worker thread that initializes HID interface
  *
  * @param worker FlipperWedgeHidWorker instance
- * @param mode USB or BLE mode
+ * @param mode USB, BLE or USB serial mode
  */
 void flipper_wedge_hid_worker_start(FlipperWedgeHidWorker* worker, FlipperWedgeHidWorkerMode mode);
 
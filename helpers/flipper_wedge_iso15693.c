@@ -0,0 +1,207 @@
+#include "flipper_wedge_iso15693.h"
+
+#define TAG "FlipperWedgeIso15693"
+
+#define FLIPPER_WEDGE_ISO15693_UID_BITS (FLIPPER_WEDGE_ISO15693_UID_LEN * 8)
+
+typedef struct {
+    uint64_t uid;
+    uint32_t last_seen;
+} FlipperWedgeIso15693PresenceEntry;
+
+struct FlipperWedgeIso15693Presence {
+    FlipperWedgeIso15693PresenceEntry entries[FLIPPER_WEDGE_ISO15693_PRESENCE_MAX];
+    size_t count;
+};
+
+uint32_t flipper_wedge_iso15693_inventory(
+    FlipperWedgeIso15693InventoryRequest request,
+    void* request_context,
+    FlipperWedgeIso15693UidCallback callback,
+    void* callback_context) {
+    furi_assert(request);
+    furi_assert(callback);
+
+    // Depth-first: each collision pushes two masks one bit longer,
+    // so the stack never holds more than one entry per mask length
+    struct {
+        uint8_t len;
+        uint64_t mask;
+    } stack[FLIPPER_WEDGE_ISO15693_UID_BITS + 1];
+    size_t top = 0;
+    uint32_t requests = 0;
+
+    stack[top].len = 0;
+    stack[top].mask = 0;
+    top++;
+
+    while(top > 0 && requests < FLIPPER_WEDGE_ISO15693_INVENTORY_MAX_REQUESTS) {
+        top--;
+        uint8_t len = stack[top].len;
+        uint64_t mask = stack[top].mask;
+        uint64_t uid = 0;
+
+        FlipperWedgeIso15693Reply reply = request(len, mask, &uid, request_context);
+        requests++;
+
+        if(reply == FlipperWedgeIso15693ReplySingle) {
+            callback(uid, callback_context);
+        } else if(reply == FlipperWedgeIso15693ReplyCollision && len < FLIPPER_WEDGE_ISO15693_UID_BITS) {
+            // A collision with the full UID as mask is noise, not two tags
+            stack[top].len = len + 1;
+            stack[top].mask = mask | (1ULL << len);
+            top++;
+            stack[top].len = len + 1;
+            stack[top].mask = mask;
+            top++;
+        }
+    }
+
+    if(top > 0) {
+        FURI_LOG_W(TAG, "Inventory stopped after %lu requests", requests);
+    }
+    return requests;
+}
+
+void flipper_wedge_iso15693_uid_to_bytes(uint64_t uid, uint8_t* bytes) {
+    furi_assert(bytes);
+    for(size_t i = 0; i < FLIPPER_WEDGE_ISO15693_UID_LEN; i++) {
+        bytes[i] = (uid >> (8 * (FLIPPER_WEDGE_ISO15693_UID_LEN - 1 - i))) & 0xFF;
+    }
+}
+
+FlipperWedgeIso15693Presence* flipper_wedge_iso15693_presence_alloc(void) {
+    FlipperWedgeIso15693Presence* presence = malloc(sizeof(FlipperWedgeIso15693Presence));
+    presence->count = 0;
+    return presence;
+}
+
+void flipper_wedge_iso15693_presence_free(FlipperWedgeIso15693Presence* presence) {
+    furi_assert(presence);
+    free(presence);
+}
+
+void flipper_wedge_iso15693_presence_clear(FlipperWedgeIso15693Presence* presence) {
+    furi_assert(presence);
+    presence->count = 0;
+}
+
+bool flipper_wedge_iso15693_presence_seen(FlipperWedgeIso15693Presence* presence, uint64_t uid, uint32_t now) {
+    furi_assert(presence);
+
+    for(size_t i = 0; i < presence->count; i++) {
+        if(presence->entries[i].uid == uid) {
+            presence->entries[i].last_seen = now;
+            return false;
+        }
+    }
+
+    if(presence->count >= FLIPPER_WEDGE_ISO15693_PRESENCE_MAX) {
+        FURI_LOG_W(TAG, "Presence table full, tag not tracked");
+        return false;
+    }
+
+    presence->entries[presence->count].uid = uid;
+    presence->entries[presence->count].last_seen = now;
+    presence->count++;
+    return true;
+}
+
+bool flipper_wedge_iso15693_presence_expire(
+    FlipperWedgeIso15693Presence* presence,
+    uint32_t now,
+    uint32_t age_out,
+    uint64_t* uid) {
+    furi_assert(presence);
+    furi_assert(uid);
+
+    for(size_t i = 0; i < presence->count; i++) {
+        if(now - presence->entries[i].last_seen >= age_out) {
+            *uid = presence->entries[i].uid;
+            // Order does not matter, fill the gap with the last entry
+            presence->entries[i] = presence->entries[presence->count - 1];
+            presence->count--;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t flipper_wedge_iso15693_presence_count(const FlipperWedgeIso15693Presence* presence) {
+    furi_assert(presence);
+    return presence->count;
+}
+
+#ifdef FURI_DEBUG
+typedef struct {
+    const uint64_t* uids;
+    size_t count;
+} FlipperWedgeIso15693SimField;
+
+// Simulated field: every tag whose low UID bits match the mask answers
+static FlipperWedgeIso15693Reply
+    flipper_wedge_iso15693_sim_request(uint8_t mask_len, uint64_t mask, uint64_t* uid, void* context) {
+    const FlipperWedgeIso15693SimField* field = context;
+    uint64_t bits = mask_len >= FLIPPER_WEDGE_ISO15693_UID_BITS ? UINT64_MAX : (1ULL << mask_len) - 1;
+    size_t answers = 0;
+
+    for(size_t i = 0; i < field->count; i++) {
+        if((field->uids[i] & bits) == mask) {
+            *uid = field->uids[i];
+            answers++;
+        }
+    }
+
+    if(answers == 0) return FlipperWedgeIso15693ReplyNone;
+    return answers == 1 ? FlipperWedgeIso15693ReplySingle : FlipperWedgeIso15693ReplyCollision;
+}
+
+static void flipper_wedge_iso15693_sim_found(uint64_t uid, void* context) {
+    UNUSED(uid);
+    size_t* found = context;
+    (*found)++;
+}
+#endif
+
+void flipper_wedge_iso15693_benchmark(void) {
+#ifdef FURI_DEBUG
+    const size_t field_sizes[] = {1, 4, 16, 64};
+    const uint32_t rounds = 100;
+    uint64_t* uids = malloc(sizeof(uint64_t) * FLIPPER_WEDGE_ISO15693_PRESENCE_MAX);
+
+    // ICODE-like UIDs: E0 04 manufacturer prefix, pseudo-random serial
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    for(size_t i = 0; i < FLIPPER_WEDGE_ISO15693_PRESENCE_MAX; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        uids[i] = 0xE004000000000000ULL | (seed & 0x0000FFFFFFFFFFFFULL);
+    }
+
+    for(size_t s = 0; s < COUNT_OF(field_sizes); s++) {
+        FlipperWedgeIso15693SimField field = {.uids = uids, .count = field_sizes[s]};
+        size_t found = 0;
+        uint32_t requests = 0;
+
+        uint32_t start = furi_get_tick();
+        for(uint32_t r = 0; r < rounds; r++) {
+            found = 0;
+            requests = flipper_wedge_iso15693_inventory(
+                flipper_wedge_iso15693_sim_request, &field, flipper_wedge_iso15693_sim_found, &found);
+        }
+        uint32_t elapsed_ms = furi_get_tick() - start;
+
+        // On-air time per request is logged by real inventory rounds
+        FURI_LOG_I(
+            TAG,
+            "Benchmark: %zu tags, %zu found, %lu requests/round, search %lu ms per %lu rounds",
+            field.count,
+            found,
+            requests,
+            elapsed_ms,
+            rounds);
+    }
+
+    free(uids);
+#endif
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <furi.h>
+
+// ISO15693 inventory and presence tracking
+//
+// The inventory finds every vicinity tag in the field with single-slot
+// Inventory requests and a growing UID mask: a request that gets a collision
+// is split into two requests with one more mask bit, so N tags take about
+// 2N requests. The transport is a callback, so the search also runs against
+// a simulated field (flipper_wedge_iso15693_benchmark()).
+//
+// UIDs are handled as 64-bit numbers, least significant byte first on the air.
+
+#define FLIPPER_WEDGE_ISO15693_UID_LEN 8
+#define FLIPPER_WEDGE_ISO15693_INVENTORY_MAX_REQUESTS 512  // Bounds one round in a noisy field
+#define FLIPPER_WEDGE_ISO15693_PRESENCE_MAX 64             // Tags tracked at once
+#define FLIPPER_WEDGE_ISO15693_AGE_OUT_MS 3000             // Unseen this long: departed
+
+typedef enum {
+    FlipperWedgeIso15693ReplyNone,       // No tag answered
+    FlipperWedgeIso15693ReplySingle,     // One tag answered, uid is valid
+    FlipperWedgeIso15693ReplyCollision,  // Several tags answered (or a garbled reply)
+} FlipperWedgeIso15693Reply;
+
+/** Send one single-slot Inventory request
+ *
+ * @param mask_len Number of UID bits in the mask (0-64)
+ * @param mask Mask value, the low mask_len bits of the UIDs that should answer
+ * @param uid Answering UID for FlipperWedgeIso15693ReplySingle
+ * @param context Request context
+ * @return Reply type
+ */
+typedef FlipperWedgeIso15693Reply (
+    *FlipperWedgeIso15693InventoryRequest)(uint8_t mask_len, uint64_t mask, uint64_t* uid, void* context);
+
+/** Found tag callback
+ *
+ * @param uid Tag UID
+ * @param context Callback context
+ */
+typedef void (*FlipperWedgeIso15693UidCallback)(uint64_t uid, void* context);
+
+typedef struct FlipperWedgeIso15693Presence FlipperWedgeIso15693Presence;
+
+/** Run one inventory round
+ *
+ * @param request Request function
+ * @param request_context Request context
+ * @param callback Called once for every tag found
+ * @param callback_context Callback context
+ * @return Number of requests sent
+ */
+uint32_t flipper_wedge_iso15693_inventory(
+    FlipperWedgeIso15693InventoryRequest request,
+    void* request_context,
+    FlipperWedgeIso15693UidCallback callback,
+    void* callback_context);
+
+/** Convert a UID to bytes in display order (E0 manufacturer byte first)
+ *
+ * @param uid Tag UID
+ * @param bytes Output, FLIPPER_WEDGE_ISO15693_UID_LEN bytes
+ */
+void flipper_wedge_iso15693_uid_to_bytes(uint64_t uid, uint8_t* bytes);
+
+/** Allocate presence tracker
+ *
+ * @return FlipperWedgeIso15693Presence instance
+ */
+FlipperWedgeIso15693Presence* flipper_wedge_iso15693_presence_alloc(void);
+
+/** Free presence tracker
+ *
+ * @param presence FlipperWedgeIso15693Presence instance
+ */
+void flipper_wedge_iso15693_presence_free(FlipperWedgeIso15693Presence* presence);
+
+/** Forget all tags
+ *
+ * @param presence FlipperWedgeIso15693Presence instance
+ */
+void flipper_wedge_iso15693_presence_clear(FlipperWedgeIso15693Presence* presence);
+
+/** Record a tag seen by an inventory round
+ *
+ * @param presence FlipperWedgeIso15693Presence instance
+ * @param uid Tag UID
+ * @param now Current tick
+ * @return true if the tag just arrived (not tracked before)
+ */
+bool flipper_wedge_iso15693_presence_seen(FlipperWedgeIso15693Presence* presence, uint64_t uid, uint32_t now);
+
+/** Remove one tag that has not been seen for the age-out time
+ * Call until it returns false to collect every departure.
+ *
+ * @param presence FlipperWedgeIso15693Presence instance
+ * @param now Current tick
+ * @param age_out Age-out time in ticks
+ * @param uid Departed tag UID
+ * @return true if a tag departed
+ */
+bool flipper_wedge_iso15693_presence_expire(
+    FlipperWedgeIso15693Presence* presence,
+    uint32_t now,
+    uint32_t age_out,
+    uint64_t* uid);
+
+/** Get the number of tags present
+ *
+ * @param presence FlipperWedgeIso15693Presence instance
+ * @return Tag count
+ */
+size_t flipper_wedge_iso15693_presence_count(const FlipperWedgeIso15693Presence* presence);
+
+/** Log inventory requests and search time for simulated fields of 1 to 64 tags
+ * Only active in debug firmware builds (FURI_DEBUG), no-op otherwise
+ */
+void flipper_wedge_iso15693_benchmark(void);
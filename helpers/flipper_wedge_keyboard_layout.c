@@ -270,91 +270,22 @@ const char* flipper_wedge_keyboard_layout_type_name(FlipperWedgeLayoutType type)
     return layout_type_names[type];
 }
 
-size_t flipper_wedge_keyboard_layout_list(
-    Storage* storage,
-    FuriString** names,
-    FuriString** paths,
-    size_t max_count) {
+bool flipper_wedge_keyboard_layout_read_name(Storage* storage, const char* path, FuriString* name) {
     furi_assert(storage);
-    furi_assert(names);
-    furi_assert(paths);
-
-    size_t count = 0;
-
-    // Ensure directory exists
-    if(!storage_dir_exists(storage, FLIPPER_WEDGE_LAYOUTS_DIRECTORY)) {
-        FURI_LOG_I(TAG, "Creating layouts directory");
-        storage_simply_mkdir(storage, FLIPPER_WEDGE_LAYOUTS_DIRECTORY);
-        return 0;
-    }
-
-    File* dir = storage_file_alloc(storage);
-    if(!storage_dir_open(dir, FLIPPER_WEDGE_LAYOUTS_DIRECTORY)) {
-        FURI_LOG_E(TAG, "Failed to open layouts directory");
-        storage_file_free(dir);
-        return 0;
-    }
-
-    FileInfo file_info;
-    char filename[256];
-
-    while(count < max_count && storage_dir_read(dir, &file_info, filename, sizeof(filename))) {
-        // Skip directories
-        if(file_info.flags & FSF_DIRECTORY) {
-            continue;
-        }
-
-        // Only process .txt files
-        size_t len = strlen(filename);
-        if(len < 4 || strcmp(filename + len - 4, ".txt") != 0) {
-            continue;
-        }
-
-        // Build full path
-        FuriString* full_path = furi_string_alloc();
-        furi_string_printf(full_path, "%s/%s", FLIPPER_WEDGE_LAYOUTS_DIRECTORY, filename);
-
-        // Try to read layout name from file
-        FlipperFormat* file = flipper_format_file_alloc(storage);
-        FuriString* layout_name = furi_string_alloc();
-        bool got_name = false;
-
-        if(flipper_format_file_open_existing(file, furi_string_get_cstr(full_path))) {
-            FuriString* file_type = furi_string_alloc();
-            uint32_t version = 0;
-
-            if(flipper_format_read_header(file, file_type, &version)) {
-                if(furi_string_cmp_str(file_type, LAYOUT_FILE_TYPE) == 0) {
-                    if(flipper_format_read_string(file, "Name", layout_name)) {
-                        got_name = true;
-                    }
-                }
-            }
-            furi_string_free(file_type);
-        }
-
-        flipper_format_file_close(file);
-        flipper_format_free(file);
-
-        // Use filename without extension as fallback name
-        if(!got_name) {
-            furi_string_set_str(layout_name, filename);
-            furi_string_left(layout_name, len - 4);  // Remove .txt
-        }
-
-        // Store name and path
-        names[count] = layout_name;
-        paths[count] = full_path;
-        count++;
+    furi_assert(path);
+    furi_assert(name);
 
-        FURI_LOG_D(TAG, "Found layout: %s at %s",
-            furi_string_get_cstr(layout_name),
-            furi_string_get_cstr(full_path));
-    }
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* file_type = furi_string_alloc();
+    uint32_t version = 0;
 
-    storage_dir_close(dir);
-    storage_file_free(dir);
+    bool got_name = flipper_format_file_open_existing(file, path) &&
+                    flipper_format_read_header(file, file_type, &version) &&
+                    furi_string_cmp_str(file_type, LAYOUT_FILE_TYPE) == 0 &&
+                    flipper_format_read_string(file, "Name", name);
 
-    FURI_LOG_I(TAG, "Found %zu custom layouts", count);
-    return count;
+    furi_string_free(file_type);
+    flipper_format_file_close(file);
+    flipper_format_free(file);
+    return got_name;
 }
@@ -77,16 +77,11 @@ uint16_t flipper_wedge_keyboard_layout_get_keycode(FlipperWedgeKeyboardLayout* l
  */
 const char* flipper_wedge_keyboard_layout_type_name(FlipperWedgeLayoutType type);
 
-/** List available custom layout files on SD card
+/** Read the name of a layout file without loading its mappings
  *
  * @param storage Storage instance
- * @param names Array to fill with layout names (from file content)
- * @param paths Array to fill with file paths
- * @param max_count Maximum number of layouts to return
- * @return Number of layouts found
+ * @param path Path to layout file
+ * @param name Receives the layout name
+ * @return true if the file is a layout file with a name
  */
-size_t flipper_wedge_keyboard_layout_list(
-    Storage* storage,
-    FuriString** names,
-    FuriString** paths,
-    size_t max_count);
+bool flipper_wedge_keyboard_layout_read_name(Storage* storage, const char* path, FuriString* name);
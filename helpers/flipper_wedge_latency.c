@@ -0,0 +1,277 @@
+#include "flipper_wedge_latency.h"
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <inttypes.h>
+
+#define TAG "FlipperWedgeLatency"
+
+// Bucket upper bounds in microseconds, the last bucket takes everything above
+static const uint32_t latency_bucket_us[FLIPPER_WEDGE_LATENCY_BUCKETS] = {
+    100,    200,    500,    1000,   2000,   3000,    5000,    7500,
+    10000,  15000,  20000,  30000,  50000,  75000,   100000,  150000,
+    200000, 300000, 500000, 750000, 1000000, 2000000, 5000000, UINT32_MAX,
+};
+
+static const char* const latency_stage_names[FlipperWedgeLatencyStageCount] = {
+    "Detect",
+    "Poller start",
+    "Read",
+    "Callback",
+    "Format",
+    "First key",
+    "Last key",
+    "Rearm",
+};
+
+typedef struct {
+    uint32_t buckets[FLIPPER_WEDGE_LATENCY_BUCKETS];
+    uint32_t count;
+    uint32_t max_us;
+} FlipperWedgeLatencyHistogram;
+
+struct FlipperWedgeLatency {
+    // Current cycle, written by whichever thread reaches a stage
+    volatile uint32_t stamps[FlipperWedgeLatencyStageCount];
+    volatile uint32_t marked;  // Bit per stage reached in the current cycle
+
+    uint32_t cycles_per_us;
+    FlipperWedgeLatencyHistogram stages[FlipperWedgeLatencyStageCount];
+    FlipperWedgeLatencyHistogram total;
+    FlipperWedgeLatencyHistogram cycle;
+};
+
+static inline uint32_t flipper_wedge_latency_now(void) {
+    // Free-running cycle counter, wraps after about a minute at 64 MHz
+    return furi_hal_cortex_timer_get(0).start;
+}
+
+static void flipper_wedge_latency_record(FlipperWedgeLatencyHistogram* histogram, uint32_t us) {
+    size_t bucket = 0;
+    while(us > latency_bucket_us[bucket]) {
+        bucket++;
+    }
+    histogram->buckets[bucket]++;
+    histogram->count++;
+    if(us > histogram->max_us) histogram->max_us = us;
+}
+
+static uint32_t
+    flipper_wedge_latency_percentile(const FlipperWedgeLatencyHistogram* histogram, uint32_t percent) {
+    // Rank of the sample at this percentile, rounded up
+    uint32_t rank = (uint32_t)(((uint64_t)histogram->count * percent + 99) / 100);
+    uint32_t seen = 0;
+
+    for(size_t bucket = 0; bucket < FLIPPER_WEDGE_LATENCY_BUCKETS; bucket++) {
+        seen += histogram->buckets[bucket];
+        if(seen >= rank) {
+            return MIN(latency_bucket_us[bucket], histogram->max_us);
+        }
+    }
+    return histogram->max_us;
+}
+
+static void flipper_wedge_latency_get_stats(
+    const FlipperWedgeLatencyHistogram* histogram,
+    FlipperWedgeLatencyStats* stats) {
+    stats->count = histogram->count;
+    if(histogram->count == 0) {
+        stats->p50_us = stats->p95_us = stats->p99_us = stats->max_us = 0;
+        return;
+    }
+    stats->p50_us = flipper_wedge_latency_percentile(histogram, 50);
+    stats->p95_us = flipper_wedge_latency_percentile(histogram, 95);
+    stats->p99_us = flipper_wedge_latency_percentile(histogram, 99);
+    stats->max_us = histogram->max_us;
+}
+
+// Add the finished cycle to the histograms
+static void flipper_wedge_latency_commit(FlipperWedgeLatency* latency, uint32_t marked) {
+    int first = -1;
+    int previous = -1;
+
+    for(int stage = 0; stage < FlipperWedgeLatencyStageCount; stage++) {
+        if(!(marked & (1UL << stage))) continue;
+        if(previous < 0) {
+            first = previous = stage;
+            continue;
+        }
+
+        uint32_t cycles = latency->stamps[stage] - latency->stamps[previous];
+        if((int32_t)cycles < 0) continue;  // Reached before the previous stage
+        flipper_wedge_latency_record(&latency->stages[stage], cycles / latency->cycles_per_us);
+        previous = stage;
+    }
+
+    if(first >= 0 && first != FlipperWedgeLatencyStageLastKey &&
+       (marked & (1UL << FlipperWedgeLatencyStageLastKey))) {
+        uint32_t cycles =
+            latency->stamps[FlipperWedgeLatencyStageLastKey] - latency->stamps[first];
+        if((int32_t)cycles >= 0) {
+            flipper_wedge_latency_record(&latency->total, cycles / latency->cycles_per_us);
+        }
+    }
+
+    // Scans that were output only, repeats and errors never reach Format
+    if(first >= 0 && first != FlipperWedgeLatencyStageRearm &&
+       (marked & (1UL << FlipperWedgeLatencyStageFormat))) {
+        uint32_t cycles = latency->stamps[FlipperWedgeLatencyStageRearm] - latency->stamps[first];
+        if((int32_t)cycles >= 0) {
+            flipper_wedge_latency_record(&latency->cycle, cycles / latency->cycles_per_us);
+        }
+    }
+}
+
+FlipperWedgeLatency* flipper_wedge_latency_alloc(void) {
+    FlipperWedgeLatency* latency = malloc(sizeof(FlipperWedgeLatency));
+    memset(latency, 0, sizeof(FlipperWedgeLatency));
+    latency->cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    return latency;
+}
+
+void flipper_wedge_latency_free(FlipperWedgeLatency* latency) {
+    furi_assert(latency);
+    free(latency);
+}
+
+void flipper_wedge_latency_mark(FlipperWedgeLatency* latency, FlipperWedgeLatencyStage stage) {
+    if(!latency) return;
+    furi_assert(stage < FlipperWedgeLatencyStageCount);
+
+    uint32_t now = flipper_wedge_latency_now();
+    uint32_t bit = 1UL << stage;
+
+    if(stage == FlipperWedgeLatencyStageRearm) {
+        latency->stamps[stage] = now;
+        uint32_t marked = latency->marked;
+        latency->marked = 0;
+        if(marked) {
+            flipper_wedge_latency_commit(latency, marked | bit);
+        }
+        return;
+    }
+
+    if(stage == FlipperWedgeLatencyStageDetect) {
+        // A new tag, or the same one again after a failed read
+        latency->marked = 0;
+    } else if(stage == FlipperWedgeLatencyStageFirstKey && (latency->marked & bit)) {
+        return;
+    }
+
+    latency->stamps[stage] = now;
+    latency->marked |= bit;
+}
+
+void flipper_wedge_latency_reset(FlipperWedgeLatency* latency) {
+    furi_assert(latency);
+    latency->marked = 0;
+    memset(latency->stages, 0, sizeof(latency->stages));
+    memset(&latency->total, 0, sizeof(latency->total));
+    memset(&latency->cycle, 0, sizeof(latency->cycle));
+}
+
+void flipper_wedge_latency_get_stage(
+    FlipperWedgeLatency* latency,
+    FlipperWedgeLatencyStage stage,
+    FlipperWedgeLatencyStats* stats) {
+    furi_assert(latency);
+    furi_assert(stage < FlipperWedgeLatencyStageCount);
+    furi_assert(stats);
+    flipper_wedge_latency_get_stats(&latency->stages[stage], stats);
+}
+
+void flipper_wedge_latency_get_total(FlipperWedgeLatency* latency, FlipperWedgeLatencyStats* stats) {
+    furi_assert(latency);
+    furi_assert(stats);
+    flipper_wedge_latency_get_stats(&latency->total, stats);
+}
+
+void flipper_wedge_latency_get_cycle(FlipperWedgeLatency* latency, FlipperWedgeLatencyStats* stats) {
+    furi_assert(latency);
+    furi_assert(stats);
+    flipper_wedge_latency_get_stats(&latency->cycle, stats);
+}
+
+uint32_t flipper_wedge_latency_scans_per_minute(const FlipperWedgeLatencyStats* cycle) {
+    furi_assert(cycle);
+    if(cycle->count == 0 || cycle->p50_us == 0) return 0;
+    return 60000000UL / cycle->p50_us;
+}
+
+const char* flipper_wedge_latency_stage_name(FlipperWedgeLatencyStage stage) {
+    if(stage >= FlipperWedgeLatencyStageCount) return "Unknown";
+    return latency_stage_names[stage];
+}
+
+static bool flipper_wedge_latency_write_row(
+    File* file,
+    const char* name,
+    const FlipperWedgeLatencyHistogram* histogram) {
+    char line[64];
+    FlipperWedgeLatencyStats stats;
+    flipper_wedge_latency_get_stats(histogram, &stats);
+
+    int len = snprintf(
+        line,
+        sizeof(line),
+        "%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32,
+        name,
+        stats.count,
+        stats.p50_us,
+        stats.p95_us,
+        stats.p99_us,
+        stats.max_us);
+    if(storage_file_write(file, line, len) != (size_t)len) return false;
+
+    for(size_t bucket = 0; bucket < FLIPPER_WEDGE_LATENCY_BUCKETS; bucket++) {
+        len = snprintf(line, sizeof(line), ",%" PRIu32, histogram->buckets[bucket]);
+        if(storage_file_write(file, line, len) != (size_t)len) return false;
+    }
+    return storage_file_write(file, "\n", 1) == 1;
+}
+
+bool flipper_wedge_latency_save(FlipperWedgeLatency* latency, const char* path) {
+    furi_assert(latency);
+    furi_assert(path);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_common_mkdir(storage, APP_DATA_PATH(""));
+    File* file = storage_file_alloc(storage);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+
+        // Header: bucket columns are named after their upper bound ("inf" for the last)
+        char line[32];
+        const char* header = "stage,count,p50_us,p95_us,p99_us,max_us";
+        if(storage_file_write(file, header, strlen(header)) != strlen(header)) break;
+        bool written = true;
+        for(size_t bucket = 0; bucket < FLIPPER_WEDGE_LATENCY_BUCKETS && written; bucket++) {
+            int len = bucket + 1 < FLIPPER_WEDGE_LATENCY_BUCKETS ?
+                          snprintf(line, sizeof(line), ",le_%" PRIu32, latency_bucket_us[bucket]) :
+                          snprintf(line, sizeof(line), ",inf");
+            written = storage_file_write(file, line, len) == (size_t)len;
+        }
+        if(!written || storage_file_write(file, "\n", 1) != 1) break;
+
+        for(int stage = 0; stage < FlipperWedgeLatencyStageCount && written; stage++) {
+            written = flipper_wedge_latency_write_row(
+                file, latency_stage_names[stage], &latency->stages[stage]);
+        }
+        if(!written || !flipper_wedge_latency_write_row(file, "total", &latency->total)) break;
+        if(!flipper_wedge_latency_write_row(file, "cycle", &latency->cycle)) break;
+
+        success = true;
+    } while(false);
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    if(success) {
+        FURI_LOG_I(TAG, "Latency histograms saved to %s", path);
+    } else {
+        FURI_LOG_E(TAG, "Failed to save latency histograms to %s", path);
+    }
+    return success;
+}
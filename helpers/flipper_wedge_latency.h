@@ -0,0 +1,119 @@
+#pragma once
+
+#include <furi.h>
+
+// Per-stage scan latency
+//
+// Each scan is timestamped with the CPU cycle counter at fixed stages, from
+// the tag entering the field to the scanner being re-armed. When the scan is
+// re-armed, the time between each stage and the previous one reached is
+// added to that stage's histogram, the detect -> last key time to the total,
+// and the detect -> re-arm time of scans that were output to the cycle (the
+// time a scan holds the reader, feedback included). Histograms have fixed buckets, so memory use does not grow with the
+// number of scans and percentiles are bucket upper bounds (never below the
+// real value, at most one bucket above it).
+//
+// Stages reached out of order (keys typed while a streamed NDEF read is still
+// running) are left out of the cycle instead of giving negative times.
+
+#define FLIPPER_WEDGE_LATENCY_PATH APP_DATA_PATH("latency.csv")
+#define FLIPPER_WEDGE_LATENCY_BUCKETS 24
+
+typedef enum {
+    FlipperWedgeLatencyStageDetect,        // Scanner reported a tag, starts a new cycle
+    FlipperWedgeLatencyStagePollerStart,   // Poller started on the tag
+    FlipperWedgeLatencyStageReadComplete,  // Poller finished reading the tag
+    FlipperWedgeLatencyStageCallback,      // Tag data delivered to the scene
+    FlipperWedgeLatencyStageFormat,        // Output formatted
+    FlipperWedgeLatencyStageFirstKey,      // First key report sent (first mark of the cycle kept)
+    FlipperWedgeLatencyStageLastKey,       // Last key report sent
+    FlipperWedgeLatencyStageRearm,         // Scanning restarted, closes the cycle
+    FlipperWedgeLatencyStageCount,
+} FlipperWedgeLatencyStage;
+
+typedef struct {
+    uint32_t count;
+    uint32_t p50_us;
+    uint32_t p95_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} FlipperWedgeLatencyStats;
+
+typedef struct FlipperWedgeLatency FlipperWedgeLatency;
+
+/** Allocate latency recorder
+ *
+ * @return FlipperWedgeLatency instance
+ */
+FlipperWedgeLatency* flipper_wedge_latency_alloc(void);
+
+/** Free latency recorder
+ *
+ * @param latency FlipperWedgeLatency instance
+ */
+void flipper_wedge_latency_free(FlipperWedgeLatency* latency);
+
+/** Timestamp a stage of the current scan
+ * Safe from reader threads, a few stores; Rearm must be marked from the
+ * thread reading the statistics. Does nothing if latency is NULL.
+ *
+ * @param latency FlipperWedgeLatency instance (can be NULL)
+ * @param stage Stage reached
+ */
+void flipper_wedge_latency_mark(FlipperWedgeLatency* latency, FlipperWedgeLatencyStage stage);
+
+/** Clear every histogram and the current cycle
+ *
+ * @param latency FlipperWedgeLatency instance
+ */
+void flipper_wedge_latency_reset(FlipperWedgeLatency* latency);
+
+/** Get statistics of the time spent reaching a stage from the previous one
+ *
+ * @param latency FlipperWedgeLatency instance
+ * @param stage Stage
+ * @param stats Output
+ */
+void flipper_wedge_latency_get_stage(
+    FlipperWedgeLatency* latency,
+    FlipperWedgeLatencyStage stage,
+    FlipperWedgeLatencyStats* stats);
+
+/** Get statistics of the time from the first stage of a scan to its last key
+ *
+ * @param latency FlipperWedgeLatency instance
+ * @param stats Output
+ */
+void flipper_wedge_latency_get_total(FlipperWedgeLatency* latency, FlipperWedgeLatencyStats* stats);
+
+/** Get statistics of the time from the first stage of an output scan to the re-arm
+ *
+ * @param latency FlipperWedgeLatency instance
+ * @param stats Output
+ */
+void flipper_wedge_latency_get_cycle(FlipperWedgeLatency* latency, FlipperWedgeLatencyStats* stats);
+
+/** Scans per minute the reader can take back to back at the median cycle
+ * The wait for the next tag after the re-arm is not included.
+ *
+ * @param cycle Statistics from flipper_wedge_latency_get_cycle()
+ * @return Scans per minute, 0 if no cycle was timed
+ */
+uint32_t flipper_wedge_latency_scans_per_minute(const FlipperWedgeLatencyStats* cycle);
+
+/** Get display name of a stage
+ *
+ * @param stage Stage
+ * @return Static string name
+ */
+const char* flipper_wedge_latency_stage_name(FlipperWedgeLatencyStage stage);
+
+/** Write percentiles and bucket counts of every histogram as CSV
+ * One row per stage plus "total" and "cycle": name, count, p50/p95/p99/max in us, then
+ * the count of each bucket (the header row has the bucket upper bounds).
+ *
+ * @param latency FlipperWedgeLatency instance
+ * @param path File to create or replace
+ * @return true if the file was written
+ */
+bool flipper_wedge_latency_save(FlipperWedgeLatency* latency, const char* path);
@@ -0,0 +1,423 @@
+#include "flipper_wedge_layout_index.h"
+
+#define TAG "FlipperWedgeLayoutIndex"
+
+#define LAYOUT_INDEX_MAGIC 0x594C5746  // "FWLY"
+#define LAYOUT_INDEX_VERSION 1
+#define LAYOUT_INDEX_FNV_OFFSET 2166136261UL
+#define LAYOUT_INDEX_FNV_PRIME 16777619UL
+
+// One layout file, in directory order
+typedef struct {
+    char name[FLIPPER_WEDGE_LAYOUT_NAME_MAX];        // Layout name, NUL-terminated
+    char file[FLIPPER_WEDGE_LAYOUT_INDEX_FILE_MAX];  // File name, NUL-terminated
+    uint32_t size;
+    uint32_t timestamp;
+} __attribute__((packed)) FlipperWedgeLayoutIndexRecord;
+
+_Static_assert(sizeof(FlipperWedgeLayoutIndexRecord) == 128, "Layout index record must stay 128 bytes");
+
+#define LAYOUT_PAGE_RECORDS (FLIPPER_WEDGE_LAYOUT_INDEX_PAGE_SIZE / sizeof(FlipperWedgeLayoutIndexRecord))
+
+// Index file header, records follow
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t count;
+    uint32_t dir_timestamp;  // Directory the index was built from, rebuilt
+    uint32_t listing_hash;   // when either of these changes
+    uint8_t reserved[12];
+} __attribute__((packed)) FlipperWedgeLayoutIndexHeader;
+
+_Static_assert(sizeof(FlipperWedgeLayoutIndexHeader) == 32, "Layout index header must stay 32 bytes");
+
+struct FlipperWedgeLayoutIndex {
+    Storage* storage;
+    File* file;
+    FuriString* dir_path;
+    uint32_t count;
+    uint32_t page;  // Cached page, UINT32_MAX if none
+    FlipperWedgeLayoutIndexRecord records[LAYOUT_PAGE_RECORDS];
+};
+
+// Layout files are .txt files with a name short enough for a record
+static bool flipper_wedge_layout_index_is_layout(const FileInfo* info, const char* file_name) {
+    if(info->flags & FSF_DIRECTORY) return false;
+    size_t len = strlen(file_name);
+    return len > 4 && len < FLIPPER_WEDGE_LAYOUT_INDEX_FILE_MAX && strcmp(file_name + len - 4, ".txt") == 0;
+}
+
+// FNV-1a
+static uint32_t flipper_wedge_layout_index_hash(uint32_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * LAYOUT_INDEX_FNV_PRIME;
+    }
+    return hash;
+}
+
+static uint32_t flipper_wedge_layout_index_hash_entry(
+    uint32_t hash,
+    const char* file_name,
+    uint32_t size,
+    uint32_t timestamp) {
+    // NUL included so "a.txt" + size cannot run into the next name
+    hash = flipper_wedge_layout_index_hash(hash, file_name, strlen(file_name) + 1);
+    hash = flipper_wedge_layout_index_hash(hash, &size, sizeof(size));
+    return flipper_wedge_layout_index_hash(hash, &timestamp, sizeof(timestamp));
+}
+
+static uint32_t
+    flipper_wedge_layout_index_timestamp(Storage* storage, FuriString* path, const char* dir_path, const char* file_name) {
+    uint32_t timestamp = 0;
+    furi_string_printf(path, "%s/%s", dir_path, file_name);
+    storage_common_timestamp(storage, furi_string_get_cstr(path), &timestamp);
+    return timestamp;
+}
+
+// One pass over the directory entries, no layout file is opened
+static bool flipper_wedge_layout_index_scan(
+    Storage* storage,
+    const char* dir_path,
+    uint32_t* count,
+    uint32_t* hash) {
+    File* dir = storage_file_alloc(storage);
+    if(!storage_dir_open(dir, dir_path)) {
+        storage_file_free(dir);
+        return false;
+    }
+
+    FileInfo info;
+    char file_name[256];
+    FuriString* path = furi_string_alloc();
+    *count = 0;
+    *hash = LAYOUT_INDEX_FNV_OFFSET;
+    while(storage_dir_read(dir, &info, file_name, sizeof(file_name))) {
+        if(!flipper_wedge_layout_index_is_layout(&info, file_name)) continue;
+        uint32_t timestamp = flipper_wedge_layout_index_timestamp(storage, path, dir_path, file_name);
+        *hash = flipper_wedge_layout_index_hash_entry(*hash, file_name, (uint32_t)info.size, timestamp);
+        (*count)++;
+    }
+
+    furi_string_free(path);
+    storage_dir_close(dir);
+    storage_file_free(dir);
+    return true;
+}
+
+// Open an index file and check it is well-formed, whatever it was built from
+static bool flipper_wedge_layout_index_open(File* file, const char* index_path, FlipperWedgeLayoutIndexHeader* header) {
+    if(!storage_file_open(file, index_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        return false;
+    }
+
+    if(storage_file_read(file, header, sizeof(*header)) != sizeof(*header) ||
+       header->magic != LAYOUT_INDEX_MAGIC || header->version != LAYOUT_INDEX_VERSION ||
+       header->record_size != sizeof(FlipperWedgeLayoutIndexRecord) ||
+       storage_file_size(file) !=
+           sizeof(*header) + (uint64_t)header->count * sizeof(FlipperWedgeLayoutIndexRecord)) {
+        storage_file_close(file);
+        return false;
+    }
+    return true;
+}
+
+static bool flipper_wedge_layout_index_read_record(File* file, uint32_t position, FlipperWedgeLayoutIndexRecord* record) {
+    uint64_t offset =
+        sizeof(FlipperWedgeLayoutIndexHeader) + (uint64_t)position * sizeof(FlipperWedgeLayoutIndexRecord);
+    return storage_file_seek(file, offset, true) &&
+           storage_file_read(file, record, sizeof(*record)) == sizeof(*record);
+}
+
+// Find a file in the previous index, trying its old position first since
+// the directory order rarely changes
+static bool flipper_wedge_layout_index_find_old(
+    File* old,
+    uint32_t old_count,
+    uint32_t hint,
+    const char* file_name,
+    FlipperWedgeLayoutIndexRecord* record) {
+    if(hint < old_count && flipper_wedge_layout_index_read_record(old, hint, record) &&
+       strncmp(record->file, file_name, sizeof(record->file)) == 0) {
+        return true;
+    }
+    for(uint32_t i = 0; i < old_count; i++) {
+        if(i == hint) continue;
+        if(!flipper_wedge_layout_index_read_record(old, i, record)) return false;
+        if(strncmp(record->file, file_name, sizeof(record->file)) == 0) return true;
+    }
+    return false;
+}
+
+static bool flipper_wedge_layout_index_build(
+    Storage* storage,
+    const char* dir_path,
+    const char* index_path,
+    uint32_t dir_timestamp) {
+    FURI_LOG_I(TAG, "Building index for %s", dir_path);
+    uint32_t start = furi_get_tick();
+
+    // Written next to the old index, which stays readable for reuse
+    FuriString* tmp_path = furi_string_alloc_set_str(index_path);
+    furi_string_cat_str(tmp_path, ".tmp");
+
+    File* old = storage_file_alloc(storage);
+    File* index = storage_file_alloc(storage);
+    File* dir = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+    uint32_t count = 0;
+    uint32_t reused = 0;
+    bool success = false;
+
+    FlipperWedgeLayoutIndexHeader header;
+    uint32_t old_count = flipper_wedge_layout_index_open(old, index_path, &header) ? header.count : 0;
+
+    do {
+        if(!storage_file_open(index, furi_string_get_cstr(tmp_path), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Failed to create %s", furi_string_get_cstr(tmp_path));
+            break;
+        }
+        if(!storage_dir_open(dir, dir_path)) {
+            FURI_LOG_E(TAG, "Failed to open %s", dir_path);
+            break;
+        }
+
+        // Header goes last, an interrupted build leaves an invalid index
+        memset(&header, 0, sizeof(header));
+        if(storage_file_write(index, &header, sizeof(header)) != sizeof(header)) break;
+
+        FileInfo info;
+        char file_name[256];
+        uint32_t hash = LAYOUT_INDEX_FNV_OFFSET;
+        bool write_ok = true;
+        while(write_ok && storage_dir_read(dir, &info, file_name, sizeof(file_name))) {
+            if(!flipper_wedge_layout_index_is_layout(&info, file_name)) continue;
+
+            FlipperWedgeLayoutIndexRecord record;
+            uint32_t size = (uint32_t)info.size;
+            uint32_t timestamp = flipper_wedge_layout_index_timestamp(storage, path, dir_path, file_name);
+
+            if(flipper_wedge_layout_index_find_old(old, old_count, count, file_name, &record) &&
+               record.size == size && record.timestamp == timestamp) {
+                reused++;
+            } else {
+                memset(&record, 0, sizeof(record));
+                snprintf(record.file, sizeof(record.file), "%s", file_name);
+                record.size = size;
+                record.timestamp = timestamp;
+
+                // Use filename without extension as fallback name
+                if(!flipper_wedge_keyboard_layout_read_name(storage, furi_string_get_cstr(path), name)) {
+                    furi_string_set_strn(name, file_name, strlen(file_name) - 4);
+                }
+                snprintf(record.name, sizeof(record.name), "%s", furi_string_get_cstr(name));
+            }
+
+            hash = flipper_wedge_layout_index_hash_entry(hash, file_name, size, timestamp);
+            write_ok = storage_file_write(index, &record, sizeof(record)) == sizeof(record);
+            count++;
+        }
+        if(!write_ok) {
+            FURI_LOG_E(TAG, "Failed to write index");
+            break;
+        }
+
+        header.magic = LAYOUT_INDEX_MAGIC;
+        header.version = LAYOUT_INDEX_VERSION;
+        header.record_size = sizeof(FlipperWedgeLayoutIndexRecord);
+        header.count = count;
+        header.dir_timestamp = dir_timestamp;
+        header.listing_hash = hash;
+        if(!storage_file_seek(index, 0, true) ||
+           storage_file_write(index, &header, sizeof(header)) != sizeof(header)) {
+            break;
+        }
+        success = true;
+    } while(false);
+
+    storage_dir_close(dir);
+    storage_file_free(dir);
+    storage_file_close(index);
+    storage_file_free(index);
+    storage_file_close(old);
+    storage_file_free(old);
+    furi_string_free(name);
+    furi_string_free(path);
+
+    storage_common_remove(storage, index_path);
+    if(success && storage_common_rename(storage, furi_string_get_cstr(tmp_path), index_path) != FSE_OK) {
+        FURI_LOG_E(TAG, "Failed to replace %s", index_path);
+        success = false;
+    }
+    if(!success) {
+        storage_common_remove(storage, furi_string_get_cstr(tmp_path));
+    } else {
+        FURI_LOG_I(
+            TAG,
+            "Indexed %lu layouts in %lu ms (%lu unchanged)",
+            count,
+            furi_get_tick() - start,
+            reused);
+    }
+    furi_string_free(tmp_path);
+    return success;
+}
+
+FlipperWedgeLayoutIndex* flipper_wedge_layout_index_alloc(void) {
+    FlipperWedgeLayoutIndex* index = malloc(sizeof(FlipperWedgeLayoutIndex));
+    index->storage = NULL;
+    index->file = NULL;
+    index->dir_path = furi_string_alloc();
+    index->count = 0;
+    index->page = UINT32_MAX;
+    return index;
+}
+
+void flipper_wedge_layout_index_free(FlipperWedgeLayoutIndex* index) {
+    furi_assert(index);
+    flipper_wedge_layout_index_unload(index);
+    furi_string_free(index->dir_path);
+    free(index);
+}
+
+bool flipper_wedge_layout_index_load(FlipperWedgeLayoutIndex* index, const char* dir_path, const char* index_path) {
+    furi_assert(index);
+    furi_assert(dir_path);
+    furi_assert(index_path);
+
+    flipper_wedge_layout_index_unload(index);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!storage_dir_exists(storage, dir_path)) {
+        FURI_LOG_I(TAG, "Creating layouts directory");
+        storage_simply_mkdir(storage, dir_path);
+    }
+
+    // 0 if the filesystem has no directory times, the listing hash still applies
+    uint32_t dir_timestamp = 0;
+    storage_common_timestamp(storage, dir_path, &dir_timestamp);
+
+    uint32_t count = 0;
+    uint32_t hash = 0;
+    if(!flipper_wedge_layout_index_scan(storage, dir_path, &count, &hash)) {
+        FURI_LOG_E(TAG, "Failed to open %s", dir_path);
+        furi_record_close(RECORD_STORAGE);
+        return false;
+    }
+
+    File* file = storage_file_alloc(storage);
+    FlipperWedgeLayoutIndexHeader header;
+    bool valid = flipper_wedge_layout_index_open(file, index_path, &header);
+    if(valid && (header.count != count || header.dir_timestamp != dir_timestamp ||
+                 header.listing_hash != hash)) {
+        storage_file_close(file);
+        valid = false;
+    }
+    if(!valid) {
+        // Missing or built from another version of the directory
+        if(flipper_wedge_layout_index_build(storage, dir_path, index_path, dir_timestamp)) {
+            valid = flipper_wedge_layout_index_open(file, index_path, &header);
+        }
+    }
+
+    if(!valid) {
+        FURI_LOG_E(TAG, "Failed to load %s", index_path);
+        storage_file_free(file);
+        furi_record_close(RECORD_STORAGE);
+        return false;
+    }
+
+    index->storage = storage;
+    index->file = file;
+    index->count = header.count;
+    index->page = UINT32_MAX;
+    furi_string_set_str(index->dir_path, dir_path);
+    FURI_LOG_I(TAG, "Loaded %lu layouts", index->count);
+    return true;
+}
+
+void flipper_wedge_layout_index_unload(FlipperWedgeLayoutIndex* index) {
+    furi_assert(index);
+    if(!index->storage) return;
+
+    storage_file_close(index->file);
+    storage_file_free(index->file);
+    furi_record_close(RECORD_STORAGE);
+
+    index->storage = NULL;
+    index->file = NULL;
+    index->count = 0;
+    index->page = UINT32_MAX;
+}
+
+uint32_t flipper_wedge_layout_index_get_count(FlipperWedgeLayoutIndex* index) {
+    furi_assert(index);
+    return index->count;
+}
+
+static const FlipperWedgeLayoutIndexRecord*
+    flipper_wedge_layout_index_get_record(FlipperWedgeLayoutIndex* index, uint32_t position) {
+    if(position >= index->count) return NULL;
+
+    uint32_t page = position / LAYOUT_PAGE_RECORDS;
+    if(index->page != page) {
+        uint32_t first = page * LAYOUT_PAGE_RECORDS;
+        size_t records = MIN(index->count - first, (uint32_t)LAYOUT_PAGE_RECORDS);
+        size_t size = records * sizeof(FlipperWedgeLayoutIndexRecord);
+        uint64_t offset = sizeof(FlipperWedgeLayoutIndexHeader) +
+                          (uint64_t)first * sizeof(FlipperWedgeLayoutIndexRecord);
+
+        if(!storage_file_seek(index->file, offset, true) ||
+           storage_file_read(index->file, index->records, size) != size) {
+            FURI_LOG_E(TAG, "Failed to read index page %lu", page);
+            index->page = UINT32_MAX;
+            return NULL;
+        }
+        index->page = page;
+    }
+    return &index->records[position % LAYOUT_PAGE_RECORDS];
+}
+
+bool flipper_wedge_layout_index_get(
+    FlipperWedgeLayoutIndex* index,
+    uint32_t position,
+    FuriString* name,
+    FuriString* path) {
+    furi_assert(index);
+
+    const FlipperWedgeLayoutIndexRecord* record = flipper_wedge_layout_index_get_record(index, position);
+    if(!record) return false;
+
+    if(name) {
+        furi_string_set_strn(name, record->name, strnlen(record->name, sizeof(record->name)));
+    }
+    if(path) {
+        furi_string_printf(
+            path,
+            "%s/%.*s",
+            furi_string_get_cstr(index->dir_path),
+            (int)strnlen(record->file, sizeof(record->file)),
+            record->file);
+    }
+    return true;
+}
+
+uint32_t flipper_wedge_layout_index_find(FlipperWedgeLayoutIndex* index, const char* path) {
+    furi_assert(index);
+    furi_assert(path);
+
+    size_t dir_len = furi_string_size(index->dir_path);
+    if(strncmp(path, furi_string_get_cstr(index->dir_path), dir_len) != 0 || path[dir_len] != '/') {
+        return UINT32_MAX;
+    }
+    const char* file_name = &path[dir_len + 1];
+
+    for(uint32_t i = 0; i < index->count; i++) {
+        const FlipperWedgeLayoutIndexRecord* record = flipper_wedge_layout_index_get_record(index, i);
+        if(!record) break;
+        if(strncmp(record->file, file_name, sizeof(record->file)) == 0) return i;
+    }
+    return UINT32_MAX;
+}
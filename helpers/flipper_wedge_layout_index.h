@@ -0,0 +1,86 @@
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+#include "flipper_wedge_keyboard_layout.h"
+
+// Index of the custom keyboard layouts on SD
+//
+// Showing a layout by name means opening its file, which with a shared pack
+// of dozens of layouts makes the settings scene slow to enter. The names are
+// kept in an index file of fixed-width records (name, file name, size,
+// mtime), one per layout file in directory order.
+//
+// Loading revalidates the index with one pass over the directory entries:
+// the directory mtime and a hash of the file names, sizes and mtimes must
+// match the header, no layout file is opened. FAT does not update a
+// directory's mtime when files are added, removed or edited, hence the
+// listing hash. When they differ the index is rebuilt, reusing the name of
+// every file whose size and mtime are unchanged, so only new or edited
+// layouts are opened.
+//
+// Entries are read on demand a page at a time, memory use does not depend on
+// the number of layouts.
+
+#define FLIPPER_WEDGE_LAYOUT_INDEX_PATH APP_DATA_PATH("layouts.idx")
+#define FLIPPER_WEDGE_LAYOUT_INDEX_FILE_MAX 88    // File name in the layouts directory, with NUL
+#define FLIPPER_WEDGE_LAYOUT_INDEX_PAGE_SIZE 512  // Index bytes per SD read
+
+typedef struct FlipperWedgeLayoutIndex FlipperWedgeLayoutIndex;
+
+/** Allocate layout index (not loaded)
+ *
+ * @return FlipperWedgeLayoutIndex instance
+ */
+FlipperWedgeLayoutIndex* flipper_wedge_layout_index_alloc(void);
+
+/** Free layout index
+ *
+ * @param index FlipperWedgeLayoutIndex instance
+ */
+void flipper_wedge_layout_index_free(FlipperWedgeLayoutIndex* index);
+
+/** Load the index of a layouts directory, rebuilding it if it is out of date
+ * Creates the directory if it is missing.
+ *
+ * @param index FlipperWedgeLayoutIndex instance
+ * @param dir_path Layouts directory
+ * @param index_path Index file
+ * @return true if the index is ready, possibly with no layouts
+ */
+bool flipper_wedge_layout_index_load(FlipperWedgeLayoutIndex* index, const char* dir_path, const char* index_path);
+
+/** Close the index file and drop the cached page
+ *
+ * @param index FlipperWedgeLayoutIndex instance
+ */
+void flipper_wedge_layout_index_unload(FlipperWedgeLayoutIndex* index);
+
+/** Get the number of indexed layouts
+ *
+ * @param index FlipperWedgeLayoutIndex instance
+ * @return Layout count, 0 if not loaded
+ */
+uint32_t flipper_wedge_layout_index_get_count(FlipperWedgeLayoutIndex* index);
+
+/** Get an indexed layout
+ *
+ * @param index FlipperWedgeLayoutIndex instance
+ * @param position Layout position, below flipper_wedge_layout_index_get_count()
+ * @param name Receives the layout name (can be NULL)
+ * @param path Receives the full file path (can be NULL)
+ * @return true if the entry was read
+ */
+bool flipper_wedge_layout_index_get(
+    FlipperWedgeLayoutIndex* index,
+    uint32_t position,
+    FuriString* name,
+    FuriString* path);
+
+/** Find a layout by file path
+ *
+ * @param index FlipperWedgeLayoutIndex instance
+ * @param path Full file path
+ * @return Layout position, UINT32_MAX if it is not indexed
+ */
+uint32_t flipper_wedge_layout_index_find(FlipperWedgeLayoutIndex* index, const char* path);
@@ -34,3 +34,35 @@ void flipper_wedge_led_reset(void* context) {
     furi_thread_flags_wait(
         0, FuriFlagWaitAny, 300); //Delay, prevent removal from RAM before LED value set
 }
+
+// Static sequences stay valid after the call, so these return without waiting
+static const NotificationSequence sequence_led_green = {
+    &message_red_0,
+    &message_green_255,
+    &message_blue_0,
+    &message_do_not_reset,
+    NULL,
+};
+
+static const NotificationSequence sequence_led_red = {
+    &message_red_255,
+    &message_green_0,
+    &message_blue_0,
+    &message_do_not_reset,
+    NULL,
+};
+
+void flipper_wedge_led_green(void* context) {
+    FlipperWedge* app = context;
+    notification_message(app->notification, &sequence_led_green);
+}
+
+void flipper_wedge_led_red(void* context) {
+    FlipperWedge* app = context;
+    notification_message(app->notification, &sequence_led_red);
+}
+
+void flipper_wedge_led_off(void* context) {
+    FlipperWedge* app = context;
+    notification_message(app->notification, &sequence_reset_rgb);
+}
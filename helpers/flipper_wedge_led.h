@@ -3,3 +3,10 @@
 void flipper_wedge_led_set_rgb(void* context, int red, int green, int blue);
 
 void flipper_wedge_led_reset(void* context);
+
+// Non-blocking, for feedback that overlaps scanning
+void flipper_wedge_led_green(void* context);
+
+void flipper_wedge_led_red(void* context);
+
+void flipper_wedge_led_off(void* context);
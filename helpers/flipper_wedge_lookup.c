@@ -0,0 +1,762 @@
+#include "flipper_wedge_lookup.h"
+
+#define TAG "FlipperWedgeLookup"
+
+#define LOOKUP_INDEX_MAGIC 0x584C5746  // "FWLX"
+#define LOOKUP_INDEX_VERSION 1
+#define LOOKUP_RUN_PATH APP_DATA_PATH("lookup.tmp")
+#define LOOKUP_CURSOR_RECORDS 4  // Records buffered per run while merging
+#define LOOKUP_MAX_RECORDS (FLIPPER_WEDGE_LOOKUP_RUN_RECORDS * FLIPPER_WEDGE_LOOKUP_MAX_RUNS)
+
+// One index entry, sorted by UID length, then UID bytes, then CSV position
+typedef struct {
+    uint8_t uid_len;
+    uint8_t uid[FLIPPER_WEDGE_LOOKUP_UID_MAX_LEN];
+    uint8_t value_len;
+    uint32_t offset;  // Value position in the CSV
+} __attribute__((packed)) FlipperWedgeLookupRecord;
+
+_Static_assert(sizeof(FlipperWedgeLookupRecord) == 16, "Lookup record must stay 16 bytes");
+
+#define LOOKUP_PAGE_RECORDS (FLIPPER_WEDGE_LOOKUP_PAGE_SIZE / sizeof(FlipperWedgeLookupRecord))
+
+// Index file header, records follow
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t count;
+    uint32_t csv_size;       // CSV the index was built from, rebuilt when
+    uint32_t csv_timestamp;  // either of these changes
+    uint8_t reserved[12];
+} __attribute__((packed)) FlipperWedgeLookupHeader;
+
+_Static_assert(sizeof(FlipperWedgeLookupHeader) == 32, "Lookup header must stay 32 bytes");
+
+typedef struct {
+    uint32_t page;  // UINT32_MAX if unused
+    uint32_t last_used;
+    FlipperWedgeLookupRecord records[LOOKUP_PAGE_RECORDS];
+} FlipperWedgeLookupPage;
+
+struct FlipperWedgeLookup {
+    Storage* storage;
+    File* index;
+    File* csv;
+    uint32_t count;
+    uint32_t use_counter;
+    FlipperWedgeLookupPage cache[FLIPPER_WEDGE_LOOKUP_CACHE_PAGES];
+};
+
+// Buffered byte reader for the CSV, tracks the file offset of every byte
+typedef struct {
+    File* file;
+    uint8_t buf[FLIPPER_WEDGE_LOOKUP_PAGE_SIZE];
+    size_t len;
+    size_t pos;
+    uint32_t offset;
+} FlipperWedgeLookupReader;
+
+// Sorted run being merged, see flipper_wedge_lookup_merge()
+typedef struct {
+    uint32_t next;       // Next unbuffered record in the run file
+    uint32_t remaining;  // Records not yet buffered
+    FlipperWedgeLookupRecord buf[LOOKUP_CURSOR_RECORDS];
+    uint8_t buf_len;
+    uint8_t buf_pos;
+} FlipperWedgeLookupCursor;
+
+static int flipper_wedge_lookup_record_cmp_key(
+    const FlipperWedgeLookupRecord* a,
+    const FlipperWedgeLookupRecord* b) {
+    if(a->uid_len != b->uid_len) return a->uid_len < b->uid_len ? -1 : 1;
+    return memcmp(a->uid, b->uid, a->uid_len);
+}
+
+static int flipper_wedge_lookup_record_cmp(const void* a, const void* b) {
+    const FlipperWedgeLookupRecord* ra = a;
+    const FlipperWedgeLookupRecord* rb = b;
+    int cmp = flipper_wedge_lookup_record_cmp_key(ra, rb);
+    if(cmp != 0) return cmp;
+    // Duplicate UIDs: the first CSV line sorts first and wins
+    if(ra->offset != rb->offset) return ra->offset < rb->offset ? -1 : 1;
+    return 0;
+}
+
+static int flipper_wedge_lookup_reader_getc(FlipperWedgeLookupReader* reader) {
+    if(reader->pos >= reader->len) {
+        reader->len = storage_file_read(reader->file, reader->buf, sizeof(reader->buf));
+        reader->pos = 0;
+        if(reader->len == 0) return -1;
+    }
+    reader->offset++;
+    return reader->buf[reader->pos++];
+}
+
+static int flipper_wedge_lookup_hex_value(int c) {
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool flipper_wedge_lookup_write_run(
+    File* run_file,
+    FlipperWedgeLookupRecord* records,
+    size_t count) {
+    qsort(records, count, sizeof(FlipperWedgeLookupRecord), flipper_wedge_lookup_record_cmp);
+    size_t size = count * sizeof(FlipperWedgeLookupRecord);
+    return storage_file_write(run_file, records, size) == size;
+}
+
+// Parse the CSV into sorted runs of FLIPPER_WEDGE_LOOKUP_RUN_RECORDS records
+// Returns the number of records written, UINT32_MAX on error
+static uint32_t flipper_wedge_lookup_split_runs(File* csv, File* run_file) {
+    FlipperWedgeLookupReader* reader = malloc(sizeof(FlipperWedgeLookupReader));
+    reader->file = csv;
+    reader->len = 0;
+    reader->pos = 0;
+    reader->offset = 0;
+
+    FlipperWedgeLookupRecord* run =
+        malloc(sizeof(FlipperWedgeLookupRecord) * FLIPPER_WEDGE_LOOKUP_RUN_RECORDS);
+    size_t run_len = 0;
+    uint32_t total = 0;
+    uint32_t skipped = 0;
+    bool ok = true;
+
+    // Line state
+    enum { FieldUid, FieldValue, FieldRest } field = FieldUid;
+    FlipperWedgeLookupRecord record = {0};
+    size_t nibbles = 0;
+    bool bad = false;
+    size_t value_len = 0;
+
+    while(ok) {
+        int c = flipper_wedge_lookup_reader_getc(reader);
+        bool eof = c < 0;
+
+        if(eof || c == '\n' || c == '\r') {
+            if(!bad && nibbles > 0 && nibbles % 2 == 0) {
+                if(total >= LOOKUP_MAX_RECORDS) {
+                    FURI_LOG_W(TAG, "Table truncated at %lu entries", total);
+                    break;
+                }
+                if(field == FieldUid) {
+                    // UID without a value column
+                    record.offset = reader->offset;
+                }
+                record.uid_len = nibbles / 2;
+                record.value_len = MIN(value_len, (size_t)FLIPPER_WEDGE_LOOKUP_VALUE_MAX_LEN);
+                run[run_len++] = record;
+                total++;
+                if(run_len == FLIPPER_WEDGE_LOOKUP_RUN_RECORDS) {
+                    ok = flipper_wedge_lookup_write_run(run_file, run, run_len);
+                    run_len = 0;
+                }
+            } else if(nibbles > 0) {
+                skipped++;
+            }
+            if(eof) break;
+
+            field = FieldUid;
+            memset(&record, 0, sizeof(record));
+            nibbles = 0;
+            bad = false;
+            value_len = 0;
+            continue;
+        }
+
+        if(field == FieldUid) {
+            int nibble = flipper_wedge_lookup_hex_value(c);
+            if(c == ',') {
+                field = FieldValue;
+                record.offset = reader->offset;
+            } else if(nibble >= 0) {
+                if(nibbles < FLIPPER_WEDGE_LOOKUP_UID_MAX_LEN * 2) {
+                    record.uid[nibbles / 2] |= nibble << ((nibbles % 2) ? 0 : 4);
+                } else {
+                    bad = true;
+                }
+                nibbles++;
+            } else if(reader->offset <= 3 && c >= 0x80) {
+                // UTF-8 byte order mark of spreadsheet exports
+            } else if(c != ':' && c != '-' && c != ' ') {
+                bad = true;
+            }
+        } else if(field == FieldValue) {
+            if(c == ',') {
+                field = FieldRest;
+            } else {
+                value_len++;
+            }
+        }
+    }
+
+    if(ok && run_len > 0) {
+        ok = flipper_wedge_lookup_write_run(run_file, run, run_len);
+    }
+
+    if(skipped > 0) {
+        FURI_LOG_W(TAG, "Skipped %lu lines with an invalid UID", skipped);
+    }
+
+    free(run);
+    free(reader);
+    return ok ? total : UINT32_MAX;
+}
+
+static bool flipper_wedge_lookup_cursor_peek(
+    File* run_file,
+    FlipperWedgeLookupCursor* cursor,
+    FlipperWedgeLookupRecord** record) {
+    if(cursor->buf_pos >= cursor->buf_len) {
+        if(cursor->remaining == 0) return false;
+        size_t n = MIN(cursor->remaining, (uint32_t)LOOKUP_CURSOR_RECORDS);
+        size_t size = n * sizeof(FlipperWedgeLookupRecord);
+        if(!storage_file_seek(run_file, cursor->next * sizeof(FlipperWedgeLookupRecord), true) ||
+           storage_file_read(run_file, cursor->buf, size) != size) {
+            FURI_LOG_E(TAG, "Failed to read sorted run");
+            cursor->remaining = 0;
+            return false;
+        }
+        cursor->next += n;
+        cursor->remaining -= n;
+        cursor->buf_len = n;
+        cursor->buf_pos = 0;
+    }
+    *record = &cursor->buf[cursor->buf_pos];
+    return true;
+}
+
+// K-way merge of the sorted runs into the index, dropping duplicate UIDs
+// Returns the number of records written, UINT32_MAX on error
+static uint32_t flipper_wedge_lookup_merge(File* run_file, uint32_t total, File* index) {
+    uint32_t run_count =
+        (total + FLIPPER_WEDGE_LOOKUP_RUN_RECORDS - 1) / FLIPPER_WEDGE_LOOKUP_RUN_RECORDS;
+    FlipperWedgeLookupCursor* cursors = malloc(sizeof(FlipperWedgeLookupCursor) * run_count);
+    FlipperWedgeLookupRecord* page = malloc(FLIPPER_WEDGE_LOOKUP_PAGE_SIZE);
+    size_t page_len = 0;
+    uint32_t written = 0;
+    uint32_t duplicates = 0;
+    FlipperWedgeLookupRecord last = {0};
+    bool ok = true;
+
+    // Every run is full except the last one
+    for(uint32_t i = 0; i < run_count; i++) {
+        cursors[i].next = i * FLIPPER_WEDGE_LOOKUP_RUN_RECORDS;
+        cursors[i].remaining = MIN(total - cursors[i].next, (uint32_t)FLIPPER_WEDGE_LOOKUP_RUN_RECORDS);
+        cursors[i].buf_len = 0;
+        cursors[i].buf_pos = 0;
+    }
+
+    while(ok) {
+        // Linear scan is fine, at most FLIPPER_WEDGE_LOOKUP_MAX_RUNS runs and SD reads dominate
+        FlipperWedgeLookupCursor* min_cursor = NULL;
+        FlipperWedgeLookupRecord* min_record = NULL;
+        for(uint32_t i = 0; i < run_count; i++) {
+            FlipperWedgeLookupRecord* record;
+            if(!flipper_wedge_lookup_cursor_peek(run_file, &cursors[i], &record)) continue;
+            if(!min_record || flipper_wedge_lookup_record_cmp(record, min_record) < 0) {
+                min_cursor = &cursors[i];
+                min_record = record;
+            }
+        }
+        if(!min_record) break;
+
+        if(written > 0 && flipper_wedge_lookup_record_cmp_key(min_record, &last) == 0) {
+            duplicates++;
+        } else {
+            page[page_len++] = *min_record;
+            last = *min_record;
+            written++;
+            if(page_len == LOOKUP_PAGE_RECORDS) {
+                ok = storage_file_write(index, page, FLIPPER_WEDGE_LOOKUP_PAGE_SIZE) ==
+                     FLIPPER_WEDGE_LOOKUP_PAGE_SIZE;
+                page_len = 0;
+            }
+        }
+        min_cursor->buf_pos++;
+    }
+
+    if(ok && page_len > 0) {
+        size_t size = page_len * sizeof(FlipperWedgeLookupRecord);
+        ok = storage_file_write(index, page, size) == size;
+    }
+
+    if(duplicates > 0) {
+        FURI_LOG_W(TAG, "Ignored %lu duplicate UIDs, first line wins", duplicates);
+    }
+
+    free(page);
+    free(cursors);
+    return ok ? written : UINT32_MAX;
+}
+
+static bool flipper_wedge_lookup_build(
+    Storage* storage,
+    const char* csv_path,
+    const char* index_path,
+    uint32_t csv_size,
+    uint32_t csv_timestamp) {
+    FURI_LOG_I(TAG, "Building index for %s (%lu bytes)", csv_path, csv_size);
+    uint32_t start = furi_get_tick();
+
+    File* csv = storage_file_alloc(storage);
+    File* run_file = storage_file_alloc(storage);
+    File* index = storage_file_alloc(storage);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(csv, csv_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            FURI_LOG_E(TAG, "Failed to open %s", csv_path);
+            break;
+        }
+        if(!storage_file_open(run_file, LOOKUP_RUN_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Failed to create %s", LOOKUP_RUN_PATH);
+            break;
+        }
+
+        uint32_t total = flipper_wedge_lookup_split_runs(csv, run_file);
+        if(total == UINT32_MAX) {
+            FURI_LOG_E(TAG, "Failed to write sorted runs");
+            break;
+        }
+        uint32_t split_ms = furi_get_tick() - start;
+
+        if(!storage_file_open(index, index_path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Failed to create %s", index_path);
+            break;
+        }
+
+        // Header goes last, an interrupted build leaves an invalid index
+        FlipperWedgeLookupHeader header = {0};
+        if(storage_file_write(index, &header, sizeof(header)) != sizeof(header)) break;
+
+        uint32_t count = flipper_wedge_lookup_merge(run_file, total, index);
+        if(count == UINT32_MAX) {
+            FURI_LOG_E(TAG, "Failed to write index");
+            break;
+        }
+
+        header.magic = LOOKUP_INDEX_MAGIC;
+        header.version = LOOKUP_INDEX_VERSION;
+        header.record_size = sizeof(FlipperWedgeLookupRecord);
+        header.count = count;
+        header.csv_size = csv_size;
+        header.csv_timestamp = csv_timestamp;
+        if(!storage_file_seek(index, 0, true) ||
+           storage_file_write(index, &header, sizeof(header)) != sizeof(header)) {
+            break;
+        }
+
+        FURI_LOG_I(
+            TAG,
+            "Indexed %lu entries in %lu ms (split %lu ms, merge %lu ms)",
+            count,
+            furi_get_tick() - start,
+            split_ms,
+            furi_get_tick() - start - split_ms);
+        success = true;
+    } while(false);
+
+    storage_file_close(index);
+    storage_file_free(index);
+    storage_file_close(run_file);
+    storage_file_free(run_file);
+    storage_file_close(csv);
+    storage_file_free(csv);
+    storage_common_remove(storage, LOOKUP_RUN_PATH);
+
+    if(!success) {
+        storage_common_remove(storage, index_path);
+    }
+    return success;
+}
+
+// Open the index if it matches the CSV, returns the entry count or UINT32_MAX
+static uint32_t flipper_wedge_lookup_open_index(
+    File* index,
+    const char* index_path,
+    uint32_t csv_size,
+    uint32_t csv_timestamp) {
+    if(!storage_file_open(index, index_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        return UINT32_MAX;
+    }
+
+    FlipperWedgeLookupHeader header;
+    if(storage_file_read(index, &header, sizeof(header)) != sizeof(header) ||
+       header.magic != LOOKUP_INDEX_MAGIC || header.version != LOOKUP_INDEX_VERSION ||
+       header.record_size != sizeof(FlipperWedgeLookupRecord) || header.csv_size != csv_size ||
+       header.csv_timestamp != csv_timestamp ||
+       storage_file_size(index) != sizeof(header) + (uint64_t)header.count * sizeof(FlipperWedgeLookupRecord)) {
+        storage_file_close(index);
+        return UINT32_MAX;
+    }
+    return header.count;
+}
+
+FlipperWedgeLookup* flipper_wedge_lookup_alloc(void) {
+    FlipperWedgeLookup* lookup = malloc(sizeof(FlipperWedgeLookup));
+    lookup->storage = NULL;
+    lookup->index = NULL;
+    lookup->csv = NULL;
+    lookup->count = 0;
+    lookup->use_counter = 0;
+    return lookup;
+}
+
+void flipper_wedge_lookup_free(FlipperWedgeLookup* lookup) {
+    furi_assert(lookup);
+    flipper_wedge_lookup_unload(lookup);
+    free(lookup);
+}
+
+bool flipper_wedge_lookup_load(FlipperWedgeLookup* lookup, const char* csv_path, const char* index_path) {
+    furi_assert(lookup);
+    furi_assert(csv_path);
+    furi_assert(index_path);
+
+    flipper_wedge_lookup_unload(lookup);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FileInfo info;
+    uint32_t csv_timestamp = 0;
+    if(storage_common_stat(storage, csv_path, &info) != FSE_OK ||
+       storage_common_timestamp(storage, csv_path, &csv_timestamp) != FSE_OK) {
+        FURI_LOG_I(TAG, "No table at %s", csv_path);
+        furi_record_close(RECORD_STORAGE);
+        return false;
+    }
+    uint32_t csv_size = (uint32_t)info.size;
+
+    File* index = storage_file_alloc(storage);
+    uint32_t count = flipper_wedge_lookup_open_index(index, index_path, csv_size, csv_timestamp);
+    if(count == UINT32_MAX) {
+        // Missing or built from another version of the CSV
+        if(flipper_wedge_lookup_build(storage, csv_path, index_path, csv_size, csv_timestamp)) {
+            count = flipper_wedge_lookup_open_index(index, index_path, csv_size, csv_timestamp);
+        }
+    }
+
+    File* csv = storage_file_alloc(storage);
+    if(count == UINT32_MAX || !storage_file_open(csv, csv_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        FURI_LOG_E(TAG, "Failed to load %s", csv_path);
+        storage_file_close(csv);
+        storage_file_free(csv);
+        storage_file_close(index);
+        storage_file_free(index);
+        furi_record_close(RECORD_STORAGE);
+        return false;
+    }
+
+    lookup->storage = storage;
+    lookup->index = index;
+    lookup->csv = csv;
+    lookup->count = count;
+    for(size_t i = 0; i < FLIPPER_WEDGE_LOOKUP_CACHE_PAGES; i++) {
+        lookup->cache[i].page = UINT32_MAX;
+        lookup->cache[i].last_used = 0;
+    }
+    FURI_LOG_I(TAG, "Loaded %lu entries", count);
+    return true;
+}
+
+void flipper_wedge_lookup_unload(FlipperWedgeLookup* lookup) {
+    furi_assert(lookup);
+    if(!lookup->storage) return;
+
+    storage_file_close(lookup->csv);
+    storage_file_free(lookup->csv);
+    storage_file_close(lookup->index);
+    storage_file_free(lookup->index);
+    furi_record_close(RECORD_STORAGE);
+
+    lookup->storage = NULL;
+    lookup->index = NULL;
+    lookup->csv = NULL;
+    lookup->count = 0;
+}
+
+bool flipper_wedge_lookup_is_loaded(FlipperWedgeLookup* lookup) {
+    furi_assert(lookup);
+    return lookup->storage != NULL;
+}
+
+uint32_t flipper_wedge_lookup_get_count(FlipperWedgeLookup* lookup) {
+    furi_assert(lookup);
+    return lookup->count;
+}
+
+// Get an index page through the LRU cache, NULL on read error
+static const FlipperWedgeLookupPage*
+    flipper_wedge_lookup_get_page(FlipperWedgeLookup* lookup, uint32_t page, uint32_t* reads) {
+    FlipperWedgeLookupPage* victim = &lookup->cache[0];
+    lookup->use_counter++;
+
+    for(size_t i = 0; i < FLIPPER_WEDGE_LOOKUP_CACHE_PAGES; i++) {
+        FlipperWedgeLookupPage* entry = &lookup->cache[i];
+        if(entry->page == page) {
+            entry->last_used = lookup->use_counter;
+            return entry;
+        }
+        if(entry->page == UINT32_MAX ||
+           (victim->page != UINT32_MAX && entry->last_used < victim->last_used)) {
+            victim = entry;
+        }
+    }
+
+    uint32_t first = page * LOOKUP_PAGE_RECORDS;
+    size_t records = MIN(lookup->count - first, (uint32_t)LOOKUP_PAGE_RECORDS);
+    size_t size = records * sizeof(FlipperWedgeLookupRecord);
+    uint64_t position =
+        sizeof(FlipperWedgeLookupHeader) + (uint64_t)first * sizeof(FlipperWedgeLookupRecord);
+
+    (*reads)++;
+    if(!storage_file_seek(lookup->index, position, true) ||
+       storage_file_read(lookup->index, victim->records, size) != size) {
+        FURI_LOG_E(TAG, "Failed to read index page %lu", page);
+        victim->page = UINT32_MAX;
+        return NULL;
+    }
+    victim->page = page;
+    victim->last_used = lookup->use_counter;
+    return victim;
+}
+
+bool flipper_wedge_lookup_foreach(
+    FlipperWedgeLookup* lookup,
+    FlipperWedgeLookupUidCallback callback,
+    void* context) {
+    furi_assert(lookup);
+    furi_assert(callback);
+    if(!lookup->storage) return false;
+
+    // Sequential pass with its own buffer, the page cache stays hot
+    FlipperWedgeLookupRecord* page = malloc(FLIPPER_WEDGE_LOOKUP_PAGE_SIZE);
+    bool ok = storage_file_seek(lookup->index, sizeof(FlipperWedgeLookupHeader), true);
+    uint32_t done = 0;
+
+    while(ok && done < lookup->count) {
+        size_t records = MIN(lookup->count - done, (uint32_t)LOOKUP_PAGE_RECORDS);
+        size_t size = records * sizeof(FlipperWedgeLookupRecord);
+        if(storage_file_read(lookup->index, page, size) != size) {
+            FURI_LOG_E(TAG, "Failed to read index at entry %lu", done);
+            ok = false;
+            break;
+        }
+        for(size_t i = 0; i < records; i++) {
+            callback(page[i].uid, page[i].uid_len, context);
+        }
+        done += records;
+    }
+
+    free(page);
+    return ok;
+}
+
+// Binary search, first over page boundaries, then inside one page
+static bool flipper_wedge_lookup_search(
+    FlipperWedgeLookup* lookup,
+    const FlipperWedgeLookupRecord* key,
+    FlipperWedgeLookupRecord* found,
+    uint32_t* reads) {
+    uint32_t pages = (lookup->count + LOOKUP_PAGE_RECORDS - 1) / LOOKUP_PAGE_RECORDS;
+    uint32_t lo = 0;
+    uint32_t hi = pages;
+
+    // Find the last page whose first record is <= key
+    while(hi - lo > 1) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        const FlipperWedgeLookupPage* page = flipper_wedge_lookup_get_page(lookup, mid, reads);
+        if(!page) return false;
+        if(flipper_wedge_lookup_record_cmp_key(&page->records[0], key) <= 0) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    const FlipperWedgeLookupPage* page = flipper_wedge_lookup_get_page(lookup, lo, reads);
+    if(!page) return false;
+
+    size_t records = MIN(lookup->count - lo * LOOKUP_PAGE_RECORDS, (uint32_t)LOOKUP_PAGE_RECORDS);
+    size_t left = 0;
+    size_t right = records;
+    while(left < right) {
+        size_t mid = left + (right - left) / 2;
+        int cmp = flipper_wedge_lookup_record_cmp_key(&page->records[mid], key);
+        if(cmp == 0) {
+            *found = page->records[mid];
+            return true;
+        } else if(cmp < 0) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return false;
+}
+
+bool flipper_wedge_lookup_find(
+    FlipperWedgeLookup* lookup,
+    const uint8_t* uid,
+    uint8_t uid_len,
+    char* value,
+    size_t value_size) {
+    furi_assert(lookup);
+    furi_assert(uid);
+    furi_assert(value);
+    furi_assert(value_size > 0);
+
+    value[0] = '\0';
+    if(!lookup->storage || lookup->count == 0) return false;
+    if(uid_len == 0 || uid_len > FLIPPER_WEDGE_LOOKUP_UID_MAX_LEN) return false;
+
+    uint32_t start = furi_get_tick();
+    uint32_t reads = 0;
+
+    FlipperWedgeLookupRecord key = {0};
+    key.uid_len = uid_len;
+    memcpy(key.uid, uid, uid_len);
+
+    FlipperWedgeLookupRecord found;
+    bool hit = flipper_wedge_lookup_search(lookup, &key, &found, &reads);
+
+    if(hit) {
+        size_t len = MIN((size_t)found.value_len, value_size - 1);
+        if(len > 0 && (!storage_file_seek(lookup->csv, found.offset, true) ||
+                       storage_file_read(lookup->csv, value, len) != len)) {
+            FURI_LOG_E(TAG, "Failed to read value at %lu", found.offset);
+            len = 0;
+            hit = false;
+        }
+        value[len] = '\0';
+    }
+
+    FURI_LOG_D(
+        TAG,
+        "Lookup %s in %lu ms, %lu index reads",
+        hit ? "hit" : "miss",
+        furi_get_tick() - start,
+        reads);
+    return hit;
+}
+
+#ifdef FURI_DEBUG
+#define LOOKUP_BENCH_MARKER_PATH APP_DATA_PATH("lookup_bench")
+#define LOOKUP_BENCH_CSV_PATH APP_DATA_PATH("lookup_bench.csv")
+#define LOOKUP_BENCH_INDEX_PATH APP_DATA_PATH("lookup_bench.idx")
+
+// Deterministic 7-byte UID for entry i of a generated table
+static void flipper_wedge_lookup_bench_uid(uint32_t i, uint8_t* uid) {
+    uint32_t x = i * 2654435761UL;
+    uid[0] = 0x04;
+    uid[1] = x >> 24;
+    uid[2] = x >> 16;
+    uid[3] = x >> 8;
+    uid[4] = x;
+    uid[5] = i >> 8;
+    uid[6] = i;
+}
+
+static bool flipper_wedge_lookup_bench_write(Storage* storage, uint32_t entries) {
+    File* file = storage_file_alloc(storage);
+    bool ok = storage_file_open(file, LOOKUP_BENCH_CSV_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    char* buf = malloc(FLIPPER_WEDGE_LOOKUP_PAGE_SIZE);
+    size_t len = 0;
+
+    for(uint32_t i = 0; ok && i < entries; i++) {
+        uint8_t uid[7];
+        flipper_wedge_lookup_bench_uid(i, uid);
+        char line[40];
+        int n = snprintf(
+            line,
+            sizeof(line),
+            "%02X%02X%02X%02X%02X%02X%02X,EMP%06lu\n",
+            uid[0], uid[1], uid[2], uid[3], uid[4], uid[5], uid[6],
+            i);
+        if(len + n > FLIPPER_WEDGE_LOOKUP_PAGE_SIZE) {
+            ok = storage_file_write(file, buf, len) == len;
+            len = 0;
+        }
+        memcpy(buf + len, line, n);
+        len += n;
+    }
+    if(ok && len > 0) {
+        ok = storage_file_write(file, buf, len) == len;
+    }
+
+    free(buf);
+    storage_file_close(file);
+    storage_file_free(file);
+    return ok;
+}
+#endif
+
+void flipper_wedge_lookup_benchmark(void) {
+#ifdef FURI_DEBUG
+    const uint32_t table_sizes[] = {1000, 10000, 100000};
+    const uint32_t lookups = 200;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    // Writes several MB to SD, only run when asked for
+    if(!storage_file_exists(storage, LOOKUP_BENCH_MARKER_PATH)) {
+        furi_record_close(RECORD_STORAGE);
+        return;
+    }
+
+    FlipperWedgeLookup* lookup = flipper_wedge_lookup_alloc();
+
+    for(size_t s = 0; s < COUNT_OF(table_sizes); s++) {
+        uint32_t entries = table_sizes[s];
+        if(!flipper_wedge_lookup_bench_write(storage, entries)) {
+            FURI_LOG_E(TAG, "Benchmark: failed to write %lu entry table", entries);
+            break;
+        }
+
+        uint32_t start = furi_get_tick();
+        bool loaded =
+            flipper_wedge_lookup_load(lookup, LOOKUP_BENCH_CSV_PATH, LOOKUP_BENCH_INDEX_PATH);
+        uint32_t build_ms = furi_get_tick() - start;
+        if(!loaded) break;
+
+        // Cold: spread over the whole table, mostly cache misses
+        // Warm: the same UID again, the way a badge is presented twice
+        uint32_t hits = 0;
+        uint8_t uid[7];
+        char value[FLIPPER_WEDGE_LOOKUP_VALUE_MAX_LEN + 1];
+
+        start = furi_get_tick();
+        for(uint32_t i = 0; i < lookups; i++) {
+            flipper_wedge_lookup_bench_uid((i * 7919) % entries, uid);
+            hits += flipper_wedge_lookup_find(lookup, uid, sizeof(uid), value, sizeof(value));
+        }
+        uint32_t cold_ms = furi_get_tick() - start;
+
+        flipper_wedge_lookup_bench_uid(entries / 2, uid);
+        start = furi_get_tick();
+        for(uint32_t i = 0; i < lookups; i++) {
+            hits += flipper_wedge_lookup_find(lookup, uid, sizeof(uid), value, sizeof(value));
+        }
+        uint32_t warm_ms = furi_get_tick() - start;
+
+        FURI_LOG_I(
+            TAG,
+            "Benchmark: %lu entries, index build %lu ms, %lu lookups cold %lu ms, warm %lu ms, %lu hits",
+            entries,
+            build_ms,
+            lookups,
+            cold_ms,
+            warm_ms,
+            hits);
+
+        flipper_wedge_lookup_unload(lookup);
+    }
+
+    flipper_wedge_lookup_free(lookup);
+    storage_common_remove(storage, LOOKUP_BENCH_CSV_PATH);
+    storage_common_remove(storage, LOOKUP_BENCH_INDEX_PATH);
+    furi_record_close(RECORD_STORAGE);
+#endif
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+
+// UID -> value lookup table ("scan badge, type employee number")
+//
+// The table is a CSV file with one "UID,value" line per tag, e.g.
+//   04A1B2C3D4E5F6,10042
+//   04:11:22:33,Jane Doe
+// The UID is hex as the app types it (':', '-' and spaces are ignored, any
+// case). Only the second column is used, there is no quoting. A UID alone on
+// a line maps to an empty value, so a plain UID list works as a set. Lines
+// that do not start with a hex UID (headers, '#' comments) are skipped.
+//
+// On load the CSV is indexed once into a sorted file of fixed-width records
+// (UID -> value offset in the CSV), rebuilt whenever the CSV changes. The
+// index is sorted in RAM-sized runs that are then merged, and lookups are a
+// binary search over index pages read from SD, with an LRU of a few pages in
+// RAM. Memory use does not depend on the table size.
+
+#define FLIPPER_WEDGE_LOOKUP_CSV_PATH APP_DATA_PATH("lookup.csv")
+#define FLIPPER_WEDGE_LOOKUP_INDEX_PATH APP_DATA_PATH("lookup.idx")
+#define FLIPPER_WEDGE_LOOKUP_UID_MAX_LEN 10
+#define FLIPPER_WEDGE_LOOKUP_VALUE_MAX_LEN 64  // Longer values are cut
+#define FLIPPER_WEDGE_LOOKUP_PAGE_SIZE 512     // Index bytes per SD read
+#define FLIPPER_WEDGE_LOOKUP_CACHE_PAGES 8     // Index pages kept in RAM
+#define FLIPPER_WEDGE_LOOKUP_RUN_RECORDS 1024  // Records sorted in RAM at once while indexing
+#define FLIPPER_WEDGE_LOOKUP_MAX_RUNS 128      // Limits the table to 131072 entries
+
+typedef struct FlipperWedgeLookup FlipperWedgeLookup;
+
+/** Table UID callback
+ *
+ * @param uid UID bytes
+ * @param uid_len Length of UID
+ * @param context Callback context
+ */
+typedef void (*FlipperWedgeLookupUidCallback)(const uint8_t* uid, uint8_t uid_len, void* context);
+
+/** Allocate lookup table (not loaded)
+ *
+ * @return FlipperWedgeLookup instance
+ */
+FlipperWedgeLookup* flipper_wedge_lookup_alloc(void);
+
+/** Free lookup table
+ *
+ * @param lookup FlipperWedgeLookup instance
+ */
+void flipper_wedge_lookup_free(FlipperWedgeLookup* lookup);
+
+/** Load a CSV table, building its index if it is missing or out of date
+ *
+ * @param lookup FlipperWedgeLookup instance
+ * @param csv_path CSV file
+ * @param index_path Index file
+ * @return true if the table is ready for lookups
+ */
+bool flipper_wedge_lookup_load(FlipperWedgeLookup* lookup, const char* csv_path, const char* index_path);
+
+/** Close the table files and drop cached pages
+ *
+ * @param lookup FlipperWedgeLookup instance
+ */
+void flipper_wedge_lookup_unload(FlipperWedgeLookup* lookup);
+
+/** Check if a table is loaded
+ *
+ * @param lookup FlipperWedgeLookup instance
+ * @return true if flipper_wedge_lookup_find() can be used
+ */
+bool flipper_wedge_lookup_is_loaded(FlipperWedgeLookup* lookup);
+
+/** Get the number of UIDs in the loaded table
+ *
+ * @param lookup FlipperWedgeLookup instance
+ * @return Entry count
+ */
+uint32_t flipper_wedge_lookup_get_count(FlipperWedgeLookup* lookup);
+
+/** Find the value for a UID
+ *
+ * @param lookup FlipperWedgeLookup instance
+ * @param uid UID bytes
+ * @param uid_len Length of UID
+ * @param value Output buffer for the NUL-terminated value
+ * @param value_size Size of output buffer
+ * @return true if the UID is in the table
+ */
+bool flipper_wedge_lookup_find(
+    FlipperWedgeLookup* lookup,
+    const uint8_t* uid,
+    uint8_t uid_len,
+    char* value,
+    size_t value_size);
+
+/** Call a function for every UID in the loaded table, in index order
+ *
+ * @param lookup FlipperWedgeLookup instance
+ * @param callback Called once per UID
+ * @param context Callback context
+ * @return true if the whole index was read
+ */
+bool flipper_wedge_lookup_foreach(
+    FlipperWedgeLookup* lookup,
+    FlipperWedgeLookupUidCallback callback,
+    void* context);
+
+/** Log index build time and lookup latency for generated tables of 1k to 100k entries
+ * Only active in debug firmware builds (FURI_DEBUG), no-op otherwise.
+ * Runs only if the file lookup_bench exists in the app data folder,
+ * writes and removes temporary tables there.
+ */
+void flipper_wedge_lookup_benchmark(void);
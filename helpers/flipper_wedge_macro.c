@@ -0,0 +1,514 @@
+#include "flipper_wedge_macro.h"
+#include "flipper_wedge_format.h"
+#include <furi_hal_usb_hid.h>
+#include <storage/storage.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#define TAG "FlipperWedgeMacro"
+
+#define MACRO_CODE_SIZE 1024
+#define MACRO_TOKEN_MAX_LEN 32
+#define MACRO_RUN_MAX 255  // Keys or text bytes in one run
+#define MACRO_FIELD_MAX_LEN 256
+#define MACRO_NDEF_LINE_MAX 9
+
+// Program: one opcode byte followed by its operands
+typedef enum {
+    FlipperWedgeMacroOpEnd,
+    FlipperWedgeMacroOpKeys,   // [count] [count x keycode, little-endian]
+    FlipperWedgeMacroOpText,   // [len] [len bytes of UTF-8]
+    FlipperWedgeMacroOpDelay,  // [ms, little-endian 16-bit]
+    FlipperWedgeMacroOpField,  // [FlipperWedgeMacroField] [arg]
+} FlipperWedgeMacroOp;
+
+typedef enum {
+    FlipperWedgeMacroFieldOutput,
+    FlipperWedgeMacroFieldNfc,
+    FlipperWedgeMacroFieldRfid,
+    FlipperWedgeMacroFieldNdef,  // arg: line (1-9), 0 for all of it
+    FlipperWedgeMacroFieldDate,
+    FlipperWedgeMacroFieldTime,
+} FlipperWedgeMacroField;
+
+struct FlipperWedgeMacro {
+    char source[FLIPPER_WEDGE_MACRO_SOURCE_MAX_LEN + 1];
+    bool loaded;
+    uint8_t code[MACRO_CODE_SIZE];
+    size_t code_len;
+    size_t run_at;  // Offset of the open run's count byte, 0 if none
+    uint32_t delay_ms;
+    char error[FLIPPER_WEDGE_MACRO_ERROR_MAX_LEN];
+};
+
+typedef struct {
+    const char* name;
+    uint16_t value;
+} FlipperWedgeMacroName;
+
+static const FlipperWedgeMacroName macro_fields[] = {
+    {"output", FlipperWedgeMacroFieldOutput},
+    {"nfc", FlipperWedgeMacroFieldNfc},
+    {"rfid", FlipperWedgeMacroFieldRfid},
+    {"ndef", FlipperWedgeMacroFieldNdef},
+    {"date", FlipperWedgeMacroFieldDate},
+    {"time", FlipperWedgeMacroFieldTime},
+};
+
+static const FlipperWedgeMacroName macro_keys[] = {
+    {"enter", HID_KEYBOARD_RETURN},
+    {"tab", HID_KEYBOARD_TAB},
+    {"esc", HID_KEYBOARD_ESCAPE},
+    {"space", HID_KEYBOARD_SPACEBAR},
+    {"backspace", HID_KEYBOARD_DELETE},
+    {"delete", HID_KEYBOARD_DELETE_FORWARD},
+    {"insert", HID_KEYBOARD_INSERT},
+    {"home", HID_KEYBOARD_HOME},
+    {"end", HID_KEYBOARD_END},
+    {"pgup", HID_KEYBOARD_PAGE_UP},
+    {"pgdn", HID_KEYBOARD_PAGE_DOWN},
+    {"up", HID_KEYBOARD_UP_ARROW},
+    {"down", HID_KEYBOARD_DOWN_ARROW},
+    {"left", HID_KEYBOARD_LEFT_ARROW},
+    {"right", HID_KEYBOARD_RIGHT_ARROW},
+};
+
+static const FlipperWedgeMacroName macro_modifiers[] = {
+    {"ctrl", KEY_MOD_LEFT_CTRL},
+    {"shift", KEY_MOD_LEFT_SHIFT},
+    {"alt", KEY_MOD_LEFT_ALT},
+    {"gui", KEY_MOD_LEFT_GUI},
+};
+
+static bool flipper_wedge_macro_find_name(
+    const FlipperWedgeMacroName* names,
+    size_t count,
+    const char* name,
+    uint16_t* value) {
+    for(size_t i = 0; i < count; i++) {
+        if(strcasecmp(names[i].name, name) == 0) {
+            *value = names[i].value;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint16_t flipper_wedge_macro_char_key(FlipperWedgeKeyboardLayout* layout, char c) {
+    if(layout) {
+        return flipper_wedge_keyboard_layout_get_keycode(layout, c);
+    }
+    return HID_ASCII_TO_KEY(c);
+}
+
+FlipperWedgeMacro* flipper_wedge_macro_alloc(void) {
+    FlipperWedgeMacro* macro = malloc(sizeof(FlipperWedgeMacro));
+    macro->source[0] = '\0';
+    flipper_wedge_macro_unload(macro);
+    return macro;
+}
+
+void flipper_wedge_macro_free(FlipperWedgeMacro* macro) {
+    furi_assert(macro);
+    free(macro);
+}
+
+static bool flipper_wedge_macro_emit(FlipperWedgeMacro* macro, uint8_t byte) {
+    // Keep one byte free for the final End
+    if(macro->code_len + 1 >= MACRO_CODE_SIZE) return false;
+    macro->code[macro->code_len++] = byte;
+    return true;
+}
+
+// Append to the open run of the same kind, or start a new one
+static bool flipper_wedge_macro_emit_run(FlipperWedgeMacro* macro, FlipperWedgeMacroOp op, const uint8_t* bytes, size_t len) {
+    if(macro->run_at == 0 || macro->code[macro->run_at - 1] != op ||
+       macro->code[macro->run_at] + (op == FlipperWedgeMacroOpKeys ? 1 : len) > MACRO_RUN_MAX) {
+        if(!flipper_wedge_macro_emit(macro, op)) return false;
+        macro->run_at = macro->code_len;
+        if(!flipper_wedge_macro_emit(macro, 0)) return false;
+    }
+    for(size_t i = 0; i < len; i++) {
+        if(!flipper_wedge_macro_emit(macro, bytes[i])) return false;
+    }
+    macro->code[macro->run_at] += op == FlipperWedgeMacroOpKeys ? 1 : len;
+    return true;
+}
+
+static bool flipper_wedge_macro_emit_key(FlipperWedgeMacro* macro, uint16_t keycode) {
+    uint8_t bytes[2] = {keycode & 0xFF, keycode >> 8};
+    return flipper_wedge_macro_emit_run(macro, FlipperWedgeMacroOpKeys, bytes, sizeof(bytes));
+}
+
+// Parse a decimal argument in [min, max]
+static bool flipper_wedge_macro_parse_number(const char* text, uint32_t min, uint32_t max, uint32_t* value) {
+    char* end;
+    if(*text < '0' || *text > '9') return false;
+    unsigned long number = strtoul(text, &end, 10);
+    if(*end != '\0' || number < min || number > max) return false;
+    *value = number;
+    return true;
+}
+
+// Compile the text between braces, returns an error message or NULL
+static const char* flipper_wedge_macro_compile_token(
+    FlipperWedgeMacro* macro,
+    const char* token,
+    size_t len,
+    FlipperWedgeKeyboardLayout* layout) {
+    char buf[MACRO_TOKEN_MAX_LEN];
+    if(len == 0) return "empty {}";
+    if(len >= sizeof(buf)) return "name too long";
+    memcpy(buf, token, len);
+    buf[len] = '\0';
+
+    uint16_t value;
+    char* arg = strchr(buf, ':');
+    if(arg) {
+        *arg++ = '\0';
+        uint32_t number;
+        if(strcasecmp(buf, "delay") == 0) {
+            if(!flipper_wedge_macro_parse_number(arg, 1, FLIPPER_WEDGE_MACRO_DELAY_MAX_MS, &number)) {
+                return "bad delay";
+            }
+            macro->delay_ms += number;
+            if(macro->delay_ms > FLIPPER_WEDGE_MACRO_DELAY_MAX_MS) return "delays over 10 s";
+            macro->run_at = 0;
+            return flipper_wedge_macro_emit(macro, FlipperWedgeMacroOpDelay) &&
+                           flipper_wedge_macro_emit(macro, number & 0xFF) &&
+                           flipper_wedge_macro_emit(macro, number >> 8) ?
+                       NULL :
+                       "macro too long";
+        }
+        if(strcasecmp(buf, "ndef") == 0) {
+            if(!flipper_wedge_macro_parse_number(arg, 1, MACRO_NDEF_LINE_MAX, &number)) {
+                return "bad NDEF line";
+            }
+            macro->run_at = 0;
+            return flipper_wedge_macro_emit(macro, FlipperWedgeMacroOpField) &&
+                           flipper_wedge_macro_emit(macro, FlipperWedgeMacroFieldNdef) &&
+                           flipper_wedge_macro_emit(macro, number) ?
+                       NULL :
+                       "macro too long";
+        }
+        return "unknown field";
+    }
+
+    if(flipper_wedge_macro_find_name(macro_fields, COUNT_OF(macro_fields), buf, &value)) {
+        macro->run_at = 0;
+        return flipper_wedge_macro_emit(macro, FlipperWedgeMacroOpField) &&
+                       flipper_wedge_macro_emit(macro, value) && flipper_wedge_macro_emit(macro, 0) ?
+                   NULL :
+                   "macro too long";
+    }
+
+    // Chord: modifiers, then a key name or one character ("ctrl++" is Ctrl and '+')
+    uint16_t modifiers = 0;
+    char* key = buf;
+    char* plus;
+    while((plus = strchr(key + 1, '+')) && plus[1] != '\0') {
+        *plus = '\0';
+        if(!flipper_wedge_macro_find_name(macro_modifiers, COUNT_OF(macro_modifiers), key, &value)) {
+            return "unknown modifier";
+        }
+        modifiers |= value;
+        key = plus + 1;
+    }
+
+    uint16_t keycode;
+    if(key[1] == '\0' && key[0] >= ' ' && key[0] <= '~') {
+        keycode = flipper_wedge_macro_char_key(layout, key[0]);
+        if(keycode == HID_KEYBOARD_NONE) return "character not on layout";
+    } else if(key[0] == 'f' || key[0] == 'F') {
+        uint32_t number;
+        if(!flipper_wedge_macro_parse_number(key + 1, 1, 12, &number)) return "unknown key";
+        keycode = HID_KEYBOARD_F1 + number - 1;
+    } else if(!flipper_wedge_macro_find_name(macro_keys, COUNT_OF(macro_keys), key, &keycode)) {
+        return "unknown key";
+    }
+
+    return flipper_wedge_macro_emit_key(macro, keycode | modifiers) ? NULL : "macro too long";
+}
+
+bool flipper_wedge_macro_compile(FlipperWedgeMacro* macro, const char* source, FlipperWedgeKeyboardLayout* layout) {
+    furi_assert(macro);
+    furi_assert(source);
+
+    if(source != macro->source) {
+        snprintf(macro->source, sizeof(macro->source), "%s", source);
+    }
+    macro->loaded = false;
+    macro->code_len = 0;
+    macro->run_at = 0;
+    macro->delay_ms = 0;
+    macro->error[0] = '\0';
+
+    const char* error = NULL;
+    const char* p = macro->source;
+    const char* line_start = p;
+    const char* token_start = p;
+    uint32_t line = 1;
+    while(!error && *p != '\0') {
+        token_start = p;
+        if(*p == '\n') {
+            line++;
+            line_start = ++p;
+        } else if(*p == '\r') {
+            p++;
+        } else if(*p == '#' && p == line_start) {
+            while(*p != '\0' && *p != '\n') p++;
+        } else if(*p == '\\') {
+            p++;
+            if(*p == '\\' || *p == '{' || *p == '}') {
+                uint16_t keycode = flipper_wedge_macro_char_key(layout, *p);
+                if(keycode == HID_KEYBOARD_NONE) {
+                    error = "character not on layout";
+                } else if(!flipper_wedge_macro_emit_key(macro, keycode)) {
+                    error = "macro too long";
+                }
+                p++;
+            } else {
+                error = "bad escape";
+            }
+        } else if(*p == '{') {
+            const char* end = p + 1;
+            while(*end != '\0' && *end != '}' && *end != '\n') end++;
+            if(*end != '}') {
+                error = "missing }";
+            } else {
+                error = flipper_wedge_macro_compile_token(macro, p + 1, end - p - 1, layout);
+                p = end + 1;
+            }
+        } else if(*p == '}') {
+            error = "unexpected }";
+        } else if((uint8_t)*p >= 0x80) {
+            // Typed with the Unicode setting at run time
+            uint32_t code_point;
+            size_t len = flipper_wedge_utf8_decode(p, &code_point);
+            if(code_point == FLIPPER_WEDGE_UTF8_INVALID) {
+                error = "not UTF-8";
+            } else if(!flipper_wedge_macro_emit_run(macro, FlipperWedgeMacroOpText, (const uint8_t*)p, len)) {
+                error = "macro too long";
+            }
+            p += len;
+        } else if(*p == '\t' || (*p >= ' ' && *p <= '~')) {
+            uint16_t keycode = flipper_wedge_macro_char_key(layout, *p);
+            if(keycode == HID_KEYBOARD_NONE) {
+                error = "character not on layout";
+            } else if(!flipper_wedge_macro_emit_key(macro, keycode)) {
+                error = "macro too long";
+            }
+            p++;
+        } else {
+            error = "control character";
+        }
+    }
+
+    if(error) {
+        snprintf(
+            macro->error,
+            sizeof(macro->error),
+            "Line %lu col %d: %s",
+            (unsigned long)line,
+            (int)(token_start - line_start) + 1,
+            error);
+        FURI_LOG_E(TAG, "%s", macro->error);
+        macro->code_len = 0;
+    }
+
+    // emit() always leaves room for this
+    macro->code[macro->code_len++] = FlipperWedgeMacroOpEnd;
+    macro->run_at = 0;
+
+    if(!error && macro->code_len == 1) {
+        snprintf(macro->error, sizeof(macro->error), "Macro is empty");
+        FURI_LOG_E(TAG, "%s", macro->error);
+        return false;
+    }
+    if(!error) {
+        FURI_LOG_I(TAG, "Compiled macro to %zu bytes", macro->code_len);
+        macro->loaded = true;
+    }
+    return macro->loaded;
+}
+
+bool flipper_wedge_macro_load(FlipperWedgeMacro* macro, const char* path, FlipperWedgeKeyboardLayout* layout) {
+    furi_assert(macro);
+    furi_assert(path);
+
+    flipper_wedge_macro_unload(macro);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool read_ok = false;
+    if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        snprintf(macro->error, sizeof(macro->error), "Cannot open macro file");
+    } else if(storage_file_size(file) > FLIPPER_WEDGE_MACRO_SOURCE_MAX_LEN) {
+        snprintf(macro->error, sizeof(macro->error), "Macro file over %d bytes", FLIPPER_WEDGE_MACRO_SOURCE_MAX_LEN);
+    } else {
+        size_t len = storage_file_read(file, macro->source, FLIPPER_WEDGE_MACRO_SOURCE_MAX_LEN);
+        macro->source[len] = '\0';
+        if(strlen(macro->source) != len) {
+            snprintf(macro->error, sizeof(macro->error), "Macro file is not text");
+        } else {
+            read_ok = true;
+        }
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    if(!read_ok) {
+        FURI_LOG_E(TAG, "%s: %s", macro->error, path);
+        macro->source[0] = '\0';
+        return false;
+    }
+    return flipper_wedge_macro_compile(macro, macro->source, layout);
+}
+
+bool flipper_wedge_macro_set_layout(FlipperWedgeMacro* macro, FlipperWedgeKeyboardLayout* layout) {
+    furi_assert(macro);
+    if(!macro->loaded) return false;
+    return flipper_wedge_macro_compile(macro, macro->source, layout);
+}
+
+void flipper_wedge_macro_unload(FlipperWedgeMacro* macro) {
+    furi_assert(macro);
+    macro->loaded = false;
+    macro->code[0] = FlipperWedgeMacroOpEnd;
+    macro->code_len = 1;
+    macro->run_at = 0;
+    macro->delay_ms = 0;
+    macro->error[0] = '\0';
+}
+
+bool flipper_wedge_macro_is_loaded(FlipperWedgeMacro* macro) {
+    furi_assert(macro);
+    return macro->loaded;
+}
+
+const char* flipper_wedge_macro_get_error(FlipperWedgeMacro* macro) {
+    furi_assert(macro);
+    return macro->error;
+}
+
+// Line N (1-based) of the NDEF text, cut to whole characters
+static void flipper_wedge_macro_ndef_line(const char* text, uint8_t line, char* output, size_t output_size) {
+    output[0] = '\0';
+    while(--line > 0) {
+        text = strchr(text, '\n');
+        if(!text) return;
+        text++;
+    }
+
+    size_t len = strcspn(text, "\r\n");
+    if(len >= output_size) {
+        len = output_size - 1;
+        len -= flipper_wedge_utf8_tail_len(text, len);
+    }
+    memcpy(output, text, len);
+    output[len] = '\0';
+}
+
+static void flipper_wedge_macro_run_field(
+    const uint8_t* code,
+    const FlipperWedgeMacroData* data,
+    const FlipperWedgeMacroOutput* output) {
+    char buf[MACRO_FIELD_MAX_LEN];
+    const char* text = buf;
+    buf[0] = '\0';
+
+    switch(code[0]) {
+    case FlipperWedgeMacroFieldOutput:
+        text = data->output;
+        break;
+    case FlipperWedgeMacroFieldNfc:
+        if(data->nfc_uid && data->nfc_uid_len > 0) {
+            flipper_wedge_format_uid(data->nfc_uid, data->nfc_uid_len, data->delimiter, buf, sizeof(buf));
+        }
+        break;
+    case FlipperWedgeMacroFieldRfid:
+        if(data->rfid_uid && data->rfid_uid_len > 0) {
+            flipper_wedge_format_uid(data->rfid_uid, data->rfid_uid_len, data->delimiter, buf, sizeof(buf));
+        }
+        break;
+    case FlipperWedgeMacroFieldNdef:
+        if(!data->ndef_text) {
+            text = NULL;
+        } else if(code[1] == 0) {
+            text = data->ndef_text;
+        } else {
+            flipper_wedge_macro_ndef_line(data->ndef_text, code[1], buf, sizeof(buf));
+        }
+        break;
+    case FlipperWedgeMacroFieldDate:
+        if(data->datetime) {
+            snprintf(
+                buf,
+                sizeof(buf),
+                "%04d-%02d-%02d",
+                data->datetime->year,
+                data->datetime->month,
+                data->datetime->day);
+        }
+        break;
+    case FlipperWedgeMacroFieldTime:
+        if(data->datetime) {
+            snprintf(
+                buf,
+                sizeof(buf),
+                "%02d:%02d:%02d",
+                data->datetime->hour,
+                data->datetime->minute,
+                data->datetime->second);
+        }
+        break;
+    default:
+        break;
+    }
+
+    if(text && text[0] != '\0') {
+        output->text(text, output->context);
+    }
+}
+
+void flipper_wedge_macro_run(
+    FlipperWedgeMacro* macro,
+    const FlipperWedgeMacroData* data,
+    const FlipperWedgeMacroOutput* output) {
+    furi_assert(macro);
+    furi_assert(data);
+    furi_assert(output);
+
+    const uint8_t* pc = macro->code;
+    while(true) {
+        switch(*pc++) {
+        case FlipperWedgeMacroOpKeys:
+            for(uint8_t i = 0; i < pc[0]; i++) {
+                output->key(pc[1 + 2 * i] | (pc[2 + 2 * i] << 8), output->context);
+            }
+            pc += 1 + 2 * pc[0];
+            break;
+        case FlipperWedgeMacroOpText: {
+            char text[MACRO_RUN_MAX + 1];
+            memcpy(text, pc + 1, pc[0]);
+            text[pc[0]] = '\0';
+            output->text(text, output->context);
+            pc += 1 + pc[0];
+            break;
+        }
+        case FlipperWedgeMacroOpDelay:
+            output->delay(pc[0] | (pc[1] << 8), output->context);
+            pc += 2;
+            break;
+        case FlipperWedgeMacroOpField:
+            flipper_wedge_macro_run_field(pc, data, output);
+            pc += 2;
+            break;
+        case FlipperWedgeMacroOpEnd:
+        default:
+            return;
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <furi.h>
+#include <furi_hal_rtc.h>
+#include "flipper_wedge_keyboard_layout.h"
+
+// Post-scan keystroke macros
+//
+// A macro types a scan as a sequence of fields and keys instead of the
+// output followed by Enter, e.g. to fill a form from one scan:
+//   {nfc}{tab}{ndef:2}{tab}{time}{enter}
+// Line breaks in the macro file are ignored and lines starting with '#' are
+// comments. Text outside braces is typed as-is (\\, \{ and \} are escapes).
+// Keys:    {enter} {tab} {esc} {space} {backspace} {delete} {insert} {home}
+//          {end} {pgup} {pgdn} {up} {down} {left} {right} {f1} to {f12}
+// Chords:  modifiers joined to a key or character with '+', e.g. {ctrl+a},
+//          {alt+tab}, {ctrl+shift+esc}, {gui+r}. Modifiers: ctrl shift alt gui
+// Delays:  {delay:N} waits N ms, up to FLIPPER_WEDGE_MACRO_DELAY_MAX_MS in all
+// Fields:  {output}       What the scan types without a macro
+//          {nfc} {rfid}   UID with the delimiter setting
+//          {ndef}         NDEF text, {ndef:N} its line N (1-9)
+//          {date} {time}  YYYY-MM-DD and HH:MM:SS
+// A field with no value types nothing.
+//
+// The macro is checked when it is loaded and compiled into a keycode
+// program: text, keys and chords become HID keycodes for the keyboard layout,
+// so a scan runs a short loop with no parsing and no layout lookups outside
+// the fields. Errors are reported with their line and column.
+
+#define FLIPPER_WEDGE_MACRO_PATH APP_DATA_PATH("macro.txt")
+#define FLIPPER_WEDGE_MACRO_SOURCE_MAX_LEN 1024
+#define FLIPPER_WEDGE_MACRO_DELAY_MAX_MS 10000  // All delays of a macro together
+#define FLIPPER_WEDGE_MACRO_ERROR_MAX_LEN 64
+
+typedef struct FlipperWedgeMacro FlipperWedgeMacro;
+
+typedef struct {
+    const char* output;  // Formatted scan output, NULL if none
+    const uint8_t* nfc_uid;
+    uint8_t nfc_uid_len;
+    const uint8_t* rfid_uid;
+    uint8_t rfid_uid_len;
+    const char* ndef_text;  // NULL or empty if none
+    const char* delimiter;
+    const DateTime* datetime;  // Time of the scan
+} FlipperWedgeMacroData;
+
+/** Key callback: press and release one keycode (key + modifiers)
+ *
+ * @param keycode HID keycode, modifiers in the upper 8 bits
+ * @param context Callback context
+ */
+typedef void (*FlipperWedgeMacroKeyCallback)(uint16_t keycode, void* context);
+
+/** Text callback: type field text or non-ASCII literal text
+ *
+ * @param text NUL-terminated UTF-8 text
+ * @param context Callback context
+ */
+typedef void (*FlipperWedgeMacroTextCallback)(const char* text, void* context);
+
+/** Delay callback
+ *
+ * @param ms Milliseconds to wait
+ * @param context Callback context
+ */
+typedef void (*FlipperWedgeMacroDelayCallback)(uint32_t ms, void* context);
+
+typedef struct {
+    FlipperWedgeMacroKeyCallback key;
+    FlipperWedgeMacroTextCallback text;
+    FlipperWedgeMacroDelayCallback delay;
+    void* context;
+} FlipperWedgeMacroOutput;
+
+/** Allocate macro (not loaded)
+ *
+ * @return FlipperWedgeMacro instance
+ */
+FlipperWedgeMacro* flipper_wedge_macro_alloc(void);
+
+/** Free macro
+ *
+ * @param macro FlipperWedgeMacro instance
+ */
+void flipper_wedge_macro_free(FlipperWedgeMacro* macro);
+
+/** Read and compile a macro file
+ *
+ * @param macro FlipperWedgeMacro instance
+ * @param path Macro file
+ * @param layout Keyboard layout for text and chords (NULL for US QWERTY)
+ * @return true if the macro is ready, see flipper_wedge_macro_get_error() otherwise
+ */
+bool flipper_wedge_macro_load(FlipperWedgeMacro* macro, const char* path, FlipperWedgeKeyboardLayout* layout);
+
+/** Compile macro source
+ *
+ * @param macro FlipperWedgeMacro instance
+ * @param source Macro text, as in the macro file
+ * @param layout Keyboard layout for text and chords (NULL for US QWERTY)
+ * @return true if the macro is ready, see flipper_wedge_macro_get_error() otherwise
+ */
+bool flipper_wedge_macro_compile(FlipperWedgeMacro* macro, const char* source, FlipperWedgeKeyboardLayout* layout);
+
+/** Compile the loaded macro again for another keyboard layout
+ * Call whenever the layout is changed or reloaded.
+ *
+ * @param macro FlipperWedgeMacro instance
+ * @param layout Keyboard layout (NULL for US QWERTY)
+ * @return true if the macro is still ready
+ */
+bool flipper_wedge_macro_set_layout(FlipperWedgeMacro* macro, FlipperWedgeKeyboardLayout* layout);
+
+/** Drop the macro
+ *
+ * @param macro FlipperWedgeMacro instance
+ */
+void flipper_wedge_macro_unload(FlipperWedgeMacro* macro);
+
+/** Check if a macro is loaded
+ *
+ * @param macro FlipperWedgeMacro instance
+ * @return true if flipper_wedge_macro_run() should be used for output
+ */
+bool flipper_wedge_macro_is_loaded(FlipperWedgeMacro* macro);
+
+/** Get the reason the last load or compile failed
+ *
+ * @param macro FlipperWedgeMacro instance
+ * @return Message with line and column, empty if it did not fail
+ */
+const char* flipper_wedge_macro_get_error(FlipperWedgeMacro* macro);
+
+/** Type one scan with the compiled macro
+ *
+ * @param macro FlipperWedgeMacro instance
+ * @param data Scan data
+ * @param output Key, text and delay callbacks
+ */
+void flipper_wedge_macro_run(
+    FlipperWedgeMacro* macro,
+    const FlipperWedgeMacroData* data,
+    const FlipperWedgeMacroOutput* output);
@@ -0,0 +1,302 @@
+#include "flipper_wedge_ndef_stream.h"
+
+#define NDEF_TLV_NULL 0x00
+#define NDEF_TLV_MESSAGE 0x03
+#define NDEF_TLV_TERMINATOR 0xFE
+#define NDEF_TLV_LONG_LENGTH 0xFF
+
+#define NDEF_FLAG_MB_ME_MESSAGE_END 0x40
+#define NDEF_FLAG_SHORT_RECORD 0x10
+#define NDEF_FLAG_ID_LENGTH 0x08
+#define NDEF_TNF_MASK 0x07
+#define NDEF_TNF_WELL_KNOWN 0x01
+
+#define NDEF_TEXT_LANG_LEN_MASK 0x3F
+
+typedef enum {
+    // TLV layer (Type 2/5 only)
+    FlipperWedgeNdefStreamStateTlvType,
+    FlipperWedgeNdefStreamStateTlvLength,
+    FlipperWedgeNdefStreamStateTlvLengthHigh,
+    FlipperWedgeNdefStreamStateTlvLengthLow,
+    FlipperWedgeNdefStreamStateTlvSkip,
+    // Record layer, everything from here on is inside the NDEF message
+    FlipperWedgeNdefStreamStateRecordHeader,
+    FlipperWedgeNdefStreamStateTypeLength,
+    FlipperWedgeNdefStreamStatePayloadLength,
+    FlipperWedgeNdefStreamStateIdLength,
+    FlipperWedgeNdefStreamStateType,
+    FlipperWedgeNdefStreamStateId,
+    FlipperWedgeNdefStreamStateTextStatus,
+    FlipperWedgeNdefStreamStateTextLanguage,
+    FlipperWedgeNdefStreamStateText,
+    FlipperWedgeNdefStreamStatePayloadSkip,
+    FlipperWedgeNdefStreamStateDone,
+} FlipperWedgeNdefStreamState;
+
+struct FlipperWedgeNdefStream {
+    FlipperWedgeNdefStreamState state;
+    bool tlv_wrapped;
+
+    // TLV layer
+    uint8_t tlv_type;
+    uint32_t tlv_remaining;  // Bytes left in the current TLV value
+
+    // Current record
+    uint8_t flags;
+    uint8_t type_len;
+    uint8_t id_len;
+    uint32_t payload_len;
+    uint32_t remaining;       // Bytes left in the current field (payload for text states)
+    uint32_t lang_remaining;  // Language code bytes left in a text payload
+    bool is_text;
+
+    size_t text_len;
+    FlipperWedgeNdefStreamTextCallback callback;
+    void* context;
+};
+
+FlipperWedgeNdefStream* flipper_wedge_ndef_stream_alloc(void) {
+    FlipperWedgeNdefStream* stream = malloc(sizeof(FlipperWedgeNdefStream));
+    flipper_wedge_ndef_stream_reset(stream, false, NULL, NULL);
+    return stream;
+}
+
+void flipper_wedge_ndef_stream_free(FlipperWedgeNdefStream* stream) {
+    furi_assert(stream);
+    free(stream);
+}
+
+void flipper_wedge_ndef_stream_reset(
+    FlipperWedgeNdefStream* stream,
+    bool tlv_wrapped,
+    FlipperWedgeNdefStreamTextCallback callback,
+    void* context) {
+    furi_assert(stream);
+
+    memset(stream, 0, sizeof(FlipperWedgeNdefStream));
+    stream->tlv_wrapped = tlv_wrapped;
+    stream->state = tlv_wrapped ? FlipperWedgeNdefStreamStateTlvType :
+                                  FlipperWedgeNdefStreamStateRecordHeader;
+    stream->callback = callback;
+    stream->context = context;
+}
+
+static void flipper_wedge_ndef_stream_end_record(FlipperWedgeNdefStream* stream) {
+    if(stream->flags & NDEF_FLAG_MB_ME_MESSAGE_END) {
+        stream->state = FlipperWedgeNdefStreamStateDone;
+    } else {
+        stream->state = FlipperWedgeNdefStreamStateRecordHeader;
+    }
+}
+
+static void flipper_wedge_ndef_stream_start_payload(FlipperWedgeNdefStream* stream) {
+    stream->remaining = stream->payload_len;
+    if(stream->is_text && stream->payload_len > 1) {
+        stream->state = FlipperWedgeNdefStreamStateTextStatus;
+    } else if(stream->payload_len > 0) {
+        stream->state = FlipperWedgeNdefStreamStatePayloadSkip;
+    } else {
+        flipper_wedge_ndef_stream_end_record(stream);
+    }
+}
+
+static void flipper_wedge_ndef_stream_start_id(FlipperWedgeNdefStream* stream) {
+    stream->remaining = stream->id_len;
+    if(stream->remaining > 0) {
+        stream->state = FlipperWedgeNdefStreamStateId;
+    } else {
+        flipper_wedge_ndef_stream_start_payload(stream);
+    }
+}
+
+static void flipper_wedge_ndef_stream_start_type(FlipperWedgeNdefStream* stream) {
+    // Only a well-known record with the one-byte type "T" can be text
+    stream->is_text = ((stream->flags & NDEF_TNF_MASK) == NDEF_TNF_WELL_KNOWN) &&
+                      (stream->type_len == 1);
+    stream->remaining = stream->type_len;
+    if(stream->remaining > 0) {
+        stream->state = FlipperWedgeNdefStreamStateType;
+    } else {
+        flipper_wedge_ndef_stream_start_id(stream);
+    }
+}
+
+static void flipper_wedge_ndef_stream_start_tlv_value(FlipperWedgeNdefStream* stream) {
+    if(stream->tlv_remaining == 0) {
+        stream->state = FlipperWedgeNdefStreamStateTlvType;
+    } else if(stream->tlv_type == NDEF_TLV_MESSAGE) {
+        stream->state = FlipperWedgeNdefStreamStateRecordHeader;
+    } else {
+        stream->state = FlipperWedgeNdefStreamStateTlvSkip;
+    }
+}
+
+// Consume bytes for the current state, returns how many were used (at least 1)
+static size_t flipper_wedge_ndef_stream_step(
+    FlipperWedgeNdefStream* stream,
+    const uint8_t* data,
+    size_t len) {
+    uint8_t byte = data[0];
+    size_t used = 1;
+
+    switch(stream->state) {
+    case FlipperWedgeNdefStreamStateTlvType:
+        if(byte == NDEF_TLV_TERMINATOR) {
+            stream->state = FlipperWedgeNdefStreamStateDone;
+        } else if(byte != NDEF_TLV_NULL) {
+            stream->tlv_type = byte;
+            stream->state = FlipperWedgeNdefStreamStateTlvLength;
+        }
+        break;
+    case FlipperWedgeNdefStreamStateTlvLength:
+        if(byte == NDEF_TLV_LONG_LENGTH) {
+            stream->state = FlipperWedgeNdefStreamStateTlvLengthHigh;
+        } else {
+            stream->tlv_remaining = byte;
+            flipper_wedge_ndef_stream_start_tlv_value(stream);
+        }
+        break;
+    case FlipperWedgeNdefStreamStateTlvLengthHigh:
+        stream->tlv_remaining = (uint32_t)byte << 8;
+        stream->state = FlipperWedgeNdefStreamStateTlvLengthLow;
+        break;
+    case FlipperWedgeNdefStreamStateTlvLengthLow:
+        stream->tlv_remaining |= byte;
+        flipper_wedge_ndef_stream_start_tlv_value(stream);
+        break;
+    case FlipperWedgeNdefStreamStateTlvSkip:
+        used = MIN(len, stream->tlv_remaining);
+        stream->tlv_remaining -= used;
+        if(stream->tlv_remaining == 0) {
+            stream->state = FlipperWedgeNdefStreamStateTlvType;
+        }
+        break;
+
+    case FlipperWedgeNdefStreamStateRecordHeader:
+        stream->flags = byte;
+        stream->state = FlipperWedgeNdefStreamStateTypeLength;
+        break;
+    case FlipperWedgeNdefStreamStateTypeLength:
+        stream->type_len = byte;
+        stream->payload_len = 0;
+        stream->remaining = (stream->flags & NDEF_FLAG_SHORT_RECORD) ? 1 : 4;
+        stream->state = FlipperWedgeNdefStreamStatePayloadLength;
+        break;
+    case FlipperWedgeNdefStreamStatePayloadLength:
+        stream->payload_len = (stream->payload_len << 8) | byte;
+        if(--stream->remaining == 0) {
+            if(stream->flags & NDEF_FLAG_ID_LENGTH) {
+                stream->state = FlipperWedgeNdefStreamStateIdLength;
+            } else {
+                stream->id_len = 0;
+                flipper_wedge_ndef_stream_start_type(stream);
+            }
+        }
+        break;
+    case FlipperWedgeNdefStreamStateIdLength:
+        stream->id_len = byte;
+        flipper_wedge_ndef_stream_start_type(stream);
+        break;
+    case FlipperWedgeNdefStreamStateType:
+        used = MIN(len, stream->remaining);
+        if(stream->is_text && byte != 'T') {
+            stream->is_text = false;
+        }
+        stream->remaining -= used;
+        if(stream->remaining == 0) {
+            flipper_wedge_ndef_stream_start_id(stream);
+        }
+        break;
+    case FlipperWedgeNdefStreamStateId:
+        used = MIN(len, stream->remaining);
+        stream->remaining -= used;
+        if(stream->remaining == 0) {
+            flipper_wedge_ndef_stream_start_payload(stream);
+        }
+        break;
+
+    case FlipperWedgeNdefStreamStateTextStatus:
+        // Text record payload: [status byte][language code][text]
+        stream->remaining--;
+        stream->lang_remaining = byte & NDEF_TEXT_LANG_LEN_MASK;
+        if(stream->lang_remaining > stream->remaining) {
+            // Malformed language length, skip the record
+            stream->state = FlipperWedgeNdefStreamStatePayloadSkip;
+        } else if(stream->lang_remaining > 0) {
+            stream->state = FlipperWedgeNdefStreamStateTextLanguage;
+        } else {
+            stream->state = FlipperWedgeNdefStreamStateText;
+        }
+        if(stream->remaining == 0) {
+            flipper_wedge_ndef_stream_end_record(stream);
+        }
+        break;
+    case FlipperWedgeNdefStreamStateTextLanguage:
+        used = MIN(len, stream->lang_remaining);
+        stream->lang_remaining -= used;
+        stream->remaining -= used;
+        if(stream->remaining == 0) {
+            flipper_wedge_ndef_stream_end_record(stream);
+        } else if(stream->lang_remaining == 0) {
+            stream->state = FlipperWedgeNdefStreamStateText;
+        }
+        break;
+    case FlipperWedgeNdefStreamStateText:
+        used = MIN(len, stream->remaining);
+        stream->remaining -= used;
+        stream->text_len += used;
+        if(stream->callback) {
+            stream->callback(data, used, stream->context);
+        }
+        if(stream->remaining == 0) {
+            flipper_wedge_ndef_stream_end_record(stream);
+        }
+        break;
+    case FlipperWedgeNdefStreamStatePayloadSkip:
+        used = MIN(len, stream->remaining);
+        stream->remaining -= used;
+        if(stream->remaining == 0) {
+            flipper_wedge_ndef_stream_end_record(stream);
+        }
+        break;
+
+    case FlipperWedgeNdefStreamStateDone:
+        break;
+    }
+
+    return used;
+}
+
+bool flipper_wedge_ndef_stream_feed(FlipperWedgeNdefStream* stream, const uint8_t* data, size_t len) {
+    furi_assert(stream);
+
+    size_t pos = 0;
+    while(pos < len && stream->state != FlipperWedgeNdefStreamStateDone) {
+        // Inside a TLV the NDEF message ends with the TLV value
+        bool in_message = stream->tlv_wrapped &&
+                          stream->state >= FlipperWedgeNdefStreamStateRecordHeader;
+        size_t avail = len - pos;
+        if(in_message) {
+            avail = MIN(avail, stream->tlv_remaining);
+        }
+
+        size_t used = flipper_wedge_ndef_stream_step(stream, &data[pos], avail);
+        pos += used;
+
+        if(in_message) {
+            stream->tlv_remaining -= used;
+            if(stream->tlv_remaining == 0) {
+                // Only the first NDEF message is parsed
+                stream->state = FlipperWedgeNdefStreamStateDone;
+            }
+        }
+    }
+
+    return stream->state != FlipperWedgeNdefStreamStateDone;
+}
+
+size_t flipper_wedge_ndef_stream_get_text_len(FlipperWedgeNdefStream* stream) {
+    furi_assert(stream);
+    return stream->text_len;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <furi.h>
+
+// Incremental NDEF text record parser
+//
+// Bytes are fed in whatever pieces the tag read produces (APDU responses,
+// memory blocks) and the text of every Text record (TNF 0x01, type "T") is
+// handed to a callback as soon as it arrives, without the language code.
+// The parser keeps only record header state, so memory use does not depend
+// on the message size. Text runs are passed as pointers into the fed data.
+
+typedef struct FlipperWedgeNdefStream FlipperWedgeNdefStream;
+
+/** Text callback
+ *
+ * @param text Text bytes (not NUL-terminated)
+ * @param len Number of bytes
+ * @param context Callback context
+ */
+typedef void (*FlipperWedgeNdefStreamTextCallback)(const uint8_t* text, size_t len, void* context);
+
+/** Allocate parser
+ *
+ * @return FlipperWedgeNdefStream instance
+ */
+FlipperWedgeNdefStream* flipper_wedge_ndef_stream_alloc(void);
+
+/** Free parser
+ *
+ * @param stream FlipperWedgeNdefStream instance
+ */
+void flipper_wedge_ndef_stream_free(FlipperWedgeNdefStream* stream);
+
+/** Start parsing a new message
+ *
+ * @param stream FlipperWedgeNdefStream instance
+ * @param tlv_wrapped true for Type 2/5 memory (NDEF Message TLV), false for raw records (Type 4)
+ * @param callback Text callback
+ * @param context Callback context
+ */
+void flipper_wedge_ndef_stream_reset(
+    FlipperWedgeNdefStream* stream,
+    bool tlv_wrapped,
+    FlipperWedgeNdefStreamTextCallback callback,
+    void* context);
+
+/** Feed the next piece of the message
+ *
+ * @param stream FlipperWedgeNdefStream instance
+ * @param data Message bytes
+ * @param len Number of bytes
+ * @return true if more input is expected, false once the message has ended
+ */
+bool flipper_wedge_ndef_stream_feed(FlipperWedgeNdefStream* stream, const uint8_t* data, size_t len);
+
+/** Get the number of text bytes delivered since the last reset
+ *
+ * @param stream FlipperWedgeNdefStream instance
+ * @return Text length in bytes
+ */
+size_t flipper_wedge_ndef_stream_get_text_len(FlipperWedgeNdefStream* stream);
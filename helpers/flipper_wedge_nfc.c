@@ -1,4 +1,8 @@
 #include "flipper_wedge_nfc.h"
+#include "flipper_wedge_debug.h"
+#include "flipper_wedge_ndef_stream.h"
+#include "flipper_wedge_format.h"
+#include "flipper_wedge_iso15693.h"
 #include <furi_hal.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a_poller.h>
 #include <nfc/protocols/iso14443_4a/iso14443_4a.h>
@@ -7,6 +11,8 @@
 #include <nfc/protocols/mf_ultralight/mf_ultralight_poller.h>
 #include <nfc/protocols/iso15693_3/iso15693_3.h>
 #include <nfc/protocols/iso15693_3/iso15693_3_poller.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#include <nfc/protocols/mf_classic/mf_classic_poller.h>
 #include <toolbox/simple_array.h>
 #include <toolbox/bit_buffer.h>
 
@@ -26,6 +32,16 @@ static const uint8_t NDEF_T4_AID[NDEF_T4_AID_LEN] = {
 #define NDEF_T4_RETRY_DELAY_MS 15      // Delay between retries in milliseconds
 
 // APDU status codes
+// ISO15693 Inventory request (single slot, high data rate)
+#define ISO15693_INVENTORY_FLAGS 0x26  // Data rate + Inventory + 1 slot
+#define ISO15693_CMD_INVENTORY 0x01
+#define ISO15693_INVENTORY_RESP_LEN 10  // Flags, DSFID, UID (without CRC)
+#define ISO15693_RESP_FLAG_ERROR 0x01
+#define ISO15693_FWT_FC 4202U          // Response wait time (~310 us)
+
+// MIFARE Classic sector read
+#define CLASSIC_SECTOR_DATA_MAX (15 * MF_CLASSIC_BLOCK_SIZE)  // Data blocks of a 4K large sector
+
 #define APDU_SW1_SUCCESS 0x90
 #define APDU_SW2_SUCCESS 0x00
 
@@ -45,241 +61,194 @@ struct FlipperWedgeNfc {
 
     FlipperWedgeNfcState state;
     bool parse_ndef;
+    bool inventory;  // Read all ISO14443-3A tags in the field
+    bool presence;   // Continuous ISO15693 inventory rounds
+
+    // MIFARE Classic sector read (poller thread walks the keys, tick saves the cache)
+    FlipperWedgeClassicKeys* classic_keys;  // NULL: Classic tags are read as ISO14443-3A
+    uint8_t classic_sector;
+    FlipperWedgeClassicWalk classic_walk;
+    FlipperWedgeClassicKey classic_key;  // Key of the last sector read request
+    uint32_t classic_start_tick;
+    uint16_t classic_attempts;
+
+    // ISO15693 presence (poller thread produces UIDs, flipper_wedge_nfc_presence_next() consumes)
+    FuriMessageQueue* presence_queue;  // uint64_t UIDs
+    BitBuffer* presence_tx;
+    BitBuffer* presence_rx;
     NfcProtocol detected_protocol;
 
     FlipperWedgeNfcCallback callback;
     void* callback_context;
+    FlipperWedgeLatency* latency;  // Detect, poller start and read complete stamps (can be NULL)
 
     FlipperWedgeNfcData last_data;
+    FlipperWedgeScanBufferPool* ndef_pool;
+    FlipperWedgeNdefStream* ndef_parser;
+    size_t ndef_fill;  // Text bytes in last_data.ndef
+
+    // NDEF text streaming (poller thread produces, flipper_wedge_nfc_stream_next() consumes)
+    bool stream_ndef;
+    bool stream_active;  // Current read delivers text through the stream
+    bool stream_sent;    // At least one chunk was queued for the current read
+    volatile bool stream_cancel;
+    FlipperWedgeScanBufferPool* stream_pool;
+    FuriMessageQueue* stream_queue;  // FlipperWedgeScanBuffer*, NULL marks the end of the text
+    FlipperWedgeScanBuffer* stream_chunk;
+    size_t stream_chunk_len;
+    char stream_carry[4];  // Start of a UTF-8 character cut off by a full chunk
+    size_t stream_carry_len;
 
     // Thread-safe signaling
     FuriThreadId owner_thread;
 };
 
-// Simple NDEF text record parser
-// Returns number of bytes written to output, 0 if no text records found
-// Parse raw NDEF records (for Type 4 tags - no TLV wrapping)
-static size_t flipper_wedge_nfc_parse_raw_ndef_text(const uint8_t* data, size_t data_len, char* output, size_t output_max) {
-    if(!data || !output || data_len < 4 || output_max == 0) {
-        return 0;
-    }
-
-    size_t output_pos = 0;
-    size_t pos = 0;
-
-    // Parse NDEF message records directly (no TLV wrapper)
-    while(pos < data_len) {
-        // Read record header
-        if(pos + 1 > data_len) break;
-        uint8_t flags_tnf = data[pos++];
-
-        uint8_t tnf = flags_tnf & 0x07;
-        bool short_record = (flags_tnf & 0x10) != 0;
-        bool id_length_present = (flags_tnf & 0x08) != 0;
-        bool message_end = (flags_tnf & 0x40) != 0;
-
-        // Read type length
-        if(pos >= data_len) break;
-        uint8_t type_len = data[pos++];
-
-        // Read payload length
-        if(pos >= data_len) break;
-        uint32_t payload_len;
-        if(short_record) {
-            payload_len = data[pos++];
-        } else {
-            if(pos + 4 > data_len) break;
-            payload_len = (data[pos] << 24) | (data[pos + 1] << 16) |
-                         (data[pos + 2] << 8) | data[pos + 3];
-            pos += 4;
-        }
-
-        // Read ID length if present
-        uint8_t id_len = 0;
-        if(id_length_present) {
-            if(pos >= data_len) break;
-            id_len = data[pos++];
-        }
-
-        // Read type
-        if(pos + type_len > data_len) break;
-        const uint8_t* type = &data[pos];
-        pos += type_len;
-
-        // Skip ID
-        if(pos + id_len > data_len) break;
-        pos += id_len;
-
-        // Read payload
-        if(pos + payload_len > data_len) break;
-        const uint8_t* payload = &data[pos];
-        pos += payload_len;
+// Drop the NDEF result of the previous read
+static void flipper_wedge_nfc_clear_ndef(FlipperWedgeNfc* instance) {
+    flipper_wedge_scan_buffer_unref(instance->last_data.ndef);
+    instance->last_data.ndef = NULL;
+    instance->last_data.has_ndef = false;
+    instance->last_data.ndef_streamed = false;
+}
 
-        // Check if this is a text record (TNF=0x01, Type='T')
-        if(tnf == 0x01 && type_len == 1 && type[0] == 'T' && payload_len > 1) {
-            FURI_LOG_I(TAG, "Type 4 NDEF: Found text record in raw NDEF");
+// Poller thread: the read is done, the next tick hands the result to the callback
+static void flipper_wedge_nfc_set_success(FlipperWedgeNfc* instance) {
+    flipper_wedge_latency_mark(instance->latency, FlipperWedgeLatencyStageReadComplete);
+    instance->state = FlipperWedgeNfcStateSuccess;
+}
 
-            // Text record format: [status byte][language code][text]
-            uint8_t status = payload[0];
-            uint8_t lang_len = status & 0x3F;
+// Hand a finished stream chunk to the consumer
+static void flipper_wedge_nfc_stream_flush(FlipperWedgeNfc* instance) {
+    if(!instance->stream_chunk) return;
 
-            FURI_LOG_I(TAG, "Type 4 NDEF: Status=0x%02X, lang_len=%d, payload_len=%lu",
-                       status, lang_len, payload_len);
+    if(furi_message_queue_put(instance->stream_queue, &instance->stream_chunk, 0) == FuriStatusOk) {
+        instance->stream_sent = true;
+    } else {
+        FURI_LOG_W(TAG, "NDEF stream: queue full, dropping chunk");
+        flipper_wedge_scan_buffer_unref(instance->stream_chunk);
+    }
+    instance->stream_chunk = NULL;
+}
 
-            if((uint32_t)(lang_len + 1) <= payload_len) {
-                // Skip language code, extract text
-                const uint8_t* text = &payload[1 + lang_len];
-                size_t text_len = payload_len - 1 - lang_len;
+// Text sink for the NDEF parser: appends to the scan buffer, or in stream
+// mode fills fixed-size chunks and queues each one as soon as it is full
+static void flipper_wedge_nfc_ndef_text_callback(const uint8_t* text, size_t len, void* context) {
+    FlipperWedgeNfc* instance = context;
 
-                FURI_LOG_I(TAG, "Type 4 NDEF: Text length=%zu", text_len);
+    if(!instance->stream_active) {
+        if(!instance->last_data.ndef) return;
+        char* output = flipper_wedge_scan_buffer_data(instance->last_data.ndef);
+        size_t room = flipper_wedge_scan_buffer_capacity(instance->last_data.ndef) - 1 - instance->ndef_fill;
+        size_t copy_len = MIN(len, room);
+        memcpy(&output[instance->ndef_fill], text, copy_len);
+        instance->ndef_fill += copy_len;
+        output[instance->ndef_fill] = '\0';
+        return;
+    }
 
-                // Copy text to output
-                size_t copy_len = text_len;
-                if(output_pos + copy_len >= output_max) {
-                    copy_len = output_max - output_pos - 1;
-                }
-                if(copy_len > 0) {
-                    memcpy(&output[output_pos], text, copy_len);
-                    output_pos += copy_len;
-                }
+    while(len > 0 && !instance->stream_cancel) {
+        if(!instance->stream_chunk) {
+            // Blocks while the consumer is still typing earlier chunks
+            instance->stream_chunk = flipper_wedge_scan_buffer_acquire_timeout(
+                instance->stream_pool, FLIPPER_WEDGE_NDEF_STREAM_WAIT_MS);
+            if(!instance->stream_chunk) {
+                FURI_LOG_W(TAG, "NDEF stream: consumer stalled, dropping remaining text");
+                instance->stream_cancel = true;
+                break;
             }
+            // A character never spans two chunks, they are typed separately
+            char* start = flipper_wedge_scan_buffer_data(instance->stream_chunk);
+            memcpy(start, instance->stream_carry, instance->stream_carry_len);
+            instance->stream_chunk_len = instance->stream_carry_len;
+            start[instance->stream_chunk_len] = '\0';
+            instance->stream_carry_len = 0;
         }
 
-        // Stop if this was the last record
-        if(message_end) break;
+        char* chunk = flipper_wedge_scan_buffer_data(instance->stream_chunk);
+        size_t room = FLIPPER_WEDGE_NDEF_STREAM_CHUNK_LEN - 1 - instance->stream_chunk_len;
+        size_t copy_len = MIN(len, room);
+        memcpy(&chunk[instance->stream_chunk_len], text, copy_len);
+        instance->stream_chunk_len += copy_len;
+        chunk[instance->stream_chunk_len] = '\0';
+        text += copy_len;
+        len -= copy_len;
+
+        if(instance->stream_chunk_len == FLIPPER_WEDGE_NDEF_STREAM_CHUNK_LEN - 1) {
+            size_t tail = flipper_wedge_utf8_tail_len(chunk, instance->stream_chunk_len);
+            instance->stream_chunk_len -= tail;
+            memcpy(instance->stream_carry, &chunk[instance->stream_chunk_len], tail);
+            instance->stream_carry_len = tail;
+            chunk[instance->stream_chunk_len] = '\0';
+            flipper_wedge_nfc_stream_flush(instance);
+        }
     }
+}
 
-    // Null-terminate
-    if(output_pos < output_max) {
-        output[output_pos] = '\0';
-    } else if(output_max > 0) {
-        output[output_max - 1] = '\0';
+// Start collecting NDEF text for the current tag
+// Returns false, with FlipperWedgeNfcErrorBusy set, if there is nowhere to put the text
+static bool flipper_wedge_nfc_ndef_begin(FlipperWedgeNfc* instance, bool tlv_wrapped) {
+    flipper_wedge_nfc_clear_ndef(instance);
+    flipper_wedge_ndef_stream_reset(
+        instance->ndef_parser, tlv_wrapped, flipper_wedge_nfc_ndef_text_callback, instance);
+
+    instance->stream_active = instance->stream_ndef && instance->parse_ndef;
+    instance->stream_sent = false;
+    instance->stream_carry_len = 0;
+    if(!instance->stream_active) {
+        instance->last_data.ndef = flipper_wedge_scan_buffer_acquire(instance->ndef_pool);
+        if(!instance->last_data.ndef) {
+            // Queued reads hold the buffers until the scene has output them
+            FURI_LOG_W(TAG, "No free NDEF buffer, text of this read dropped");
+            instance->last_data.error = FlipperWedgeNfcErrorBusy;
+            return false;
+        }
+        instance->ndef_fill = 0;
     }
-
-    FURI_LOG_I(TAG, "Type 4 NDEF: Parsed %zu bytes of text", output_pos);
-    return output_pos;
+    return true;
 }
 
-// Parse TLV-wrapped NDEF records (for Type 2/5 tags)
-static size_t flipper_wedge_nfc_parse_ndef_text(const uint8_t* data, size_t data_len, char* output, size_t output_max) {
-    if(!data || !output || data_len < 4 || output_max == 0) {
-        return 0;
+// Feed the next piece of the NDEF message
+// Returns false once no more input is wanted (message ended, buffer full or stream cancelled)
+static bool flipper_wedge_nfc_ndef_feed(FlipperWedgeNfc* instance, const uint8_t* data, size_t len) {
+    if(instance->stream_cancel) return false;
+    if(!instance->stream_active &&
+       instance->ndef_fill + 1 >= flipper_wedge_scan_buffer_capacity(instance->last_data.ndef)) {
+        return false;
     }
+    return flipper_wedge_ndef_stream_feed(instance->ndef_parser, data, len) &&
+           !instance->stream_cancel;
+}
 
-    size_t output_pos = 0;
-    size_t pos = 0;
-
-    // Look for NDEF Message TLV (Type=0x03)
-    while(pos < data_len - 1) {
-        uint8_t tlv_type = data[pos++];
-
-        // Skip padding
-        if(tlv_type == 0x00) continue;
-
-        // Terminator found
-        if(tlv_type == 0xFE) break;
-
-        // Get length
-        if(pos >= data_len) break;
-        uint32_t tlv_len = data[pos++];
-        if(tlv_len == 0xFF) {
-            // 3-byte length
-            if(pos + 2 > data_len) break;
-            tlv_len = (data[pos] << 8) | data[pos + 1];
-            pos += 2;
-        }
-
-        // Check if this is an NDEF message
-        if(tlv_type == 0x03 && tlv_len > 0 && pos + tlv_len <= data_len) {
-            // Parse NDEF message records
-            size_t msg_end = pos + tlv_len;
-
-            while(pos < msg_end && pos < data_len) {
-                // Read record header
-                if(pos + 1 > data_len) break;
-                uint8_t flags_tnf = data[pos++];
-
-                uint8_t tnf = flags_tnf & 0x07;
-                bool short_record = (flags_tnf & 0x10) != 0;
-                bool id_length_present = (flags_tnf & 0x08) != 0;
-
-                // Read type length
-                if(pos >= data_len) break;
-                uint8_t type_len = data[pos++];
-
-                // Read payload length
-                if(pos >= data_len) break;
-                uint32_t payload_len;
-                if(short_record) {
-                    payload_len = data[pos++];
-                } else {
-                    if(pos + 4 > data_len) break;
-                    payload_len = (data[pos] << 24) | (data[pos + 1] << 16) |
-                                 (data[pos + 2] << 8) | data[pos + 3];
-                    pos += 4;
-                }
-
-                // Read ID length if present
-                uint8_t id_len = 0;
-                if(id_length_present) {
-                    if(pos >= data_len) break;
-                    id_len = data[pos++];
-                }
-
-                // Read type
-                if(pos + type_len > data_len) break;
-                const uint8_t* type = &data[pos];
-                pos += type_len;
-
-                // Skip ID
-                if(pos + id_len > data_len) break;
-                pos += id_len;
-
-                // Read payload
-                if(pos + payload_len > data_len) break;
-                const uint8_t* payload = &data[pos];
-                pos += payload_len;
-
-                // Check if this is a text record (TNF=0x01, Type='T')
-                if(tnf == 0x01 && type_len == 1 && type[0] == 'T' && payload_len > 1) {
-                    // Text record format: [status byte][language code][text]
-                    uint8_t status = payload[0];
-                    uint8_t lang_len = status & 0x3F;
-
-                    if((uint32_t)(lang_len + 1) <= payload_len) {
-                        // Skip language code, extract text
-                        const uint8_t* text = &payload[1 + lang_len];
-                        size_t text_len = payload_len - 1 - lang_len;
-
-                        // Copy text to output
-                        size_t copy_len = text_len;
-                        if(output_pos + copy_len >= output_max) {
-                            copy_len = output_max - output_pos - 1;
-                        }
-                        if(copy_len > 0) {
-                            memcpy(&output[output_pos], text, copy_len);
-                            output_pos += copy_len;
-                        }
-                    }
-                }
-            }
-
-            // Found and processed NDEF message, stop searching
-            break;
-        } else {
-            // Skip this TLV
-            pos += tlv_len;
+// Finish the NDEF text of the current tag and record the result in last_data
+// Returns true if any text was found
+static bool flipper_wedge_nfc_ndef_end(FlipperWedgeNfc* instance) {
+    size_t text_len = flipper_wedge_ndef_stream_get_text_len(instance->ndef_parser);
+
+    if(instance->stream_active) {
+        flipper_wedge_nfc_stream_flush(instance);
+        if(instance->stream_sent) {
+            // End of text marker
+            FlipperWedgeScanBuffer* end = NULL;
+            furi_message_queue_put(instance->stream_queue, &end, 0);
         }
+        instance->stream_active = false;
+        instance->last_data.ndef_streamed = (text_len > 0);
+        FURI_LOG_I(TAG, "NDEF stream: %zu bytes of text", text_len);
+    } else if(text_len == 0) {
+        flipper_wedge_scan_buffer_unref(instance->last_data.ndef);
+        instance->last_data.ndef = NULL;
     }
 
-    // Null-terminate
-    if(output_pos < output_max) {
-        output[output_pos] = '\0';
-    } else if(output_max > 0) {
-        output[output_max - 1] = '\0';
-    }
+    instance->last_data.has_ndef = (text_len > 0);
+    return instance->last_data.has_ndef;
+}
 
-    return output_pos;
+// Return queued stream chunks to the pool
+static void flipper_wedge_nfc_stream_drain(FlipperWedgeNfc* instance) {
+    FlipperWedgeScanBuffer* chunk = NULL;
+    while(furi_message_queue_get(instance->stream_queue, &chunk, 0) == FuriStatusOk) {
+        flipper_wedge_scan_buffer_unref(chunk);
+    }
 }
 
 // Type 4 NDEF APDU Helper Functions
@@ -334,9 +303,8 @@ static void flipper_wedge_nfc_t4_build_read_binary_apdu(
 }
 
 // Read Type 4 NDEF data from ISO14443-4A tag
-static bool flipper_wedge_nfc_read_type4_ndef(
-    Iso14443_4aPoller* poller,
-    FlipperWedgeNfcData* data) {
+static bool flipper_wedge_nfc_read_type4_ndef(FlipperWedgeNfc* instance, Iso14443_4aPoller* poller) {
+    FlipperWedgeNfcData* data = &instance->last_data;
 
     BitBuffer* tx_buffer = bit_buffer_alloc(256);
     BitBuffer* rx_buffer = bit_buffer_alloc(256);
@@ -485,17 +453,16 @@ static bool flipper_wedge_nfc_read_type4_ndef(
             break;
         }
 
-        // Limit NDEF read to reasonable size (increased from 240 to support large text records)
-        if(ndef_len > 1024) {
-            FURI_LOG_W(TAG, "Type 4 NDEF: NDEF too large (%d bytes), limiting to 1024", ndef_len);
-            ndef_len = 1024;
-        }
-
         FURI_LOG_D(TAG, "Type 4 NDEF: NDEF length = %d bytes", ndef_len);
 
+        // Records are parsed as each response arrives, so text reaches the
+        // scan buffer (or the stream) without holding the raw message
+        if(!flipper_wedge_nfc_ndef_begin(instance, false)) {
+            break;
+        }
+
         // Step 6: READ NDEF Message data (skip 2-byte length prefix)
         // Read in chunks if needed (most tags support up to 128-250 bytes per read)
-        uint8_t ndef_data[1024];
         uint16_t bytes_read = 0;
 
         while(bytes_read < ndef_len) {
@@ -514,42 +481,25 @@ static bool flipper_wedge_nfc_read_type4_ndef(
                 FURI_LOG_W(TAG, "Type 4 NDEF: No data in chunk");
                 break;
             }
-
-            // Copy chunk to buffer
-            for(size_t i = 0; i < chunk_received && bytes_read < ndef_len; i++) {
-                ndef_data[bytes_read++] = bit_buffer_get_byte(rx_buffer, i);
+            if(chunk_received > (size_t)(ndef_len - bytes_read)) {
+                chunk_received = ndef_len - bytes_read;
             }
+            bytes_read += chunk_received;
 
             FURI_LOG_D(TAG, "Type 4 NDEF: Read %zu bytes, total %d/%d", chunk_received, bytes_read, ndef_len);
-        }
 
-        if(bytes_read == 0) {
-            FURI_LOG_W(TAG, "Type 4 NDEF: No NDEF data read");
-            data->error = FlipperWedgeNfcErrorNoTextRecord;
-            break;
-        }
-
-        FURI_LOG_I(TAG, "Type 4 NDEF: Successfully read %d bytes", bytes_read);
-
-        // Log the raw NDEF data for debugging
-        FURI_LOG_I(TAG, "Type 4 NDEF: Raw data (first %d bytes):", bytes_read > 32 ? 32 : bytes_read);
-        for(uint16_t i = 0; i < bytes_read && i < 32; i++) {
-            FURI_LOG_I(TAG, "  [%02d] = 0x%02X", i, ndef_data[i]);
+            // Step 7: Parse NDEF records (Type 4 uses raw records, no TLV wrapping)
+            if(!flipper_wedge_nfc_ndef_feed(instance, bit_buffer_get_data(rx_buffer), chunk_received)) {
+                break;
+            }
         }
 
-        // Step 7: Parse NDEF message to extract text records
-        // Type 4 uses raw NDEF records (no TLV wrapping)
-        size_t text_len = flipper_wedge_nfc_parse_raw_ndef_text(
-            ndef_data,
-            bytes_read,
-            data->ndef_text,
-            FLIPPER_WEDGE_NDEF_MAX_LEN);
+        FURI_LOG_I(TAG, "Type 4 NDEF: Read %d of %d bytes", bytes_read, ndef_len);
 
-        if(text_len > 0) {
-            data->has_ndef = true;
+        if(flipper_wedge_nfc_ndef_end(instance)) {
             data->error = FlipperWedgeNfcErrorNone;
             success = true;
-            FURI_LOG_I(TAG, "Type 4 NDEF: Found text record: %s", data->ndef_text);
+            FURI_LOG_I(TAG, "Type 4 NDEF: Found text record");
         } else {
             data->error = FlipperWedgeNfcErrorNoTextRecord;
             FURI_LOG_D(TAG, "Type 4 NDEF: No text records found in NDEF message");
@@ -560,9 +510,96 @@ static bool flipper_wedge_nfc_read_type4_ndef(
     bit_buffer_free(tx_buffer);
     bit_buffer_free(rx_buffer);
 
+    flipper_wedge_debug_log_stack(TAG, "Type 4 NDEF read");
+
     return success;
 }
 
+// Add a UID to the inventory keeping it sorted (hex string order) and unique
+// Returns false for a UID that is already listed or when the list is full
+static bool flipper_wedge_nfc_inventory_add(FlipperWedgeNfcData* data, const uint8_t* uid, uint8_t uid_len) {
+    if(uid_len == 0) {
+        return false;
+    }
+    if(uid_len > FLIPPER_WEDGE_NFC_UID_MAX_LEN) {
+        uid_len = FLIPPER_WEDGE_NFC_UID_MAX_LEN;
+    }
+
+    uint8_t pos = 0;
+    for(; pos < data->inventory_count; pos++) {
+        const FlipperWedgeNfcUid* entry = &data->inventory[pos];
+        int cmp = memcmp(uid, entry->uid, MIN(uid_len, entry->uid_len));
+        if(cmp == 0) {
+            if(uid_len == entry->uid_len) return false;
+            cmp = uid_len < entry->uid_len ? -1 : 1;
+        }
+        if(cmp < 0) break;
+    }
+
+    if(data->inventory_count >= FLIPPER_WEDGE_NFC_INVENTORY_MAX) {
+        return false;
+    }
+
+    memmove(
+        &data->inventory[pos + 1],
+        &data->inventory[pos],
+        (data->inventory_count - pos) * sizeof(FlipperWedgeNfcUid));
+    memcpy(data->inventory[pos].uid, uid, uid_len);
+    data->inventory[pos].uid_len = uid_len;
+    data->inventory_count++;
+    return true;
+}
+
+// Collect every tag in the field, called with the first tag already activated
+// (first points into the poller data, which the next activation overwrites)
+// iso14443_3a_poller_activate() halts the current tag before its REQA, and halted
+// tags do not answer REQA, so each pass selects a tag that was not read yet
+static void flipper_wedge_nfc_read_inventory(
+    FlipperWedgeNfc* instance,
+    Iso14443_3aPoller* poller,
+    const Iso14443_3aData* first) {
+    uint32_t start_tick = furi_get_tick();
+    FlipperWedgeNfcData* data = &instance->last_data;
+    Iso14443_3aData iso3a_data;
+
+    data->inventory_count = 0;
+    flipper_wedge_nfc_inventory_add(data, first->uid, first->uid_len);
+
+    uint8_t selects = 1;
+    uint8_t misses = 0;
+    while(data->inventory_count < FLIPPER_WEDGE_NFC_INVENTORY_MAX &&
+          misses < FLIPPER_WEDGE_NFC_INVENTORY_RETRIES) {
+        Iso14443_3aError error = iso14443_3a_poller_activate(poller, &iso3a_data);
+        selects++;
+        if(error == Iso14443_3aErrorTimeout) {
+            // Every tag in the field is halted
+            break;
+        }
+        // A collision the anticollision could not resolve, or a tag that
+        // re-entered the field, counts as a miss
+        if(error != Iso14443_3aErrorNone ||
+           !flipper_wedge_nfc_inventory_add(data, iso3a_data.uid, iso3a_data.uid_len)) {
+            misses++;
+        } else {
+            misses = 0;
+        }
+    }
+    iso14443_3a_poller_halt(poller);
+
+    // The first UID in the batch is also reported as the tag UID
+    data->uid_len = data->inventory[0].uid_len;
+    memcpy(data->uid, data->inventory[0].uid, data->uid_len);
+
+    uint32_t elapsed_ms = furi_get_tick() - start_tick;
+    FURI_LOG_I(
+        TAG,
+        "Inventory: %u tags in %lu ms (%u selects, %lu tags/s)",
+        data->inventory_count,
+        elapsed_ms,
+        selects,
+        elapsed_ms > 0 ? data->inventory_count * 1000UL / elapsed_ms : 0);
+}
+
 static NfcCommand flipper_wedge_nfc_poller_callback_iso14443_3a(NfcGenericEvent event, void* context) {
     furi_assert(context);
     FlipperWedgeNfc* instance = context;
@@ -588,11 +625,14 @@ static NfcCommand flipper_wedge_nfc_poller_callback_iso14443_3a(NfcGenericEvent
                     FURI_LOG_W(TAG, "3A UID length %d exceeds max %d, truncating", uid_len, FLIPPER_WEDGE_NFC_UID_MAX_LEN);
                     uid_len = FLIPPER_WEDGE_NFC_UID_MAX_LEN;
                 }
-                if(uid_len > 0) {
+                if(uid_len > 0 && instance->inventory) {
+                    flipper_wedge_nfc_read_inventory(instance, event.instance, iso3a_data);
+                    instance->last_data.error = FlipperWedgeNfcErrorNone;
+                    flipper_wedge_nfc_set_success(instance);
+                } else if(uid_len > 0) {
                     instance->last_data.uid_len = uid_len;
                     memcpy(instance->last_data.uid, iso3a_data->uid, uid_len);
-                    instance->last_data.has_ndef = false;
-                    instance->last_data.ndef_text[0] = '\0';
+                    flipper_wedge_nfc_clear_ndef(instance);
 
                     // ISO14443-3A doesn't support NDEF - if NDEF was requested, mark as not forum compliant
                     if(instance->parse_ndef) {
@@ -602,7 +642,7 @@ static NfcCommand flipper_wedge_nfc_poller_callback_iso14443_3a(NfcGenericEvent
                         instance->last_data.error = FlipperWedgeNfcErrorNone;
                         FURI_LOG_I(TAG, "Got ISO14443-3A UID, len: %d", instance->last_data.uid_len);
                     }
-                    instance->state = FlipperWedgeNfcStateSuccess;
+                    flipper_wedge_nfc_set_success(instance);
                 } else {
                     FURI_LOG_E(TAG, "3A UID length is 0, cannot proceed");
                     instance->state = FlipperWedgeNfcStateError;
@@ -660,8 +700,7 @@ static NfcCommand flipper_wedge_nfc_poller_callback_iso14443_4a(NfcGenericEvent
                     if(uid_len > 0) {
                         instance->last_data.uid_len = uid_len;
                         memcpy(instance->last_data.uid, iso3a_data->uid, uid_len);
-                        instance->last_data.has_ndef = false;
-                        instance->last_data.ndef_text[0] = '\0';
+                        flipper_wedge_nfc_clear_ndef(instance);
                         instance->last_data.error = FlipperWedgeNfcErrorNone;
 
                         // ISO14443-4A is Type 4 NDEF - ALWAYS try to read NDEF
@@ -669,12 +708,13 @@ static NfcCommand flipper_wedge_nfc_poller_callback_iso14443_4a(NfcGenericEvent
 
                         // Attempt to read Type 4 NDEF data
                         Iso14443_4aPoller* iso4a_poller = event.instance;
-                        flipper_wedge_nfc_read_type4_ndef(iso4a_poller, &instance->last_data);
+                        flipper_wedge_nfc_read_type4_ndef(instance, iso4a_poller);
 
                         // flipper_wedge_nfc_read_type4_ndef sets error field:
                         // - FlipperWedgeNfcErrorNone if NDEF text found
                         // - FlipperWedgeNfcErrorUnsupportedType if no NDEF app
                         // - FlipperWedgeNfcErrorNoTextRecord if NDEF exists but no text records
+                        // - FlipperWedgeNfcErrorBusy if no NDEF buffer was free
 
                         // If we're NOT in NDEF-only mode, we still want to output UID even if NDEF fails
                         if(!instance->parse_ndef) {
@@ -686,7 +726,7 @@ static NfcCommand flipper_wedge_nfc_poller_callback_iso14443_4a(NfcGenericEvent
                         }
                         // If parse_ndef is true (NDEF mode), keep the error as-is
 
-                        instance->state = FlipperWedgeNfcStateSuccess;
+                        flipper_wedge_nfc_set_success(instance);
                     }
                 } else {
                     FURI_LOG_E(TAG, "4A data has NULL 3A pointer");
@@ -743,8 +783,7 @@ static NfcCommand flipper_wedge_nfc_poller_callback_mf_ultralight(NfcGenericEven
                     if(uid_len > 0) {
                         instance->last_data.uid_len = uid_len;
                         memcpy(instance->last_data.uid, iso3a_data->uid, uid_len);
-                        instance->last_data.has_ndef = false;
-                        instance->last_data.ndef_text[0] = '\0';
+                        flipper_wedge_nfc_clear_ndef(instance);
                         instance->last_data.error = FlipperWedgeNfcErrorNone;
 
                         FURI_LOG_I(TAG, "Got MF Ultralight UID, len: %d", instance->last_data.uid_len);
@@ -753,32 +792,23 @@ static NfcCommand flipper_wedge_nfc_poller_callback_mf_ultralight(NfcGenericEven
                         if(instance->parse_ndef && mfu_data->pages_read > 4) {
                             // NDEF data typically starts at page 4 (byte offset 16)
                             // Pages 0-3 are reserved for UID and lock bytes
-                            // Increased limit from 240 to 1024 to support large text records
                             size_t ndef_data_len = (mfu_data->pages_read - 4) * 4;
-                            if(ndef_data_len > 1024) {
-                                FURI_LOG_W(TAG, "Type 2 NDEF: Data too large (%zu bytes), limiting to 1024", ndef_data_len);
-                                ndef_data_len = 1024;
-                            }
-
                             const uint8_t* ndef_data = &mfu_data->page[4].data[0];
 
                             FURI_LOG_I(TAG, "Attempting NDEF parse, data_len=%zu, pages_read=%d",
                                       ndef_data_len, mfu_data->pages_read);
 
-                            size_t text_len = flipper_wedge_nfc_parse_ndef_text(
-                                ndef_data,
-                                ndef_data_len,
-                                instance->last_data.ndef_text,
-                                FLIPPER_WEDGE_NDEF_MAX_LEN);
-
-                            if(text_len > 0) {
-                                instance->last_data.has_ndef = true;
-                                instance->last_data.error = FlipperWedgeNfcErrorNone;
-                                FURI_LOG_I(TAG, "Found NDEF text: %s", instance->last_data.ndef_text);
-                            } else {
-                                // Type 2 tag but no NDEF text record found
-                                instance->last_data.error = FlipperWedgeNfcErrorNoTextRecord;
-                                FURI_LOG_I(TAG, "No NDEF text records found on Type 2 tag");
+                            // Otherwise no free buffer, ndef_begin set the error
+                            if(flipper_wedge_nfc_ndef_begin(instance, true)) {
+                                flipper_wedge_nfc_ndef_feed(instance, ndef_data, ndef_data_len);
+                                if(flipper_wedge_nfc_ndef_end(instance)) {
+                                    instance->last_data.error = FlipperWedgeNfcErrorNone;
+                                    FURI_LOG_I(TAG, "Found NDEF text");
+                                } else {
+                                    // Type 2 tag but no NDEF text record found
+                                    instance->last_data.error = FlipperWedgeNfcErrorNoTextRecord;
+                                    FURI_LOG_I(TAG, "No NDEF text records found on Type 2 tag");
+                                }
                             }
                         } else if(instance->parse_ndef) {
                             // Not enough pages read for NDEF
@@ -788,7 +818,7 @@ static NfcCommand flipper_wedge_nfc_poller_callback_mf_ultralight(NfcGenericEven
                             FURI_LOG_I(TAG, "NDEF parsing not requested (parse_ndef=false)");
                         }
 
-                        instance->state = FlipperWedgeNfcStateSuccess;
+                        flipper_wedge_nfc_set_success(instance);
                     } else {
                         FURI_LOG_E(TAG, "MFU UID length is 0");
                         instance->state = FlipperWedgeNfcStateError;
@@ -821,6 +851,170 @@ static NfcCommand flipper_wedge_nfc_poller_callback_mf_ultralight(NfcGenericEven
     return NfcCommandContinue;
 }
 
+// Sector data as text: up to the first NUL if that is printable ASCII,
+// otherwise hex without the trailing zero bytes
+static size_t flipper_wedge_nfc_classic_text(const uint8_t* bytes, size_t len, char* text, size_t size) {
+    size_t text_len = 0;
+    while(text_len < len && bytes[text_len] >= 0x20 && bytes[text_len] < 0x7F) {
+        text_len++;
+    }
+    if(text_len == len || bytes[text_len] == 0x00) {
+        text_len = MIN(text_len, size - 1);
+        memcpy(text, bytes, text_len);
+        text[text_len] = '\0';
+        return text_len;
+    }
+
+    while(len > 0 && bytes[len - 1] == 0x00) len--;
+    flipper_wedge_format_uid(bytes, len, "", text, size);
+    return strlen(text);
+}
+
+// Start of a Classic read: the poller has selected the card and asks for its mode
+static NfcCommand flipper_wedge_nfc_classic_start(FlipperWedgeNfc* instance) {
+    FlipperWedgeNfcData* data = &instance->last_data;
+    const MfClassicData* mfc_data = nfc_poller_get_data(instance->poller);
+    if(!mfc_data || !mfc_data->iso14443_3a_data || mfc_data->iso14443_3a_data->uid_len == 0) {
+        FURI_LOG_E(TAG, "Classic poller returned no UID");
+        instance->state = FlipperWedgeNfcStateError;
+        return NfcCommandStop;
+    }
+
+    const Iso14443_3aData* iso3a_data = mfc_data->iso14443_3a_data;
+    data->uid_len = MIN(iso3a_data->uid_len, FLIPPER_WEDGE_NFC_UID_MAX_LEN);
+    memcpy(data->uid, iso3a_data->uid, data->uid_len);
+    flipper_wedge_nfc_clear_ndef(instance);
+    data->error = FlipperWedgeNfcErrorNone;
+
+    uint8_t sector = instance->classic_sector;
+    if(sector >= mf_classic_get_total_sectors_num(mfc_data->type)) {
+        FURI_LOG_W(TAG, "Classic: card has no sector %u", sector);
+        if(instance->parse_ndef) data->error = FlipperWedgeNfcErrorNoTextRecord;
+        flipper_wedge_nfc_set_success(instance);
+        return NfcCommandStop;
+    }
+
+    flipper_wedge_classic_keys_walk_start(
+        instance->classic_keys, &instance->classic_walk, data->uid, data->uid_len, sector);
+    instance->classic_start_tick = furi_get_tick();
+    instance->classic_attempts = 0;
+    return NfcCommandContinue;
+}
+
+// The poller asks for the next sector to read after the previous one. It
+// authenticates and reads every block of the sector with the key given here,
+// so a sector whose data blocks are now read was opened by the last key;
+// otherwise the next key of the walk is handed out
+static NfcCommand flipper_wedge_nfc_classic_request_sector(
+    FlipperWedgeNfc* instance,
+    MfClassicPollerEventDataReadSectorRequest* request) {
+    FlipperWedgeNfcData* data = &instance->last_data;
+    FlipperWedgeClassicWalk* walk = &instance->classic_walk;
+    const MfClassicData* mfc_data = nfc_poller_get_data(instance->poller);
+    uint8_t sector = instance->classic_sector;
+
+    // Sector 0 starts with the manufacturer block, every sector ends with its trailer
+    uint8_t block = mf_classic_get_first_block_num_of_sector(sector);
+    uint8_t block_count = mf_classic_get_blocks_num_in_sector(sector) - 1;
+    if(sector == 0) {
+        block++;
+        block_count--;
+    }
+
+    bool read = instance->classic_attempts > 0;
+    for(uint8_t i = 0; i < block_count && read; i++) {
+        read = mf_classic_is_block_read(mfc_data, block + i);
+    }
+
+    if(!read) {
+        if(!flipper_wedge_classic_keys_walk_next(instance->classic_keys, walk, &instance->classic_key)) {
+            FURI_LOG_W(
+                TAG,
+                "Classic: no key opens sector %u, %u tried in %lu ms",
+                sector,
+                instance->classic_attempts,
+                furi_get_tick() - instance->classic_start_tick);
+            // The UID is still good outside NDEF mode
+            if(instance->parse_ndef) data->error = FlipperWedgeNfcErrorClassicNoKey;
+            flipper_wedge_nfc_set_success(instance);
+            return NfcCommandStop;
+        }
+        instance->classic_attempts++;
+
+        request->sector_num = sector;
+        memcpy(request->key.data, instance->classic_key.data, sizeof(request->key.data));
+        request->key_type = instance->classic_key.type == FlipperWedgeClassicKeyTypeA ?
+                                MfClassicKeyTypeA :
+                                MfClassicKeyTypeB;
+        request->key_provided = true;
+        return NfcCommandContinue;
+    }
+    flipper_wedge_classic_keys_walk_found(instance->classic_keys, walk, &instance->classic_key);
+
+    data->ndef = flipper_wedge_scan_buffer_acquire(instance->ndef_pool);
+    if(data->ndef) {
+        uint8_t sector_data[CLASSIC_SECTOR_DATA_MAX];
+        for(uint8_t i = 0; i < block_count; i++) {
+            memcpy(
+                &sector_data[i * MF_CLASSIC_BLOCK_SIZE],
+                mfc_data->block[block + i].data,
+                MF_CLASSIC_BLOCK_SIZE);
+        }
+        size_t text_len = flipper_wedge_nfc_classic_text(
+            sector_data,
+            block_count * MF_CLASSIC_BLOCK_SIZE,
+            flipper_wedge_scan_buffer_data(data->ndef),
+            flipper_wedge_scan_buffer_capacity(data->ndef));
+        data->has_ndef = text_len > 0;
+    } else {
+        FURI_LOG_W(TAG, "No free NDEF buffer, Classic text of this read dropped");
+    }
+    if(!data->has_ndef) {
+        if(instance->parse_ndef) {
+            data->error = data->ndef ? FlipperWedgeNfcErrorNoTextRecord : FlipperWedgeNfcErrorBusy;
+        }
+        flipper_wedge_nfc_clear_ndef(instance);
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "Classic: sector %u read in %lu ms, %u auth attempts (key cache %s)",
+        sector,
+        furi_get_tick() - instance->classic_start_tick,
+        instance->classic_attempts,
+        instance->classic_attempts == 1 && walk->has_cached ? "hit" : "miss");
+    flipper_wedge_nfc_set_success(instance);
+    return NfcCommandStop;
+}
+
+// The MF Classic poller in read mode asks for the mode once, then for one
+// sector and key at a time. A wrong key fails the sector's authentication and
+// the poller asks again, so the key walk runs one request per key
+static NfcCommand flipper_wedge_nfc_poller_callback_mf_classic(NfcGenericEvent event, void* context) {
+    furi_assert(context);
+    FlipperWedgeNfc* instance = context;
+
+    if(event.protocol == NfcProtocolMfClassic) {
+        const MfClassicPollerEvent* mfc_event = event.event_data;
+        FURI_LOG_D(TAG, "MF Classic event type: %d", mfc_event->type);
+
+        if(mfc_event->type == MfClassicPollerEventTypeRequestMode) {
+            mfc_event->data->poller_mode.mode = MfClassicPollerModeRead;
+            return flipper_wedge_nfc_classic_start(instance);
+        } else if(mfc_event->type == MfClassicPollerEventTypeRequestReadSector) {
+            return flipper_wedge_nfc_classic_request_sector(
+                instance, &mfc_event->data->read_sector_request_data);
+        } else if(
+            mfc_event->type == MfClassicPollerEventTypeFail ||
+            mfc_event->type == MfClassicPollerEventTypeCardLost) {
+            FURI_LOG_E(TAG, "MF Classic poller: card lost or read failed");
+            instance->state = FlipperWedgeNfcStateError;
+            return NfcCommandStop;
+        }
+    }
+    return NfcCommandContinue;
+}
+
 static NfcCommand flipper_wedge_nfc_poller_callback_iso15693(NfcGenericEvent event, void* context) {
     furi_assert(context);
     FlipperWedgeNfc* instance = context;
@@ -842,8 +1036,7 @@ static NfcCommand flipper_wedge_nfc_poller_callback_iso15693(NfcGenericEvent eve
 
                 instance->last_data.uid_len = uid_len;
                 memcpy(instance->last_data.uid, iso15_data->uid, uid_len);
-                instance->last_data.has_ndef = false;
-                instance->last_data.ndef_text[0] = '\0';
+                flipper_wedge_nfc_clear_ndef(instance);
                 instance->last_data.error = FlipperWedgeNfcErrorNone;
 
                 FURI_LOG_I(TAG, "Got ISO15693 UID, len: %d", instance->last_data.uid_len);
@@ -873,26 +1066,17 @@ static NfcCommand flipper_wedge_nfc_poller_callback_iso15693(NfcGenericEvent eve
                             // NDEF data starts after CC (4 bytes)
                             size_t ndef_data_len = block_data_size - 4;
 
-                            // Limit to reasonable size (increased from 256 to 1024 for large text records)
-                            if(ndef_data_len > 1024) {
-                                FURI_LOG_W(TAG, "Type 5 NDEF: Data too large (%zu bytes), limiting to 1024", ndef_data_len);
-                                ndef_data_len = 1024;
-                            }
-
-                            size_t text_len = flipper_wedge_nfc_parse_ndef_text(
-                                &block_data[4], // Skip 4-byte CC
-                                ndef_data_len,
-                                instance->last_data.ndef_text,
-                                FLIPPER_WEDGE_NDEF_MAX_LEN);
-
-                            if(text_len > 0) {
-                                instance->last_data.has_ndef = true;
-                                instance->last_data.error = FlipperWedgeNfcErrorNone;
-                                FURI_LOG_I(TAG, "Found Type 5 NDEF text: %s", instance->last_data.ndef_text);
-                            } else {
-                                // Type 5 tag with valid CC but no NDEF text record
-                                instance->last_data.error = FlipperWedgeNfcErrorNoTextRecord;
-                                FURI_LOG_D(TAG, "No NDEF text records found on Type 5 tag");
+                            // Otherwise no free buffer, ndef_begin set the error
+                            if(flipper_wedge_nfc_ndef_begin(instance, true)) {
+                                flipper_wedge_nfc_ndef_feed(instance, &block_data[4], ndef_data_len);
+                                if(flipper_wedge_nfc_ndef_end(instance)) {
+                                    instance->last_data.error = FlipperWedgeNfcErrorNone;
+                                    FURI_LOG_I(TAG, "Found Type 5 NDEF text");
+                                } else {
+                                    // Type 5 tag with valid CC but no NDEF text record
+                                    instance->last_data.error = FlipperWedgeNfcErrorNoTextRecord;
+                                    FURI_LOG_D(TAG, "No NDEF text records found on Type 5 tag");
+                                }
                             }
                         } else {
                             // No valid Capability Container
@@ -905,7 +1089,7 @@ static NfcCommand flipper_wedge_nfc_poller_callback_iso15693(NfcGenericEvent eve
                     }
                 }
 
-                instance->state = FlipperWedgeNfcStateSuccess;
+                flipper_wedge_nfc_set_success(instance);
             } else {
                 FURI_LOG_E(TAG, "ISO15693 poller returned NULL data");
                 instance->state = FlipperWedgeNfcStateError;
@@ -920,6 +1104,106 @@ static NfcCommand flipper_wedge_nfc_poller_callback_iso15693(NfcGenericEvent eve
     return NfcCommandContinue;
 }
 
+typedef struct {
+    FlipperWedgeNfc* instance;
+    Iso15693_3Poller* poller;
+} FlipperWedgeNfcPresenceRound;
+
+// One single-slot Inventory request for flipper_wedge_iso15693_inventory()
+static FlipperWedgeIso15693Reply flipper_wedge_nfc_iso15693_request(
+    uint8_t mask_len,
+    uint64_t mask,
+    uint64_t* uid,
+    void* context) {
+    FlipperWedgeNfcPresenceRound* round = context;
+    FlipperWedgeNfc* instance = round->instance;
+
+    bit_buffer_reset(instance->presence_tx);
+    bit_buffer_append_byte(instance->presence_tx, ISO15693_INVENTORY_FLAGS);
+    bit_buffer_append_byte(instance->presence_tx, ISO15693_CMD_INVENTORY);
+    bit_buffer_append_byte(instance->presence_tx, mask_len);
+    for(uint8_t i = 0; i < (mask_len + 7) / 8; i++) {
+        bit_buffer_append_byte(instance->presence_tx, (mask >> (8 * i)) & 0xFF);
+    }
+
+    Iso15693_3Error error = iso15693_3_poller_send_frame(
+        round->poller, instance->presence_tx, instance->presence_rx, ISO15693_FWT_FC);
+    if(error == Iso15693_3ErrorTimeout) {
+        return FlipperWedgeIso15693ReplyNone;
+    }
+    // Overlapping answers arrive as a bad CRC or a broken frame
+    if(error != Iso15693_3ErrorNone ||
+       bit_buffer_get_size_bytes(instance->presence_rx) != ISO15693_INVENTORY_RESP_LEN ||
+       (bit_buffer_get_byte(instance->presence_rx, 0) & ISO15693_RESP_FLAG_ERROR)) {
+        return FlipperWedgeIso15693ReplyCollision;
+    }
+
+    // UID is sent least significant byte first
+    uint64_t value = 0;
+    for(size_t i = 0; i < FLIPPER_WEDGE_ISO15693_UID_LEN; i++) {
+        value |= (uint64_t)bit_buffer_get_byte(instance->presence_rx, 2 + i) << (8 * i);
+    }
+    *uid = value;
+    return FlipperWedgeIso15693ReplySingle;
+}
+
+static void flipper_wedge_nfc_presence_found(uint64_t uid, void* context) {
+    FlipperWedgeNfc* instance = context;
+    if(furi_message_queue_put(instance->presence_queue, &uid, 0) != FuriStatusOk) {
+        FURI_LOG_W(TAG, "Presence queue full, UID dropped this round");
+    }
+}
+
+// Presence mode poller: every callback (tag ready or activation error with
+// several tags answering) runs one inventory round over the whole field
+static NfcCommand flipper_wedge_nfc_poller_callback_iso15693_presence(NfcGenericEvent event, void* context) {
+    furi_assert(context);
+    FlipperWedgeNfc* instance = context;
+
+    if(event.protocol == NfcProtocolIso15693_3) {
+        FlipperWedgeNfcPresenceRound round = {.instance = instance, .poller = event.instance};
+        uint32_t start_tick = furi_get_tick();
+        uint32_t requests = flipper_wedge_iso15693_inventory(
+            flipper_wedge_nfc_iso15693_request, &round, flipper_wedge_nfc_presence_found, instance);
+        FURI_LOG_D(
+            TAG,
+            "Presence round: %lu requests in %lu ms",
+            requests,
+            furi_get_tick() - start_tick);
+
+        furi_delay_ms(FLIPPER_WEDGE_NFC_PRESENCE_ROUND_MS);
+    }
+    return NfcCommandContinue;
+}
+
+static const char* flipper_wedge_nfc_protocol_name(NfcProtocol protocol) {
+    switch(protocol) {
+    case NfcProtocolIso14443_3a:
+        return "ISO14443-3A";
+    case NfcProtocolIso14443_4a:
+        return "ISO14443-4A (ISO-DEP)";
+    case NfcProtocolMfUltralight:
+        return "MIFARE Ultralight";
+    case NfcProtocolMfClassic:
+        return "MIFARE Classic";
+    case NfcProtocolIso15693_3:
+        return "ISO15693";
+    default:
+        return "Other";
+    }
+}
+
+// Check if a protocol is ISO14443-3A or built on it
+static bool flipper_wedge_nfc_is_iso14443_3a(NfcProtocol protocol) {
+    while(protocol != NfcProtocolInvalid) {
+        if(protocol == NfcProtocolIso14443_3a) {
+            return true;
+        }
+        protocol = nfc_protocol_get_parent(protocol);
+    }
+    return false;
+}
+
 static void flipper_wedge_nfc_scanner_callback(NfcScannerEvent event, void* context) {
     furi_assert(context);
     FlipperWedgeNfc* instance = context;
@@ -934,19 +1218,37 @@ static void flipper_wedge_nfc_scanner_callback(NfcScannerEvent event, void* cont
 
         // Log all detected protocols with names
         for(size_t i = 0; i < event.data.protocol_num; i++) {
-            const char* proto_name = "Unknown";
-            switch(event.data.protocols[i]) {
-                case NfcProtocolIso14443_3a: proto_name = "ISO14443-3A"; break;
-                case NfcProtocolIso14443_4a: proto_name = "ISO14443-4A (ISO-DEP)"; break;
-                case NfcProtocolMfUltralight: proto_name = "MIFARE Ultralight"; break;
-                case NfcProtocolIso15693_3: proto_name = "ISO15693"; break;
-                default: proto_name = "Other"; break;
+            FURI_LOG_I(
+                TAG,
+                "  Protocol[%zu]: %d (%s)",
+                i,
+                event.data.protocols[i],
+                flipper_wedge_nfc_protocol_name(event.data.protocols[i]));
+        }
+
+        // Inventory reads only need the UIDs, which every ISO14443-3A tag has
+        if(instance->inventory) {
+            for(size_t i = 0; i < event.data.protocol_num; i++) {
+                if(flipper_wedge_nfc_is_iso14443_3a(event.data.protocols[i])) {
+                    protocol_to_use = NfcProtocolIso14443_3a;
+                    break;
+                }
+            }
+        }
+
+        // Classic sector reads go first, Classic tags are read as ISO14443-3A otherwise
+        for(size_t i = 0; i < event.data.protocol_num && instance->classic_keys && !instance->inventory; i++) {
+            if(event.data.protocols[i] == NfcProtocolMfClassic) {
+                protocol_to_use = NfcProtocolMfClassic;
+                FURI_LOG_I(TAG, "Using MF Classic protocol, sector %u", instance->classic_sector);
+                break;
             }
-            FURI_LOG_I(TAG, "  Protocol[%zu]: %d (%s)", i, event.data.protocols[i], proto_name);
         }
 
         // Check for protocols in priority order
-        for(size_t i = 0; i < event.data.protocol_num; i++) {
+        for(size_t i = 0; i < event.data.protocol_num && !instance->inventory &&
+                           protocol_to_use == NfcProtocolInvalid;
+            i++) {
             NfcProtocol p = event.data.protocols[i];
 
             // Highest priority: MfUltralight (supports Type 2 NDEF)
@@ -970,7 +1272,7 @@ static void flipper_wedge_nfc_scanner_callback(NfcScannerEvent event, void* cont
         }
 
         // If no direct match, try parent protocols
-        if(protocol_to_use == NfcProtocolInvalid && event.data.protocol_num > 0) {
+        if(protocol_to_use == NfcProtocolInvalid && event.data.protocol_num > 0 && !instance->inventory) {
             for(size_t i = 0; i < event.data.protocol_num; i++) {
                 NfcProtocol p = event.data.protocols[i];
                 NfcProtocol parent = nfc_protocol_get_parent(p);
@@ -995,17 +1297,14 @@ static void flipper_wedge_nfc_scanner_callback(NfcScannerEvent event, void* cont
         }
 
         if(protocol_to_use != NfcProtocolInvalid) {
-            const char* proto_name = "Unknown";
-            switch(protocol_to_use) {
-                case NfcProtocolIso14443_3a: proto_name = "ISO14443-3A"; break;
-                case NfcProtocolIso14443_4a: proto_name = "ISO14443-4A (ISO-DEP)"; break;
-                case NfcProtocolMfUltralight: proto_name = "MIFARE Ultralight"; break;
-                case NfcProtocolIso15693_3: proto_name = "ISO15693"; break;
-                default: proto_name = "Other"; break;
-            }
             instance->detected_protocol = protocol_to_use;
+            flipper_wedge_latency_mark(instance->latency, FlipperWedgeLatencyStageDetect);
             instance->state = FlipperWedgeNfcStateTagDetected;
-            FURI_LOG_I(TAG, "*** SELECTED PROTOCOL: %d (%s) ***", protocol_to_use, proto_name);
+            FURI_LOG_I(
+                TAG,
+                "*** SELECTED PROTOCOL: %d (%s) ***",
+                protocol_to_use,
+                flipper_wedge_nfc_protocol_name(protocol_to_use));
         } else {
             FURI_LOG_W(TAG, "No supported protocol found");
         }
@@ -1023,6 +1322,13 @@ static void flipper_wedge_nfc_start_poller(FlipperWedgeNfc* instance) {
         instance->scanner = NULL;
     }
 
+    // Record which protocol this read used (reported with structured output)
+    snprintf(
+        instance->last_data.protocol_name,
+        sizeof(instance->last_data.protocol_name),
+        "%s",
+        flipper_wedge_nfc_protocol_name(instance->detected_protocol));
+
     // Start poller for the detected protocol
     instance->poller = nfc_poller_alloc(instance->nfc, instance->detected_protocol);
     if(instance->poller) {
@@ -1035,7 +1341,10 @@ static void flipper_wedge_nfc_start_poller(FlipperWedgeNfc* instance) {
             nfc_poller_start(instance->poller, flipper_wedge_nfc_poller_callback_iso14443_4a, instance);
         } else if(instance->detected_protocol == NfcProtocolIso15693_3) {
             nfc_poller_start(instance->poller, flipper_wedge_nfc_poller_callback_iso15693, instance);
+        } else if(instance->detected_protocol == NfcProtocolMfClassic) {
+            nfc_poller_start(instance->poller, flipper_wedge_nfc_poller_callback_mf_classic, instance);
         }
+        flipper_wedge_latency_mark(instance->latency, FlipperWedgeLatencyStagePollerStart);
         FURI_LOG_I(TAG, "Started poller for protocol %d", instance->detected_protocol);
     } else {
         FURI_LOG_E(TAG, "Failed to allocate poller");
@@ -1051,12 +1360,39 @@ FlipperWedgeNfc* flipper_wedge_nfc_alloc(void) {
     instance->poller = NULL;
     instance->state = FlipperWedgeNfcStateIdle;
     instance->parse_ndef = false;
+    instance->inventory = false;
+    instance->presence = false;
+    instance->classic_keys = NULL;
+    instance->classic_sector = 0;
+    instance->presence_queue =
+        furi_message_queue_alloc(FLIPPER_WEDGE_ISO15693_PRESENCE_MAX, sizeof(uint64_t));
+    // Inventory request: flags, command, mask length, up to 8 mask bytes (+ CRC)
+    instance->presence_tx = bit_buffer_alloc(16);
+    instance->presence_rx = bit_buffer_alloc(16);
     instance->detected_protocol = NfcProtocolInvalid;
     instance->callback = NULL;
     instance->callback_context = NULL;
+    instance->latency = NULL;
     instance->owner_thread = furi_thread_get_current_id();
 
     memset(&instance->last_data, 0, sizeof(FlipperWedgeNfcData));
+    instance->ndef_pool = flipper_wedge_scan_buffer_pool_alloc(
+        FLIPPER_WEDGE_NDEF_BUFFER_COUNT, FLIPPER_WEDGE_NDEF_MAX_LEN);
+    instance->ndef_parser = flipper_wedge_ndef_stream_alloc();
+    instance->ndef_fill = 0;
+
+    instance->stream_ndef = false;
+    instance->stream_active = false;
+    instance->stream_sent = false;
+    instance->stream_cancel = false;
+    instance->stream_pool = flipper_wedge_scan_buffer_pool_alloc(
+        FLIPPER_WEDGE_NDEF_STREAM_CHUNK_COUNT, FLIPPER_WEDGE_NDEF_STREAM_CHUNK_LEN);
+    // One slot per chunk plus the end marker
+    instance->stream_queue = furi_message_queue_alloc(
+        FLIPPER_WEDGE_NDEF_STREAM_CHUNK_COUNT + 1, sizeof(FlipperWedgeScanBuffer*));
+    instance->stream_chunk = NULL;
+    instance->stream_chunk_len = 0;
+    instance->stream_carry_len = 0;
 
     FURI_LOG_I(TAG, "NFC reader allocated");
 
@@ -1067,6 +1403,15 @@ void flipper_wedge_nfc_free(FlipperWedgeNfc* instance) {
     furi_assert(instance);
 
     flipper_wedge_nfc_stop(instance);
+    flipper_wedge_nfc_clear_ndef(instance);
+    flipper_wedge_scan_buffer_pool_free(instance->ndef_pool);
+    flipper_wedge_ndef_stream_free(instance->ndef_parser);
+
+    furi_message_queue_free(instance->stream_queue);
+    furi_message_queue_free(instance->presence_queue);
+    bit_buffer_free(instance->presence_tx);
+    bit_buffer_free(instance->presence_rx);
+    flipper_wedge_scan_buffer_pool_free(instance->stream_pool);
 
     if(instance->nfc) {
         nfc_free(instance->nfc);
@@ -1086,6 +1431,11 @@ void flipper_wedge_nfc_set_callback(
     instance->callback_context = context;
 }
 
+void flipper_wedge_nfc_set_latency(FlipperWedgeNfc* instance, FlipperWedgeLatency* latency) {
+    furi_assert(instance);
+    instance->latency = latency;
+}
+
 void flipper_wedge_nfc_start(FlipperWedgeNfc* instance, bool parse_ndef) {
     furi_assert(instance);
 
@@ -1113,7 +1463,22 @@ void flipper_wedge_nfc_start(FlipperWedgeNfc* instance, bool parse_ndef) {
 
     instance->parse_ndef = parse_ndef;
     instance->detected_protocol = NfcProtocolInvalid;
+    instance->stream_cancel = false;
+    flipper_wedge_nfc_stream_drain(instance);
+    flipper_wedge_nfc_clear_ndef(instance);
     memset(&instance->last_data, 0, sizeof(FlipperWedgeNfcData));
+    furi_message_queue_reset(instance->presence_queue);
+
+    if(instance->presence) {
+        // No scanner: inventory rounds run on the poller until stopped
+        instance->detected_protocol = NfcProtocolIso15693_3;
+        instance->poller = nfc_poller_alloc(instance->nfc, NfcProtocolIso15693_3);
+        nfc_poller_start(
+            instance->poller, flipper_wedge_nfc_poller_callback_iso15693_presence, instance);
+        instance->state = FlipperWedgeNfcStatePolling;
+        FURI_LOG_I(TAG, "NFC presence inventory started");
+        return;
+    }
 
     // Create and start scanner
     instance->scanner = nfc_scanner_alloc(instance->nfc);
@@ -1134,12 +1499,23 @@ void flipper_wedge_nfc_stop(FlipperWedgeNfc* instance) {
     FURI_LOG_I(TAG, "NFC stop called, state=%d", instance->state);
 
     if(instance->poller) {
+        // A streaming read may be waiting for chunks to be returned:
+        // cancel it and free the queued chunks so it can finish
+        instance->stream_cancel = true;
+        flipper_wedge_nfc_stream_drain(instance);
+
         FURI_LOG_D(TAG, "Stopping poller");
         nfc_poller_stop(instance->poller);
         nfc_poller_free(instance->poller);
         instance->poller = NULL;
     }
 
+    // Poller thread is gone, release whatever the stream still holds
+    flipper_wedge_nfc_stream_drain(instance);
+    flipper_wedge_scan_buffer_unref(instance->stream_chunk);
+    instance->stream_chunk = NULL;
+    instance->stream_active = false;
+
     if(instance->scanner) {
         FURI_LOG_D(TAG, "Stopping scanner");
         nfc_scanner_stop(instance->scanner);
@@ -1154,6 +1530,49 @@ void flipper_wedge_nfc_stop(FlipperWedgeNfc* instance) {
     FURI_LOG_I(TAG, "NFC scanning stopped, state now Idle");
 }
 
+void flipper_wedge_nfc_set_ndef_stream(FlipperWedgeNfc* instance, bool enabled) {
+    furi_assert(instance);
+    instance->stream_ndef = enabled;
+}
+
+void flipper_wedge_nfc_set_inventory(FlipperWedgeNfc* instance, bool enabled) {
+    furi_assert(instance);
+    instance->inventory = enabled;
+}
+
+void flipper_wedge_nfc_set_classic(FlipperWedgeNfc* instance, FlipperWedgeClassicKeys* keys, uint8_t sector) {
+    furi_assert(instance);
+    instance->classic_keys = keys;
+    instance->classic_sector = sector;
+}
+
+void flipper_wedge_nfc_set_presence(FlipperWedgeNfc* instance, bool enabled) {
+    furi_assert(instance);
+    instance->presence = enabled;
+}
+
+bool flipper_wedge_nfc_presence_next(FlipperWedgeNfc* instance, uint64_t* uid) {
+    furi_assert(instance);
+    return furi_message_queue_get(instance->presence_queue, uid, 0) == FuriStatusOk;
+}
+
+bool flipper_wedge_nfc_stream_pending(FlipperWedgeNfc* instance) {
+    furi_assert(instance);
+    return furi_message_queue_get_count(instance->stream_queue) > 0;
+}
+
+FlipperWedgeScanBuffer* flipper_wedge_nfc_stream_next(FlipperWedgeNfc* instance, uint32_t timeout_ms) {
+    furi_assert(instance);
+
+    FlipperWedgeScanBuffer* chunk = NULL;
+    if(furi_message_queue_get(instance->stream_queue, &chunk, furi_ms_to_ticks(timeout_ms)) !=
+       FuriStatusOk) {
+        FURI_LOG_W(TAG, "NDEF stream: no chunk within %lu ms", timeout_ms);
+        return NULL;
+    }
+    return chunk;
+}
+
 bool flipper_wedge_nfc_is_scanning(FlipperWedgeNfc* instance) {
     furi_assert(instance);
     return instance->state == FlipperWedgeNfcStateScanning ||
@@ -1162,6 +1581,13 @@ bool flipper_wedge_nfc_is_scanning(FlipperWedgeNfc* instance) {
            instance->state == FlipperWedgeNfcStateError;  // Still scanning during error recovery
 }
 
+bool flipper_wedge_nfc_is_reading(FlipperWedgeNfc* instance) {
+    furi_assert(instance);
+    return instance->state == FlipperWedgeNfcStateTagDetected ||
+           instance->state == FlipperWedgeNfcStatePolling ||
+           instance->state == FlipperWedgeNfcStateSuccess;
+}
+
 // Call this from the main thread's tick handler to process NFC events
 // Returns true if a tag was successfully read (data available in last_data)
 bool flipper_wedge_nfc_tick(FlipperWedgeNfc* instance) {
@@ -1195,6 +1621,9 @@ bool flipper_wedge_nfc_tick(FlipperWedgeNfc* instance) {
         instance->state = FlipperWedgeNfcStateScanning;
         instance->detected_protocol = NfcProtocolInvalid;
         FURI_LOG_I(TAG, "Tick: error recovery complete, scanning resumed");
+
+        // A Classic read may have learned a key before the card was lost
+        if(instance->classic_keys) flipper_wedge_classic_keys_save(instance->classic_keys);
         return false;
     }
 
@@ -1222,6 +1651,12 @@ bool flipper_wedge_nfc_tick(FlipperWedgeNfc* instance) {
             instance->callback(&instance->last_data, instance->callback_context);
             FURI_LOG_D(TAG, "Tick: callback returned");
         }
+
+        // Callback took its own reference if it needs the text
+        flipper_wedge_nfc_clear_ndef(instance);
+
+        // Keys learned by a Classic read, written after the output is on its way
+        if(instance->classic_keys) flipper_wedge_classic_keys_save(instance->classic_keys);
         return true;
     }
 
@@ -8,9 +8,19 @@
 #include <nfc/protocols/iso14443_3a/iso14443_3a_poller.h>
 #include <nfc/protocols/mf_ultralight/mf_ultralight.h>
 #include <nfc/protocols/mf_ultralight/mf_ultralight_poller.h>
+#include "flipper_wedge_scan_buffer.h"
+#include "flipper_wedge_latency.h"
+#include "flipper_wedge_classic_keys.h"
 
 #define FLIPPER_WEDGE_NFC_UID_MAX_LEN 10
 #define FLIPPER_WEDGE_NDEF_MAX_LEN 1024  // Buffer size (max user setting is 1000 chars, +24 for safety)
+#define FLIPPER_WEDGE_NDEF_BUFFER_COUNT 2  // One held by the app for output, one for the next read
+#define FLIPPER_WEDGE_NDEF_STREAM_CHUNK_LEN 128   // Streamed text chunk size (including terminator)
+#define FLIPPER_WEDGE_NDEF_STREAM_CHUNK_COUNT 4   // Chunks in flight between reader and consumer
+#define FLIPPER_WEDGE_NDEF_STREAM_WAIT_MS 3000    // How long the reader waits for a free chunk
+#define FLIPPER_WEDGE_NFC_INVENTORY_MAX 32         // Tags collected by one inventory read
+#define FLIPPER_WEDGE_NFC_INVENTORY_RETRIES 3      // Failed or repeated selects before the field is considered empty
+#define FLIPPER_WEDGE_NFC_PRESENCE_ROUND_MS 100     // Pause between ISO15693 presence inventory rounds
 
 typedef struct FlipperWedgeNfc FlipperWedgeNfc;
 
@@ -19,16 +29,33 @@ typedef enum {
     FlipperWedgeNfcErrorNotForumCompliant, // Tag is not NFC Forum compliant (e.g., MIFARE Classic)
     FlipperWedgeNfcErrorUnsupportedType, // Tag detected but unsupported NFC Forum Type for NDEF
     FlipperWedgeNfcErrorNoTextRecord,    // Supported type but no NDEF text record found
+    FlipperWedgeNfcErrorClassicNoKey,    // MIFARE Classic sector not opened by any key in the key set
+    FlipperWedgeNfcErrorBusy,            // No free NDEF buffer, earlier reads still hold them all
 } FlipperWedgeNfcError;
 
 typedef struct {
     uint8_t uid[FLIPPER_WEDGE_NFC_UID_MAX_LEN];
     uint8_t uid_len;
-    char ndef_text[FLIPPER_WEDGE_NDEF_MAX_LEN];
+} FlipperWedgeNfcUid;
+
+typedef struct {
+    uint8_t uid[FLIPPER_WEDGE_NFC_UID_MAX_LEN];
+    uint8_t uid_len;
+    char protocol_name[32];
+    // Inventory reads: every tag in the field, sorted and without duplicates
+    // (uid is the first of them)
+    FlipperWedgeNfcUid inventory[FLIPPER_WEDGE_NFC_INVENTORY_MAX];
+    uint8_t inventory_count;
+    FlipperWedgeScanBuffer* ndef;  // NDEF text when has_ndef, valid during the callback only
     bool has_ndef;
+    bool ndef_streamed;  // NDEF text was delivered through the stream instead of ndef
     FlipperWedgeNfcError error;
 } FlipperWedgeNfcData;
 
+/** Tag read callback, runs on the thread calling flipper_wedge_nfc_tick()
+ * To keep the NDEF text past the callback take a reference with
+ * flipper_wedge_scan_buffer_ref(); the reader drops its own when it returns.
+ */
 typedef void (*FlipperWedgeNfcCallback)(FlipperWedgeNfcData* data, void* context);
 
 /** Allocate NFC reader
@@ -54,6 +81,13 @@ void flipper_wedge_nfc_set_callback(
     FlipperWedgeNfcCallback callback,
     void* context);
 
+/** Timestamp scanner detect, poller start and read complete of each read
+ *
+ * @param instance FlipperWedgeNfc instance
+ * @param latency FlipperWedgeLatency instance, NULL to stop timestamping
+ */
+void flipper_wedge_nfc_set_latency(FlipperWedgeNfc* instance, FlipperWedgeLatency* latency);
+
 /** Start NFC scanning
  *
  * @param instance FlipperWedgeNfc instance
@@ -67,6 +101,76 @@ void flipper_wedge_nfc_start(FlipperWedgeNfc* instance, bool parse_ndef);
  */
 void flipper_wedge_nfc_stop(FlipperWedgeNfc* instance);
 
+/** Deliver NDEF text in chunks while the tag is being read
+ * Applies to reads started with parse_ndef, from the next flipper_wedge_nfc_start().
+ * Text of any length is passed through FLIPPER_WEDGE_NDEF_STREAM_CHUNK_COUNT
+ * fixed-size chunks; the read waits while all of them are with the consumer.
+ * The tag callback then reports has_ndef with ndef_streamed set and no ndef buffer.
+ *
+ * @param instance FlipperWedgeNfc instance
+ * @param enabled true to stream, false to collect the text in one buffer
+ */
+void flipper_wedge_nfc_set_ndef_stream(FlipperWedgeNfc* instance, bool enabled);
+
+/** Read every ISO14443-3A tag in the field instead of the first one
+ * Applies from the next flipper_wedge_nfc_start(). Each tag is selected through
+ * anticollision and halted after its UID is read, so the next select finds
+ * another one, until no tag answers. The tag callback reports the batch in
+ * inventory/inventory_count. Other tag types are ignored.
+ *
+ * @param instance FlipperWedgeNfc instance
+ * @param enabled true for inventory reads
+ */
+void flipper_wedge_nfc_set_inventory(FlipperWedgeNfc* instance, bool enabled);
+
+/** Read a sector of MIFARE Classic tags instead of the UID only
+ * Applies from the next flipper_wedge_nfc_start(), not to inventory reads.
+ * The sector's data blocks are reported as the tag's text (has_ndef): as is
+ * up to the first NUL if that is printable ASCII, in hex otherwise. Keys come
+ * from the key set with the cached key for the UID and sector first; the
+ * cache is saved from flipper_wedge_nfc_tick() when a read changed it.
+ *
+ * @param instance FlipperWedgeNfc instance
+ * @param keys Key set and cache, NULL to read Classic tags as ISO14443-3A
+ * @param sector Sector to read
+ */
+void flipper_wedge_nfc_set_classic(FlipperWedgeNfc* instance, FlipperWedgeClassicKeys* keys, uint8_t sector);
+
+/** Run ISO15693 inventory rounds continuously instead of reading one tag
+ * Applies from the next flipper_wedge_nfc_start(). Every round reports each
+ * vicinity tag in the field through flipper_wedge_nfc_presence_next(); the tag
+ * callback is not used.
+ *
+ * @param instance FlipperWedgeNfc instance
+ * @param enabled true for presence rounds
+ */
+void flipper_wedge_nfc_set_presence(FlipperWedgeNfc* instance, bool enabled);
+
+/** Get the next UID seen by a presence round
+ *
+ * @param instance FlipperWedgeNfc instance
+ * @param uid UID, see flipper_wedge_iso15693_uid_to_bytes()
+ * @return true if a UID was returned, false if none is waiting
+ */
+bool flipper_wedge_nfc_presence_next(FlipperWedgeNfc* instance, uint64_t* uid);
+
+/** Check if streamed NDEF text is waiting to be collected
+ *
+ * @param instance FlipperWedgeNfc instance
+ * @return true if flipper_wedge_nfc_stream_next() has something to return
+ */
+bool flipper_wedge_nfc_stream_pending(FlipperWedgeNfc* instance);
+
+/** Get the next chunk of streamed NDEF text
+ * The caller owns the returned reference and releases it with
+ * flipper_wedge_scan_buffer_unref() when done, which lets the read continue.
+ *
+ * @param instance FlipperWedgeNfc instance
+ * @param timeout_ms Maximum time to wait for the reader
+ * @return Chunk with NUL-terminated text, or NULL at the end of the text or on timeout
+ */
+FlipperWedgeScanBuffer* flipper_wedge_nfc_stream_next(FlipperWedgeNfc* instance, uint32_t timeout_ms);
+
 /** Check if NFC is currently scanning
  *
  * @param instance FlipperWedgeNfc instance
@@ -74,6 +178,14 @@ void flipper_wedge_nfc_stop(FlipperWedgeNfc* instance);
  */
 bool flipper_wedge_nfc_is_scanning(FlipperWedgeNfc* instance);
 
+/** Check if a detected tag is being read
+ * The field must stay on until the read finishes or fails.
+ *
+ * @param instance FlipperWedgeNfc instance
+ * @return true between tag detection and the result
+ */
+bool flipper_wedge_nfc_is_reading(FlipperWedgeNfc* instance);
+
 /** Process NFC state machine from main thread
  * Call this in the tick event handler to safely process NFC events
  *
@@ -0,0 +1,50 @@
+#include "flipper_wedge_nkro_batch.h"
+
+size_t flipper_wedge_nkro_batch_next(
+    FlipperWedgeKeyboardLayout* layout,
+    const char** str,
+    size_t max_keys,
+    uint8_t* modifiers,
+    uint8_t* keys) {
+    furi_assert(str);
+    furi_assert(modifiers);
+    furi_assert(keys);
+
+    const char* c = *str;
+    size_t count = 0;
+    *modifiers = 0;
+
+    while(*c && count < max_keys) {
+        if((uint8_t)*c >= 0x80) break;
+
+        uint16_t keycode = layout ? flipper_wedge_keyboard_layout_get_keycode(layout, *c) :
+                                    HID_ASCII_TO_KEY(*c);
+        uint8_t key = keycode & 0xFF;
+        uint8_t key_modifiers = keycode >> 8;
+
+        if(keycode == HID_KEYBOARD_NONE || key > FLIPPER_WEDGE_NKRO_MAX_USAGE) {
+            // Not typeable, skipped like flipper_wedge_hid_type_char() does
+            c++;
+            continue;
+        }
+        if(count > 0 && (key_modifiers != *modifiers || key <= keys[count - 1])) {
+            break;
+        }
+
+        *modifiers = key_modifiers;
+        keys[count++] = key;
+        c++;
+    }
+
+    *str = c;
+    return count;
+}
+
+void flipper_wedge_nkro_batch_bitmap(const uint8_t* keys, size_t count, uint8_t* bitmap) {
+    memset(bitmap, 0, FLIPPER_WEDGE_NKRO_BITMAP_SIZE);
+    for(size_t i = 0; i < count; i++) {
+        if(keys[i] <= FLIPPER_WEDGE_NKRO_MAX_USAGE) {
+            bitmap[keys[i] / 8] |= 1 << (keys[i] % 8);
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <furi.h>
+#include "flipper_wedge_keyboard_layout.h"
+
+// Packing typed text into NKRO keyboard reports
+//
+// A host reports the keys newly pressed in one report in usage order, not in
+// the order they were put in the report. A batch therefore only grows while
+// the usages are strictly ascending and share one modifier state: the typed
+// order is kept and no key appears twice in a report (the host would see a
+// single press). Each batch is sent as one press report and one all-up
+// report, against two reports per character with a 6KRO keyboard.
+
+#define FLIPPER_WEDGE_NKRO_MAX_USAGE 0xDF  // Highest non-modifier usage in the bitmap
+#define FLIPPER_WEDGE_NKRO_BITMAP_SIZE ((FLIPPER_WEDGE_NKRO_MAX_USAGE + 1) / 8)
+
+/** Take the next batch of keys from a string
+ * Characters the layout cannot type are skipped. Stops before a non-ASCII
+ * byte, which is typed on its own with a Unicode input sequence.
+ *
+ * @param layout Keyboard layout (NULL for US QWERTY)
+ * @param str Text, advanced past the characters in the batch
+ * @param max_keys Keys one report can carry
+ * @param modifiers Receives the modifier byte (KEY_MOD_* >> 8) of the batch
+ * @param keys Receives up to max_keys usages
+ * @return Number of keys, 0 at the end of the string or at a non-ASCII byte
+ */
+size_t flipper_wedge_nkro_batch_next(
+    FlipperWedgeKeyboardLayout* layout,
+    const char** str,
+    size_t max_keys,
+    uint8_t* modifiers,
+    uint8_t* keys);
+
+/** Set the bitmap bits of a batch, one bit per usage 0x00-0xDF
+ *
+ * @param keys Key usages, ones above FLIPPER_WEDGE_NKRO_MAX_USAGE are dropped
+ * @param count Number of keys
+ * @param bitmap FLIPPER_WEDGE_NKRO_BITMAP_SIZE bytes, cleared first
+ */
+void flipper_wedge_nkro_batch_bitmap(const uint8_t* keys, size_t count, uint8_t* bitmap);
@@ -1,4 +1,7 @@
 #include "flipper_wedge_rfid.h"
+#include "flipper_wedge_debug.h"
+#include "flipper_wedge_rfid_decode.h"
+#include <lfrfid/lfrfid_worker.h>
 #include <lfrfid/protocols/lfrfid_protocols.h>
 
 #define TAG "FlipperWedgeRfid"
@@ -7,62 +10,148 @@ struct FlipperWedgeRfid {
     LFRFIDWorker* worker;
     ProtocolDict* dict;
 
+    // Protocols in the dictionary; the worker reports indexes into these
+    FlipperWedgeRfidProtocols protocols;
+    const ProtocolBase* dict_protocols[LFRFIDProtocolMax];
+    ProtocolId dict_ids[LFRFIDProtocolMax];  // LFRFIDProtocol of each entry
+    size_t dict_count;
+    LFRFIDWorkerReadType read_type;
+
     bool scanning;
+    uint32_t scan_start_tick;
 
     FlipperWedgeRfidCallback callback;
     void* callback_context;
 
-    FlipperWedgeRfidData last_data;
+    // Protocol data of the current read, sized for the largest protocol
+    uint8_t* scratch;
+    size_t scratch_size;
+
+    // Read being decoded, only touched by the LF worker thread
+    FlipperWedgeRfidData read;
 };
 
+// Runs on the LF worker thread: decode the read and hand it to the callback
 static void flipper_wedge_rfid_worker_callback(LFRFIDWorkerReadResult result, ProtocolId protocol, void* context) {
     furi_assert(context);
     FlipperWedgeRfid* instance = context;
 
-    if(result == LFRFIDWorkerReadDone) {
-        // Get protocol data
-        size_t data_size = protocol_dict_get_data_size(instance->dict, protocol);
-        if(data_size > FLIPPER_WEDGE_RFID_UID_MAX_LEN) {
-            data_size = FLIPPER_WEDGE_RFID_UID_MAX_LEN;
-        }
+    if(result != LFRFIDWorkerReadDone) {
+        return;
+    }
+
+    FlipperWedgeRfidData* data = &instance->read;
+    size_t data_size = protocol_dict_get_data_size(instance->dict, protocol);
+    furi_check(data_size <= instance->scratch_size);
+    protocol_dict_get_data(instance->dict, protocol, instance->scratch, data_size);
 
-        uint8_t* data = malloc(protocol_dict_get_data_size(instance->dict, protocol));
-        protocol_dict_get_data(instance->dict, protocol, data, protocol_dict_get_data_size(instance->dict, protocol));
+    data->uid_len = MIN(data_size, (size_t)FLIPPER_WEDGE_RFID_UID_MAX_LEN);
+    memcpy(data->uid, instance->scratch, data->uid_len);
 
-        // Copy to our data structure
-        instance->last_data.uid_len = data_size;
-        memcpy(instance->last_data.uid, data, data_size);
+    // Get protocol name
+    const char* name = protocol_dict_get_name(instance->dict, protocol);
+    if(name) {
+        snprintf(data->protocol_name, sizeof(data->protocol_name), "%s", name);
+    } else {
+        data->protocol_name[0] = '\0';
+    }
+
+    // Decode access-control fields once, formatting only reads them
+    flipper_wedge_rfid_decode(instance->dict_ids[protocol], instance->scratch, data_size, &data->decoded);
+
+    FURI_LOG_I(
+        TAG,
+        "RFID tag read: %s, len: %d, %lu ms",
+        data->protocol_name,
+        data->uid_len,
+        furi_get_tick() - instance->scan_start_tick);
+    flipper_wedge_debug_log_stack(TAG, "RFID read");
 
-        // Get protocol name
-        const char* name = protocol_dict_get_name(instance->dict, protocol);
-        if(name) {
-            snprintf(instance->last_data.protocol_name, sizeof(instance->last_data.protocol_name), "%s", name);
-        } else {
-            instance->last_data.protocol_name[0] = '\0';
-        }
+    if(instance->callback) {
+        instance->callback(data, instance->callback_context);
+    }
+}
 
-        free(data);
+static bool flipper_wedge_rfid_protocol_allowed(FlipperWedgeRfidProtocols protocols, ProtocolId id) {
+    bool em4100 = (id == LFRFIDProtocolEM4100);
+    bool hid_prox = (id == LFRFIDProtocolH10301 || id == LFRFIDProtocolHidGeneric);
+
+    switch(protocols) {
+    case FlipperWedgeRfidProtocolsAsk:
+        return lfrfid_protocols[id]->features & LFRFIDFeatureASK;
+    case FlipperWedgeRfidProtocolsEm4100:
+        return em4100;
+    case FlipperWedgeRfidProtocolsHidProx:
+        return hid_prox;
+    case FlipperWedgeRfidProtocolsEm4100HidProx:
+        return em4100 || hid_prox;
+    case FlipperWedgeRfidProtocolsPsk:
+        return lfrfid_protocols[id]->features & LFRFIDFeaturePSK;
+    case FlipperWedgeRfidProtocolsAll:
+    default:
+        return true;
+    }
+}
+
+// (Re)create the dictionary and worker for instance->protocols, must not be scanning
+static void flipper_wedge_rfid_build(FlipperWedgeRfid* instance) {
+    if(instance->worker) {
+        lfrfid_worker_free(instance->worker);
+    }
+    if(instance->dict) {
+        protocol_dict_free(instance->dict);
+    }
 
-        FURI_LOG_I(TAG, "RFID tag read: %s, len: %d", instance->last_data.protocol_name, instance->last_data.uid_len);
+    bool has_ask = false;
+    bool has_psk = false;
+    instance->dict_count = 0;
+    for(ProtocolId id = 0; id < LFRFIDProtocolMax; id++) {
+        if(!flipper_wedge_rfid_protocol_allowed(instance->protocols, id)) continue;
+
+        instance->dict_protocols[instance->dict_count] = lfrfid_protocols[id];
+        instance->dict_ids[instance->dict_count] = id;
+        instance->dict_count++;
+        has_ask |= (lfrfid_protocols[id]->features & LFRFIDFeatureASK) != 0;
+        has_psk |= (lfrfid_protocols[id]->features & LFRFIDFeaturePSK) != 0;
+    }
 
-        // Notify callback
-        if(instance->callback) {
-            instance->callback(&instance->last_data, instance->callback_context);
-        }
+    if(has_ask && !has_psk) {
+        instance->read_type = LFRFIDWorkerReadTypeASKOnly;
+    } else if(has_psk && !has_ask) {
+        instance->read_type = LFRFIDWorkerReadTypePSKOnly;
+    } else {
+        instance->read_type = LFRFIDWorkerReadTypeAuto;
     }
+
+    instance->dict = protocol_dict_alloc(instance->dict_protocols, instance->dict_count);
+    instance->worker = lfrfid_worker_alloc(instance->dict);
+
+    FURI_LOG_I(
+        TAG,
+        "Protocol set %d: %zu protocols, read type %d",
+        instance->protocols,
+        instance->dict_count,
+        instance->read_type);
 }
 
 FlipperWedgeRfid* flipper_wedge_rfid_alloc(void) {
     FlipperWedgeRfid* instance = malloc(sizeof(FlipperWedgeRfid));
 
-    instance->dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
-    instance->worker = lfrfid_worker_alloc(instance->dict);
+    instance->dict = NULL;
+    instance->worker = NULL;
+    instance->protocols = FlipperWedgeRfidProtocolsAll;
+    flipper_wedge_rfid_build(instance);
 
     instance->scanning = false;
+    instance->scan_start_tick = 0;
     instance->callback = NULL;
     instance->callback_context = NULL;
 
-    memset(&instance->last_data, 0, sizeof(FlipperWedgeRfidData));
+    // The first dictionary holds every protocol, so it sets the scratch size
+    instance->scratch_size = protocol_dict_get_max_data_size(instance->dict);
+    instance->scratch = malloc(instance->scratch_size);
+
+    memset(&instance->read, 0, sizeof(FlipperWedgeRfidData));
 
     FURI_LOG_I(TAG, "RFID reader allocated");
 
@@ -84,6 +173,8 @@ void flipper_wedge_rfid_free(FlipperWedgeRfid* instance) {
         instance->dict = NULL;
     }
 
+    free(instance->scratch);
+
     free(instance);
     FURI_LOG_I(TAG, "RFID reader freed");
 }
@@ -97,6 +188,27 @@ void flipper_wedge_rfid_set_callback(
     instance->callback_context = context;
 }
 
+void flipper_wedge_rfid_set_protocols(FlipperWedgeRfid* instance, FlipperWedgeRfidProtocols protocols) {
+    furi_assert(instance);
+
+    if(protocols >= FlipperWedgeRfidProtocolsCount) {
+        protocols = FlipperWedgeRfidProtocolsAll;
+    }
+    if(protocols == instance->protocols) {
+        return;
+    }
+
+    bool was_scanning = instance->scanning;
+    flipper_wedge_rfid_stop(instance);
+
+    instance->protocols = protocols;
+    flipper_wedge_rfid_build(instance);
+
+    if(was_scanning) {
+        flipper_wedge_rfid_start(instance);
+    }
+}
+
 void flipper_wedge_rfid_start(FlipperWedgeRfid* instance) {
     furi_assert(instance);
 
@@ -106,9 +218,10 @@ void flipper_wedge_rfid_start(FlipperWedgeRfid* instance) {
     }
 
     lfrfid_worker_start_thread(instance->worker);
-    lfrfid_worker_read_start(instance->worker, LFRFIDWorkerReadTypeAuto, flipper_wedge_rfid_worker_callback, instance);
+    lfrfid_worker_read_start(instance->worker, instance->read_type, flipper_wedge_rfid_worker_callback, instance);
 
     instance->scanning = true;
+    instance->scan_start_tick = furi_get_tick();
     FURI_LOG_I(TAG, "RFID scanning started");
 }
 
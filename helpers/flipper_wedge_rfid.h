@@ -1,18 +1,53 @@
 #pragma once
 
 #include <furi.h>
-#include <lfrfid/lfrfid_worker.h>
 
 #define FLIPPER_WEDGE_RFID_UID_MAX_LEN 8
+#define FLIPPER_WEDGE_RFID_NUMBER_MAX_LEN 16
 
 typedef struct FlipperWedgeRfid FlipperWedgeRfid;
 
+// LF protocols to demodulate. Narrower sets skip the ASK or PSK read windows
+typedef enum {
+    FlipperWedgeRfidProtocolsAll,            // Every protocol, ASK and PSK time-sliced
+    FlipperWedgeRfidProtocolsAsk,            // ASK protocols only (EM4100, HID, ...)
+    FlipperWedgeRfidProtocolsEm4100,
+    FlipperWedgeRfidProtocolsHidProx,        // H10301 and other HID Prox formats
+    FlipperWedgeRfidProtocolsEm4100HidProx,
+    FlipperWedgeRfidProtocolsPsk,            // PSK protocols only (Indala, Keri, ...)
+    FlipperWedgeRfidProtocolsCount,
+} FlipperWedgeRfidProtocols;
+
+// Decoded fields present in FlipperWedgeRfidDecoded
+typedef enum {
+    FlipperWedgeRfidFieldNumber = (1 << 0),    // Card number as printed on EM4100 fobs
+    FlipperWedgeRfidFieldFacility = (1 << 1),  // Wiegand facility code
+    FlipperWedgeRfidFieldCard = (1 << 2),      // Wiegand card number
+} FlipperWedgeRfidField;
+
+// Access-control fields decoded once from the raw protocol data
+typedef struct {
+    uint8_t fields;  // FlipperWedgeRfidField bits, 0 if the protocol has no decoder
+    char number[FLIPPER_WEDGE_RFID_NUMBER_MAX_LEN];  // Decimal text, e.g. "0012345678"
+    uint32_t facility;
+    uint32_t card;
+} FlipperWedgeRfidDecoded;
+
 typedef struct {
     uint8_t uid[FLIPPER_WEDGE_RFID_UID_MAX_LEN];
     uint8_t uid_len;
     char protocol_name[32];
+    FlipperWedgeRfidDecoded decoded;
 } FlipperWedgeRfidData;
 
+/** Tag detection callback
+ * Called on the LF worker thread for every read. The data is only valid during
+ * the call, copy what is needed. May wait briefly; flipper_wedge_rfid_stop()
+ * waits for it to return.
+ *
+ * @param data The read
+ * @param context Callback context
+ */
 typedef void (*FlipperWedgeRfidCallback)(FlipperWedgeRfidData* data, void* context);
 
 /** Allocate RFID reader
@@ -38,6 +73,15 @@ void flipper_wedge_rfid_set_callback(
     FlipperWedgeRfidCallback callback,
     void* context);
 
+/** Restrict scanning to a set of protocols
+ * Rebuilds the protocol dictionary and picks the narrowest read type for it.
+ * A running scan is restarted with the new set.
+ *
+ * @param instance FlipperWedgeRfid instance
+ * @param protocols Protocols to scan for
+ */
+void flipper_wedge_rfid_set_protocols(FlipperWedgeRfid* instance, FlipperWedgeRfidProtocols protocols);
+
 /** Start RFID scanning
  *
  * @param instance FlipperWedgeRfid instance
@@ -0,0 +1,50 @@
+#include "flipper_wedge_rfid_decode.h"
+
+typedef void (*FlipperWedgeRfidDecoder)(const uint8_t* data, FlipperWedgeRfidDecoded* decoded);
+
+typedef struct {
+    ProtocolId protocol;
+    size_t data_size;
+    FlipperWedgeRfidDecoder decode;
+} FlipperWedgeRfidDecoderEntry;
+
+// EM4100: [version][4 ID bytes]. Fobs print the 32-bit ID as 10 decimal digits,
+// and 26-bit Wiegand readers send its low 24 bits as facility (8) + card (16)
+static void flipper_wedge_rfid_decode_em4100(const uint8_t* data, FlipperWedgeRfidDecoded* decoded) {
+    uint32_t id = ((uint32_t)data[1] << 24) | ((uint32_t)data[2] << 16) |
+                  ((uint32_t)data[3] << 8) | data[4];
+    snprintf(decoded->number, sizeof(decoded->number), "%010lu", (unsigned long)id);
+    decoded->facility = data[2];
+    decoded->card = ((uint32_t)data[3] << 8) | data[4];
+    decoded->fields = FlipperWedgeRfidFieldNumber | FlipperWedgeRfidFieldFacility |
+                      FlipperWedgeRfidFieldCard;
+}
+
+// H10301 (HID Prox 26-bit): [facility][card high][card low], parity already stripped
+static void flipper_wedge_rfid_decode_h10301(const uint8_t* data, FlipperWedgeRfidDecoded* decoded) {
+    decoded->facility = data[0];
+    decoded->card = ((uint32_t)data[1] << 8) | data[2];
+    decoded->fields = FlipperWedgeRfidFieldFacility | FlipperWedgeRfidFieldCard;
+}
+
+static const FlipperWedgeRfidDecoderEntry flipper_wedge_rfid_decoders[] = {
+    {LFRFIDProtocolEM4100, 5, flipper_wedge_rfid_decode_em4100},
+    {LFRFIDProtocolH10301, 3, flipper_wedge_rfid_decode_h10301},
+};
+
+void flipper_wedge_rfid_decode(
+    ProtocolId protocol,
+    const uint8_t* data,
+    size_t data_size,
+    FlipperWedgeRfidDecoded* decoded) {
+    furi_assert(decoded);
+    memset(decoded, 0, sizeof(FlipperWedgeRfidDecoded));
+
+    for(size_t i = 0; i < COUNT_OF(flipper_wedge_rfid_decoders); i++) {
+        const FlipperWedgeRfidDecoderEntry* entry = &flipper_wedge_rfid_decoders[i];
+        if(entry->protocol == protocol && data_size >= entry->data_size) {
+            entry->decode(data, decoded);
+            return;
+        }
+    }
+}
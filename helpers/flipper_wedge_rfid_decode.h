@@ -0,0 +1,26 @@
+#pragma once
+
+#include <furi.h>
+#include <lfrfid/protocols/lfrfid_protocols.h>
+#include "flipper_wedge_rfid.h"
+
+// Access-control fields from LF protocol data
+//
+// A table keyed by protocol turns the data the firmware demodulator reports
+// into the numbers access-control back ends use: EM4100 as its 10-digit
+// decimal ID (plus the 24-bit facility/card split Wiegand readers send),
+// H10301 as facility code and card number. Decoding runs once per read in
+// the LF worker callback, formatting only reads the result.
+
+/** Decode the fields of one read
+ *
+ * @param protocol LFRFIDProtocol of the read
+ * @param data Protocol data as the protocol dictionary reports it
+ * @param data_size Length of data
+ * @param decoded Receives the fields, fields is 0 if the protocol has no decoder
+ */
+void flipper_wedge_rfid_decode(
+    ProtocolId protocol,
+    const uint8_t* data,
+    size_t data_size,
+    FlipperWedgeRfidDecoded* decoded);
@@ -0,0 +1,125 @@
+#include "flipper_wedge_scan_buffer.h"
+
+#define TAG "FlipperWedgeScanBuffer"
+
+struct FlipperWedgeScanBuffer {
+    FlipperWedgeScanBufferPool* pool;
+    uint32_t refs;
+    char* data;
+};
+
+struct FlipperWedgeScanBufferPool {
+    FuriMutex* mutex;
+    FuriSemaphore* free_count;  // Counts buffers with no references
+    size_t count;
+    size_t capacity;
+    FlipperWedgeScanBuffer* buffers;
+    char* storage;
+};
+
+FlipperWedgeScanBufferPool* flipper_wedge_scan_buffer_pool_alloc(size_t count, size_t capacity) {
+    furi_assert(count > 0);
+    furi_assert(capacity > 0);
+
+    FlipperWedgeScanBufferPool* pool = malloc(sizeof(FlipperWedgeScanBufferPool));
+    pool->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    pool->free_count = furi_semaphore_alloc(count, count);
+    pool->count = count;
+    pool->capacity = capacity;
+    pool->buffers = malloc(count * sizeof(FlipperWedgeScanBuffer));
+    pool->storage = malloc(count * capacity);
+
+    for(size_t i = 0; i < count; i++) {
+        pool->buffers[i].pool = pool;
+        pool->buffers[i].refs = 0;
+        pool->buffers[i].data = &pool->storage[i * capacity];
+        pool->buffers[i].data[0] = '\0';
+    }
+
+    return pool;
+}
+
+void flipper_wedge_scan_buffer_pool_free(FlipperWedgeScanBufferPool* pool) {
+    furi_assert(pool);
+
+    for(size_t i = 0; i < pool->count; i++) {
+        furi_check(pool->buffers[i].refs == 0);
+    }
+
+    furi_semaphore_free(pool->free_count);
+    furi_mutex_free(pool->mutex);
+    free(pool->storage);
+    free(pool->buffers);
+    free(pool);
+}
+
+FlipperWedgeScanBuffer* flipper_wedge_scan_buffer_acquire(FlipperWedgeScanBufferPool* pool) {
+    FlipperWedgeScanBuffer* buffer = flipper_wedge_scan_buffer_acquire_timeout(pool, 0);
+    if(!buffer) {
+        FURI_LOG_W(TAG, "Pool exhausted (%zu buffers in use)", pool->count);
+    }
+    return buffer;
+}
+
+FlipperWedgeScanBuffer* flipper_wedge_scan_buffer_acquire_timeout(
+    FlipperWedgeScanBufferPool* pool,
+    uint32_t timeout_ms) {
+    furi_assert(pool);
+
+    if(furi_semaphore_acquire(pool->free_count, furi_ms_to_ticks(timeout_ms)) != FuriStatusOk) {
+        return NULL;
+    }
+
+    FlipperWedgeScanBuffer* buffer = NULL;
+    furi_check(furi_mutex_acquire(pool->mutex, FuriWaitForever) == FuriStatusOk);
+    for(size_t i = 0; i < pool->count; i++) {
+        if(pool->buffers[i].refs == 0) {
+            buffer = &pool->buffers[i];
+            buffer->refs = 1;
+            buffer->data[0] = '\0';
+            break;
+        }
+    }
+    furi_mutex_release(pool->mutex);
+
+    // The semaphore guarantees a free slot
+    furi_check(buffer);
+    return buffer;
+}
+
+FlipperWedgeScanBuffer* flipper_wedge_scan_buffer_ref(FlipperWedgeScanBuffer* buffer) {
+    furi_assert(buffer);
+
+    FlipperWedgeScanBufferPool* pool = buffer->pool;
+    furi_check(furi_mutex_acquire(pool->mutex, FuriWaitForever) == FuriStatusOk);
+    furi_assert(buffer->refs > 0);
+    buffer->refs++;
+    furi_mutex_release(pool->mutex);
+
+    return buffer;
+}
+
+void flipper_wedge_scan_buffer_unref(FlipperWedgeScanBuffer* buffer) {
+    if(!buffer) return;
+
+    FlipperWedgeScanBufferPool* pool = buffer->pool;
+    furi_check(furi_mutex_acquire(pool->mutex, FuriWaitForever) == FuriStatusOk);
+    furi_check(buffer->refs > 0);
+    buffer->refs--;
+    bool released = (buffer->refs == 0);
+    furi_mutex_release(pool->mutex);
+
+    if(released) {
+        furi_semaphore_release(pool->free_count);
+    }
+}
+
+char* flipper_wedge_scan_buffer_data(FlipperWedgeScanBuffer* buffer) {
+    furi_assert(buffer);
+    return buffer->data;
+}
+
+size_t flipper_wedge_scan_buffer_capacity(FlipperWedgeScanBuffer* buffer) {
+    furi_assert(buffer);
+    return buffer->pool->capacity;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <furi.h>
+
+// Pool of reference-counted scan result buffers
+//
+// A reader acquires a buffer, fills it once, and hands it on. Each stage that
+// needs the text past the current call takes a reference instead of copying;
+// the buffer returns to the pool when the last reference is dropped. Buffers
+// are preallocated, so no heap traffic happens per scan.
+
+typedef struct FlipperWedgeScanBufferPool FlipperWedgeScanBufferPool;
+typedef struct FlipperWedgeScanBuffer FlipperWedgeScanBuffer;
+
+/** Allocate a buffer pool
+ *
+ * @param count Number of buffers
+ * @param capacity Size of each buffer in bytes
+ * @return FlipperWedgeScanBufferPool instance
+ */
+FlipperWedgeScanBufferPool* flipper_wedge_scan_buffer_pool_alloc(size_t count, size_t capacity);
+
+/** Free a buffer pool
+ * All buffers must have been released
+ *
+ * @param pool FlipperWedgeScanBufferPool instance
+ */
+void flipper_wedge_scan_buffer_pool_free(FlipperWedgeScanBufferPool* pool);
+
+/** Take a free buffer from the pool
+ * The buffer starts empty with one reference held by the caller.
+ * Thread-safe.
+ *
+ * @param pool FlipperWedgeScanBufferPool instance
+ * @return Buffer, or NULL if every buffer is in use
+ */
+FlipperWedgeScanBuffer* flipper_wedge_scan_buffer_acquire(FlipperWedgeScanBufferPool* pool);
+
+/** Take a free buffer, waiting for one to be released if the pool is empty
+ * Thread-safe.
+ *
+ * @param pool FlipperWedgeScanBufferPool instance
+ * @param timeout_ms Maximum time to wait
+ * @return Buffer, or NULL if none was released in time
+ */
+FlipperWedgeScanBuffer* flipper_wedge_scan_buffer_acquire_timeout(
+    FlipperWedgeScanBufferPool* pool,
+    uint32_t timeout_ms);
+
+/** Add a reference to a buffer
+ * Thread-safe.
+ *
+ * @param buffer Buffer
+ * @return The same buffer, for assignment
+ */
+FlipperWedgeScanBuffer* flipper_wedge_scan_buffer_ref(FlipperWedgeScanBuffer* buffer);
+
+/** Drop a reference, returning the buffer to its pool when it was the last one
+ * Thread-safe.
+ *
+ * @param buffer Buffer (NULL is ignored)
+ */
+void flipper_wedge_scan_buffer_unref(FlipperWedgeScanBuffer* buffer);
+
+/** Get the buffer contents
+ *
+ * @param buffer Buffer
+ * @return Writable storage of flipper_wedge_scan_buffer_capacity() bytes
+ */
+char* flipper_wedge_scan_buffer_data(FlipperWedgeScanBuffer* buffer);
+
+/** Get the buffer size
+ *
+ * @param buffer Buffer
+ * @return Capacity in bytes
+ */
+size_t flipper_wedge_scan_buffer_capacity(FlipperWedgeScanBuffer* buffer);
@@ -0,0 +1,124 @@
+#include "flipper_wedge_scan_queue.h"
+#include <furi_hal.h>
+#include <stdatomic.h>
+
+#define TAG "FlipperWedgeScanQueue"
+
+struct FlipperWedgeScanQueue {
+    FuriMessageQueue* queue;  // FlipperWedgeScanRecord by value
+    atomic_uint dropped;
+};
+
+static void flipper_wedge_scan_record_init(
+    FlipperWedgeScanRecord* record,
+    FlipperWedgeScanSource source,
+    const uint8_t* uid,
+    uint8_t uid_len,
+    const char* protocol) {
+    memset(record, 0, sizeof(FlipperWedgeScanRecord));
+    record->source = source;
+    record->uid_len = MIN(uid_len, (uint8_t)sizeof(record->uid));
+    memcpy(record->uid, uid, record->uid_len);
+    snprintf(record->protocol, sizeof(record->protocol), "%s", protocol);
+    record->read_tick = furi_get_tick();
+    record->timestamp = furi_hal_rtc_get_timestamp();
+}
+
+void flipper_wedge_scan_record_from_nfc(FlipperWedgeScanRecord* record, const FlipperWedgeNfcData* data) {
+    furi_assert(record);
+    furi_assert(data);
+
+    flipper_wedge_scan_record_init(
+        record, FlipperWedgeScanSourceNfc, data->uid, data->uid_len, data->protocol_name);
+    record->error = data->error;
+
+    // Keep a reference to the reader's NDEF buffer instead of copying the text
+    if(data->has_ndef && data->ndef) {
+        record->ndef = flipper_wedge_scan_buffer_ref(data->ndef);
+    }
+    // Streamed text has already been typed by the consumer
+    record->ndef_streamed = data->has_ndef && data->ndef_streamed;
+
+    // Inventory batches are only sent in inventory mode, copy just the tags found
+    if(data->inventory_count > 0) {
+        size_t size = data->inventory_count * sizeof(FlipperWedgeNfcUid);
+        record->inventory = malloc(size);
+        memcpy(record->inventory, data->inventory, size);
+        record->inventory_count = data->inventory_count;
+    }
+}
+
+void flipper_wedge_scan_record_from_rfid(FlipperWedgeScanRecord* record, const FlipperWedgeRfidData* data) {
+    furi_assert(record);
+    furi_assert(data);
+
+    flipper_wedge_scan_record_init(
+        record, FlipperWedgeScanSourceRfid, data->uid, data->uid_len, data->protocol_name);
+    record->decoded = data->decoded;
+}
+
+void flipper_wedge_scan_record_clear(FlipperWedgeScanRecord* record) {
+    furi_assert(record);
+
+    flipper_wedge_scan_buffer_unref(record->ndef);
+    free(record->inventory);
+    memset(record, 0, sizeof(FlipperWedgeScanRecord));
+}
+
+FlipperWedgeScanQueue* flipper_wedge_scan_queue_alloc(size_t depth) {
+    furi_assert(depth > 0);
+
+    FlipperWedgeScanQueue* queue = malloc(sizeof(FlipperWedgeScanQueue));
+    queue->queue = furi_message_queue_alloc(depth, sizeof(FlipperWedgeScanRecord));
+    atomic_init(&queue->dropped, 0);
+    return queue;
+}
+
+void flipper_wedge_scan_queue_free(FlipperWedgeScanQueue* queue) {
+    furi_assert(queue);
+
+    flipper_wedge_scan_queue_flush(queue);
+    furi_message_queue_free(queue->queue);
+    free(queue);
+}
+
+bool flipper_wedge_scan_queue_put(FlipperWedgeScanQueue* queue, FlipperWedgeScanRecord* record, uint32_t timeout_ms) {
+    furi_assert(queue);
+    furi_assert(record);
+
+    if(furi_message_queue_put(queue->queue, record, furi_ms_to_ticks(timeout_ms)) == FuriStatusOk) {
+        return true;
+    }
+
+    uint32_t dropped = atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed) + 1;
+    FURI_LOG_W(TAG, "Queue full, dropped read %lu (source %d)", dropped, record->source);
+    flipper_wedge_scan_record_clear(record);
+    return false;
+}
+
+bool flipper_wedge_scan_queue_get(FlipperWedgeScanQueue* queue, FlipperWedgeScanRecord* record) {
+    furi_assert(queue);
+    furi_assert(record);
+
+    return furi_message_queue_get(queue->queue, record, 0) == FuriStatusOk;
+}
+
+size_t flipper_wedge_scan_queue_count(FlipperWedgeScanQueue* queue) {
+    furi_assert(queue);
+    return furi_message_queue_get_count(queue->queue);
+}
+
+void flipper_wedge_scan_queue_flush(FlipperWedgeScanQueue* queue) {
+    furi_assert(queue);
+
+    // Taken one by one so each payload is released
+    FlipperWedgeScanRecord record;
+    while(flipper_wedge_scan_queue_get(queue, &record)) {
+        flipper_wedge_scan_record_clear(&record);
+    }
+}
+
+uint32_t flipper_wedge_scan_queue_get_dropped(FlipperWedgeScanQueue* queue) {
+    furi_assert(queue);
+    return atomic_load_explicit(&queue->dropped, memory_order_relaxed);
+}
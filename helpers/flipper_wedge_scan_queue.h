@@ -0,0 +1,122 @@
+#pragma once
+
+#include <furi.h>
+#include "flipper_wedge_nfc.h"
+#include "flipper_wedge_rfid.h"
+#include "flipper_wedge_scan_buffer.h"
+
+// Queue of scan records from the readers to the scene
+//
+// Each record is a self-contained copy of one read. Reader threads fill a
+// record and put it; the GUI thread takes records in arrival order and owns
+// them from then on. A read that arrives while the previous one is still
+// being formatted waits in the queue instead of overwriting it.
+//
+// Payloads travel as handles: the NDEF text is a reference to the reader's
+// scan buffer, an inventory batch is a heap copy sized to the batch. Both are
+// released by flipper_wedge_scan_record_clear().
+
+#define FLIPPER_WEDGE_SCAN_QUEUE_DEPTH 8    // Reads waiting for the scene
+#define FLIPPER_WEDGE_SCAN_QUEUE_WAIT_MS 50 // How long a reader thread waits for room
+
+typedef enum {
+    FlipperWedgeScanSourceNfc,
+    FlipperWedgeScanSourceRfid,
+} FlipperWedgeScanSource;
+
+typedef struct {
+    FlipperWedgeScanSource source;
+    uint8_t uid[FLIPPER_WEDGE_NFC_UID_MAX_LEN];  // Also fits RFID UIDs
+    uint8_t uid_len;
+    char protocol[32];
+    uint32_t read_tick;  // furi_get_tick() when the reader finished
+    uint32_t timestamp;  // RTC time of the read
+
+    // NFC only
+    FlipperWedgeNfcError error;
+    FlipperWedgeScanBuffer* ndef;  // Own reference to the NDEF text, NULL if none
+    bool ndef_streamed;            // NDEF text was typed while the tag was read
+    FlipperWedgeNfcUid* inventory; // Inventory batch, NULL if none
+    uint8_t inventory_count;
+
+    // RFID only
+    FlipperWedgeRfidDecoded decoded;
+} FlipperWedgeScanRecord;
+
+typedef struct FlipperWedgeScanQueue FlipperWedgeScanQueue;
+
+/** Fill a record from an NFC read
+ * Takes a reference to the NDEF text and copies the inventory batch, so the
+ * record stays valid after the reader callback returns.
+ *
+ * @param record Record to fill
+ * @param data NFC read
+ */
+void flipper_wedge_scan_record_from_nfc(FlipperWedgeScanRecord* record, const FlipperWedgeNfcData* data);
+
+/** Fill a record from an RFID read
+ *
+ * @param record Record to fill
+ * @param data RFID read
+ */
+void flipper_wedge_scan_record_from_rfid(FlipperWedgeScanRecord* record, const FlipperWedgeRfidData* data);
+
+/** Release the payload of a record and mark it empty (uid_len 0)
+ *
+ * @param record Record, may be empty
+ */
+void flipper_wedge_scan_record_clear(FlipperWedgeScanRecord* record);
+
+/** Allocate scan queue
+ *
+ * @param depth Number of records that can wait
+ * @return FlipperWedgeScanQueue instance
+ */
+FlipperWedgeScanQueue* flipper_wedge_scan_queue_alloc(size_t depth);
+
+/** Free scan queue, releasing records still waiting
+ *
+ * @param queue FlipperWedgeScanQueue instance
+ */
+void flipper_wedge_scan_queue_free(FlipperWedgeScanQueue* queue);
+
+/** Add a record to the queue
+ * The queue owns the record from here on. If there is no room within the
+ * timeout the record is cleared and counted as dropped. Thread-safe; the
+ * consumer thread must pass 0.
+ *
+ * @param queue FlipperWedgeScanQueue instance
+ * @param record Filled record
+ * @param timeout_ms How long to wait for room
+ * @return true if queued
+ */
+bool flipper_wedge_scan_queue_put(FlipperWedgeScanQueue* queue, FlipperWedgeScanRecord* record, uint32_t timeout_ms);
+
+/** Take the oldest record without waiting
+ * The caller owns it and releases it with flipper_wedge_scan_record_clear().
+ *
+ * @param queue FlipperWedgeScanQueue instance
+ * @param record Receives the record
+ * @return true if a record was waiting
+ */
+bool flipper_wedge_scan_queue_get(FlipperWedgeScanQueue* queue, FlipperWedgeScanRecord* record);
+
+/** Number of records waiting
+ *
+ * @param queue FlipperWedgeScanQueue instance
+ * @return Record count
+ */
+size_t flipper_wedge_scan_queue_count(FlipperWedgeScanQueue* queue);
+
+/** Release every waiting record
+ *
+ * @param queue FlipperWedgeScanQueue instance
+ */
+void flipper_wedge_scan_queue_flush(FlipperWedgeScanQueue* queue);
+
+/** Number of records dropped because the queue was full
+ *
+ * @param queue FlipperWedgeScanQueue instance
+ * @return Dropped record count since alloc
+ */
+uint32_t flipper_wedge_scan_queue_get_dropped(FlipperWedgeScanQueue* queue);
@@ -0,0 +1,259 @@
+#include "flipper_wedge_scheduler.h"
+
+#define TAG "FlipperWedgeScheduler"
+
+typedef struct {
+    uint16_t hf_ms;
+    uint16_t lf_ms;
+} FlipperWedgeFieldWindowsConfig;
+
+static const FlipperWedgeFieldWindowsConfig flipper_wedge_field_windows[FlipperWedgeFieldWindowsCount] = {
+    [FlipperWedgeFieldWindows250x750] = {250, 750},
+    [FlipperWedgeFieldWindows500x500] = {500, 500},
+    [FlipperWedgeFieldWindows250x1500] = {250, 1500},
+    [FlipperWedgeFieldWindows750x250] = {750, 250},
+};
+
+static const uint16_t flipper_wedge_idle_poll_ms[FlipperWedgeIdlePollCount] = {
+    [FlipperWedgeIdlePollOff] = 0,
+    [FlipperWedgeIdlePoll500ms] = 500,
+    [FlipperWedgeIdlePoll1s] = 1000,
+    [FlipperWedgeIdlePoll2s] = 2000,
+    [FlipperWedgeIdlePoll5s] = 5000,
+};
+
+struct FlipperWedgeScheduler {
+    FlipperWedgeNfc* nfc;
+    FlipperWedgeRfid* rfid;
+
+    uint8_t fields;            // Requested fields
+    FlipperWedgeField active;  // Field that is on now, None during an idle off-window
+    bool parse_ndef;
+    bool continuous;           // Never idle, see flipper_wedge_scheduler_start_continuous()
+
+    uint32_t hf_ms;
+    uint32_t lf_ms;
+    uint32_t idle_max_ms;  // 0: idle polling off
+    uint32_t off_ms;       // Next idle off-window
+
+    uint32_t scan_start_tick;
+    uint32_t window_start_tick;
+    uint32_t window_switches;
+    uint32_t activity_tick;  // Last read or wake
+
+    // Field duty report
+    uint32_t report_last_tick;
+    uint32_t report_total_ticks;
+    uint32_t report_on_ticks;
+    uint32_t report_reads;
+};
+
+FlipperWedgeScheduler* flipper_wedge_scheduler_alloc(FlipperWedgeNfc* nfc, FlipperWedgeRfid* rfid) {
+    furi_assert(nfc);
+    furi_assert(rfid);
+
+    FlipperWedgeScheduler* scheduler = malloc(sizeof(FlipperWedgeScheduler));
+    scheduler->nfc = nfc;
+    scheduler->rfid = rfid;
+    scheduler->fields = FlipperWedgeFieldNone;
+    scheduler->active = FlipperWedgeFieldNone;
+    scheduler->parse_ndef = false;
+    scheduler->continuous = false;
+    scheduler->scan_start_tick = 0;
+    scheduler->window_start_tick = 0;
+    scheduler->window_switches = 0;
+    scheduler->activity_tick = furi_get_tick();
+    scheduler->off_ms = FLIPPER_WEDGE_SCHEDULER_OFF_MIN_MS;
+    scheduler->report_last_tick = 0;
+    scheduler->report_total_ticks = 0;
+    scheduler->report_on_ticks = 0;
+    scheduler->report_reads = 0;
+    flipper_wedge_scheduler_set_windows(scheduler, FlipperWedgeFieldWindows250x750);
+    flipper_wedge_scheduler_set_idle_poll(scheduler, FlipperWedgeIdlePollOff);
+
+    return scheduler;
+}
+
+void flipper_wedge_scheduler_free(FlipperWedgeScheduler* scheduler) {
+    furi_assert(scheduler);
+    flipper_wedge_scheduler_stop(scheduler);
+    free(scheduler);
+}
+
+void flipper_wedge_scheduler_set_windows(FlipperWedgeScheduler* scheduler, FlipperWedgeFieldWindows windows) {
+    furi_assert(scheduler);
+
+    if(windows >= FlipperWedgeFieldWindowsCount) {
+        windows = FlipperWedgeFieldWindows250x750;
+    }
+    scheduler->hf_ms = flipper_wedge_field_windows[windows].hf_ms;
+    scheduler->lf_ms = flipper_wedge_field_windows[windows].lf_ms;
+}
+
+void flipper_wedge_scheduler_set_idle_poll(FlipperWedgeScheduler* scheduler, FlipperWedgeIdlePoll idle_poll) {
+    furi_assert(scheduler);
+
+    if(idle_poll >= FlipperWedgeIdlePollCount) {
+        idle_poll = FlipperWedgeIdlePollOff;
+    }
+    scheduler->idle_max_ms = flipper_wedge_idle_poll_ms[idle_poll];
+}
+
+void flipper_wedge_scheduler_wake(FlipperWedgeScheduler* scheduler) {
+    furi_assert(scheduler);
+
+    scheduler->activity_tick = furi_get_tick();
+    scheduler->off_ms = FLIPPER_WEDGE_SCHEDULER_OFF_MIN_MS;
+}
+
+static bool flipper_wedge_scheduler_is_idle(FlipperWedgeScheduler* scheduler, uint32_t now) {
+    return !scheduler->continuous && scheduler->idle_max_ms > 0 &&
+           now - scheduler->activity_tick >= furi_ms_to_ticks(FLIPPER_WEDGE_SCHEDULER_ACTIVE_MS);
+}
+
+static void flipper_wedge_scheduler_switch_off(FlipperWedgeScheduler* scheduler) {
+    flipper_wedge_nfc_stop(scheduler->nfc);
+    flipper_wedge_rfid_stop(scheduler->rfid);
+    scheduler->active = FlipperWedgeFieldNone;
+    scheduler->window_start_tick = furi_get_tick();
+}
+
+static void flipper_wedge_scheduler_switch_to(FlipperWedgeScheduler* scheduler, FlipperWedgeField field) {
+    if(field == FlipperWedgeFieldNfc) {
+        flipper_wedge_rfid_stop(scheduler->rfid);
+        flipper_wedge_nfc_start(scheduler->nfc, scheduler->parse_ndef);
+    } else {
+        flipper_wedge_nfc_stop(scheduler->nfc);
+        flipper_wedge_rfid_start(scheduler->rfid);
+    }
+
+    scheduler->active = field;
+    scheduler->window_start_tick = furi_get_tick();
+}
+
+void flipper_wedge_scheduler_start(FlipperWedgeScheduler* scheduler, uint8_t fields, bool parse_ndef) {
+    furi_assert(scheduler);
+
+    flipper_wedge_scheduler_stop(scheduler);
+
+    scheduler->fields = fields & FlipperWedgeFieldBoth;
+    scheduler->parse_ndef = parse_ndef;
+    scheduler->continuous = false;
+    scheduler->scan_start_tick = furi_get_tick();
+    scheduler->window_switches = 0;
+    scheduler->report_last_tick = scheduler->scan_start_tick;
+
+    if(scheduler->fields & FlipperWedgeFieldNfc) {
+        flipper_wedge_scheduler_switch_to(scheduler, FlipperWedgeFieldNfc);
+    } else if(scheduler->fields & FlipperWedgeFieldRfid) {
+        flipper_wedge_scheduler_switch_to(scheduler, FlipperWedgeFieldRfid);
+    }
+}
+
+void flipper_wedge_scheduler_start_continuous(
+    FlipperWedgeScheduler* scheduler,
+    uint8_t fields,
+    bool parse_ndef) {
+    furi_assert(scheduler);
+
+    flipper_wedge_scheduler_start(scheduler, fields, parse_ndef);
+    scheduler->continuous = true;
+}
+
+void flipper_wedge_scheduler_stop(FlipperWedgeScheduler* scheduler) {
+    furi_assert(scheduler);
+
+    flipper_wedge_nfc_stop(scheduler->nfc);
+    flipper_wedge_rfid_stop(scheduler->rfid);
+    scheduler->fields = FlipperWedgeFieldNone;
+    scheduler->active = FlipperWedgeFieldNone;
+}
+
+static void flipper_wedge_scheduler_report(FlipperWedgeScheduler* scheduler, uint32_t now) {
+    // Only scanning time counts, the gap while a scan is output is skipped
+    uint32_t delta = now - scheduler->report_last_tick;
+    scheduler->report_last_tick = now;
+    scheduler->report_total_ticks += delta;
+    if(scheduler->active != FlipperWedgeFieldNone) {
+        scheduler->report_on_ticks += delta;
+    }
+
+    if(scheduler->report_total_ticks < furi_ms_to_ticks(FLIPPER_WEDGE_SCHEDULER_REPORT_MS)) {
+        return;
+    }
+
+    // Reader power scales with the time a field is on
+    FURI_LOG_I(
+        TAG,
+        "Field on %lu%% of %lu s, %lu reads, %s (idle latency up to %lu ms)",
+        scheduler->report_on_ticks * 100 / scheduler->report_total_ticks,
+        scheduler->report_total_ticks / furi_ms_to_ticks(1000),
+        scheduler->report_reads,
+        flipper_wedge_scheduler_is_idle(scheduler, now) ? "idle" : "active",
+        scheduler->idle_max_ms);
+    scheduler->report_total_ticks = 0;
+    scheduler->report_on_ticks = 0;
+    scheduler->report_reads = 0;
+}
+
+void flipper_wedge_scheduler_tick(FlipperWedgeScheduler* scheduler) {
+    furi_assert(scheduler);
+
+    if(scheduler->fields == FlipperWedgeFieldNone) {
+        return;
+    }
+
+    uint32_t now = furi_get_tick();
+    flipper_wedge_scheduler_report(scheduler, now);
+
+    bool idle = flipper_wedge_scheduler_is_idle(scheduler, now);
+    uint32_t elapsed = now - scheduler->window_start_tick;
+
+    if(scheduler->active == FlipperWedgeFieldNone) {
+        // Idle off-window, cut short if idle polling was turned off meanwhile
+        if(!idle || elapsed >= furi_ms_to_ticks(MIN(scheduler->off_ms, scheduler->idle_max_ms))) {
+            scheduler->off_ms = MIN(scheduler->off_ms * 2, scheduler->idle_max_ms);
+            flipper_wedge_scheduler_switch_to(
+                scheduler,
+                (scheduler->fields & FlipperWedgeFieldNfc) ? FlipperWedgeFieldNfc : FlipperWedgeFieldRfid);
+        }
+    } else if(scheduler->active == FlipperWedgeFieldNfc) {
+        // Never cut the field while a detected tag is being read
+        if(elapsed >= furi_ms_to_ticks(scheduler->hf_ms) &&
+           !flipper_wedge_nfc_is_reading(scheduler->nfc)) {
+            if(scheduler->fields == FlipperWedgeFieldBoth) {
+                flipper_wedge_scheduler_switch_to(scheduler, FlipperWedgeFieldRfid);
+                scheduler->window_switches++;
+            } else if(idle) {
+                flipper_wedge_scheduler_switch_off(scheduler);
+            }
+        }
+    } else if(elapsed >= furi_ms_to_ticks(scheduler->lf_ms)) {
+        // Idle: off after each LF window, i.e. after a full HF+LF cycle in dual modes
+        if(idle) {
+            flipper_wedge_scheduler_switch_off(scheduler);
+        } else if(scheduler->fields == FlipperWedgeFieldBoth) {
+            flipper_wedge_scheduler_switch_to(scheduler, FlipperWedgeFieldNfc);
+            scheduler->window_switches++;
+        }
+    }
+}
+
+uint32_t flipper_wedge_scheduler_note_read(FlipperWedgeScheduler* scheduler, FlipperWedgeField field) {
+    furi_assert(scheduler);
+
+    uint32_t now = furi_get_tick();
+    uint32_t latency_ms = now - scheduler->scan_start_tick;
+    FURI_LOG_I(
+        TAG,
+        "%s read after %lu ms (%s, %s, %lu window switches)",
+        field == FlipperWedgeFieldNfc ? "NFC" : "RFID",
+        latency_ms,
+        scheduler->fields == FlipperWedgeFieldBoth ? "dual" : "single",
+        flipper_wedge_scheduler_is_idle(scheduler, now) ? "idle" : "active",
+        scheduler->window_switches);
+
+    scheduler->report_reads++;
+    flipper_wedge_scheduler_wake(scheduler);
+    return latency_ms;
+}
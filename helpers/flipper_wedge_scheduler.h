@@ -0,0 +1,132 @@
+#pragma once
+
+#include <furi.h>
+#include "flipper_wedge_nfc.h"
+#include "flipper_wedge_rfid.h"
+
+// Field scheduler
+//
+// Starts and stops the NFC and LF RFID readers for the scan modes. The HF and
+// LF readers cannot run at the same time, so when both fields are requested
+// the scheduler alternates HF and LF windows from the tick handler. The HF
+// window is held open while a detected tag is being read.
+//
+// With idle polling enabled, the fields are switched off between polls once
+// nothing has been read for FLIPPER_WEDGE_SCHEDULER_ACTIVE_MS. The off-windows
+// double from FLIPPER_WEDGE_SCHEDULER_OFF_MIN_MS up to the maximum idle
+// latency, and the next read goes back to full-rate polling.
+
+// Full-rate polling time after a read
+#define FLIPPER_WEDGE_SCHEDULER_ACTIVE_MS (30 * 1000)
+// First off-window when going idle
+#define FLIPPER_WEDGE_SCHEDULER_OFF_MIN_MS 250
+// Field duty/latency report interval
+#define FLIPPER_WEDGE_SCHEDULER_REPORT_MS (60 * 1000)
+
+typedef struct FlipperWedgeScheduler FlipperWedgeScheduler;
+
+// Fields to scan
+typedef enum {
+    FlipperWedgeFieldNone = 0,
+    FlipperWedgeFieldNfc = (1 << 0),
+    FlipperWedgeFieldRfid = (1 << 1),
+    FlipperWedgeFieldBoth = FlipperWedgeFieldNfc | FlipperWedgeFieldRfid,
+} FlipperWedgeField;
+
+// HF/LF window lengths used when both fields are scanned
+typedef enum {
+    FlipperWedgeFieldWindows250x750,   // Default: LF protocols need several frames
+    FlipperWedgeFieldWindows500x500,
+    FlipperWedgeFieldWindows250x1500,  // Long LF windows for PSK tags
+    FlipperWedgeFieldWindows750x250,   // Mostly NFC sites
+    FlipperWedgeFieldWindowsCount,
+} FlipperWedgeFieldWindows;
+
+// Maximum off-window (added detection latency) while idle
+typedef enum {
+    FlipperWedgeIdlePollOff,  // Default: always poll at full rate
+    FlipperWedgeIdlePoll500ms,
+    FlipperWedgeIdlePoll1s,
+    FlipperWedgeIdlePoll2s,
+    FlipperWedgeIdlePoll5s,
+    FlipperWedgeIdlePollCount,
+} FlipperWedgeIdlePoll;
+
+/** Allocate scheduler
+ *
+ * @param nfc NFC reader
+ * @param rfid RFID reader
+ * @return FlipperWedgeScheduler instance
+ */
+FlipperWedgeScheduler* flipper_wedge_scheduler_alloc(FlipperWedgeNfc* nfc, FlipperWedgeRfid* rfid);
+
+/** Free scheduler (stops both readers)
+ *
+ * @param scheduler FlipperWedgeScheduler instance
+ */
+void flipper_wedge_scheduler_free(FlipperWedgeScheduler* scheduler);
+
+/** Set HF/LF window lengths for dual-field scanning
+ *
+ * @param scheduler FlipperWedgeScheduler instance
+ * @param windows Window setting
+ */
+void flipper_wedge_scheduler_set_windows(FlipperWedgeScheduler* scheduler, FlipperWedgeFieldWindows windows);
+
+/** Set maximum idle latency
+ *
+ * @param scheduler FlipperWedgeScheduler instance
+ * @param idle_poll Idle poll setting, FlipperWedgeIdlePollOff to poll at full rate
+ */
+void flipper_wedge_scheduler_set_idle_poll(FlipperWedgeScheduler* scheduler, FlipperWedgeIdlePoll idle_poll);
+
+/** Go back to full-rate polling, as after a read (e.g. on user input)
+ *
+ * @param scheduler FlipperWedgeScheduler instance
+ */
+void flipper_wedge_scheduler_wake(FlipperWedgeScheduler* scheduler);
+
+/** Start scanning, stopping whatever was running
+ * Reader callbacks must already be set.
+ *
+ * @param scheduler FlipperWedgeScheduler instance
+ * @param fields FlipperWedgeField bits to scan
+ * @param parse_ndef Passed to flipper_wedge_nfc_start()
+ */
+void flipper_wedge_scheduler_start(FlipperWedgeScheduler* scheduler, uint8_t fields, bool parse_ndef);
+
+/** Start scanning at full rate, whatever the idle poll setting
+ * For readers that must see every poll round, e.g. NFC-V presence tracking,
+ * whose age-out is shorter than the idle off-windows. Lasts until the next
+ * flipper_wedge_scheduler_start().
+ *
+ * @param scheduler FlipperWedgeScheduler instance
+ * @param fields FlipperWedgeField bits to scan
+ * @param parse_ndef Passed to flipper_wedge_nfc_start()
+ */
+void flipper_wedge_scheduler_start_continuous(
+    FlipperWedgeScheduler* scheduler,
+    uint8_t fields,
+    bool parse_ndef);
+
+/** Stop both readers
+ *
+ * @param scheduler FlipperWedgeScheduler instance
+ */
+void flipper_wedge_scheduler_stop(FlipperWedgeScheduler* scheduler);
+
+/** Switch windows when due, call from the tick handler after flipper_wedge_nfc_tick()
+ * Also runs the idle off-windows and logs the field duty report.
+ *
+ * @param scheduler FlipperWedgeScheduler instance
+ */
+void flipper_wedge_scheduler_tick(FlipperWedgeScheduler* scheduler);
+
+/** Log detection latency for a read since flipper_wedge_scheduler_start()
+ * Counts as activity: polling goes back to full rate.
+ *
+ * @param scheduler FlipperWedgeScheduler instance
+ * @param field Field the tag was read on
+ * @return Milliseconds from start to detection
+ */
+uint32_t flipper_wedge_scheduler_note_read(FlipperWedgeScheduler* scheduler, FlipperWedgeField field);
@@ -111,6 +111,66 @@ void flipper_wedge_save_settings(void* context) {
             }
         }
     }
+    // Appended after the layout keys so older files still read in order
+    if(!flipper_format_write_bool(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_USB_NKRO, &app->usb_nkro, 1)) {
+        FURI_LOG_E(TAG, "Failed to write usb_nkro");
+        save_success = false;
+    }
+    if(!flipper_format_write_string_cstr(
+           fff_file,
+           FLIPPER_WEDGE_SETTINGS_KEY_OUTPUT_TEMPLATE,
+           flipper_wedge_template_get_source(app->output_template))) {
+        FURI_LOG_E(TAG, "Failed to write output_template");
+        save_success = false;
+    }
+    uint32_t rfid_protocols = app->rfid_protocols;
+    if(!flipper_format_write_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_RFID_PROTOCOLS, &rfid_protocols, 1)) {
+        FURI_LOG_E(TAG, "Failed to write rfid_protocols");
+        save_success = false;
+    }
+    uint32_t field_windows = app->field_windows;
+    if(!flipper_format_write_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_FIELD_WINDOWS, &field_windows, 1)) {
+        FURI_LOG_E(TAG, "Failed to write field_windows");
+        save_success = false;
+    }
+    uint32_t idle_poll = app->idle_poll;
+    if(!flipper_format_write_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_IDLE_POLL, &idle_poll, 1)) {
+        FURI_LOG_E(TAG, "Failed to write idle_poll");
+        save_success = false;
+    }
+    uint32_t batch_separator = app->batch_separator;
+    if(!flipper_format_write_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_BATCH_SEPARATOR, &batch_separator, 1)) {
+        FURI_LOG_E(TAG, "Failed to write batch_separator");
+        save_success = false;
+    }
+    if(!flipper_format_write_bool(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_LOOKUP, &app->lookup_enabled, 1)) {
+        FURI_LOG_E(TAG, "Failed to write lookup_enabled");
+        save_success = false;
+    }
+    uint32_t access_mode = app->access_mode;
+    if(!flipper_format_write_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_ACCESS_MODE, &access_mode, 1)) {
+        FURI_LOG_E(TAG, "Failed to write access_mode");
+        save_success = false;
+    }
+    uint32_t feedback_profile = app->feedback_profile;
+    if(!flipper_format_write_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_FEEDBACK_PROFILE, &feedback_profile, 1)) {
+        FURI_LOG_E(TAG, "Failed to write feedback_profile");
+        save_success = false;
+    }
+    uint32_t unicode_method = app->unicode_method;
+    if(!flipper_format_write_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_UNICODE_METHOD, &unicode_method, 1)) {
+        FURI_LOG_E(TAG, "Failed to write unicode_method");
+        save_success = false;
+    }
+    if(!flipper_format_write_bool(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_MACRO, &app->macro_enabled, 1)) {
+        FURI_LOG_E(TAG, "Failed to write macro_enabled");
+        save_success = false;
+    }
+    uint32_t classic_sector = app->classic_sector;
+    if(!flipper_format_write_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_CLASSIC_SECTOR, &classic_sector, 1)) {
+        FURI_LOG_E(TAG, "Failed to write classic_sector");
+        save_success = false;
+    }
 
     if(!flipper_format_rewind(fff_file)) {
         FURI_LOG_E(TAG, "Rewind error");
@@ -228,6 +288,18 @@ void flipper_wedge_read_settings(void* context) {
             case FlipperWedgeModeStartupDefaultRfidNfc:
                 app->mode = FlipperWedgeModeRfidThenNfc;
                 break;
+            case FlipperWedgeModeStartupDefaultNfcOrRfid:
+                app->mode = FlipperWedgeModeNfcOrRfid;
+                break;
+            case FlipperWedgeModeStartupDefaultNfcAndRfid:
+                app->mode = FlipperWedgeModeNfcAndRfid;
+                break;
+            case FlipperWedgeModeStartupDefaultInventory:
+                app->mode = FlipperWedgeModeInventory;
+                break;
+            case FlipperWedgeModeStartupDefaultPresence:
+                app->mode = FlipperWedgeModePresence;
+                break;
             default:
                 app->mode = FlipperWedgeModeNfc;
                 break;
@@ -236,7 +308,7 @@ void flipper_wedge_read_settings(void* context) {
 
     // Read output mode setting (default to USB)
     // Note: Old file versions (< 5) are rejected above, so no migration needed
-    // Current format: 0 = USB, 1 = BLE
+    // Current format: 0 = USB, 1 = BLE, 2 = USB Serial
     uint32_t output_mode = FlipperWedgeOutputUsb;  // Default to USB
     if(flipper_format_read_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_OUTPUT_MODE, &output_mode, 1)) {
         // Validate output_mode is within valid range
@@ -314,6 +386,85 @@ void flipper_wedge_read_settings(void* context) {
         }
     }
 
+    // Read USB keyboard interface (default to firmware 6KRO keyboard)
+    flipper_format_read_bool(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_USB_NKRO, &app->usb_nkro, 1);
+
+    // Read output template (default to built-in format), compiled once here
+    FuriString* output_template = furi_string_alloc();
+    if(flipper_format_read_string(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_OUTPUT_TEMPLATE, output_template)) {
+        if(!flipper_wedge_template_compile(app->output_template, furi_string_get_cstr(output_template))) {
+            FURI_LOG_W(TAG, "Invalid output template, using built-in format");
+        } else if(flipper_wedge_template_is_set(app->output_template)) {
+            flipper_wedge_template_benchmark(app->output_template);
+        }
+    }
+    furi_string_free(output_template);
+
+    // Read LF protocol allowlist (default to all protocols)
+    uint32_t rfid_protocols = FlipperWedgeRfidProtocolsAll;
+    if(flipper_format_read_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_RFID_PROTOCOLS, &rfid_protocols, 1)) {
+        if(rfid_protocols < FlipperWedgeRfidProtocolsCount) {
+            app->rfid_protocols = (FlipperWedgeRfidProtocols)rfid_protocols;
+        } else {
+            FURI_LOG_E(TAG, "Invalid RFID protocols %lu, using all", rfid_protocols);
+        }
+    }
+
+    // Read HF/LF window lengths for dual-field modes
+    uint32_t field_windows = FlipperWedgeFieldWindows250x750;
+    if(flipper_format_read_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_FIELD_WINDOWS, &field_windows, 1) &&
+       field_windows < FlipperWedgeFieldWindowsCount) {
+        app->field_windows = (FlipperWedgeFieldWindows)field_windows;
+    }
+
+    // Read max idle latency
+    uint32_t idle_poll = FlipperWedgeIdlePollOff;
+    if(flipper_format_read_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_IDLE_POLL, &idle_poll, 1) &&
+       idle_poll < FlipperWedgeIdlePollCount) {
+        app->idle_poll = (FlipperWedgeIdlePoll)idle_poll;
+    }
+
+    // Read inventory batch separator
+    uint32_t batch_separator = FlipperWedgeBatchSeparatorEnter;
+    if(flipper_format_read_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_BATCH_SEPARATOR, &batch_separator, 1) &&
+       batch_separator < FlipperWedgeBatchSeparatorCount) {
+        app->batch_separator = (FlipperWedgeBatchSeparator)batch_separator;
+    }
+
+    // Read lookup table setting
+    flipper_format_read_bool(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_LOOKUP, &app->lookup_enabled, 1);
+
+    // Read access list mode
+    uint32_t access_mode = FlipperWedgeAccessModeOff;
+    if(flipper_format_read_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_ACCESS_MODE, &access_mode, 1) &&
+       access_mode < FlipperWedgeAccessModeCount) {
+        app->access_mode = (FlipperWedgeAccessMode)access_mode;
+    }
+
+    // Read feedback profile
+    uint32_t feedback_profile = FlipperWedgeFeedbackProfileStandard;
+    if(flipper_format_read_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_FEEDBACK_PROFILE, &feedback_profile, 1) &&
+       feedback_profile < FlipperWedgeFeedbackProfileCount) {
+        app->feedback_profile = (FlipperWedgeFeedbackProfile)feedback_profile;
+    }
+
+    // Read Unicode input method
+    uint32_t unicode_method = FlipperWedgeUnicodeMethodAscii;
+    if(flipper_format_read_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_UNICODE_METHOD, &unicode_method, 1) &&
+       unicode_method < FlipperWedgeUnicodeMethodCount) {
+        app->unicode_method = (FlipperWedgeUnicodeMethod)unicode_method;
+    }
+
+    // Read post-scan macro setting
+    flipper_format_read_bool(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_MACRO, &app->macro_enabled, 1);
+
+    // Read MIFARE Classic sector
+    uint32_t classic_sector = FLIPPER_WEDGE_CLASSIC_SECTOR_OFF;
+    if(flipper_format_read_uint32(fff_file, FLIPPER_WEDGE_SETTINGS_KEY_CLASSIC_SECTOR, &classic_sector, 1) &&
+       (classic_sector < FLIPPER_WEDGE_CLASSIC_SECTOR_COUNT || classic_sector == FLIPPER_WEDGE_CLASSIC_SECTOR_OFF)) {
+        app->classic_sector = classic_sector;
+    }
+
     flipper_format_rewind(fff_file);
 
     flipper_wedge_close_config_file(fff_file);
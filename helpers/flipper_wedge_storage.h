@@ -26,6 +26,18 @@
 #define FLIPPER_WEDGE_SETTINGS_KEY_LOG_TO_SD "LogToSd"
 #define FLIPPER_WEDGE_SETTINGS_KEY_LAYOUT_TYPE "LayoutType"
 #define FLIPPER_WEDGE_SETTINGS_KEY_LAYOUT_FILE "LayoutFile"
+#define FLIPPER_WEDGE_SETTINGS_KEY_USB_NKRO "UsbNkro"
+#define FLIPPER_WEDGE_SETTINGS_KEY_OUTPUT_TEMPLATE "OutputTemplate"
+#define FLIPPER_WEDGE_SETTINGS_KEY_RFID_PROTOCOLS "RfidProtocols"
+#define FLIPPER_WEDGE_SETTINGS_KEY_FIELD_WINDOWS "FieldWindows"
+#define FLIPPER_WEDGE_SETTINGS_KEY_IDLE_POLL "IdlePoll"
+#define FLIPPER_WEDGE_SETTINGS_KEY_BATCH_SEPARATOR "BatchSeparator"
+#define FLIPPER_WEDGE_SETTINGS_KEY_LOOKUP "Lookup"
+#define FLIPPER_WEDGE_SETTINGS_KEY_ACCESS_MODE "AccessMode"
+#define FLIPPER_WEDGE_SETTINGS_KEY_FEEDBACK_PROFILE "FeedbackProfile"
+#define FLIPPER_WEDGE_SETTINGS_KEY_UNICODE_METHOD "UnicodeInput"
+#define FLIPPER_WEDGE_SETTINGS_KEY_MACRO "Macro"
+#define FLIPPER_WEDGE_SETTINGS_KEY_CLASSIC_SECTOR "ClassicSector"
 
 void flipper_wedge_save_settings(void* context);
 void flipper_wedge_read_settings(void* context);
\ No newline at end of file
@@ -0,0 +1,420 @@
+#include "flipper_wedge_template.h"
+#include "flipper_wedge_format.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TAG "FlipperWedgeTemplate"
+
+#define TEMPLATE_CODE_SIZE 256
+#define TEMPLATE_FIELD_MAX_LEN 32
+#define TEMPLATE_UID_MAX_LEN 16
+#define TEMPLATE_LITERAL_MAX_LEN 255
+#define TEMPLATE_RANGE_END 0xFF
+#define TEMPLATE_VALUE_MAX_WIDTH 10
+
+// Bytecode: one opcode byte followed by its operands
+typedef enum {
+    FlipperWedgeTemplateOpEnd,
+    FlipperWedgeTemplateOpLiteral,    // [len] [len bytes]
+    FlipperWedgeTemplateOpDelimiter,
+    FlipperWedgeTemplateOpNdef,
+    FlipperWedgeTemplateOpUid,        // [source] [first] [last] [flags]
+    FlipperWedgeTemplateOpRfidNumber,
+    FlipperWedgeTemplateOpRfidValue,  // [FlipperWedgeRfidField] [width]
+} FlipperWedgeTemplateOp;
+
+typedef enum {
+    FlipperWedgeTemplateSourceNfc,
+    FlipperWedgeTemplateSourceRfid,
+} FlipperWedgeTemplateSource;
+
+#define TEMPLATE_FLAG_DEC (1 << 0)
+#define TEMPLATE_FLAG_REV (1 << 1)
+#define TEMPLATE_FLAG_LOWER (1 << 2)
+#define TEMPLATE_FLAG_NOSEP (1 << 3)
+
+struct FlipperWedgeTemplate {
+    char source[FLIPPER_WEDGE_TEMPLATE_SOURCE_MAX_LEN];
+    uint8_t code[TEMPLATE_CODE_SIZE];
+    size_t code_len;
+    size_t literal_at;  // Offset of the open literal's length byte, 0 if none
+};
+
+static const char template_hex_upper[] = "0123456789ABCDEF";
+static const char template_hex_lower[] = "0123456789abcdef";
+
+FlipperWedgeTemplate* flipper_wedge_template_alloc(void) {
+    FlipperWedgeTemplate* tpl = malloc(sizeof(FlipperWedgeTemplate));
+    flipper_wedge_template_compile(tpl, "");
+    return tpl;
+}
+
+void flipper_wedge_template_free(FlipperWedgeTemplate* tpl) {
+    furi_assert(tpl);
+    free(tpl);
+}
+
+static bool flipper_wedge_template_emit(FlipperWedgeTemplate* tpl, uint8_t byte) {
+    // Keep one byte free for the final End
+    if(tpl->code_len + 1 >= TEMPLATE_CODE_SIZE) return false;
+    tpl->code[tpl->code_len++] = byte;
+    return true;
+}
+
+static bool flipper_wedge_template_emit_literal(FlipperWedgeTemplate* tpl, char c) {
+    if(tpl->literal_at == 0 || tpl->code[tpl->literal_at] == TEMPLATE_LITERAL_MAX_LEN) {
+        if(!flipper_wedge_template_emit(tpl, FlipperWedgeTemplateOpLiteral)) return false;
+        tpl->literal_at = tpl->code_len;
+        if(!flipper_wedge_template_emit(tpl, 0)) return false;
+    }
+    if(!flipper_wedge_template_emit(tpl, (uint8_t)c)) return false;
+    tpl->code[tpl->literal_at]++;
+    return true;
+}
+
+// Parse "N" or "N-M" into a byte range
+static bool flipper_wedge_template_parse_range(const char* option, uint8_t* first, uint8_t* last) {
+    char* end;
+    unsigned long from = strtoul(option, &end, 10);
+    unsigned long to = from;
+    if(*end == '-') {
+        to = strtoul(end + 1, &end, 10);
+    }
+    if(*end != '\0' || from > to || to >= TEMPLATE_UID_MAX_LEN) return false;
+
+    *first = from;
+    *last = to;
+    return true;
+}
+
+// Compile the text between braces
+static bool flipper_wedge_template_compile_field(FlipperWedgeTemplate* tpl, const char* field, size_t len) {
+    char buf[TEMPLATE_FIELD_MAX_LEN];
+    if(len == 0 || len >= sizeof(buf)) return false;
+    memcpy(buf, field, len);
+    buf[len] = '\0';
+
+    char* options = strchr(buf, ':');
+    if(options) {
+        *options++ = '\0';
+    }
+
+    tpl->literal_at = 0;
+
+    if(strcmp(buf, "sep") == 0 || strcmp(buf, "ndef") == 0) {
+        if(options) return false;
+        return flipper_wedge_template_emit(
+            tpl, buf[0] == 's' ? FlipperWedgeTemplateOpDelimiter : FlipperWedgeTemplateOpNdef);
+    }
+
+    if(strcmp(buf, "rfid_num") == 0) {
+        if(options) return false;
+        return flipper_wedge_template_emit(tpl, FlipperWedgeTemplateOpRfidNumber);
+    }
+
+    if(strcmp(buf, "rfid_fc") == 0 || strcmp(buf, "rfid_card") == 0) {
+        unsigned long width = 0;
+        if(options) {
+            char* end;
+            width = strtoul(options, &end, 10);
+            if(end == options || *end != '\0' || width > TEMPLATE_VALUE_MAX_WIDTH) return false;
+        }
+        uint8_t field = (buf[5] == 'f') ? FlipperWedgeRfidFieldFacility : FlipperWedgeRfidFieldCard;
+        return flipper_wedge_template_emit(tpl, FlipperWedgeTemplateOpRfidValue) &&
+               flipper_wedge_template_emit(tpl, field) &&
+               flipper_wedge_template_emit(tpl, width);
+    }
+
+    FlipperWedgeTemplateSource source;
+    if(strcmp(buf, "nfc") == 0) {
+        source = FlipperWedgeTemplateSourceNfc;
+    } else if(strcmp(buf, "rfid") == 0) {
+        source = FlipperWedgeTemplateSourceRfid;
+    } else {
+        return false;
+    }
+
+    uint8_t first = 0;
+    uint8_t last = TEMPLATE_RANGE_END;
+    uint8_t flags = 0;
+    while(options) {
+        char* option = options;
+        options = strchr(options, ':');
+        if(options) {
+            *options++ = '\0';
+        }
+
+        if(strcmp(option, "hex") == 0) {
+            flags &= ~TEMPLATE_FLAG_DEC;
+        } else if(strcmp(option, "dec") == 0) {
+            flags |= TEMPLATE_FLAG_DEC;
+        } else if(strcmp(option, "rev") == 0) {
+            flags |= TEMPLATE_FLAG_REV;
+        } else if(strcmp(option, "lower") == 0) {
+            flags |= TEMPLATE_FLAG_LOWER;
+        } else if(strcmp(option, "nosep") == 0) {
+            flags |= TEMPLATE_FLAG_NOSEP;
+        } else if(option[0] >= '0' && option[0] <= '9') {
+            if(!flipper_wedge_template_parse_range(option, &first, &last)) return false;
+        } else {
+            return false;
+        }
+    }
+
+    return flipper_wedge_template_emit(tpl, FlipperWedgeTemplateOpUid) &&
+           flipper_wedge_template_emit(tpl, source) &&
+           flipper_wedge_template_emit(tpl, first) &&
+           flipper_wedge_template_emit(tpl, last) &&
+           flipper_wedge_template_emit(tpl, flags);
+}
+
+bool flipper_wedge_template_compile(FlipperWedgeTemplate* tpl, const char* source) {
+    furi_assert(tpl);
+    furi_assert(source);
+
+    snprintf(tpl->source, sizeof(tpl->source), "%s", source);
+    tpl->code_len = 0;
+    tpl->literal_at = 0;
+
+    bool ok = true;
+    const char* p = tpl->source;
+    while(ok && *p != '\0') {
+        if(*p == '\\') {
+            p++;
+            switch(*p) {
+            case 't':
+                ok = flipper_wedge_template_emit_literal(tpl, '\t');
+                break;
+            case 'n':
+                ok = flipper_wedge_template_emit_literal(tpl, '\n');
+                break;
+            case '\\':
+            case '{':
+            case '}':
+                ok = flipper_wedge_template_emit_literal(tpl, *p);
+                break;
+            default:
+                ok = false;
+                break;
+            }
+            if(ok) p++;
+        } else if(*p == '{') {
+            const char* end = strchr(p, '}');
+            ok = end && flipper_wedge_template_compile_field(tpl, p + 1, end - p - 1);
+            if(ok) p = end + 1;
+        } else if(*p == '}') {
+            ok = false;
+        } else {
+            ok = flipper_wedge_template_emit_literal(tpl, *p);
+            p++;
+        }
+    }
+
+    if(!ok) {
+        FURI_LOG_E(TAG, "Template error at offset %d: %s", (int)(p - tpl->source), tpl->source);
+        tpl->code_len = 0;
+    }
+
+    // emit() always leaves room for this
+    tpl->code[tpl->code_len++] = FlipperWedgeTemplateOpEnd;
+    tpl->literal_at = 0;
+
+    if(ok && tpl->code_len > 1) {
+        FURI_LOG_I(TAG, "Compiled template to %zu bytes: %s", tpl->code_len, tpl->source);
+    }
+    return ok;
+}
+
+bool flipper_wedge_template_is_set(const FlipperWedgeTemplate* tpl) {
+    furi_assert(tpl);
+    return tpl->code[0] != FlipperWedgeTemplateOpEnd;
+}
+
+const char* flipper_wedge_template_get_source(const FlipperWedgeTemplate* tpl) {
+    furi_assert(tpl);
+    return tpl->source;
+}
+
+static inline void flipper_wedge_template_append(
+    char* output,
+    size_t output_size,
+    size_t* pos,
+    const char* text,
+    size_t len) {
+    size_t room = output_size - 1 - *pos;
+    if(len > room) len = room;
+    memcpy(&output[*pos], text, len);
+    *pos += len;
+}
+
+static void flipper_wedge_template_render_uid(
+    const uint8_t* code,
+    const FlipperWedgeTemplateData* data,
+    char* output,
+    size_t output_size,
+    size_t* pos) {
+    const uint8_t* uid;
+    size_t uid_len;
+    if(code[0] == FlipperWedgeTemplateSourceNfc) {
+        uid = data->nfc_uid;
+        uid_len = data->nfc_uid_len;
+    } else {
+        uid = data->rfid_uid;
+        uid_len = data->rfid_uid_len;
+    }
+
+    size_t first = code[1];
+    size_t last = code[2];
+    uint8_t flags = code[3];
+    if(!uid || first >= uid_len) return;
+    if(last >= uid_len) last = uid_len - 1;
+
+    uint8_t bytes[TEMPLATE_UID_MAX_LEN];
+    size_t count = MIN(last - first + 1, sizeof(bytes));
+    for(size_t i = 0; i < count; i++) {
+        bytes[i] = (flags & TEMPLATE_FLAG_REV) ? uid[first + count - 1 - i] : uid[first + i];
+    }
+
+    if(flags & TEMPLATE_FLAG_DEC) {
+        // Big-endian bytes to decimal by repeated division, any length
+        char digits[TEMPLATE_UID_MAX_LEN * 3];
+        size_t digit_count = 0;
+        size_t start = 0;
+        while(start < count && bytes[start] == 0) start++;
+        while(start < count) {
+            uint32_t remainder = 0;
+            for(size_t i = start; i < count; i++) {
+                uint32_t value = (remainder << 8) | bytes[i];
+                bytes[i] = value / 10;
+                remainder = value % 10;
+            }
+            digits[digit_count++] = '0' + remainder;
+            while(start < count && bytes[start] == 0) start++;
+        }
+        if(digit_count == 0) {
+            digits[digit_count++] = '0';
+        }
+        while(digit_count > 0 && *pos + 1 < output_size) {
+            output[(*pos)++] = digits[--digit_count];
+        }
+        return;
+    }
+
+    const char* hex = (flags & TEMPLATE_FLAG_LOWER) ? template_hex_lower : template_hex_upper;
+    size_t delim_len = (flags & TEMPLATE_FLAG_NOSEP) || !data->delimiter ? 0 : strlen(data->delimiter);
+    for(size_t i = 0; i < count; i++) {
+        if(i > 0 && delim_len > 0) {
+            flipper_wedge_template_append(output, output_size, pos, data->delimiter, delim_len);
+        }
+        char byte_hex[2] = {hex[bytes[i] >> 4], hex[bytes[i] & 0x0F]};
+        flipper_wedge_template_append(output, output_size, pos, byte_hex, sizeof(byte_hex));
+    }
+}
+
+size_t flipper_wedge_template_render(
+    const FlipperWedgeTemplate* tpl,
+    const FlipperWedgeTemplateData* data,
+    char* output,
+    size_t output_size) {
+    furi_assert(tpl);
+    furi_assert(data);
+
+    if(!output || output_size == 0) {
+        return 0;
+    }
+
+    size_t pos = 0;
+    const uint8_t* pc = tpl->code;
+    while(true) {
+        switch(*pc++) {
+        case FlipperWedgeTemplateOpLiteral:
+            flipper_wedge_template_append(output, output_size, &pos, (const char*)pc + 1, pc[0]);
+            pc += 1 + pc[0];
+            break;
+        case FlipperWedgeTemplateOpDelimiter:
+            if(data->delimiter) {
+                flipper_wedge_template_append(
+                    output, output_size, &pos, data->delimiter, strlen(data->delimiter));
+            }
+            break;
+        case FlipperWedgeTemplateOpNdef:
+            if(data->ndef_text) {
+                flipper_wedge_template_append(
+                    output, output_size, &pos, data->ndef_text, strlen(data->ndef_text));
+            }
+            break;
+        case FlipperWedgeTemplateOpRfidNumber:
+            if(data->rfid_decoded && (data->rfid_decoded->fields & FlipperWedgeRfidFieldNumber)) {
+                flipper_wedge_template_append(
+                    output,
+                    output_size,
+                    &pos,
+                    data->rfid_decoded->number,
+                    strlen(data->rfid_decoded->number));
+            }
+            break;
+        case FlipperWedgeTemplateOpRfidValue:
+            if(data->rfid_decoded && (data->rfid_decoded->fields & pc[0])) {
+                uint32_t value = (pc[0] == FlipperWedgeRfidFieldFacility) ?
+                                     data->rfid_decoded->facility :
+                                     data->rfid_decoded->card;
+                char text[TEMPLATE_VALUE_MAX_WIDTH + 1];
+                int len = snprintf(text, sizeof(text), "%0*lu", pc[1], (unsigned long)value);
+                flipper_wedge_template_append(output, output_size, &pos, text, len);
+            }
+            pc += 2;
+            break;
+        case FlipperWedgeTemplateOpUid:
+            flipper_wedge_template_render_uid(pc, data, output, output_size, &pos);
+            pc += 4;
+            break;
+        case FlipperWedgeTemplateOpEnd:
+        default:
+            output[pos] = '\0';
+            return pos;
+        }
+    }
+}
+
+void flipper_wedge_template_benchmark(const FlipperWedgeTemplate* tpl) {
+#ifdef FURI_DEBUG
+    const uint32_t iterations = 10000;
+    const uint8_t nfc_uid[] = {0x04, 0xA1, 0xB2, 0xC3, 0xD4, 0xE5, 0xF6};
+    const uint8_t rfid_uid[] = {0x1A, 0x2B, 0x3C, 0x4D, 0x5E};
+    const FlipperWedgeTemplateData data = {
+        .nfc_uid = nfc_uid,
+        .nfc_uid_len = sizeof(nfc_uid),
+        .rfid_uid = rfid_uid,
+        .rfid_uid_len = sizeof(rfid_uid),
+        .rfid_decoded = NULL,
+        .ndef_text = NULL,
+        .delimiter = ":",
+    };
+    char output[128];
+
+    uint32_t start = furi_get_tick();
+    for(uint32_t i = 0; i < iterations; i++) {
+        flipper_wedge_format_output(
+            nfc_uid, sizeof(nfc_uid), rfid_uid, sizeof(rfid_uid), NULL, ":", true, output, sizeof(output));
+    }
+    uint32_t format_ms = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    for(uint32_t i = 0; i < iterations; i++) {
+        flipper_wedge_template_render(tpl, &data, output, sizeof(output));
+    }
+    uint32_t template_ms = furi_get_tick() - start;
+
+    // ms per 10000 calls = 0.1 us per call
+    FURI_LOG_I(
+        TAG,
+        "Benchmark (%lu calls): format_output %lu.%lu us/call, template %lu.%lu us/call",
+        iterations,
+        format_ms / 10,
+        format_ms % 10,
+        template_ms / 10,
+        template_ms % 10);
+#else
+    UNUSED(tpl);
+#endif
+}
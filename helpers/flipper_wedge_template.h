@@ -0,0 +1,98 @@
+#pragma once
+
+#include <furi.h>
+#include "flipper_wedge_rfid.h"
+
+// Output templates
+//
+// A template describes the typed output of a UID scan, e.g.
+//   {nfc:rev}{sep}{rfid:dec}\t
+// Text outside braces is typed as-is (\t, \n, \\, \{ and \} are escapes).
+// Fields:
+//   {nfc} {rfid}  UID, options after ':' in any order:
+//                   hex (default) / dec  - hex bytes or one big-endian decimal number
+//                   rev                  - reverse byte order
+//                   lower                - lowercase hex
+//                   nosep                - no delimiter between hex bytes
+//                   N or N-M             - only bytes N..M (0-based, inclusive, before rev)
+//   {rfid_num}    Decoded card number (EM4100: 10 decimal digits)
+//   {rfid_fc}     Decoded facility code, {rfid_fc:N} pads to N digits
+//   {rfid_card}   Decoded card number, {rfid_card:N} pads to N digits
+//   {ndef}        NDEF text (if read)
+//   {sep}         Delimiter setting
+// A UID field for a tag that was not scanned, or a decoded field the RFID
+// protocol does not have, produces nothing.
+//
+// Templates are compiled once into bytecode, so formatting a scan runs a
+// short interpreter loop with no parsing.
+
+#define FLIPPER_WEDGE_TEMPLATE_SOURCE_MAX_LEN 128
+
+typedef struct FlipperWedgeTemplate FlipperWedgeTemplate;
+
+typedef struct {
+    const uint8_t* nfc_uid;
+    uint8_t nfc_uid_len;
+    const uint8_t* rfid_uid;
+    uint8_t rfid_uid_len;
+    const FlipperWedgeRfidDecoded* rfid_decoded;  // NULL if none
+    const char* ndef_text;  // NULL or empty if none
+    const char* delimiter;
+} FlipperWedgeTemplateData;
+
+/** Allocate an empty template
+ *
+ * @return FlipperWedgeTemplate instance
+ */
+FlipperWedgeTemplate* flipper_wedge_template_alloc(void);
+
+/** Free template
+ *
+ * @param tpl FlipperWedgeTemplate instance
+ */
+void flipper_wedge_template_free(FlipperWedgeTemplate* tpl);
+
+/** Compile template source
+ * The source is kept (see flipper_wedge_template_get_source()) even if it
+ * does not compile; the template is then empty.
+ *
+ * @param tpl FlipperWedgeTemplate instance
+ * @param source Template text, empty to clear
+ * @return true if the source compiled
+ */
+bool flipper_wedge_template_compile(FlipperWedgeTemplate* tpl, const char* source);
+
+/** Check if a compiled template is set
+ *
+ * @param tpl FlipperWedgeTemplate instance
+ * @return true if flipper_wedge_template_render() should be used for output
+ */
+bool flipper_wedge_template_is_set(const FlipperWedgeTemplate* tpl);
+
+/** Get the template source as last passed to flipper_wedge_template_compile()
+ *
+ * @param tpl FlipperWedgeTemplate instance
+ * @return Source text
+ */
+const char* flipper_wedge_template_get_source(const FlipperWedgeTemplate* tpl);
+
+/** Format one scan with the compiled template
+ *
+ * @param tpl FlipperWedgeTemplate instance
+ * @param data Scan data
+ * @param output Output buffer
+ * @param output_size Size of output buffer
+ * @return Length of the output (truncated to fit)
+ */
+size_t flipper_wedge_template_render(
+    const FlipperWedgeTemplate* tpl,
+    const FlipperWedgeTemplateData* data,
+    char* output,
+    size_t output_size);
+
+/** Log render time against flipper_wedge_format_output() for a sample scan
+ * Only active in debug firmware builds (FURI_DEBUG), no-op otherwise
+ *
+ * @param tpl FlipperWedgeTemplate instance
+ */
+void flipper_wedge_template_benchmark(const FlipperWedgeTemplate* tpl);
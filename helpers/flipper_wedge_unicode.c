@@ -0,0 +1,268 @@
+#include "flipper_wedge_unicode.h"
+
+#define TAG "FlipperWedgeUnicode"
+
+#define UNICODE_LATIN_FIRST 0x00C0
+#define UNICODE_LATIN_LAST 0x017F
+#define UNICODE_CACHE_EMPTY UINT32_MAX
+
+typedef struct {
+    uint32_t code_point;  // UNICODE_CACHE_EMPTY if unused
+    FlipperWedgeUnicodeSequence sequence;
+} FlipperWedgeUnicodeCacheEntry;
+
+struct FlipperWedgeUnicode {
+    FlipperWedgeUnicodeMethod method;
+    FlipperWedgeKeyboardLayout* layout;
+
+    // Keys worked out by flipper_wedge_unicode_configure()
+    uint16_t digits[16];  // Digit values 0-15 for the method
+    uint16_t hold;
+    uint16_t prefix;
+    uint16_t suffix;
+
+    FlipperWedgeUnicodeCacheEntry cache[FLIPPER_WEDGE_UNICODE_CACHE_SIZE];
+};
+
+typedef struct {
+    uint16_t code_point;
+    char ascii[4];
+} FlipperWedgeUnicodeTranslit;
+
+// Characters without a single base letter, sorted by code point
+static const FlipperWedgeUnicodeTranslit unicode_translit[] = {
+    {0x00A0, " "},   {0x00A1, "!"},   {0x00A2, "c"},   {0x00A3, "GBP"}, {0x00A5, "JPY"},
+    {0x00A6, "|"},   {0x00A7, "S"},   {0x00A8, "\""},  {0x00A9, "(c)"}, {0x00AA, "a"},
+    {0x00AB, "<<"},  {0x00AC, "!"},   {0x00AD, "-"},   {0x00AE, "(R)"}, {0x00AF, "-"},
+    {0x00B0, "deg"}, {0x00B1, "+-"},  {0x00B2, "2"},   {0x00B3, "3"},   {0x00B4, "'"},
+    {0x00B5, "u"},   {0x00B6, "P"},   {0x00B7, "."},   {0x00B8, ","},   {0x00B9, "1"},
+    {0x00BA, "o"},   {0x00BB, ">>"},  {0x00BC, "1/4"}, {0x00BD, "1/2"}, {0x00BE, "3/4"},
+    {0x00BF, "?"},   {0x00C6, "AE"},  {0x00DE, "TH"},  {0x00DF, "ss"},  {0x00E6, "ae"},
+    {0x00F7, "/"},   {0x00FE, "th"},  {0x0132, "IJ"},  {0x0133, "ij"},  {0x0152, "OE"},
+    {0x0153, "oe"},  {0x2010, "-"},   {0x2011, "-"},   {0x2012, "-"},   {0x2013, "-"},
+    {0x2014, "-"},   {0x2015, "-"},   {0x2018, "'"},   {0x2019, "'"},   {0x201A, ","},
+    {0x201C, "\""},  {0x201D, "\""},  {0x201E, "\""},  {0x2022, "*"},   {0x2026, "..."},
+    {0x2039, "<"},   {0x203A, ">"},   {0x20AC, "EUR"}, {0x2122, "TM"},  {0x2212, "-"},
+};
+
+// Base letter of U+00C0 to U+017F ('?': see unicode_translit)
+static const char unicode_latin_base[] =
+    "AAAAAA?CEEEEIIIIDNOOOOOxOUUUUY??"  // U+00C0
+    "aaaaaa?ceeeeiiiidnooooo?ouuuuy?y"  // U+00E0
+    "AaAaAaCcCcCcCcDdDdEeEeEeEeEeGgGg"  // U+0100
+    "GgGgHhHhIiIiIiIiIi??JjKkkLlLlLlL"  // U+0120
+    "lLlNnNnNnnNnOoOoOo??RrRrRrSsSsSs"  // U+0140
+    "SsTtTtTtUuUuUuUuUuUuWwYyYZzZzZzs"; // U+0160
+
+_Static_assert(
+    sizeof(unicode_latin_base) - 1 == UNICODE_LATIN_LAST - UNICODE_LATIN_FIRST + 1,
+    "One base letter per code point");
+
+// HID_KEYPAD_0 to HID_KEYPAD_9
+static const uint8_t unicode_numpad_keys[10] = {0x62, 0x59, 0x5A, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F, 0x60, 0x61};
+
+static const char* const unicode_method_names[FlipperWedgeUnicodeMethodCount] = {
+    "ASCII",
+    "Windows",
+    "Linux",
+    "macOS",
+};
+
+static uint16_t flipper_wedge_unicode_ascii_key(FlipperWedgeKeyboardLayout* layout, char c) {
+    if(layout) {
+        return flipper_wedge_keyboard_layout_get_keycode(layout, c);
+    }
+    return HID_ASCII_TO_KEY(c);
+}
+
+size_t flipper_wedge_unicode_transliterate(uint32_t code_point, char output[4]) {
+    output[0] = '\0';
+
+    size_t low = 0;
+    size_t high = COUNT_OF(unicode_translit);
+    while(low < high) {
+        size_t mid = (low + high) / 2;
+        if(unicode_translit[mid].code_point < code_point) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if(low < COUNT_OF(unicode_translit) && unicode_translit[low].code_point == code_point) {
+        strcpy(output, unicode_translit[low].ascii);
+        return strlen(output);
+    }
+
+    if(code_point >= UNICODE_LATIN_FIRST && code_point <= UNICODE_LATIN_LAST) {
+        char base = unicode_latin_base[code_point - UNICODE_LATIN_FIRST];
+        if(base != '?') {
+            output[0] = base;
+            output[1] = '\0';
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Digit values of a number, most significant first, padded to min_digits
+static size_t flipper_wedge_unicode_digits(uint32_t value, uint32_t base, size_t min_digits, uint8_t* digits) {
+    uint8_t reversed[FLIPPER_WEDGE_UNICODE_KEYS_MAX];
+    size_t count = 0;
+    do {
+        reversed[count++] = value % base;
+        value /= base;
+    } while(value > 0 && count < sizeof(reversed));
+    while(count < min_digits && count < sizeof(reversed)) {
+        reversed[count++] = 0;
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        digits[i] = reversed[count - 1 - i];
+    }
+    return count;
+}
+
+static void flipper_wedge_unicode_build(
+    FlipperWedgeUnicode* unicode,
+    uint32_t code_point,
+    FlipperWedgeUnicodeSequence* sequence) {
+    memset(sequence, 0, sizeof(FlipperWedgeUnicodeSequence));
+
+    uint8_t digits[FLIPPER_WEDGE_UNICODE_KEYS_MAX];
+    size_t digit_count = 0;
+
+    switch(unicode->method) {
+    case FlipperWedgeUnicodeMethodWindows:
+        // Alt+0NNN is Latin-1 everywhere. Without the 0 most apps take the
+        // number modulo 256 in the OEM code page, so larger code points would
+        // type an unrelated character; they are transliterated below instead
+        if(code_point <= 0xFF) {
+            digits[0] = 0;
+            digit_count = 1 + flipper_wedge_unicode_digits(code_point, 10, 3, &digits[1]);
+        }
+        break;
+    case FlipperWedgeUnicodeMethodLinux:
+        digit_count = flipper_wedge_unicode_digits(code_point, 16, 1, digits);
+        break;
+    case FlipperWedgeUnicodeMethodMac:
+        if(code_point > 0xFFFF) {
+            // UTF-16 surrogate pair, 4 digits each
+            uint32_t value = code_point - 0x10000;
+            digit_count = flipper_wedge_unicode_digits(0xD800 + (value >> 10), 16, 4, digits);
+            digit_count += flipper_wedge_unicode_digits(0xDC00 + (value & 0x3FF), 16, 4, &digits[4]);
+        } else {
+            digit_count = flipper_wedge_unicode_digits(code_point, 16, 4, digits);
+        }
+        break;
+    default:
+        break;
+    }
+
+    if(digit_count > 0) {
+        sequence->hold = unicode->hold;
+        sequence->prefix = unicode->prefix;
+        sequence->suffix = unicode->suffix;
+        for(size_t i = 0; i < digit_count; i++) {
+            sequence->keys[i] = unicode->digits[digits[i]];
+        }
+        sequence->key_count = digit_count;
+        return;
+    }
+
+    // ASCII method, or not enterable with this method
+    char ascii[4];
+    size_t ascii_len = flipper_wedge_unicode_transliterate(code_point, ascii);
+    if(ascii_len == 0 && unicode->method == FlipperWedgeUnicodeMethodWindows) {
+        // Shows that a character was there, as Windows does for text it cannot convert
+        strcpy(ascii, "?");
+        ascii_len = 1;
+    }
+    for(size_t i = 0; i < ascii_len; i++) {
+        uint16_t keycode = flipper_wedge_unicode_ascii_key(unicode->layout, ascii[i]);
+        if(keycode != HID_KEYBOARD_NONE) {
+            sequence->keys[sequence->key_count++] = keycode;
+        }
+    }
+}
+
+FlipperWedgeUnicode* flipper_wedge_unicode_alloc(void) {
+    FlipperWedgeUnicode* unicode = malloc(sizeof(FlipperWedgeUnicode));
+    flipper_wedge_unicode_configure(unicode, FlipperWedgeUnicodeMethodAscii, NULL);
+    return unicode;
+}
+
+void flipper_wedge_unicode_free(FlipperWedgeUnicode* unicode) {
+    furi_assert(unicode);
+    free(unicode);
+}
+
+void flipper_wedge_unicode_configure(
+    FlipperWedgeUnicode* unicode,
+    FlipperWedgeUnicodeMethod method,
+    FlipperWedgeKeyboardLayout* layout) {
+    furi_assert(unicode);
+
+    unicode->method = method < FlipperWedgeUnicodeMethodCount ? method : FlipperWedgeUnicodeMethodAscii;
+    unicode->layout = layout;
+    unicode->hold = 0;
+    unicode->prefix = HID_KEYBOARD_NONE;
+    unicode->suffix = HID_KEYBOARD_NONE;
+
+    static const char hex[] = "0123456789abcdef";
+    for(size_t i = 0; i < COUNT_OF(unicode->digits); i++) {
+        switch(unicode->method) {
+        case FlipperWedgeUnicodeMethodWindows:
+            // Numpad keys do not depend on the layout
+            unicode->digits[i] = i < COUNT_OF(unicode_numpad_keys) ? unicode_numpad_keys[i] : HID_KEYBOARD_NONE;
+            break;
+        case FlipperWedgeUnicodeMethodMac:
+            // Unicode Hex Input replaces the layout with US QWERTY
+            unicode->digits[i] = HID_ASCII_TO_KEY(hex[i]);
+            break;
+        default:
+            unicode->digits[i] = flipper_wedge_unicode_ascii_key(layout, hex[i]);
+            break;
+        }
+    }
+
+    switch(unicode->method) {
+    case FlipperWedgeUnicodeMethodWindows:
+    case FlipperWedgeUnicodeMethodMac:
+        unicode->hold = KEY_MOD_LEFT_ALT;
+        break;
+    case FlipperWedgeUnicodeMethodLinux:
+        unicode->prefix =
+            flipper_wedge_unicode_ascii_key(layout, 'u') | KEY_MOD_LEFT_CTRL | KEY_MOD_LEFT_SHIFT;
+        unicode->suffix = flipper_wedge_unicode_ascii_key(layout, ' ');
+        break;
+    default:
+        break;
+    }
+
+    for(size_t i = 0; i < FLIPPER_WEDGE_UNICODE_CACHE_SIZE; i++) {
+        unicode->cache[i].code_point = UNICODE_CACHE_EMPTY;
+    }
+}
+
+FlipperWedgeUnicodeMethod flipper_wedge_unicode_get_method(FlipperWedgeUnicode* unicode) {
+    furi_assert(unicode);
+    return unicode->method;
+}
+
+const FlipperWedgeUnicodeSequence*
+    flipper_wedge_unicode_get_sequence(FlipperWedgeUnicode* unicode, uint32_t code_point) {
+    furi_assert(unicode);
+
+    FlipperWedgeUnicodeCacheEntry* entry =
+        &unicode->cache[code_point & (FLIPPER_WEDGE_UNICODE_CACHE_SIZE - 1)];
+    if(entry->code_point != code_point) {
+        flipper_wedge_unicode_build(unicode, code_point, &entry->sequence);
+        entry->code_point = code_point;
+    }
+    return entry->sequence.key_count > 0 ? &entry->sequence : NULL;
+}
+
+const char* flipper_wedge_unicode_method_name(FlipperWedgeUnicodeMethod method) {
+    if(method >= FlipperWedgeUnicodeMethodCount) return "Unknown";
+    return unicode_method_names[method];
+}
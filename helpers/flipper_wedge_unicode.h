@@ -0,0 +1,104 @@
+#pragma once
+
+#include <furi.h>
+#include <furi_hal_usb_hid.h>
+#include "flipper_wedge_keyboard_layout.h"
+
+// Typing non-ASCII characters
+//
+// A keyboard can only send key positions, so a character that is not on the
+// layout is entered through the host's Unicode input method, which differs
+// per OS:
+//   Windows  hold Alt, code point in decimal on the numpad (Alt+0233 for é),
+//            up to U+00FF, which every app reads as Latin-1. Alt codes above
+//            that are OEM code page values mod 256 outside rich-edit apps, so
+//            larger code points are transliterated, '?' if there is no ASCII
+//            form. NumLock must be on.
+//   Linux    Ctrl+Shift+U, code point in hex, Space (GTK and IBus).
+//   macOS    hold Option, 4 hex digits per UTF-16 unit. Needs the "Unicode
+//            Hex Input" input source, which is laid out like US QWERTY.
+// With the ASCII method, and for characters a method cannot enter, common
+// Latin characters and punctuation are transliterated (é -> e, ß -> ss,
+// € -> EUR). Anything else is skipped, as before.
+//
+// The keys of a method are worked out once when it is configured, and the
+// sequence of each character typed is kept in a small cache, so a name with
+// the same accented letter twice builds its sequence once.
+
+#define FLIPPER_WEDGE_UNICODE_KEYS_MAX 8     // Digits of a sequence (macOS surrogate pair)
+#define FLIPPER_WEDGE_UNICODE_CACHE_SIZE 32  // Sequences cached, power of two
+
+typedef enum {
+    FlipperWedgeUnicodeMethodAscii,    // Default: transliterate, no OS input method
+    FlipperWedgeUnicodeMethodWindows,  // Alt + numpad decimal
+    FlipperWedgeUnicodeMethodLinux,    // Ctrl+Shift+U, hex, Space
+    FlipperWedgeUnicodeMethodMac,      // Option + hex (Unicode Hex Input)
+    FlipperWedgeUnicodeMethodCount,
+} FlipperWedgeUnicodeMethod;
+
+// Keys that enter one character: prefix chord, then the keys with the hold
+// modifier down, then the suffix key
+typedef struct {
+    uint16_t hold;     // Modifier held while the keys are tapped, 0 if none
+    uint16_t prefix;   // Chord tapped first, HID_KEYBOARD_NONE if none
+    uint16_t suffix;   // Key tapped last, HID_KEYBOARD_NONE if none
+    uint8_t key_count;
+    uint16_t keys[FLIPPER_WEDGE_UNICODE_KEYS_MAX];
+} FlipperWedgeUnicodeSequence;
+
+typedef struct FlipperWedgeUnicode FlipperWedgeUnicode;
+
+/** Allocate Unicode input (ASCII method, default layout)
+ *
+ * @return FlipperWedgeUnicode instance
+ */
+FlipperWedgeUnicode* flipper_wedge_unicode_alloc(void);
+
+/** Free Unicode input
+ *
+ * @param unicode FlipperWedgeUnicode instance
+ */
+void flipper_wedge_unicode_free(FlipperWedgeUnicode* unicode);
+
+/** Set the input method and keyboard layout, dropping cached sequences
+ * Call again whenever the layout is changed or reloaded.
+ *
+ * @param unicode FlipperWedgeUnicode instance
+ * @param method Host input method
+ * @param layout Keyboard layout for ASCII keys (NULL for US QWERTY)
+ */
+void flipper_wedge_unicode_configure(
+    FlipperWedgeUnicode* unicode,
+    FlipperWedgeUnicodeMethod method,
+    FlipperWedgeKeyboardLayout* layout);
+
+/** Get the configured input method
+ *
+ * @param unicode FlipperWedgeUnicode instance
+ * @return Input method
+ */
+FlipperWedgeUnicodeMethod flipper_wedge_unicode_get_method(FlipperWedgeUnicode* unicode);
+
+/** Get the keys that enter a character
+ *
+ * @param unicode FlipperWedgeUnicode instance
+ * @param code_point Unicode code point (non-ASCII)
+ * @return Sequence valid until the next call, NULL if the character cannot be typed
+ */
+const FlipperWedgeUnicodeSequence*
+    flipper_wedge_unicode_get_sequence(FlipperWedgeUnicode* unicode, uint32_t code_point);
+
+/** Get the ASCII stand-in for a character
+ *
+ * @param code_point Unicode code point
+ * @param output Receives up to 3 characters and a NUL
+ * @return Number of characters, 0 if there is no stand-in
+ */
+size_t flipper_wedge_unicode_transliterate(uint32_t code_point, char output[4]);
+
+/** Get display name of a method
+ *
+ * @param method Input method
+ * @return Static string name
+ */
+const char* flipper_wedge_unicode_method_name(FlipperWedgeUnicodeMethod method);
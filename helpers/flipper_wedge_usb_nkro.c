@@ -0,0 +1,333 @@
+#include "flipper_wedge_usb_nkro.h"
+#include <usb_hid.h>
+
+#define TAG "FlipperWedgeUsbNkro"
+
+#define NKRO_EP_IN 0x81
+#define NKRO_EP_SZ 0x20
+#define NKRO_INTERVAL 1  // ms, full-speed interrupt polling
+
+// Distinct from the stock HID config so hosts don't reuse a cached 6KRO descriptor
+#define NKRO_VID 0x0483
+#define NKRO_PID 0x5751
+
+#define NKRO_BITMAP_SIZE FLIPPER_WEDGE_NKRO_BITMAP_SIZE
+
+// GET_PROTOCOL answers
+#define NKRO_PROTOCOL_BOOT 0
+#define NKRO_PROTOCOL_REPORT 1
+
+typedef struct {
+    uint8_t modifiers;
+    uint8_t reserved;
+    uint8_t keys[FLIPPER_WEDGE_USB_NKRO_BOOT_KEYS];
+} FURI_PACKED NkroBootReport;
+
+typedef struct {
+    uint8_t modifiers;
+    uint8_t bitmap[NKRO_BITMAP_SIZE];
+} FURI_PACKED NkroBitmapReport;
+
+// Report protocol layout: modifier bits, then one bit per usage 0x00-0xDF
+static const uint8_t nkro_report_desc[] = {
+    0x05, 0x01, // Usage Page (Generic Desktop)
+    0x09, 0x06, // Usage (Keyboard)
+    0xA1, 0x01, // Collection (Application)
+    0x05, 0x07, //   Usage Page (Keyboard/Keypad)
+    0x19, 0xE0, //   Usage Minimum (Left Control)
+    0x29, 0xE7, //   Usage Maximum (Right GUI)
+    0x15, 0x00, //   Logical Minimum (0)
+    0x25, 0x01, //   Logical Maximum (1)
+    0x75, 0x01, //   Report Size (1)
+    0x95, 0x08, //   Report Count (8)
+    0x81, 0x02, //   Input (Data, Variable, Absolute) - modifiers
+    0x19, 0x00, //   Usage Minimum (0)
+    0x29, FLIPPER_WEDGE_USB_NKRO_MAX_USAGE, // Usage Maximum
+    0x95, FLIPPER_WEDGE_USB_NKRO_MAX_USAGE + 1, // Report Count (one bit per usage)
+    0x81, 0x02, //   Input (Data, Variable, Absolute) - key bitmap
+    0x05, 0x08, //   Usage Page (LEDs)
+    0x19, 0x01, //   Usage Minimum (Num Lock)
+    0x29, 0x05, //   Usage Maximum (Kana)
+    0x95, 0x05, //   Report Count (5)
+    0x91, 0x02, //   Output (Data, Variable, Absolute)
+    0x95, 0x03, //   Report Count (3)
+    0x91, 0x01, //   Output (Constant) - padding
+    0xC0, // End Collection
+};
+
+struct NkroIntfDescriptor {
+    struct usb_interface_descriptor hid;
+    struct usb_hid_descriptor hid_desc;
+    struct usb_endpoint_descriptor hid_ep_in;
+} FURI_PACKED;
+
+struct NkroConfigDescriptor {
+    struct usb_config_descriptor config;
+    struct NkroIntfDescriptor intf_0;
+} FURI_PACKED;
+
+static const struct usb_string_descriptor nkro_manuf_desc = USB_STRING_DESC("Dangerous Things");
+static const struct usb_string_descriptor nkro_prod_desc = USB_STRING_DESC("Flipper Wedge");
+
+static struct usb_device_descriptor nkro_dev_desc = {
+    .bLength = sizeof(struct usb_device_descriptor),
+    .bDescriptorType = USB_DTYPE_DEVICE,
+    .bcdUSB = VERSION_BCD(2, 0, 0),
+    .bDeviceClass = USB_CLASS_PER_INTERFACE,
+    .bDeviceSubClass = USB_SUBCLASS_NONE,
+    .bDeviceProtocol = USB_PROTO_NONE,
+    .bMaxPacketSize0 = USB_EP0_SIZE,
+    .idVendor = NKRO_VID,
+    .idProduct = NKRO_PID,
+    .bcdDevice = VERSION_BCD(1, 0, 0),
+    .iManufacturer = UsbDevManuf,
+    .iProduct = UsbDevProduct,
+    .iSerialNumber = NO_DESCRIPTOR,
+    .bNumConfigurations = 1,
+};
+
+static const struct NkroConfigDescriptor nkro_cfg_desc = {
+    .config =
+        {
+            .bLength = sizeof(struct usb_config_descriptor),
+            .bDescriptorType = USB_DTYPE_CONFIGURATION,
+            .wTotalLength = sizeof(struct NkroConfigDescriptor),
+            .bNumInterfaces = 1,
+            .bConfigurationValue = 1,
+            .iConfiguration = NO_DESCRIPTOR,
+            .bmAttributes = USB_CFG_ATTR_RESERVED | USB_CFG_ATTR_SELFPOWERED,
+            .bMaxPower = USB_CFG_POWER_MA(100),
+        },
+    .intf_0 =
+        {
+            .hid =
+                {
+                    .bLength = sizeof(struct usb_interface_descriptor),
+                    .bDescriptorType = USB_DTYPE_INTERFACE,
+                    .bInterfaceNumber = 0,
+                    .bAlternateSetting = 0,
+                    .bNumEndpoints = 1,
+                    .bInterfaceClass = USB_CLASS_HID,
+                    .bInterfaceSubClass = USB_HID_SUBCLASS_BOOT,
+                    .bInterfaceProtocol = USB_HID_PROTO_KEYBOARD,
+                    .iInterface = NO_DESCRIPTOR,
+                },
+            .hid_desc =
+                {
+                    .bLength = sizeof(struct usb_hid_descriptor),
+                    .bDescriptorType = USB_DTYPE_HID,
+                    .bcdHID = VERSION_BCD(1, 1, 1),
+                    .bCountryCode = USB_HID_COUNTRY_NONE,
+                    .bNumDescriptors = 1,
+                    .bDescriptorType0 = USB_DTYPE_HID_REPORT,
+                    .wDescriptorLength0 = sizeof(nkro_report_desc),
+                },
+            .hid_ep_in =
+                {
+                    .bLength = sizeof(struct usb_endpoint_descriptor),
+                    .bDescriptorType = USB_DTYPE_ENDPOINT,
+                    .bEndpointAddress = NKRO_EP_IN,
+                    .bmAttributes = USB_EPTYPE_INTERRUPT,
+                    .wMaxPacketSize = NKRO_EP_SZ,
+                    .bInterval = NKRO_INTERVAL,
+                },
+        },
+};
+
+static usbd_device* nkro_usb_dev = NULL;
+static FuriSemaphore* nkro_tx_done = NULL;
+static volatile bool nkro_connected = false;
+static volatile bool nkro_boot_protocol = false;
+static NkroBitmapReport nkro_report;
+static NkroBootReport nkro_boot_report;
+static uint8_t nkro_led_state = 0;
+static uint8_t nkro_protocol = NKRO_PROTOCOL_REPORT;  // GET_PROTOCOL reply, must outlive the request
+
+static void nkro_txrx_ep_callback(usbd_device* dev, uint8_t event, uint8_t ep) {
+    UNUSED(dev);
+    UNUSED(ep);
+    if(event == usbd_evt_eptx) {
+        furi_semaphore_release(nkro_tx_done);
+    }
+}
+
+static usbd_respond nkro_ep_config(usbd_device* dev, uint8_t cfg) {
+    switch(cfg) {
+    case 0:
+        // Deconfiguring device
+        usbd_ep_deconfig(dev, NKRO_EP_IN);
+        usbd_reg_endpoint(dev, NKRO_EP_IN, 0);
+        return usbd_ack;
+    case 1:
+        // Configuring device
+        usbd_ep_config(dev, NKRO_EP_IN, USB_EPTYPE_INTERRUPT, NKRO_EP_SZ);
+        usbd_reg_endpoint(dev, NKRO_EP_IN, nkro_txrx_ep_callback);
+        usbd_ep_write(dev, NKRO_EP_IN, 0, 0);
+        nkro_boot_protocol = false; // BIOS will SET_PROTOCOL if it wants boot reports
+        return usbd_ack;
+    default:
+        return usbd_fail;
+    }
+}
+
+static usbd_respond
+    nkro_control(usbd_device* dev, usbd_ctlreq* req, usbd_rqc_callback* callback) {
+    UNUSED(callback);
+
+    // HID class requests
+    if(((USB_REQ_RECIPIENT | USB_REQ_TYPE) & req->bmRequestType) ==
+           (USB_REQ_INTERFACE | USB_REQ_CLASS) &&
+       req->wIndex == 0) {
+        switch(req->bRequest) {
+        case USB_HID_SETIDLE:
+            return usbd_ack;
+        case USB_HID_GETREPORT:
+            if(nkro_boot_protocol) {
+                dev->status.data_ptr = &nkro_boot_report;
+                dev->status.data_count = sizeof(nkro_boot_report);
+            } else {
+                dev->status.data_ptr = &nkro_report;
+                dev->status.data_count = sizeof(nkro_report);
+            }
+            return usbd_ack;
+        case USB_HID_SETREPORT:
+            // LED output report arrives on the control pipe (no OUT endpoint)
+            if(req->wLength >= 1) {
+                nkro_led_state = req->data[0];
+            }
+            return usbd_ack;
+        case USB_HID_SETPROTOCOL:
+            if(req->wValue == NKRO_PROTOCOL_BOOT) {
+                nkro_boot_protocol = true;
+            } else if(req->wValue == NKRO_PROTOCOL_REPORT) {
+                nkro_boot_protocol = false;
+            } else {
+                return usbd_fail;
+            }
+            return usbd_ack;
+        case USB_HID_GETPROTOCOL:
+            nkro_protocol = nkro_boot_protocol ? NKRO_PROTOCOL_BOOT : NKRO_PROTOCOL_REPORT;
+            dev->status.data_ptr = &nkro_protocol;
+            dev->status.data_count = 1;
+            return usbd_ack;
+        default:
+            return usbd_fail;
+        }
+    }
+
+    // HID descriptor requests
+    if(((USB_REQ_RECIPIENT | USB_REQ_TYPE) & req->bmRequestType) ==
+           (USB_REQ_INTERFACE | USB_REQ_STANDARD) &&
+       req->wIndex == 0 && req->bRequest == USB_STD_GET_DESCRIPTOR) {
+        switch(req->wValue >> 8) {
+        case USB_DTYPE_HID:
+            dev->status.data_ptr = (uint8_t*)&(nkro_cfg_desc.intf_0.hid_desc);
+            dev->status.data_count = sizeof(nkro_cfg_desc.intf_0.hid_desc);
+            return usbd_ack;
+        case USB_DTYPE_HID_REPORT:
+            dev->status.data_ptr = (uint8_t*)nkro_report_desc;
+            dev->status.data_count = sizeof(nkro_report_desc);
+            return usbd_ack;
+        default:
+            return usbd_fail;
+        }
+    }
+
+    return usbd_fail;
+}
+
+static void nkro_init(usbd_device* dev, FuriHalUsbInterface* intf, void* ctx) {
+    UNUSED(intf);
+    UNUSED(ctx);
+
+    if(nkro_tx_done == NULL) {
+        nkro_tx_done = furi_semaphore_alloc(1, 1);
+    }
+    nkro_usb_dev = dev;
+    nkro_connected = false;
+    nkro_boot_protocol = false;
+    memset(&nkro_report, 0, sizeof(nkro_report));
+    memset(&nkro_boot_report, 0, sizeof(nkro_boot_report));
+
+    usbd_reg_config(dev, nkro_ep_config);
+    usbd_reg_control(dev, nkro_control);
+    usbd_connect(dev, true);
+
+    FURI_LOG_I(TAG, "NKRO interface initialized");
+}
+
+static void nkro_deinit(usbd_device* dev) {
+    usbd_reg_config(dev, NULL);
+    usbd_reg_control(dev, NULL);
+
+    nkro_connected = false;
+    nkro_usb_dev = NULL;
+    if(nkro_tx_done) {
+        furi_semaphore_free(nkro_tx_done);
+        nkro_tx_done = NULL;
+    }
+
+    FURI_LOG_I(TAG, "NKRO interface deinitialized");
+}
+
+static void nkro_on_wakeup(usbd_device* dev) {
+    UNUSED(dev);
+    nkro_connected = true;
+}
+
+static void nkro_on_suspend(usbd_device* dev) {
+    UNUSED(dev);
+    if(nkro_connected) {
+        nkro_connected = false;
+        // Unblock a sender waiting on a report the host will never collect
+        furi_semaphore_release(nkro_tx_done);
+    }
+}
+
+FuriHalUsbInterface flipper_wedge_usb_nkro = {
+    .init = nkro_init,
+    .deinit = nkro_deinit,
+    .wakeup = nkro_on_wakeup,
+    .suspend = nkro_on_suspend,
+    .dev_descr = &nkro_dev_desc,
+    .str_manuf_descr = (void*)&nkro_manuf_desc,
+    .str_prod_descr = (void*)&nkro_prod_desc,
+    .str_serial_descr = NULL,
+    .cfg_descr = (void*)&nkro_cfg_desc,
+};
+
+bool flipper_wedge_usb_nkro_is_connected(void) {
+    return nkro_connected;
+}
+
+bool flipper_wedge_usb_nkro_is_boot_protocol(void) {
+    return nkro_boot_protocol;
+}
+
+size_t flipper_wedge_usb_nkro_max_keys(void) {
+    return nkro_boot_protocol ? FLIPPER_WEDGE_USB_NKRO_BOOT_KEYS :
+                                (FLIPPER_WEDGE_USB_NKRO_MAX_USAGE + 1);
+}
+
+bool flipper_wedge_usb_nkro_send(uint8_t modifiers, const uint8_t* keys, size_t count) {
+    if(!nkro_usb_dev || !nkro_tx_done || !nkro_connected) return false;
+
+    // Wait for the host to collect the previous report
+    if(furi_semaphore_acquire(nkro_tx_done, FuriWaitForever) != FuriStatusOk) return false;
+    if(!nkro_connected) return false;
+
+    if(nkro_boot_protocol) {
+        memset(&nkro_boot_report, 0, sizeof(nkro_boot_report));
+        nkro_boot_report.modifiers = modifiers;
+        for(size_t i = 0; i < count && i < FLIPPER_WEDGE_USB_NKRO_BOOT_KEYS; i++) {
+            nkro_boot_report.keys[i] = keys[i];
+        }
+        usbd_ep_write(nkro_usb_dev, NKRO_EP_IN, &nkro_boot_report, sizeof(nkro_boot_report));
+    } else {
+        nkro_report.modifiers = modifiers;
+        flipper_wedge_nkro_batch_bitmap(keys, count, nkro_report.bitmap);
+        usbd_ep_write(nkro_usb_dev, NKRO_EP_IN, &nkro_report, sizeof(nkro_report));
+    }
+
+    return true;
+}
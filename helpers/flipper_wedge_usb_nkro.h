@@ -0,0 +1,48 @@
+#pragma once
+
+#include <furi.h>
+#include <furi_hal_usb.h>
+#include "flipper_wedge_nkro_batch.h"
+
+// App-provided USB keyboard interface with an N-key rollover (NKRO) report
+//
+// The interface is a boot-subclass keyboard, so BIOS/UEFI hosts that issue
+// SET_PROTOCOL(boot) still get standard 8-byte 6KRO reports. Hosts that stay
+// in report protocol (every desktop OS) get a bitmap report with one bit per
+// key usage 0x00-0xDF plus the modifier byte, so one report can hold any set
+// of distinct keys.
+
+#define FLIPPER_WEDGE_USB_NKRO_BOOT_KEYS 6   // Key slots in a boot protocol report
+#define FLIPPER_WEDGE_USB_NKRO_MAX_USAGE FLIPPER_WEDGE_NKRO_MAX_USAGE // Highest non-modifier usage in the bitmap
+
+/** USB interface config, pass to furi_hal_usb_set_config() */
+extern FuriHalUsbInterface flipper_wedge_usb_nkro;
+
+/** Check if the host has configured the interface and is not suspended
+ *
+ * @return true if connected
+ */
+bool flipper_wedge_usb_nkro_is_connected(void);
+
+/** Check if the host switched the interface to boot protocol
+ *
+ * @return true for boot protocol (6KRO), false for NKRO bitmap reports
+ */
+bool flipper_wedge_usb_nkro_is_boot_protocol(void);
+
+/** Maximum distinct keys one report can carry in the current protocol
+ *
+ * @return Key count
+ */
+size_t flipper_wedge_usb_nkro_max_keys(void);
+
+/** Send a report with the given keys held down
+ * Replaces the previous report (keys not listed are released).
+ * Blocks until the previous report has been collected by the host.
+ *
+ * @param modifiers Modifier byte (KEY_MOD_* >> 8)
+ * @param keys Key usages (0x00-0xDF), may be NULL when count is 0
+ * @param count Number of keys
+ * @return true if the report was queued
+ */
+bool flipper_wedge_usb_nkro_send(uint8_t modifiers, const uint8_t* keys, size_t count);
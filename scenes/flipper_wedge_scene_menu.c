@@ -2,6 +2,7 @@
 
 enum SubmenuIndex {
     SubmenuIndexSettings = 10,
+    SubmenuIndexStatistics,
 };
 
 void flipper_wedge_scene_menu_submenu_callback(void* context, uint32_t index) {
@@ -22,6 +23,13 @@ void flipper_wedge_scene_menu_on_enter(void* context) {
         flipper_wedge_scene_menu_submenu_callback,
         app);
 
+    submenu_add_item(
+        app->submenu,
+        "Statistics",
+        SubmenuIndexStatistics,
+        flipper_wedge_scene_menu_submenu_callback,
+        app);
+
     submenu_set_selected_item(
         app->submenu, scene_manager_get_scene_state(app->scene_manager, FlipperWedgeSceneMenu));
 
@@ -42,6 +50,11 @@ bool flipper_wedge_scene_menu_on_event(void* context, SceneManagerEvent event) {
                 app->scene_manager, FlipperWedgeSceneMenu, SubmenuIndexSettings);
             scene_manager_next_scene(app->scene_manager, FlipperWedgeSceneSettings);
             return true;
+        } else if(event.event == SubmenuIndexStatistics) {
+            scene_manager_set_scene_state(
+                app->scene_manager, FlipperWedgeSceneMenu, SubmenuIndexStatistics);
+            scene_manager_next_scene(app->scene_manager, FlipperWedgeSceneStatistics);
+            return true;
         }
     }
     return false;
@@ -14,6 +14,17 @@ enum SettingsIndex {
     SettingsIndexNdefMaxLen,
     SettingsIndexLogToSd,
     SettingsIndexKeyboardLayout,
+    SettingsIndexUnicode,
+    SettingsIndexUsbKeys,
+    SettingsIndexLfProtocols,
+    SettingsIndexFieldWindows,
+    SettingsIndexIdlePoll,
+    SettingsIndexBatchSeparator,
+    SettingsIndexLookup,
+    SettingsIndexAccess,
+    SettingsIndexFeedback,
+    SettingsIndexMacro,
+    SettingsIndexClassic,
 };
 
 const char* const on_off_text[2] = {
@@ -30,26 +41,81 @@ const char* const vibration_text[4] = {
 };
 
 // NDEF max length options
-const char* const ndef_max_len_text[3] = {
+const char* const ndef_max_len_text[4] = {
     "250 chars",
     "500 chars",
     "1000 chars",
+    "No limit",
 };
 
 // Mode startup behavior options
-const char* const mode_startup_text[6] = {
+const char* const mode_startup_text[FlipperWedgeModeStartupCount] = {
     "Remember",
     "NFC",
     "RFID",
     "NDEF",
     "NFC+RFID",
     "RFID+NFC",
+    "NFC|RFID",
+    "NFC&RFID",
+    "Inventory",
+    "NFC-V",
 };
 
 // Output mode options
-const char* const output_text[2] = {
+const char* const output_text[3] = {
     "USB",
     "BLE",
+    "USB Serial",
+};
+
+// USB keyboard interface options
+const char* const usb_keys_text[2] = {
+    "6KRO",
+    "NKRO",
+};
+
+// LF protocol allowlist options
+const char* const lf_protocols_text[FlipperWedgeRfidProtocolsCount] = {
+    "All",
+    "ASK only",
+    "EM4100",
+    "HID Prox",
+    "EM+HID",
+    "PSK only",
+};
+
+// HF/LF window options for dual-field modes (ms)
+const char* const field_windows_text[FlipperWedgeFieldWindowsCount] = {
+    "250/750",
+    "500/500",
+    "250/1500",
+    "750/250",
+};
+
+// Max idle latency options
+const char* const idle_poll_text[FlipperWedgeIdlePollCount] = {
+    "OFF",
+    "0.5s",
+    "1s",
+    "2s",
+    "5s",
+};
+
+// Inventory batch separator options
+const char* const batch_separator_text[FlipperWedgeBatchSeparatorCount] = {
+    "Enter",
+    "Tab",
+    "Space",
+    ",",
+    ";",
+};
+
+// Access list options
+const char* const access_mode_text[FlipperWedgeAccessModeCount] = {
+    "OFF",
+    "Allow",
+    "Deny",
 };
 
 // Delimiter options - display names
@@ -78,13 +144,9 @@ const char* const delimiter_values[] = {
 
 #define DELIMITER_OPTIONS_COUNT 8
 
-// Keyboard layout storage (built-in + custom layouts from SD)
+// Keyboard layouts: built-in, then custom layouts from app->layout_index
 #define LAYOUT_BUILTIN_COUNT 2  // Default, NumPad
-#define LAYOUT_MAX_CUSTOM 10    // Max custom layouts to show
-static FuriString* layout_custom_names[LAYOUT_MAX_CUSTOM];
-static FuriString* layout_custom_paths[LAYOUT_MAX_CUSTOM];
-static size_t layout_custom_count = 0;
-static size_t layout_total_count = LAYOUT_BUILTIN_COUNT;
+#define LAYOUT_MAX_CUSTOM (UINT8_MAX - LAYOUT_BUILTIN_COUNT)  // VariableItem values are uint8_t
 
 // Built-in layout names
 static const char* layout_builtin_names[LAYOUT_BUILTIN_COUNT] = {
@@ -163,6 +225,22 @@ static void flipper_wedge_scene_settings_set_log_to_sd(VariableItem* item) {
     flipper_wedge_save_settings(app);  // Save immediately to persist across app restarts
 }
 
+// Show a layout by its selector index, custom layout names are read from the index
+static void flipper_wedge_scene_settings_set_layout_text(FlipperWedge* app, VariableItem* item, uint8_t index) {
+    if(index < LAYOUT_BUILTIN_COUNT) {
+        variable_item_set_current_value_text(item, layout_builtin_names[index]);
+        return;
+    }
+
+    FuriString* name = furi_string_alloc();
+    if(flipper_wedge_layout_index_get(app->layout_index, index - LAYOUT_BUILTIN_COUNT, name, NULL)) {
+        variable_item_set_current_value_text(item, furi_string_get_cstr(name));
+    } else {
+        variable_item_set_current_value_text(item, "???");
+    }
+    furi_string_free(name);
+}
+
 static void flipper_wedge_scene_settings_set_keyboard_layout(VariableItem* item) {
     FlipperWedge* app = variable_item_get_context(item);
     uint8_t index = variable_item_get_current_value_index(item);
@@ -170,18 +248,7 @@ static void flipper_wedge_scene_settings_set_keyboard_layout(VariableItem* item)
     FURI_LOG_I("Settings", "Layout callback: index=%d", index);
 
     // Get the layout name for display
-    const char* layout_name;
-    if(index < LAYOUT_BUILTIN_COUNT) {
-        layout_name = layout_builtin_names[index];
-    } else {
-        size_t custom_index = index - LAYOUT_BUILTIN_COUNT;
-        if(custom_index < layout_custom_count && layout_custom_names[custom_index]) {
-            layout_name = furi_string_get_cstr(layout_custom_names[custom_index]);
-        } else {
-            layout_name = "???";
-        }
-    }
-    variable_item_set_current_value_text(item, layout_name);
+    flipper_wedge_scene_settings_set_layout_text(app, item, index);
 
     // Apply the selected layout
     if(index == 0) {
@@ -192,11 +259,10 @@ static void flipper_wedge_scene_settings_set_keyboard_layout(VariableItem* item)
         flipper_wedge_keyboard_layout_set_numpad(app->keyboard_layout);
     } else {
         // Custom layout from file
-        size_t custom_index = index - LAYOUT_BUILTIN_COUNT;
-        if(custom_index < layout_custom_count && layout_custom_paths[custom_index]) {
-            const char* path = furi_string_get_cstr(layout_custom_paths[custom_index]);
-            if(!flipper_wedge_keyboard_layout_load(app->keyboard_layout, path)) {
-                FURI_LOG_E("Settings", "Failed to load layout: %s", path);
+        FuriString* path = furi_string_alloc();
+        if(flipper_wedge_layout_index_get(app->layout_index, index - LAYOUT_BUILTIN_COUNT, NULL, path)) {
+            if(!flipper_wedge_keyboard_layout_load(app->keyboard_layout, furi_string_get_cstr(path))) {
+                FURI_LOG_E("Settings", "Failed to load layout: %s", furi_string_get_cstr(path));
                 // Notify user of failure with error feedback
                 NotificationApp* notifications = furi_record_open(RECORD_NOTIFICATION);
                 notification_message(notifications, &sequence_error);
@@ -207,11 +273,35 @@ static void flipper_wedge_scene_settings_set_keyboard_layout(VariableItem* item)
                 variable_item_set_current_value_text(item, "Default (QWERTY)");
             }
         }
+        furi_string_free(path);
     }
 
+    // Cached Unicode sequences and macro keycodes came from the previous layout
+    flipper_wedge_unicode_configure(app->unicode, app->unicode_method, app->keyboard_layout);
+    if(app->macro_enabled && !flipper_wedge_macro_set_layout(app->macro, app->keyboard_layout)) {
+        // The macro uses a character the new layout lacks, turn it off as the Macro item does
+        FURI_LOG_E("Settings", "Macro disabled: %s", flipper_wedge_macro_get_error(app->macro));
+        NotificationApp* notifications = furi_record_open(RECORD_NOTIFICATION);
+        notification_message(notifications, &sequence_error);
+        furi_record_close(RECORD_NOTIFICATION);
+        app->macro_enabled = false;
+        VariableItem* macro_item = variable_item_list_get(app->variable_item_list, SettingsIndexMacro);
+        variable_item_set_current_value_index(macro_item, 0);
+        variable_item_set_current_value_text(macro_item, on_off_text[0]);
+    }
     flipper_wedge_save_settings(app);  // Save immediately to persist across app restarts
 }
 
+static void flipper_wedge_scene_settings_set_unicode(VariableItem* item) {
+    FlipperWedge* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    app->unicode_method = (FlipperWedgeUnicodeMethod)index;
+    variable_item_set_current_value_text(item, flipper_wedge_unicode_method_name(app->unicode_method));
+    flipper_wedge_unicode_configure(app->unicode, app->unicode_method, app->keyboard_layout);
+    flipper_wedge_save_settings(app);
+}
+
 static void flipper_wedge_scene_settings_set_output(VariableItem* item) {
     FlipperWedge* app = variable_item_get_context(item);
     uint8_t index = variable_item_get_current_value_index(item);
@@ -222,8 +312,8 @@ static void flipper_wedge_scene_settings_set_output(VariableItem* item) {
     // Handle output mode change with DEFERRED switching
     if(new_output_mode != app->output_mode) {
         FURI_LOG_I("Settings", "Requesting output mode switch: %s -> %s",
-                   app->output_mode == FlipperWedgeOutputUsb ? "USB" : "BLE",
-                   new_output_mode == FlipperWedgeOutputUsb ? "USB" : "BLE");
+                   flipper_wedge_output_name(app->output_mode),
+                   flipper_wedge_output_name(new_output_mode));
 
         // Set flag for tick callback to process (worker thread handles HID lifecycle)
         app->output_switch_pending = true;
@@ -240,6 +330,154 @@ static void flipper_wedge_scene_settings_set_output(VariableItem* item) {
     }
 }
 
+static void flipper_wedge_scene_settings_set_usb_keys(VariableItem* item) {
+    FlipperWedge* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, usb_keys_text[index]);
+    bool usb_nkro = (index == 1);
+    if(usb_nkro == app->usb_nkro) return;
+
+    app->usb_nkro = usb_nkro;
+    flipper_wedge_save_settings(app);
+
+    // Re-enumerate with the new descriptor (same deferred path as an output switch)
+    if(app->output_mode == FlipperWedgeOutputUsb && !app->output_switch_pending) {
+        FURI_LOG_I("Settings", "Requesting USB re-init with %s keyboard", usb_keys_text[index]);
+        app->output_switch_pending = true;
+        app->output_switch_target = FlipperWedgeOutputUsb;
+    }
+}
+
+static void flipper_wedge_scene_settings_set_lf_protocols(VariableItem* item) {
+    FlipperWedge* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, lf_protocols_text[index]);
+    app->rfid_protocols = (FlipperWedgeRfidProtocols)index;
+    flipper_wedge_rfid_set_protocols(app->rfid, app->rfid_protocols);
+    flipper_wedge_save_settings(app);
+}
+
+static void flipper_wedge_scene_settings_set_field_windows(VariableItem* item) {
+    FlipperWedge* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, field_windows_text[index]);
+    app->field_windows = (FlipperWedgeFieldWindows)index;
+    flipper_wedge_scheduler_set_windows(app->scheduler, app->field_windows);
+    flipper_wedge_save_settings(app);
+}
+
+static void flipper_wedge_scene_settings_set_idle_poll(VariableItem* item) {
+    FlipperWedge* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, idle_poll_text[index]);
+    app->idle_poll = (FlipperWedgeIdlePoll)index;
+    flipper_wedge_scheduler_set_idle_poll(app->scheduler, app->idle_poll);
+    flipper_wedge_save_settings(app);
+}
+
+static void flipper_wedge_scene_settings_set_batch_separator(VariableItem* item) {
+    FlipperWedge* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, batch_separator_text[index]);
+    app->batch_separator = (FlipperWedgeBatchSeparator)index;
+    flipper_wedge_save_settings(app);
+}
+
+static void flipper_wedge_scene_settings_set_lookup(VariableItem* item) {
+    FlipperWedge* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, on_off_text[index]);
+    app->lookup_enabled = (index == 1);
+    if(app->lookup_enabled) {
+        // Builds the index first if the CSV changed, can take a few seconds
+        flipper_wedge_lookup_load(
+            app->lookup, FLIPPER_WEDGE_LOOKUP_CSV_PATH, FLIPPER_WEDGE_LOOKUP_INDEX_PATH);
+    } else {
+        flipper_wedge_lookup_unload(app->lookup);
+    }
+    flipper_wedge_save_settings(app);
+}
+
+static void flipper_wedge_scene_settings_set_access(VariableItem* item) {
+    FlipperWedge* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, access_mode_text[index]);
+    bool was_off = app->access_mode == FlipperWedgeAccessModeOff;
+    app->access_mode = (FlipperWedgeAccessMode)index;
+    if(app->access_mode == FlipperWedgeAccessModeOff) {
+        flipper_wedge_access_unload(app->access);
+    } else if(was_off) {
+        // Same list for both modes, only load it when leaving OFF
+        flipper_wedge_access_load(
+            app->access, FLIPPER_WEDGE_ACCESS_LIST_PATH, FLIPPER_WEDGE_ACCESS_INDEX_PATH);
+    }
+    flipper_wedge_save_settings(app);
+}
+
+static void flipper_wedge_scene_settings_set_feedback(VariableItem* item) {
+    FlipperWedge* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    app->feedback_profile = (FlipperWedgeFeedbackProfile)index;
+    variable_item_set_current_value_text(item, flipper_wedge_feedback_profile_name(app->feedback_profile));
+    // Statistics start over so scans/min is measured under one profile
+    flipper_wedge_latency_reset(app->latency);
+    flipper_wedge_save_settings(app);
+}
+
+static void flipper_wedge_scene_settings_set_macro(VariableItem* item) {
+    FlipperWedge* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    app->macro_enabled = (index == 1);
+    if(app->macro_enabled &&
+       !flipper_wedge_macro_load(app->macro, FLIPPER_WEDGE_MACRO_PATH, app->keyboard_layout)) {
+        // Missing file or a macro that does not compile, the log has the line and column
+        NotificationApp* notifications = furi_record_open(RECORD_NOTIFICATION);
+        notification_message(notifications, &sequence_error);
+        furi_record_close(RECORD_NOTIFICATION);
+        app->macro_enabled = false;
+        variable_item_set_current_value_index(item, 0);
+    } else if(!app->macro_enabled) {
+        flipper_wedge_macro_unload(app->macro);
+    }
+    variable_item_set_current_value_text(item, on_off_text[app->macro_enabled ? 1 : 0]);
+    flipper_wedge_save_settings(app);
+}
+
+// Value 0 is OFF, value N reads sector N - 1
+static void flipper_wedge_scene_settings_classic_text(VariableItem* item, uint8_t sector) {
+    char text[8];
+    if(sector == FLIPPER_WEDGE_CLASSIC_SECTOR_OFF) {
+        variable_item_set_current_value_text(item, on_off_text[0]);
+    } else {
+        snprintf(text, sizeof(text), "Sec %u", sector);
+        variable_item_set_current_value_text(item, text);
+    }
+}
+
+static void flipper_wedge_scene_settings_set_classic(VariableItem* item) {
+    FlipperWedge* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    bool was_off = app->classic_sector == FLIPPER_WEDGE_CLASSIC_SECTOR_OFF;
+    app->classic_sector = index == 0 ? FLIPPER_WEDGE_CLASSIC_SECTOR_OFF : index - 1;
+    if(was_off && app->classic_sector != FLIPPER_WEDGE_CLASSIC_SECTOR_OFF) {
+        // Keys are per card, not per sector, so only load them when leaving OFF
+        flipper_wedge_classic_keys_load(
+            app->classic_keys, FLIPPER_WEDGE_CLASSIC_KEYS_PATH, FLIPPER_WEDGE_CLASSIC_CACHE_PATH);
+    }
+    flipper_wedge_scene_settings_classic_text(item, app->classic_sector);
+    flipper_wedge_save_settings(app);
+}
+
 static void flipper_wedge_scene_settings_item_callback(void* context, uint32_t index) {
     FlipperWedge* app = context;
     view_dispatcher_send_custom_event(app->view_dispatcher, index);
@@ -379,29 +617,15 @@ void flipper_wedge_scene_settings_on_enter(void* context) {
     variable_item_set_current_value_text(item, on_off_text[app->log_to_sd ? 1 : 0]);
 
     // Keyboard Layout selector
-    // First, free any previously allocated custom layout strings
-    for(size_t i = 0; i < layout_custom_count; i++) {
-        if(layout_custom_names[i]) {
-            furi_string_free(layout_custom_names[i]);
-            layout_custom_names[i] = NULL;
-        }
-        if(layout_custom_paths[i]) {
-            furi_string_free(layout_custom_paths[i]);
-            layout_custom_paths[i] = NULL;
-        }
+    // Custom layouts come from the index, revalidated without opening the layout files
+    flipper_wedge_layout_index_load(
+        app->layout_index, FLIPPER_WEDGE_LAYOUTS_DIRECTORY, FLIPPER_WEDGE_LAYOUT_INDEX_PATH);
+    uint32_t layout_custom_count = flipper_wedge_layout_index_get_count(app->layout_index);
+    if(layout_custom_count > LAYOUT_MAX_CUSTOM) {
+        FURI_LOG_W("Settings", "Showing %d of %lu layouts", LAYOUT_MAX_CUSTOM, layout_custom_count);
+        layout_custom_count = LAYOUT_MAX_CUSTOM;
     }
 
-    // Scan for custom layouts on SD card
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    layout_custom_count = flipper_wedge_keyboard_layout_list(
-        storage,
-        layout_custom_names,
-        layout_custom_paths,
-        LAYOUT_MAX_CUSTOM);
-    furi_record_close(RECORD_STORAGE);
-
-    layout_total_count = LAYOUT_BUILTIN_COUNT + layout_custom_count;
-
     // Determine current layout index
     uint8_t layout_index = 0;
     if(app->keyboard_layout) {
@@ -411,37 +635,133 @@ void flipper_wedge_scene_settings_on_enter(void* context) {
             layout_index = 1;
         } else if(app->keyboard_layout->type == FlipperWedgeLayoutCustom) {
             // Find the matching custom layout by path
-            for(size_t i = 0; i < layout_custom_count; i++) {
-                if(layout_custom_paths[i] &&
-                   strcmp(app->keyboard_layout->file_path, furi_string_get_cstr(layout_custom_paths[i])) == 0) {
-                    layout_index = LAYOUT_BUILTIN_COUNT + i;
-                    break;
-                }
+            uint32_t position =
+                flipper_wedge_layout_index_find(app->layout_index, app->keyboard_layout->file_path);
+            if(position < layout_custom_count) {
+                layout_index = LAYOUT_BUILTIN_COUNT + position;
             }
         }
     }
 
-    // Get current layout name for display
-    const char* current_layout_name;
-    if(layout_index < LAYOUT_BUILTIN_COUNT) {
-        current_layout_name = layout_builtin_names[layout_index];
-    } else {
-        size_t custom_idx = layout_index - LAYOUT_BUILTIN_COUNT;
-        if(custom_idx < layout_custom_count && layout_custom_names[custom_idx]) {
-            current_layout_name = furi_string_get_cstr(layout_custom_names[custom_idx]);
-        } else {
-            current_layout_name = "???";
-        }
-    }
-
     item = variable_item_list_add(
         app->variable_item_list,
         "KB Layout:",
-        layout_total_count,
+        LAYOUT_BUILTIN_COUNT + layout_custom_count,
         flipper_wedge_scene_settings_set_keyboard_layout,
         app);
     variable_item_set_current_value_index(item, layout_index);
-    variable_item_set_current_value_text(item, current_layout_name);
+    flipper_wedge_scene_settings_set_layout_text(app, item, layout_index);
+
+    // Host input method for accented and other non-ASCII characters
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Unicode:",
+        FlipperWedgeUnicodeMethodCount,
+        flipper_wedge_scene_settings_set_unicode,
+        app);
+    variable_item_set_current_value_index(item, app->unicode_method);
+    variable_item_set_current_value_text(item, flipper_wedge_unicode_method_name(app->unicode_method));
+
+    // USB keyboard interface selector (applies to USB output)
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "USB Keys:",
+        2,
+        flipper_wedge_scene_settings_set_usb_keys,
+        app);
+    variable_item_set_current_value_index(item, app->usb_nkro ? 1 : 0);
+    variable_item_set_current_value_text(item, usb_keys_text[app->usb_nkro ? 1 : 0]);
+
+    // LF protocol allowlist (narrower sets read faster)
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "LF Protocols:",
+        FlipperWedgeRfidProtocolsCount,
+        flipper_wedge_scene_settings_set_lf_protocols,
+        app);
+    variable_item_set_current_value_index(item, app->rfid_protocols);
+    variable_item_set_current_value_text(item, lf_protocols_text[app->rfid_protocols]);
+
+    // HF/LF window lengths for the NFC|RFID and NFC+RFID modes
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "HF/LF ms:",
+        FlipperWedgeFieldWindowsCount,
+        flipper_wedge_scene_settings_set_field_windows,
+        app);
+    variable_item_set_current_value_index(item, app->field_windows);
+    variable_item_set_current_value_text(item, field_windows_text[app->field_windows]);
+
+    // Slow polling after FLIPPER_WEDGE_SCHEDULER_ACTIVE_MS without a read
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Idle Poll:",
+        FlipperWedgeIdlePollCount,
+        flipper_wedge_scene_settings_set_idle_poll,
+        app);
+    variable_item_set_current_value_index(item, app->idle_poll);
+    variable_item_set_current_value_text(item, idle_poll_text[app->idle_poll]);
+
+    // Separator between UIDs in NFC Inventory mode
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Batch Sep:",
+        FlipperWedgeBatchSeparatorCount,
+        flipper_wedge_scene_settings_set_batch_separator,
+        app);
+    variable_item_set_current_value_index(item, app->batch_separator);
+    variable_item_set_current_value_text(item, batch_separator_text[app->batch_separator]);
+
+    // Type values from lookup.csv instead of UIDs
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Lookup:",
+        2,
+        flipper_wedge_scene_settings_set_lookup,
+        app);
+    variable_item_set_current_value_index(item, app->lookup_enabled ? 1 : 0);
+    variable_item_set_current_value_text(item, on_off_text[app->lookup_enabled ? 1 : 0]);
+
+    // Allowlist/denylist from access_list.txt
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Access:",
+        FlipperWedgeAccessModeCount,
+        flipper_wedge_scene_settings_set_access,
+        app);
+    variable_item_set_current_value_index(item, app->access_mode);
+    variable_item_set_current_value_text(item, access_mode_text[app->access_mode]);
+
+    // Fast: scan again while the result is still shown
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Feedback:",
+        FlipperWedgeFeedbackProfileCount,
+        flipper_wedge_scene_settings_set_feedback,
+        app);
+    variable_item_set_current_value_index(item, app->feedback_profile);
+    variable_item_set_current_value_text(item, flipper_wedge_feedback_profile_name(app->feedback_profile));
+
+    // Type scans with macro.txt (fields, keys, delays) instead of output + Enter
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Macro:",
+        2,
+        flipper_wedge_scene_settings_set_macro,
+        app);
+    variable_item_set_current_value_index(item, app->macro_enabled ? 1 : 0);
+    variable_item_set_current_value_text(item, on_off_text[app->macro_enabled ? 1 : 0]);
+
+    // Read a MIFARE Classic sector with classic_keys.txt as the tag's text
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Classic:",
+        FLIPPER_WEDGE_CLASSIC_SECTOR_COUNT + 1,
+        flipper_wedge_scene_settings_set_classic,
+        app);
+    variable_item_set_current_value_index(
+        item, app->classic_sector == FLIPPER_WEDGE_CLASSIC_SECTOR_OFF ? 0 : app->classic_sector + 1);
+    flipper_wedge_scene_settings_classic_text(item, app->classic_sector);
 
     // Set callback for when user clicks on an item
     variable_item_list_set_enter_callback(
@@ -538,19 +858,8 @@ void flipper_wedge_scene_settings_on_exit(void* context) {
     variable_item_list_set_selected_item(app->variable_item_list, 0);
     variable_item_list_reset(app->variable_item_list);
 
-    // Free custom layout strings
-    for(size_t i = 0; i < layout_custom_count; i++) {
-        if(layout_custom_names[i]) {
-            furi_string_free(layout_custom_names[i]);
-            layout_custom_names[i] = NULL;
-        }
-        if(layout_custom_paths[i]) {
-            furi_string_free(layout_custom_paths[i]);
-            layout_custom_paths[i] = NULL;
-        }
-    }
-    layout_custom_count = 0;
-    layout_total_count = LAYOUT_BUILTIN_COUNT;
+    // Close the layout index
+    flipper_wedge_layout_index_unload(app->layout_index);
 
     // Return backlight to auto mode
     notification_message(app->notification, &sequence_display_backlight_enforce_auto);
@@ -3,77 +3,24 @@
 #include "../views/flipper_wedge_startscreen.h"
 #include "../helpers/flipper_wedge_haptic.h"
 #include "../helpers/flipper_wedge_led.h"
+#include "../helpers/flipper_wedge_debug.h"
 
-// Forward declaration of view model (defined in view's .c file)
-typedef struct {
-    bool usb_connected;
-    bool bt_connected;
-    uint8_t mode;
-    FlipperWedgeDisplayState display_state;
-    char status_text[32];
-    char uid_text[64];
-} FlipperWedgeStartscreenModel;
+#ifdef FURI_DEBUG
+#define OUTPUT_BENCH_MARKER_PATH APP_DATA_PATH("output_bench")
+// Copies of one scan sent back to back; typing is far slower, so fewer of those
+#define OUTPUT_BENCH_RECORDS 200
+#define OUTPUT_BENCH_TYPED 20
+#endif
 
 // Forward declarations
 static void flipper_wedge_scene_startscreen_start_scanning(FlipperWedge* app);
 static void flipper_wedge_scene_startscreen_stop_scanning(FlipperWedge* app);
 
-// Display timer callback - used to clear messages and return to scanning
+// Display timer callback - the feedback timeline moves on from the GUI thread
 static void flipper_wedge_scene_startscreen_display_timer_callback(void* context) {
     furi_assert(context);
     FlipperWedge* app = context;
-
-    FlipperWedgeDisplayState current_state = FlipperWedgeDisplayStateIdle;
-    with_view_model(
-        flipper_wedge_startscreen_get_view(app->flipper_wedge_startscreen),
-        FlipperWedgeStartscreenModel * model,
-        { current_state = model->display_state; },
-        false);
-
-    FURI_LOG_D("FlipperWedgeScene", "Display timer fired - current display state: %d", current_state);
-
-    // State machine for display sequence
-    if(current_state == FlipperWedgeDisplayStateResult) {
-        // First timer: showed result, check if this is success or error
-        bool is_error = false;
-        with_view_model(
-            flipper_wedge_startscreen_get_view(app->flipper_wedge_startscreen),
-            FlipperWedgeStartscreenModel * model,
-            {
-                // Error messages don't need "Sent" confirmation
-                is_error = (strstr(model->status_text, "Not NFC Forum Compliant") != NULL) ||
-                          (strstr(model->status_text, "Unsupported NFC Forum Type") != NULL) ||
-                          (strstr(model->status_text, "NDEF Not Found") != NULL);
-            },
-            false);
-
-        if(is_error) {
-            // For errors, skip "Sent" and go directly to cooldown
-            flipper_wedge_led_reset(app);
-            flipper_wedge_startscreen_set_display_state(app->flipper_wedge_startscreen, FlipperWedgeDisplayStateIdle);
-            flipper_wedge_startscreen_set_status_text(app->flipper_wedge_startscreen, "");
-            furi_timer_start(app->display_timer, furi_ms_to_ticks(300));
-        } else {
-            // For success, show "Sent" with vibration feedback
-            flipper_wedge_startscreen_set_display_state(app->flipper_wedge_startscreen, FlipperWedgeDisplayStateSent);
-            flipper_wedge_startscreen_set_status_text(app->flipper_wedge_startscreen, "Sent");
-            flipper_wedge_play_happy_bump(app);  // Vibrate when "Sent" is displayed
-            furi_timer_start(app->display_timer, furi_ms_to_ticks(200));
-        }
-    } else if(current_state == FlipperWedgeDisplayStateSent) {
-        // Second timer: showed "Sent", now cooldown and prepare to restart
-        flipper_wedge_led_reset(app);
-        flipper_wedge_startscreen_set_display_state(app->flipper_wedge_startscreen, FlipperWedgeDisplayStateIdle);
-        flipper_wedge_startscreen_set_status_text(app->flipper_wedge_startscreen, "");
-        furi_timer_start(app->display_timer, furi_ms_to_ticks(300));
-    } else {
-        // Third timer: cooldown done, return to Idle state for scanning to restart
-        flipper_wedge_led_reset(app);
-        flipper_wedge_startscreen_set_display_state(app->flipper_wedge_startscreen, FlipperWedgeDisplayStateIdle);
-        flipper_wedge_startscreen_set_status_text(app->flipper_wedge_startscreen, "");
-        app->scan_state = FlipperWedgeScanStateIdle;
-        // Tick handler will restart scanning automatically
-    }
+    view_dispatcher_send_custom_event(app->view_dispatcher, FlipperWedgeCustomEventDisplayDone);
 }
 
 // Timeout callback - used for combo mode timeout when waiting for second tag
@@ -95,41 +42,69 @@ void flipper_wedge_scene_startscreen_callback(FlipperWedgeCustomEvent event, voi
     view_dispatcher_send_custom_event(app->view_dispatcher, event);
 }
 
-// NFC callback - called when an NFC tag is detected
+// Drop the reads of the current scan (returns the NDEF buffer to the pool)
+static void flipper_wedge_scene_startscreen_clear_scan(FlipperWedge* app) {
+    flipper_wedge_scan_record_clear(&app->nfc_scan);
+    flipper_wedge_scan_record_clear(&app->rfid_scan);
+    app->ndef_streamed_len = 0;
+}
+
+// Drop the current scan and every read still queued (mode change, leaving the screen)
+static void flipper_wedge_scene_startscreen_discard_scans(FlipperWedge* app) {
+    flipper_wedge_scene_startscreen_clear_scan(app);
+    flipper_wedge_scan_queue_flush(app->scan_queue);
+}
+
+// NFC callback - called on the GUI thread from the NFC tick when a tag was read
 static void flipper_wedge_scene_startscreen_nfc_callback(FlipperWedgeNfcData* data, void* context) {
     furi_assert(context);
     FlipperWedge* app = context;
 
     FURI_LOG_I("FlipperWedgeScene", "NFC callback: uid_len=%d, has_ndef=%d, error=%d", data->uid_len, data->has_ndef, data->error);
 
-    // Store the NFC data
-    app->nfc_uid_len = data->uid_len;
-    memcpy(app->nfc_uid, data->uid, data->uid_len);
-    app->nfc_error = data->error;
-
-    // In NDEF mode, only store NDEF text; in other NFC modes, store UID
-    if(data->has_ndef) {
-        snprintf(app->ndef_text, sizeof(app->ndef_text), "%s", data->ndef_text);
-    } else {
-        app->ndef_text[0] = '\0';
+    // The consumer is this thread, so never wait for room
+    FlipperWedgeScanRecord record;
+    flipper_wedge_scan_record_from_nfc(&record, data);
+    if(flipper_wedge_scan_queue_put(app->scan_queue, &record, 0)) {
+        view_dispatcher_send_custom_event(app->view_dispatcher, FlipperWedgeCustomEventScanQueued);
     }
-
-    // Send event to main thread
-    FURI_LOG_D("FlipperWedgeScene", "NFC callback: sending custom event");
-    view_dispatcher_send_custom_event(app->view_dispatcher, FlipperWedgeCustomEventNfcDetected);
 }
 
-// RFID callback - called when an RFID tag is detected
+// RFID callback - called on the LF worker thread for every read
 static void flipper_wedge_scene_startscreen_rfid_callback(FlipperWedgeRfidData* data, void* context) {
     furi_assert(context);
     FlipperWedge* app = context;
 
-    // Store the RFID data
-    app->rfid_uid_len = data->uid_len;
-    memcpy(app->rfid_uid, data->uid, data->uid_len);
+    flipper_wedge_latency_mark(app->latency, FlipperWedgeLatencyStageReadComplete);
+
+    FlipperWedgeScanRecord record;
+    flipper_wedge_scan_record_from_rfid(&record, data);
+    if(flipper_wedge_scan_queue_put(app->scan_queue, &record, FLIPPER_WEDGE_SCAN_QUEUE_WAIT_MS)) {
+        view_dispatcher_send_custom_event(app->view_dispatcher, FlipperWedgeCustomEventScanQueued);
+    }
+}
+
+// Display state and status text in one redraw
+static void flipper_wedge_scene_startscreen_show(
+    FlipperWedge* app,
+    FlipperWedgeDisplayState state,
+    const char* status_text) {
+    FlipperWedgeStartscreenUpdate update = {
+        .fields = FlipperWedgeStartscreenFieldDisplayState | FlipperWedgeStartscreenFieldStatusText,
+        .display_state = state,
+        .status_text = status_text,
+    };
+    flipper_wedge_startscreen_update(app->flipper_wedge_startscreen, &update);
+}
 
-    // Send event to main thread
-    view_dispatcher_send_custom_event(app->view_dispatcher, FlipperWedgeCustomEventRfidDetected);
+// Typing progress: redrawn a few times a second at most, the keys come first
+static void flipper_wedge_scene_startscreen_show_progress(FlipperWedge* app, const char* status_text) {
+    FlipperWedgeStartscreenUpdate update = {
+        .fields = FlipperWedgeStartscreenFieldStatusText,
+        .status_text = status_text,
+        .progress = true,
+    };
+    flipper_wedge_startscreen_update(app->flipper_wedge_startscreen, &update);
 }
 
 static void flipper_wedge_scene_startscreen_update_status(FlipperWedge* app) {
@@ -139,8 +114,450 @@ static void flipper_wedge_scene_startscreen_update_status(FlipperWedge* app) {
         app->flipper_wedge_startscreen, usb_connected, bt_connected);
 }
 
+// Send the current scan as one JSON record over USB serial
+// The NFC UID is passed separately so inventory batches can send one record per tag
+static void flipper_wedge_scene_startscreen_send_record(
+    FlipperWedge* app,
+    const uint8_t* nfc_uid,
+    uint8_t nfc_uid_len,
+    const char* nfc_protocol,
+    const char* ndef_text,
+    const char* event) {
+    // Worst case every NDEF character needs a two-byte escape
+    const size_t record_size = FLIPPER_WEDGE_OUTPUT_MAX_LEN * 2;
+    char* record = malloc(record_size);
+    const FlipperWedgeScanRecord* rfid = &app->rfid_scan;
+
+    // Time of the read that completed the scan
+    uint32_t timestamp = furi_hal_rtc_get_timestamp();
+    if(app->nfc_scan.uid_len > 0 || rfid->uid_len > 0) {
+        timestamp = MAX(app->nfc_scan.timestamp, rfid->timestamp);
+    }
+
+    size_t record_len = flipper_wedge_format_record_json(
+        timestamp,
+        nfc_uid_len > 0 ? nfc_uid : NULL,
+        nfc_uid_len,
+        nfc_protocol,
+        rfid->uid_len > 0 ? rfid->uid : NULL,
+        rfid->uid_len,
+        rfid->protocol,
+        rfid->uid_len > 0 ? &rfid->decoded : NULL,
+        ndef_text,
+        event,
+        record,
+        record_size);
+
+    if(record_len > 0) {
+        if(!flipper_wedge_hid_send_serial(flipper_wedge_get_hid(app), (uint8_t*)record, record_len)) {
+            FURI_LOG_W("FlipperWedgeScene", "Serial record not sent (host not reading)");
+        }
+    } else {
+        FURI_LOG_E("FlipperWedgeScene", "Serial record did not fit in %zu bytes", record_size);
+    }
+
+    free(record);
+}
+
+// Debug builds with output_bench in the app data folder: repeat the scan's output
+// back to back, so tools/wedge_receiver.py times the output path and not the operator
+static void flipper_wedge_scene_startscreen_output_bench(
+    FlipperWedge* app,
+    const char* output,
+    const char* ndef_text) {
+#ifdef FURI_DEBUG
+    const FlipperWedgeScanRecord* nfc = &app->nfc_scan;
+    FlipperWedgeHid* hid = flipper_wedge_get_hid(app);
+
+    // One record per scan only: no inventory batches, no text typed while reading
+    if(app->mode == FlipperWedgeModeInventory || nfc->ndef_streamed) return;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool enabled = storage_file_exists(storage, OUTPUT_BENCH_MARKER_PATH);
+    furi_record_close(RECORD_STORAGE);
+    if(!enabled) return;
+
+    bool serial = app->output_mode == FlipperWedgeOutputSerial;
+    if(!serial && !flipper_wedge_hid_is_connected(hid)) return;
+
+    uint32_t count = serial ? OUTPUT_BENCH_RECORDS : OUTPUT_BENCH_TYPED;
+    uint32_t start = furi_get_tick();
+    if(serial) {
+        for(uint32_t i = 0; i < count; i++) {
+            flipper_wedge_scene_startscreen_send_record(
+                app, nfc->uid, nfc->uid_len, nfc->protocol, ndef_text, NULL);
+        }
+    } else {
+        // One line per copy, so the host can count them
+        if(!app->append_enter) flipper_wedge_hid_press_enter(hid);
+        for(uint32_t i = 0; i < count; i++) {
+            flipper_wedge_hid_type_string(hid, app->keyboard_layout, output);
+            flipper_wedge_hid_press_enter(hid);
+        }
+    }
+    uint32_t elapsed_ms = furi_get_tick() - start;
+
+    FURI_LOG_I(
+        "FlipperWedgeScene",
+        "Output bench: %lu x %zu chars (%s) in %lu ms, %lu per s",
+        count,
+        strlen(output),
+        flipper_wedge_output_name(app->output_mode),
+        elapsed_ms,
+        elapsed_ms > 0 ? count * 1000 / elapsed_ms : 0);
+#else
+    UNUSED(app);
+    UNUSED(output);
+    UNUSED(ndef_text);
+#endif
+}
+
+// Type NDEF text chunks as the reader produces them (NDEF mode with no length limit)
+// Returns when the reader marks the end of the text or stops producing it
+static void flipper_wedge_scene_startscreen_type_stream(FlipperWedge* app) {
+    FlipperWedgeHid* hid = flipper_wedge_get_hid(app);
+    FlipperWedgeScanBuffer* chunk;
+
+    while((chunk = flipper_wedge_nfc_stream_next(app->nfc, FLIPPER_WEDGE_NDEF_STREAM_WAIT_MS))) {
+        char* text = flipper_wedge_scan_buffer_data(chunk);
+        size_t text_len = flipper_wedge_sanitize_text(
+            text, text, flipper_wedge_scan_buffer_capacity(chunk), 0);
+        app->ndef_streamed_len += text_len;
+
+        char progress_text[32];
+        snprintf(progress_text, sizeof(progress_text), "Typing %zu chars...", app->ndef_streamed_len);
+        flipper_wedge_scene_startscreen_show_progress(app, progress_text);
+
+        if(flipper_wedge_hid_is_connected(hid)) {
+            flipper_wedge_hid_type_string(hid, app->keyboard_layout, text);
+        }
+
+        // Returning the chunk lets the reader fill it with the next part
+        flipper_wedge_scan_buffer_unref(chunk);
+    }
+
+    flipper_wedge_debug_log_stack("FlipperWedgeScene", "NDEF stream");
+}
+
+// NFC-V Presence mode: output one arrival or departure
+static void flipper_wedge_scene_startscreen_presence_event(FlipperWedge* app, uint64_t uid, bool arrived) {
+    uint8_t uid_bytes[FLIPPER_WEDGE_ISO15693_UID_LEN];
+    char uid_buf[64];
+
+    flipper_wedge_iso15693_uid_to_bytes(uid, uid_bytes);
+    flipper_wedge_format_uid(uid_bytes, sizeof(uid_bytes), app->delimiter, uid_buf, sizeof(uid_buf));
+    snprintf(app->output_buffer, sizeof(app->output_buffer), "%c%s", arrived ? '+' : '-', uid_buf);
+    FURI_LOG_I("FlipperWedgeScene", "Presence: %s", app->output_buffer);
+
+    if(app->output_mode == FlipperWedgeOutputSerial) {
+        flipper_wedge_scene_startscreen_send_record(
+            app, uid_bytes, sizeof(uid_bytes), "ISO15693", NULL, arrived ? "arrive" : "depart");
+    } else if(flipper_wedge_hid_is_connected(flipper_wedge_get_hid(app))) {
+        flipper_wedge_hid_type_string(flipper_wedge_get_hid(app), app->keyboard_layout, app->output_buffer);
+        if(app->append_enter) {
+            flipper_wedge_hid_press_enter(flipper_wedge_get_hid(app));
+        }
+    }
+
+    if(app->log_to_sd) {
+        flipper_wedge_log_scan(app->output_buffer);
+    }
+}
+
+// NFC-V Presence mode: turn the UIDs of the inventory rounds into arrivals and departures
+static void flipper_wedge_scene_startscreen_update_presence(FlipperWedge* app) {
+    uint32_t now = furi_get_tick();
+    uint64_t uid;
+
+    while(flipper_wedge_nfc_presence_next(app->nfc, &uid)) {
+        if(flipper_wedge_iso15693_presence_seen(app->iso15693_presence, uid, now)) {
+            flipper_wedge_scene_startscreen_presence_event(app, uid, true);
+        }
+    }
+    while(flipper_wedge_iso15693_presence_expire(
+        app->iso15693_presence, now, furi_ms_to_ticks(FLIPPER_WEDGE_ISO15693_AGE_OUT_MS), &uid)) {
+        flipper_wedge_scene_startscreen_presence_event(app, uid, false);
+    }
+}
+
+// Inventory mode: all UIDs of the batch in one string
+static void flipper_wedge_scene_startscreen_format_inventory(FlipperWedge* app) {
+    static const char* const separators[FlipperWedgeBatchSeparatorCount] = {
+        [FlipperWedgeBatchSeparatorEnter] = "\n",
+        [FlipperWedgeBatchSeparatorTab] = "\t",
+        [FlipperWedgeBatchSeparatorSpace] = " ",
+        [FlipperWedgeBatchSeparatorComma] = ",",
+        [FlipperWedgeBatchSeparatorSemicolon] = ";",
+    };
+    const char* separator = separators[app->batch_separator];
+    char uid_buf[64];
+    size_t pos = 0;
+
+    app->output_buffer[0] = '\0';
+    for(uint8_t i = 0; i < app->nfc_scan.inventory_count; i++) {
+        flipper_wedge_format_uid(
+            app->nfc_scan.inventory[i].uid,
+            app->nfc_scan.inventory[i].uid_len,
+            app->delimiter,
+            uid_buf,
+            sizeof(uid_buf));
+        int len = snprintf(
+            app->output_buffer + pos,
+            sizeof(app->output_buffer) - pos,
+            "%s%s",
+            i > 0 ? separator : "",
+            uid_buf);
+        if(len < 0 || pos + len >= sizeof(app->output_buffer)) {
+            // Keep only whole UIDs
+            app->output_buffer[pos] = '\0';
+            FURI_LOG_W("FlipperWedgeScene", "Inventory output truncated after %u UIDs", i);
+            break;
+        }
+        pos += len;
+    }
+}
+
+// Scanning restarts once the feedback reaches its rearm step
+static void flipper_wedge_scene_startscreen_feedback_rearm(FlipperWedge* app) {
+    // Mode change or disconnect already moved on
+    if(app->scan_state != FlipperWedgeScanStateCooldown) return;
+
+    app->scan_state = FlipperWedgeScanStateIdle;
+    // Without HID this stays Idle and the tick handler retries
+    flipper_wedge_scene_startscreen_start_scanning(app);
+}
+
+static void flipper_wedge_scene_startscreen_feedback_show(FlipperWedge* app, const FlipperWedgeFeedbackStep* step) {
+    switch(step->led) {
+    case FlipperWedgeFeedbackLedGreen:
+        flipper_wedge_led_green(app);
+        break;
+    case FlipperWedgeFeedbackLedRed:
+        flipper_wedge_led_red(app);
+        break;
+    case FlipperWedgeFeedbackLedOff:
+        flipper_wedge_led_off(app);
+        break;
+    default:
+        break;
+    }
+
+    if(step->bump) {
+        flipper_wedge_play_happy_bump_async(app);
+    }
+
+    switch(step->show) {
+    case FlipperWedgeFeedbackShowResult:
+        // Output and status text were set with the result
+        flipper_wedge_startscreen_set_display_state(app->flipper_wedge_startscreen, FlipperWedgeDisplayStateResult);
+        break;
+    case FlipperWedgeFeedbackShowSent:
+        flipper_wedge_scene_startscreen_show(app, FlipperWedgeDisplayStateSent, "Sent");
+        break;
+    case FlipperWedgeFeedbackShowIdle:
+        flipper_wedge_scene_startscreen_show(app, FlipperWedgeDisplayStateIdle, NULL);
+        break;
+    }
+}
+
+// Play the feedback timeline from a step until a step has to be held
+static void flipper_wedge_scene_startscreen_feedback_play(FlipperWedge* app, uint8_t step) {
+    const FlipperWedgeFeedbackTimeline* timeline = app->feedback;
+
+    for(; step < timeline->step_count; step++) {
+        if(step == timeline->rearm_step) {
+            flipper_wedge_scene_startscreen_feedback_rearm(app);
+        }
+        flipper_wedge_scene_startscreen_feedback_show(app, &timeline->steps[step]);
+
+        if(timeline->steps[step].duration_ms > 0) {
+            app->feedback_step = step;
+            furi_timer_start(app->display_timer, furi_ms_to_ticks(timeline->steps[step].duration_ms));
+            return;
+        }
+    }
+
+    app->feedback = NULL;
+    if(timeline->rearm_step >= timeline->step_count) {
+        flipper_wedge_scene_startscreen_feedback_rearm(app);
+    }
+}
+
+// Show the outcome of a scan, the profile's timeline decides when scanning restarts
+static void flipper_wedge_scene_startscreen_feedback_start(FlipperWedge* app, FlipperWedgeFeedbackOutcome outcome) {
+    if(app->display_timer) {
+        furi_timer_stop(app->display_timer);
+    } else {
+        app->display_timer = furi_timer_alloc(
+            flipper_wedge_scene_startscreen_display_timer_callback,
+            FuriTimerTypeOnce,
+            app);
+    }
+
+    // Set state to cooldown to prevent immediate re-scan
+    app->scan_state = FlipperWedgeScanStateCooldown;
+
+    app->feedback = flipper_wedge_feedback_get_timeline(app->feedback_profile, outcome);
+    flipper_wedge_scene_startscreen_feedback_play(app, 0);
+}
+
+// Drop the feedback still playing (its display would cover what comes next)
+static void flipper_wedge_scene_startscreen_feedback_stop(FlipperWedge* app) {
+    if(!app->feedback) return;
+
+    furi_timer_stop(app->display_timer);
+    app->feedback = NULL;
+    flipper_wedge_led_off(app);
+}
+
+// Fast feedback rearms at once, so a tag left on the reader is read again right away
+// Returns true, and scans again, if the current scan repeats the last one output
+static bool flipper_wedge_scene_startscreen_skip_repeat(FlipperWedge* app) {
+    const FlipperWedgeScanRecord* nfc = &app->nfc_scan;
+    const FlipperWedgeScanRecord* rfid = &app->rfid_scan;
+
+    if(!flipper_wedge_feedback_check_repeat(
+           &app->feedback_repeat,
+           nfc->uid,
+           nfc->uid_len,
+           rfid->uid,
+           rfid->uid_len,
+           furi_get_tick(),
+           flipper_wedge_feedback_repeat_ms(app->feedback_profile))) {
+        return false;
+    }
+
+    FURI_LOG_D("FlipperWedgeScene", "Same tag(s) as the last scan, ignored");
+    flipper_wedge_scene_startscreen_clear_scan(app);
+    app->scan_state = FlipperWedgeScanStateIdle;
+    flipper_wedge_scene_startscreen_start_scanning(app);
+    return true;
+}
+
+// Show a scan error, then clear and continue scanning (nothing is typed)
+static void flipper_wedge_scene_startscreen_show_error(
+    FlipperWedge* app,
+    const char* uid_text,
+    const char* error_msg) {
+    // Show error message (the timeline's Result step then has nothing left to redraw)
+    FlipperWedgeStartscreenUpdate error = {
+        .fields = FlipperWedgeStartscreenFieldDisplayState | FlipperWedgeStartscreenFieldStatusText |
+                  FlipperWedgeStartscreenFieldUidText,
+        .display_state = FlipperWedgeDisplayStateResult,
+        .status_text = error_msg,
+        .uid_text = uid_text,
+    };
+    flipper_wedge_startscreen_update(app->flipper_wedge_startscreen, &error);
+
+    // Clear data
+    flipper_wedge_scene_startscreen_clear_scan(app);
+
+    flipper_wedge_scene_startscreen_feedback_start(app, FlipperWedgeFeedbackOutcomeError);
+}
+
+// Lookup table applies to typed output of single-UID modes
+static bool flipper_wedge_scene_startscreen_uses_lookup(FlipperWedge* app) {
+    return flipper_wedge_lookup_is_loaded(app->lookup) &&
+           app->output_mode != FlipperWedgeOutputSerial &&
+           (app->mode == FlipperWedgeModeNfc || app->mode == FlipperWedgeModeRfid ||
+            app->mode == FlipperWedgeModeNfcOrRfid);
+}
+
+// Macro applies to typed output of every mode but the batch and presence ones
+static bool flipper_wedge_scene_startscreen_uses_macro(FlipperWedge* app) {
+    return flipper_wedge_macro_is_loaded(app->macro) && app->output_mode != FlipperWedgeOutputSerial &&
+           app->mode != FlipperWedgeModeInventory;
+}
+
+static void flipper_wedge_scene_startscreen_macro_key(uint16_t keycode, void* context) {
+    FlipperWedge* app = context;
+    flipper_wedge_hid_press_key(flipper_wedge_get_hid(app), keycode);
+}
+
+static void flipper_wedge_scene_startscreen_macro_text(const char* text, void* context) {
+    FlipperWedge* app = context;
+    flipper_wedge_hid_type_string(flipper_wedge_get_hid(app), app->keyboard_layout, text);
+}
+
+static void flipper_wedge_scene_startscreen_macro_delay(uint32_t ms, void* context) {
+    UNUSED(context);
+    furi_delay_ms(ms);
+}
+
+// Type the current scan with the macro program in place of the output and Enter
+static void flipper_wedge_scene_startscreen_run_macro(FlipperWedge* app, const char* output, const char* ndef_text) {
+    const FlipperWedgeScanRecord* nfc = &app->nfc_scan;
+    const FlipperWedgeScanRecord* rfid = &app->rfid_scan;
+    DateTime datetime;
+    furi_hal_rtc_get_datetime(&datetime);
+
+    FlipperWedgeMacroData data = {
+        .output = output,
+        .nfc_uid = nfc->uid_len > 0 ? nfc->uid : NULL,
+        .nfc_uid_len = nfc->uid_len,
+        .rfid_uid = rfid->uid_len > 0 ? rfid->uid : NULL,
+        .rfid_uid_len = rfid->uid_len,
+        .ndef_text = ndef_text,
+        .delimiter = app->delimiter,
+        .datetime = &datetime,
+    };
+    FlipperWedgeMacroOutput macro_output = {
+        .key = flipper_wedge_scene_startscreen_macro_key,
+        .text = flipper_wedge_scene_startscreen_macro_text,
+        .delay = flipper_wedge_scene_startscreen_macro_delay,
+        .context = app,
+    };
+    flipper_wedge_macro_run(app->macro, &data, &macro_output);
+}
+
+// Check one scanned UID against the access list
+static bool flipper_wedge_scene_startscreen_uid_allowed(FlipperWedge* app, const uint8_t* uid, uint8_t uid_len) {
+    if(uid_len == 0) return true;
+    if(!flipper_wedge_access_is_loaded(app->access)) {
+        // A missing allowlist lets nothing through, a missing denylist blocks nothing
+        return app->access_mode != FlipperWedgeAccessModeAllow;
+    }
+    bool listed = flipper_wedge_access_contains(app->access, uid, uid_len);
+    return app->access_mode == FlipperWedgeAccessModeAllow ? listed : !listed;
+}
+
+// Access list gate, runs before a scan is output
+// Rejected scans show "Not allowed" with a red flash and are not typed, sent or logged
+static bool flipper_wedge_scene_startscreen_access_granted(FlipperWedge* app) {
+    if(app->access_mode == FlipperWedgeAccessModeOff || app->mode == FlipperWedgeModeNdef ||
+       app->mode == FlipperWedgeModeInventory || app->mode == FlipperWedgeModePresence) {
+        return true;
+    }
+
+    // Combo modes: every scanned tag has to pass
+    const FlipperWedgeScanRecord* denied;
+    if(!flipper_wedge_scene_startscreen_uid_allowed(app, app->nfc_scan.uid, app->nfc_scan.uid_len)) {
+        denied = &app->nfc_scan;
+    } else if(!flipper_wedge_scene_startscreen_uid_allowed(app, app->rfid_scan.uid, app->rfid_scan.uid_len)) {
+        denied = &app->rfid_scan;
+    } else {
+        return true;
+    }
+
+    char uid_text[64];
+    flipper_wedge_format_uid(denied->uid, denied->uid_len, "", uid_text, sizeof(uid_text));
+    FURI_LOG_I("FlipperWedgeScene", "Access denied for %s", uid_text);
+    flipper_wedge_scene_startscreen_show_error(app, uid_text, "Not allowed");
+    return false;
+}
+
 static void flipper_wedge_scene_startscreen_output_and_reset(FlipperWedge* app) {
-    FURI_LOG_I("FlipperWedgeScene", "output_and_reset: nfc_uid_len=%d, rfid_uid_len=%d", app->nfc_uid_len, app->rfid_uid_len);
+    const FlipperWedgeScanRecord* nfc = &app->nfc_scan;
+    const FlipperWedgeScanRecord* rfid = &app->rfid_scan;
+    FURI_LOG_I("FlipperWedgeScene", "output_and_reset: nfc_uid_len=%d, rfid_uid_len=%d", nfc->uid_len, rfid->uid_len);
+
+    if(flipper_wedge_scene_startscreen_skip_repeat(app)) {
+        return;
+    }
+
+    if(!flipper_wedge_scene_startscreen_access_granted(app)) {
+        return;
+    }
 
     // Determine max NDEF length from settings
     size_t max_ndef_len = 0;
@@ -154,125 +571,200 @@ static void flipper_wedge_scene_startscreen_output_and_reset(FlipperWedge* app)
         case FlipperWedgeNdefMaxLen1000:
             max_ndef_len = 1000;
             break;
+        case FlipperWedgeNdefMaxLenUnlimited:
+            // Keyboard output streams instead; serial records get what fits the buffer
+            max_ndef_len = 0;
+            break;
         default:
             max_ndef_len = 250;
             break;
     }
 
-    // Sanitize NDEF text if present (remove non-printable chars, apply length limit)
-    char sanitized_ndef[FLIPPER_WEDGE_NDEF_MAX_LEN];
-    if(app->ndef_text[0] != '\0') {
-        size_t original_len = strlen(app->ndef_text);
-        size_t sanitized_len = flipper_wedge_sanitize_text(
-            app->ndef_text,
-            sanitized_ndef,
-            sizeof(sanitized_ndef),
-            max_ndef_len);
-
-        FURI_LOG_I("FlipperWedgeScene", "NDEF text: original=%zu, sanitized=%zu, limit=%zu",
-                   original_len, sanitized_len, max_ndef_len);
+    // Lookup table: type the value mapped to the UID, unknown tags type nothing
+    char lookup_value[FLIPPER_WEDGE_LOOKUP_VALUE_MAX_LEN + 1];
+    bool lookup_hit = false;
+    if(flipper_wedge_scene_startscreen_uses_lookup(app)) {
+        const FlipperWedgeScanRecord* scan = nfc->uid_len > 0 ? nfc : rfid;
+        const uint8_t* uid = scan->uid;
+        uint8_t uid_len = scan->uid_len;
+        lookup_hit = flipper_wedge_lookup_find(app->lookup, uid, uid_len, lookup_value, sizeof(lookup_value));
+        if(!lookup_hit) {
+            char uid_text[64];
+            flipper_wedge_format_uid(uid, uid_len, "", uid_text, sizeof(uid_text));
+            FURI_LOG_I("FlipperWedgeScene", "Lookup miss for %s", uid_text);
+            flipper_wedge_scene_startscreen_show_error(app, uid_text, "Not in table");
+            return;
+        }
+    }
 
-        // Warn if text was truncated
-        if(max_ndef_len > 0 && original_len > max_ndef_len) {
+    // Sanitize NDEF text in place (remove non-printable chars, apply length limit)
+    // The buffer is the one the reader filled; later stages only take views of it
+    const char* ndef_text = "";
+    if(nfc->ndef) {
+        char* text = flipper_wedge_scan_buffer_data(nfc->ndef);
+        size_t capacity = flipper_wedge_scan_buffer_capacity(nfc->ndef);
+        size_t original_len = strlen(text);
+        // The limit is in characters, counted as the streamed typing counts them:
+        // sanitize without a limit first, then again (only cutting) if it is over
+        size_t text_chars = flipper_wedge_sanitize_text(text, text, capacity, 0);
+        size_t sanitized_len = text_chars;
+        if(max_ndef_len > 0 && text_chars > max_ndef_len) {
+            sanitized_len = flipper_wedge_sanitize_text(text, text, capacity, max_ndef_len);
             FURI_LOG_W("FlipperWedgeScene", "NDEF text truncated from %zu to %zu chars",
-                       original_len, sanitized_len);
+                       text_chars, sanitized_len);
         }
-    } else {
-        sanitized_ndef[0] = '\0';
+        ndef_text = text;
+
+        FURI_LOG_I("FlipperWedgeScene", "NDEF text: %zu bytes, %zu chars, limit=%zu",
+                   original_len, sanitized_len, max_ndef_len);
     }
 
     // Format the output based on mode
-    if(app->mode == FlipperWedgeModeNdef) {
-        // NDEF mode: output only NDEF text (no UID)
-        snprintf(app->output_buffer, sizeof(app->output_buffer), "%s", sanitized_ndef);
+    const char* output;
+    if(app->mode == FlipperWedgeModeNdef && nfc->ndef_streamed) {
+        // NDEF mode, streamed: the text was typed while the tag was read
+        snprintf(
+            app->output_buffer,
+            sizeof(app->output_buffer),
+            "NDEF text (%zu chars)",
+            app->ndef_streamed_len);
+        output = app->output_buffer;
+    } else if(app->mode == FlipperWedgeModeNdef) {
+        // NDEF mode: output only NDEF text (no UID), typed straight from the scan buffer
+        output = ndef_text;
+    } else if(app->mode == FlipperWedgeModeInventory) {
+        // Inventory mode: every UID in the field, sorted, one batch
+        flipper_wedge_scene_startscreen_format_inventory(app);
+        output = app->output_buffer;
+    } else if(lookup_hit) {
+        // Value from the lookup table, takes the place of the UID format
+        output = lookup_value;
+    } else if(flipper_wedge_template_is_set(app->output_template)) {
+        // Other modes, custom format from the settings file
+        FlipperWedgeTemplateData data = {
+            .nfc_uid = nfc->uid_len > 0 ? nfc->uid : NULL,
+            .nfc_uid_len = nfc->uid_len,
+            .rfid_uid = rfid->uid_len > 0 ? rfid->uid : NULL,
+            .rfid_uid_len = rfid->uid_len,
+            .rfid_decoded = rfid->uid_len > 0 ? &rfid->decoded : NULL,
+            .ndef_text = ndef_text,
+            .delimiter = app->delimiter,
+        };
+        flipper_wedge_template_render(
+            app->output_template, &data, app->output_buffer, sizeof(app->output_buffer));
+        output = app->output_buffer;
     } else {
         // Other modes: format UIDs (and NDEF if present)
         bool nfc_first = (app->mode == FlipperWedgeModeNfc ||
-                          app->mode == FlipperWedgeModeNfcThenRfid);
+                          app->mode == FlipperWedgeModeNfcThenRfid ||
+                          app->mode == FlipperWedgeModeNfcOrRfid ||
+                          app->mode == FlipperWedgeModeNfcAndRfid);
 
         flipper_wedge_format_output(
-            app->nfc_uid_len > 0 ? app->nfc_uid : NULL,
-            app->nfc_uid_len,
-            app->rfid_uid_len > 0 ? app->rfid_uid : NULL,
-            app->rfid_uid_len,
-            sanitized_ndef,  // Use sanitized text
+            nfc->uid_len > 0 ? nfc->uid : NULL,
+            nfc->uid_len,
+            rfid->uid_len > 0 ? rfid->uid : NULL,
+            rfid->uid_len,
+            ndef_text,  // Use sanitized text
             app->delimiter,
             nfc_first,
             app->output_buffer,
             sizeof(app->output_buffer));
+        output = app->output_buffer;
     }
 
-    // Show the output briefly
-    flipper_wedge_startscreen_set_uid_text(app->flipper_wedge_startscreen, app->output_buffer);
-    flipper_wedge_startscreen_set_display_state(app->flipper_wedge_startscreen, FlipperWedgeDisplayStateResult);
-
-    // Type the output via HID (with chunking for long text)
-    if(flipper_wedge_hid_is_connected(flipper_wedge_get_hid(app))) {
-        size_t text_len = strlen(app->output_buffer);
+    flipper_wedge_latency_mark(app->latency, FlipperWedgeLatencyStageFormat);
+
+    // Show the output briefly (a tag count for inventory batches)
+    char inventory_text[24];
+    FlipperWedgeStartscreenUpdate result = {
+        .fields = FlipperWedgeStartscreenFieldUidText | FlipperWedgeStartscreenFieldDisplayState,
+        .display_state = FlipperWedgeDisplayStateResult,
+        .uid_text = output,
+    };
+    if(app->mode == FlipperWedgeModeInventory) {
+        snprintf(inventory_text, sizeof(inventory_text), "%u tags", nfc->inventory_count);
+        result.uid_text = inventory_text;
+    }
+    flipper_wedge_startscreen_update(app->flipper_wedge_startscreen, &result);
 
-        // If text is long (>100 chars), show progress and type in chunks
-        if(text_len > 100) {
+    if(app->output_mode == FlipperWedgeOutputSerial && app->mode == FlipperWedgeModeInventory) {
+        // Structured output: one record per tag of the batch
+        for(uint8_t i = 0; i < nfc->inventory_count; i++) {
+            flipper_wedge_scene_startscreen_send_record(
+                app, nfc->inventory[i].uid, nfc->inventory[i].uid_len, nfc->protocol, NULL, NULL);
+        }
+        if(app->log_to_sd) {
+            flipper_wedge_log_scan(output);
+        }
+    } else if(app->output_mode == FlipperWedgeOutputSerial) {
+        // Structured output: one framed record per scan instead of keystrokes
+        flipper_wedge_scene_startscreen_send_record(app, nfc->uid, nfc->uid_len, nfc->protocol, ndef_text, NULL);
+        if(app->log_to_sd) {
+            flipper_wedge_log_scan(output);
+        }
+    } else if(flipper_wedge_hid_is_connected(flipper_wedge_get_hid(app))) {
+        // Type the output via HID (with chunking for long text)
+        size_t text_len = strlen(output);
+        bool use_macro = !nfc->ndef_streamed && flipper_wedge_scene_startscreen_uses_macro(app);
+
+        if(nfc->ndef_streamed) {
+            // Already typed chunk by chunk while the tag was read
+        } else if(use_macro) {
+            flipper_wedge_scene_startscreen_run_macro(app, output, ndef_text);
+        } else if(text_len > 100) {
+            // If text is long (>100 chars), show progress and type in chunks
             const size_t chunk_size = 100;
             size_t chunks = (text_len + chunk_size - 1) / chunk_size;
+            size_t chunk_start = 0;
 
-            for(size_t i = 0; i < chunks; i++) {
+            for(size_t i = 0; chunk_start < text_len; i++) {
                 // Update progress
                 char progress_text[32];
-                snprintf(progress_text, sizeof(progress_text), "Typing %zu/%zu...", i + 1, chunks);
-                flipper_wedge_startscreen_set_status_text(app->flipper_wedge_startscreen, progress_text);
+                snprintf(progress_text, sizeof(progress_text), "Typing %zu/%zu...", MIN(i + 1, chunks), chunks);
+                flipper_wedge_scene_startscreen_show_progress(app, progress_text);
 
-                // Type chunk
-                size_t chunk_start = i * chunk_size;
+                // Type chunk, ending on a whole UTF-8 character
                 size_t chunk_len = (chunk_start + chunk_size > text_len) ?
                                    (text_len - chunk_start) : chunk_size;
+                if(chunk_start + chunk_len < text_len) {
+                    chunk_len -= flipper_wedge_utf8_tail_len(output + chunk_start, chunk_len);
+                }
 
                 char chunk[101];  // 100 + null terminator
-                memcpy(chunk, app->output_buffer + chunk_start, chunk_len);
+                memcpy(chunk, output + chunk_start, chunk_len);
                 chunk[chunk_len] = '\0';
 
                 flipper_wedge_hid_type_string(flipper_wedge_get_hid(app), app->keyboard_layout, chunk);
+                chunk_start += chunk_len;
 
                 // Small delay between chunks (let HID catch up)
                 furi_delay_ms(50);
             }
         } else {
             // Short text, type normally
-            flipper_wedge_hid_type_string(flipper_wedge_get_hid(app), app->keyboard_layout, app->output_buffer);
+            flipper_wedge_hid_type_string(flipper_wedge_get_hid(app), app->keyboard_layout, output);
         }
 
-        if(app->append_enter) {
+        if(app->append_enter && !use_macro) {
             flipper_wedge_hid_press_enter(flipper_wedge_get_hid(app));
         }
 
         // Log to SD card if enabled
         if(app->log_to_sd) {
-            flipper_wedge_log_scan(app->output_buffer);
+            flipper_wedge_log_scan(output);
         }
     }
 
-    // LED feedback (haptic happens later when "Sent" is displayed)
-    flipper_wedge_led_set_rgb(app, 0, 255, 0);  // Green flash
+    flipper_wedge_scene_startscreen_output_bench(app, output, ndef_text);
 
-    // Start display timer to show result, then "Sent", then cooldown (non-blocking)
-    if(app->display_timer) {
-        furi_timer_stop(app->display_timer);
-    } else {
-        app->display_timer = furi_timer_alloc(
-            flipper_wedge_scene_startscreen_display_timer_callback,
-            FuriTimerTypeOnce,
-            app);
-    }
-
-    // Clear scanned data
-    app->nfc_uid_len = 0;
-    app->rfid_uid_len = 0;
-    app->ndef_text[0] = '\0';
+    flipper_wedge_debug_log_stack("FlipperWedgeScene", "output");
 
-    // Set state to cooldown to prevent immediate re-scan
-    app->scan_state = FlipperWedgeScanStateCooldown;
+    // Clear scanned data (returns the NDEF buffer to the pool)
+    flipper_wedge_scene_startscreen_clear_scan(app);
 
-    // Timer will handle three stages: 200ms (show result) -> 200ms (show "Sent") -> 300ms (cooldown)
-    furi_timer_start(app->display_timer, furi_ms_to_ticks(200));
+    // Result, "Sent", cooldown as the feedback profile has them
+    flipper_wedge_scene_startscreen_feedback_start(app, FlipperWedgeFeedbackOutcomeSent);
 }
 
 static void flipper_wedge_scene_startscreen_start_scanning(FlipperWedge* app) {
@@ -284,55 +776,240 @@ static void flipper_wedge_scene_startscreen_start_scanning(FlipperWedge* app) {
 
     FURI_LOG_I("FlipperWedgeScene", "start_scanning: mode=%d, current scan_state=%d", app->mode, app->scan_state);
 
+    // Closes the timing of the previous scan
+    flipper_wedge_latency_mark(app->latency, FlipperWedgeLatencyStageRearm);
+
     // Clear previous scan state to ensure fresh start
-    app->nfc_error = FlipperWedgeNfcErrorNone;
-    app->nfc_uid_len = 0;
-    app->ndef_text[0] = '\0';
+    flipper_wedge_scene_startscreen_clear_scan(app);
 
     app->scan_state = FlipperWedgeScanStateScanning;
     // Keep display in Idle state to show mode selector while scanning
 
     // Start appropriate reader(s) based on mode
+    flipper_wedge_nfc_set_callback(app->nfc, flipper_wedge_scene_startscreen_nfc_callback, app);
+    flipper_wedge_rfid_set_callback(app->rfid, flipper_wedge_scene_startscreen_rfid_callback, app);
+    flipper_wedge_nfc_set_inventory(app->nfc, app->mode == FlipperWedgeModeInventory);
+    flipper_wedge_nfc_set_presence(app->nfc, app->mode == FlipperWedgeModePresence);
+    flipper_wedge_nfc_set_classic(
+        app->nfc,
+        app->classic_sector != FLIPPER_WEDGE_CLASSIC_SECTOR_OFF ? app->classic_keys : NULL,
+        app->classic_sector);
     switch(app->mode) {
     case FlipperWedgeModeNfc:
+    case FlipperWedgeModeNfcThenRfid:
+    case FlipperWedgeModeInventory:
         // NFC mode: read UID only (no NDEF parsing)
-        flipper_wedge_nfc_set_callback(app->nfc, flipper_wedge_scene_startscreen_nfc_callback, app);
-        flipper_wedge_nfc_start(app->nfc, false);
+        flipper_wedge_scheduler_start(app->scheduler, FlipperWedgeFieldNfc, false);
         break;
     case FlipperWedgeModeRfid:
-        flipper_wedge_rfid_set_callback(app->rfid, flipper_wedge_scene_startscreen_rfid_callback, app);
-        flipper_wedge_rfid_start(app->rfid);
+    case FlipperWedgeModeRfidThenNfc:
+        flipper_wedge_scheduler_start(app->scheduler, FlipperWedgeFieldRfid, false);
         break;
     case FlipperWedgeModeNdef:
         // NDEF mode: read and parse NDEF text records only
-        flipper_wedge_nfc_set_callback(app->nfc, flipper_wedge_scene_startscreen_nfc_callback, app);
-        flipper_wedge_nfc_start(app->nfc, true);
+        // With no length limit the text is typed while the tag is read (keyboard output only)
+        // Not with fast feedback: a streamed tag is typed before it can be checked for a repeat
+        flipper_wedge_nfc_set_ndef_stream(
+            app->nfc,
+            app->ndef_max_len == FlipperWedgeNdefMaxLenUnlimited &&
+                app->output_mode != FlipperWedgeOutputSerial &&
+                app->feedback_profile == FlipperWedgeFeedbackProfileStandard);
+        flipper_wedge_scheduler_start(app->scheduler, FlipperWedgeFieldNfc, true);
         break;
-    case FlipperWedgeModeNfcThenRfid:
-        // Start with NFC (UID only for combo mode)
-        flipper_wedge_nfc_set_callback(app->nfc, flipper_wedge_scene_startscreen_nfc_callback, app);
-        flipper_wedge_nfc_start(app->nfc, false);
+    case FlipperWedgeModePresence:
+        // Tags are tracked from scratch: everything in the field arrives again
+        flipper_wedge_iso15693_presence_clear(app->iso15693_presence);
+        // No Idle Poll: an off-window longer than the age-out would depart every tag
+        flipper_wedge_scheduler_start_continuous(app->scheduler, FlipperWedgeFieldNfc, false);
         break;
-    case FlipperWedgeModeRfidThenNfc:
-        // Start with RFID
-        flipper_wedge_rfid_set_callback(app->rfid, flipper_wedge_scene_startscreen_rfid_callback, app);
-        flipper_wedge_rfid_start(app->rfid);
+    case FlipperWedgeModeNfcOrRfid:
+    case FlipperWedgeModeNfcAndRfid:
+        // Either tag may come first: alternate HF and LF windows
+        flipper_wedge_scheduler_start(app->scheduler, FlipperWedgeFieldBoth, false);
         break;
     default:
         break;
     }
+
+    // Reads that arrived while the previous scan was being output come first
+    if(flipper_wedge_scan_queue_count(app->scan_queue) > 0) {
+        view_dispatcher_send_custom_event(app->view_dispatcher, FlipperWedgeCustomEventScanQueued);
+    }
+}
+
+// Combo modes: the first tag is stored, scan only for the other one until the timeout
+static void flipper_wedge_scene_startscreen_wait_second(FlipperWedge* app, FlipperWedgeField field) {
+    flipper_wedge_scene_startscreen_feedback_stop(app);
+    app->scan_state = FlipperWedgeScanStateWaitingSecond;
+    flipper_wedge_scene_startscreen_show(
+        app,
+        FlipperWedgeDisplayStateWaiting,
+        field == FlipperWedgeFieldRfid ? "Waiting for RFID..." : "Waiting for NFC...");
+
+    // Second tag is UID only
+    flipper_wedge_scheduler_start(app->scheduler, field, false);
+
+    // Start timeout timer (5 seconds to scan second tag)
+    if(!app->timeout_timer) {
+        app->timeout_timer = furi_timer_alloc(
+            flipper_wedge_scene_startscreen_timeout_callback,
+            FuriTimerTypeOnce,
+            app);
+    }
+    furi_timer_start(app->timeout_timer, furi_ms_to_ticks(5000));
+}
+
+// Combo modes: got the second tag
+static void flipper_wedge_scene_startscreen_second_done(FlipperWedge* app) {
+    if(app->timeout_timer) {
+        furi_timer_stop(app->timeout_timer);
+    }
+    flipper_wedge_scheduler_stop(app->scheduler);
+    flipper_wedge_scene_startscreen_output_and_reset(app);
 }
 
 static void flipper_wedge_scene_startscreen_stop_scanning(FlipperWedge* app) {
     FURI_LOG_I("FlipperWedgeScene", "stop_scanning: current scan_state=%d", app->scan_state);
 
-    flipper_wedge_nfc_stop(app->nfc);
-    flipper_wedge_rfid_stop(app->rfid);
+    flipper_wedge_scheduler_stop(app->scheduler);
     app->scan_state = FlipperWedgeScanStateIdle;
     flipper_wedge_startscreen_set_display_state(app->flipper_wedge_startscreen, FlipperWedgeDisplayStateIdle);
     FURI_LOG_D("FlipperWedgeScene", "stop_scanning: done, scan_state now Idle");
 }
 
+// NFC read taken from the queue; the record is owned by this function
+static void flipper_wedge_scene_startscreen_nfc_scan(FlipperWedge* app, FlipperWedgeScanRecord* record) {
+    FURI_LOG_I("FlipperWedgeScene", "NFC scan: mode=%d, scan_state=%d", app->mode, app->scan_state);
+
+    bool single = app->mode == FlipperWedgeModeNfc || app->mode == FlipperWedgeModeNfcOrRfid ||
+                  app->mode == FlipperWedgeModeInventory || app->mode == FlipperWedgeModeNdef;
+    bool first = app->scan_state == FlipperWedgeScanStateScanning &&
+                 (app->mode == FlipperWedgeModeNfcThenRfid || app->mode == FlipperWedgeModeNfcAndRfid);
+    // Only combo modes wait for a second tag
+    bool second = app->scan_state == FlipperWedgeScanStateWaitingSecond && app->nfc_scan.uid_len == 0;
+    if(!single && !first && !second) {
+        // Combo mode already has its NFC tag and waits for RFID
+        FURI_LOG_D("FlipperWedgeScene", "NFC scan not wanted now, dropping");
+        flipper_wedge_scan_record_clear(record);
+        return;
+    }
+
+    flipper_wedge_scan_record_clear(&app->nfc_scan);
+    app->nfc_scan = *record;
+    flipper_wedge_scheduler_note_read(app->scheduler, FlipperWedgeFieldNfc);
+    const FlipperWedgeScanRecord* nfc = &app->nfc_scan;
+
+    if(app->mode == FlipperWedgeModeNdef) {
+        // NDEF mode - check the error status to distinguish between cases
+        if(nfc->ndef || nfc->ndef_streamed) {
+            // NDEF text found - output it
+            FURI_LOG_D("FlipperWedgeScene", "NDEF mode - NDEF text found, outputting");
+            if(nfc->ndef_streamed && flipper_wedge_nfc_stream_pending(app->nfc)) {
+                // Read finished between ticks, type the rest before the reader is stopped
+                flipper_wedge_scene_startscreen_type_stream(app);
+            }
+            flipper_wedge_scene_startscreen_stop_scanning(app);
+            flipper_wedge_scene_startscreen_output_and_reset(app);
+        } else {
+            // No NDEF text - determine error message based on the read's error
+            const char* error_msg;
+            if(nfc->error == FlipperWedgeNfcErrorNotForumCompliant) {
+                error_msg = "Not NFC Forum Compliant";
+                FURI_LOG_D("FlipperWedgeScene", "NDEF mode - Not NFC Forum compliant (e.g., MIFARE Classic)");
+            } else if(nfc->error == FlipperWedgeNfcErrorUnsupportedType) {
+                error_msg = "Unsupported NFC Forum Type";
+                FURI_LOG_D("FlipperWedgeScene", "NDEF mode - Unsupported NFC Forum Type");
+            } else if(nfc->error == FlipperWedgeNfcErrorClassicNoKey) {
+                error_msg = "Classic Key Not Found";
+                FURI_LOG_D("FlipperWedgeScene", "NDEF mode - no Classic key opens the sector");
+            } else if(nfc->error == FlipperWedgeNfcErrorBusy) {
+                error_msg = "Busy, Scan Again";
+                FURI_LOG_W("FlipperWedgeScene", "NDEF mode - no free NDEF buffer, earlier reads still queued");
+            } else if(nfc->error == FlipperWedgeNfcErrorNoTextRecord) {
+                error_msg = "NDEF Not Found";
+                FURI_LOG_D("FlipperWedgeScene", "NDEF mode - NDEF not found");
+            } else {
+                // Fallback for any other case
+                error_msg = "NDEF Not Found";
+                FURI_LOG_D("FlipperWedgeScene", "NDEF mode - Unknown error");
+            }
+
+            // IMPORTANT: Stop the scanner before showing error to prevent conflicts
+            flipper_wedge_scene_startscreen_stop_scanning(app);
+            if(!flipper_wedge_scene_startscreen_skip_repeat(app)) {
+                flipper_wedge_scene_startscreen_show_error(app, "", error_msg);
+            }
+        }
+    } else if(single) {
+        // Single read mode - output UID (or inventory batch) immediately
+        FURI_LOG_D("FlipperWedgeScene", "NFC single mode - stopping and outputting");
+        flipper_wedge_scene_startscreen_stop_scanning(app);
+        flipper_wedge_scene_startscreen_output_and_reset(app);
+    } else if(first) {
+        // Combo mode - now wait for RFID
+        flipper_wedge_scene_startscreen_wait_second(app, FlipperWedgeFieldRfid);
+    } else {
+        // Got the second tag in combo mode
+        flipper_wedge_scene_startscreen_second_done(app);
+    }
+}
+
+// RFID read taken from the queue; the record is owned by this function
+static void flipper_wedge_scene_startscreen_rfid_scan(FlipperWedge* app, FlipperWedgeScanRecord* record) {
+    FURI_LOG_I("FlipperWedgeScene", "RFID scan: mode=%d, scan_state=%d", app->mode, app->scan_state);
+
+    bool single = app->mode == FlipperWedgeModeRfid || app->mode == FlipperWedgeModeNfcOrRfid;
+    bool first = app->scan_state == FlipperWedgeScanStateScanning &&
+                 (app->mode == FlipperWedgeModeRfidThenNfc || app->mode == FlipperWedgeModeNfcAndRfid);
+    bool second = app->scan_state == FlipperWedgeScanStateWaitingSecond && app->rfid_scan.uid_len == 0;
+    if(!single && !first && !second) {
+        // Combo mode already has its RFID tag and waits for NFC
+        FURI_LOG_D("FlipperWedgeScene", "RFID scan not wanted now, dropping");
+        flipper_wedge_scan_record_clear(record);
+        return;
+    }
+
+    flipper_wedge_scan_record_clear(&app->rfid_scan);
+    app->rfid_scan = *record;
+    flipper_wedge_scheduler_note_read(app->scheduler, FlipperWedgeFieldRfid);
+
+    if(single) {
+        // Single tag mode - output immediately
+        FURI_LOG_D("FlipperWedgeScene", "RFID single/any mode - stopping and outputting");
+        flipper_wedge_scene_startscreen_stop_scanning(app);
+        flipper_wedge_scene_startscreen_output_and_reset(app);
+    } else if(first) {
+        // Combo mode - now wait for NFC
+        flipper_wedge_scene_startscreen_wait_second(app, FlipperWedgeFieldNfc);
+    } else {
+        // Got the second tag in combo mode
+        flipper_wedge_scene_startscreen_second_done(app);
+    }
+}
+
+// Take queued reads in arrival order while a scan is running
+// Reads left once the scan is output wait for the next one (start_scanning drains them)
+static void flipper_wedge_scene_startscreen_drain_scans(FlipperWedge* app) {
+    FlipperWedgeScanRecord record;
+
+    while((app->scan_state == FlipperWedgeScanStateScanning ||
+           app->scan_state == FlipperWedgeScanStateWaitingSecond) &&
+          flipper_wedge_scan_queue_get(app->scan_queue, &record)) {
+        FURI_LOG_D(
+            "FlipperWedgeScene",
+            "Scan record: source=%d, queued %lu ms",
+            record.source,
+            furi_get_tick() - record.read_tick);
+        flipper_wedge_latency_mark(app->latency, FlipperWedgeLatencyStageCallback);
+
+        if(record.source == FlipperWedgeScanSourceNfc) {
+            flipper_wedge_scene_startscreen_nfc_scan(app, &record);
+        } else {
+            flipper_wedge_scene_startscreen_rfid_scan(app, &record);
+        }
+    }
+}
+
 void flipper_wedge_scene_startscreen_on_enter(void* context) {
     furi_assert(context);
     FlipperWedge* app = context;
@@ -364,6 +1041,7 @@ bool flipper_wedge_scene_startscreen_on_event(void* context, SceneManagerEvent e
         case FlipperWedgeCustomEventModeChange:
             // Stop current scanning and restart with new mode
             flipper_wedge_scene_startscreen_stop_scanning(app);
+            flipper_wedge_scene_startscreen_discard_scans(app);
 
             // Get the new mode from the view (the view already updated it)
             app->mode = flipper_wedge_startscreen_get_mode(app->flipper_wedge_startscreen);
@@ -372,141 +1050,23 @@ bool flipper_wedge_scene_startscreen_on_event(void* context, SceneManagerEvent e
             // Save mode to persistent storage
             flipper_wedge_save_settings(app);
 
+            // Someone is at the device: poll at full rate
+            flipper_wedge_scheduler_wake(app->scheduler);
             flipper_wedge_scene_startscreen_start_scanning(app);
             consumed = true;
             break;
 
-        case FlipperWedgeCustomEventNfcDetected:
-            // NFC tag detected
-            FURI_LOG_I("FlipperWedgeScene", "Event NfcDetected: mode=%d, scan_state=%d", app->mode, app->scan_state);
-            if(app->mode == FlipperWedgeModeNfc) {
-                // Single tag mode - output UID immediately
-                FURI_LOG_D("FlipperWedgeScene", "NFC single mode - stopping and outputting");
-                flipper_wedge_scene_startscreen_stop_scanning(app);
-                flipper_wedge_scene_startscreen_output_and_reset(app);
-            } else if(app->mode == FlipperWedgeModeNdef) {
-                // NDEF mode - check the error status to distinguish between cases
-                // We need to retrieve the error from the NFC data that was stored in the callback
-                // Since we're in the custom event handler, we need to check what happened
-
-                if(app->ndef_text[0] != '\0') {
-                    // NDEF text found - output it
-                    FURI_LOG_D("FlipperWedgeScene", "NDEF mode - NDEF text found, outputting");
-                    flipper_wedge_scene_startscreen_stop_scanning(app);
-                    flipper_wedge_scene_startscreen_output_and_reset(app);
-                } else {
-                    // No NDEF text - determine error message based on nfc_error field
-                    const char* error_msg;
-                    if(app->nfc_error == FlipperWedgeNfcErrorNotForumCompliant) {
-                        error_msg = "Not NFC Forum Compliant";
-                        FURI_LOG_D("FlipperWedgeScene", "NDEF mode - Not NFC Forum compliant (e.g., MIFARE Classic)");
-                    } else if(app->nfc_error == FlipperWedgeNfcErrorUnsupportedType) {
-                        error_msg = "Unsupported NFC Forum Type";
-                        FURI_LOG_D("FlipperWedgeScene", "NDEF mode - Unsupported NFC Forum Type");
-                    } else if(app->nfc_error == FlipperWedgeNfcErrorNoTextRecord) {
-                        error_msg = "NDEF Not Found";
-                        FURI_LOG_D("FlipperWedgeScene", "NDEF mode - NDEF not found");
-                    } else {
-                        // Fallback for any other case
-                        error_msg = "NDEF Not Found";
-                        FURI_LOG_D("FlipperWedgeScene", "NDEF mode - Unknown error");
-                    }
-
-                    // IMPORTANT: Stop the scanner before showing error to prevent conflicts
-                    flipper_wedge_scene_startscreen_stop_scanning(app);
-
-                    flipper_wedge_led_set_rgb(app, 255, 0, 0);  // Red flash
-
-                    // Start display timer to show error for 500ms, then clear and continue scanning
-                    if(app->display_timer) {
-                        furi_timer_stop(app->display_timer);
-                    } else {
-                        app->display_timer = furi_timer_alloc(
-                            flipper_wedge_scene_startscreen_display_timer_callback,
-                            FuriTimerTypeOnce,
-                            app);
-                    }
-
-                    // Show error message
-                    flipper_wedge_startscreen_set_uid_text(app->flipper_wedge_startscreen, "");
-                    flipper_wedge_startscreen_set_status_text(app->flipper_wedge_startscreen, error_msg);
-                    flipper_wedge_startscreen_set_display_state(app->flipper_wedge_startscreen, FlipperWedgeDisplayStateResult);
-
-                    // Clear data
-                    app->nfc_uid_len = 0;
-                    app->ndef_text[0] = '\0';
-
-                    // Set state to cooldown to prevent immediate re-scan
-                    app->scan_state = FlipperWedgeScanStateCooldown;
-
-                    // Timer will detect this is an error (via status_text) and skip "Sent" state
-                    furi_timer_start(app->display_timer, furi_ms_to_ticks(500));
-                }
-            } else if(app->mode == FlipperWedgeModeNfcThenRfid) {
-                // Combo mode - now wait for RFID
-                flipper_wedge_nfc_stop(app->nfc);
-                app->scan_state = FlipperWedgeScanStateWaitingSecond;
-                flipper_wedge_startscreen_set_status_text(app->flipper_wedge_startscreen, "Waiting for RFID...");
-                flipper_wedge_startscreen_set_display_state(app->flipper_wedge_startscreen, FlipperWedgeDisplayStateWaiting);
-
-                // Start RFID scanning
-                flipper_wedge_rfid_set_callback(app->rfid, flipper_wedge_scene_startscreen_rfid_callback, app);
-                flipper_wedge_rfid_start(app->rfid);
-
-                // Start timeout timer (5 seconds to scan second tag)
-                if(!app->timeout_timer) {
-                    app->timeout_timer = furi_timer_alloc(
-                        flipper_wedge_scene_startscreen_timeout_callback,
-                        FuriTimerTypeOnce,
-                        app);
-                }
-                furi_timer_start(app->timeout_timer, furi_ms_to_ticks(5000));
-            } else if(app->mode == FlipperWedgeModeRfidThenNfc && app->scan_state == FlipperWedgeScanStateWaitingSecond) {
-                // Got the second tag in combo mode - stop timeout timer
-                if(app->timeout_timer) {
-                    furi_timer_stop(app->timeout_timer);
-                }
-                flipper_wedge_nfc_stop(app->nfc);
-                flipper_wedge_scene_startscreen_output_and_reset(app);
+        case FlipperWedgeCustomEventDisplayDone:
+            // A timer that fired before the timeline was restarted or stopped is stale
+            if(app->feedback && !furi_timer_is_running(app->display_timer)) {
+                flipper_wedge_scene_startscreen_feedback_play(app, app->feedback_step + 1);
             }
             consumed = true;
             break;
 
-        case FlipperWedgeCustomEventRfidDetected:
-            // RFID tag detected
-            FURI_LOG_I("FlipperWedgeScene", "Event RfidDetected: mode=%d, scan_state=%d", app->mode, app->scan_state);
-            if(app->mode == FlipperWedgeModeRfid) {
-                // Single tag mode - output immediately
-                FURI_LOG_D("FlipperWedgeScene", "RFID single/any mode - stopping and outputting");
-                flipper_wedge_scene_startscreen_stop_scanning(app);
-                flipper_wedge_scene_startscreen_output_and_reset(app);
-            } else if(app->mode == FlipperWedgeModeRfidThenNfc) {
-                // Combo mode - now wait for NFC
-                flipper_wedge_rfid_stop(app->rfid);
-                app->scan_state = FlipperWedgeScanStateWaitingSecond;
-                flipper_wedge_startscreen_set_status_text(app->flipper_wedge_startscreen, "Waiting for NFC...");
-                flipper_wedge_startscreen_set_display_state(app->flipper_wedge_startscreen, FlipperWedgeDisplayStateWaiting);
-
-                // Start NFC scanning (UID only for combo mode)
-                flipper_wedge_nfc_set_callback(app->nfc, flipper_wedge_scene_startscreen_nfc_callback, app);
-                flipper_wedge_nfc_start(app->nfc, false);
-
-                // Start timeout timer (5 seconds to scan second tag)
-                if(!app->timeout_timer) {
-                    app->timeout_timer = furi_timer_alloc(
-                        flipper_wedge_scene_startscreen_timeout_callback,
-                        FuriTimerTypeOnce,
-                        app);
-                }
-                furi_timer_start(app->timeout_timer, furi_ms_to_ticks(5000));
-            } else if(app->mode == FlipperWedgeModeNfcThenRfid && app->scan_state == FlipperWedgeScanStateWaitingSecond) {
-                // Got the second tag in combo mode - stop timeout timer
-                if(app->timeout_timer) {
-                    furi_timer_stop(app->timeout_timer);
-                }
-                flipper_wedge_rfid_stop(app->rfid);
-                flipper_wedge_scene_startscreen_output_and_reset(app);
-            }
+        case FlipperWedgeCustomEventScanQueued:
+            // One event per queued read, but a drain may already have taken it
+            flipper_wedge_scene_startscreen_drain_scans(app);
             consumed = true;
             break;
 
@@ -535,17 +1095,13 @@ bool flipper_wedge_scene_startscreen_on_event(void* context, SceneManagerEvent e
             FURI_LOG_I("FlipperWedgeScene", "Scan timeout - resetting to scan first tag");
 
             // Stop any running scanners
-            flipper_wedge_nfc_stop(app->nfc);
-            flipper_wedge_rfid_stop(app->rfid);
+            flipper_wedge_scheduler_stop(app->scheduler);
 
             // Clear stored data from first tag
-            app->nfc_uid_len = 0;
-            app->rfid_uid_len = 0;
-            app->ndef_text[0] = '\0';
+            flipper_wedge_scene_startscreen_clear_scan(app);
 
             // Show timeout message briefly
-            flipper_wedge_startscreen_set_status_text(app->flipper_wedge_startscreen, "Scan timed out");
-            flipper_wedge_startscreen_set_display_state(app->flipper_wedge_startscreen, FlipperWedgeDisplayStateIdle);
+            flipper_wedge_scene_startscreen_show(app, FlipperWedgeDisplayStateIdle, "Scan timed out");
 
             // Reset to scanning state and restart for first tag
             app->scan_state = FlipperWedgeScanStateIdle;
@@ -560,15 +1116,32 @@ bool flipper_wedge_scene_startscreen_on_event(void* context, SceneManagerEvent e
         // Update HID connection status periodically
         flipper_wedge_scene_startscreen_update_status(app);
 
+        // Type streamed NDEF text while the reader is still working on the tag
+        if(app->mode == FlipperWedgeModeNdef && app->scan_state == FlipperWedgeScanStateScanning &&
+           flipper_wedge_nfc_stream_pending(app->nfc)) {
+            flipper_wedge_scene_startscreen_type_stream(app);
+        }
+
         // Process NFC state machine (handles scanner->poller transitions and callbacks)
         flipper_wedge_nfc_tick(app->nfc);
 
+        // Report tags arriving and leaving while presence rounds run
+        if(app->mode == FlipperWedgeModePresence && app->scan_state == FlipperWedgeScanStateScanning) {
+            flipper_wedge_scene_startscreen_update_presence(app);
+        }
+
+        // Alternate HF/LF windows while either tag may arrive
+        if(app->scan_state == FlipperWedgeScanStateScanning) {
+            flipper_wedge_scheduler_tick(app->scheduler);
+        }
+
         // Check if we should start/stop scanning based on HID connection
         bool connected = flipper_wedge_hid_is_connected(flipper_wedge_get_hid(app));
         if(connected && app->scan_state == FlipperWedgeScanStateIdle) {
             flipper_wedge_scene_startscreen_start_scanning(app);
         } else if(!connected && app->scan_state != FlipperWedgeScanStateIdle) {
             flipper_wedge_scene_startscreen_stop_scanning(app);
+            flipper_wedge_scene_startscreen_discard_scans(app);
         }
     }
 
@@ -579,10 +1152,11 @@ void flipper_wedge_scene_startscreen_on_exit(void* context) {
     FlipperWedge* app = context;
     flipper_wedge_scene_startscreen_stop_scanning(app);
 
-    // Stop display timer if running
-    if(app->display_timer) {
-        furi_timer_stop(app->display_timer);
-    }
+    // Reads queued for this screen are stale once it is left
+    flipper_wedge_scene_startscreen_discard_scans(app);
+
+    // Stop the feedback if it is still playing
+    flipper_wedge_scene_startscreen_feedback_stop(app);
 
     // Stop timeout timer if running
     if(app->timeout_timer) {
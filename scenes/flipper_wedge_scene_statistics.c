@@ -0,0 +1,182 @@
+#include "../flipper_wedge.h"
+
+typedef struct {
+    Widget* widget;
+    FuriString* text;
+    const char* status;  // Result of the last Save/Reset, NULL if none
+} StatisticsSceneContext;
+
+// Microseconds as milliseconds with one decimal
+static void flipper_wedge_scene_statistics_cat_ms(FuriString* text, uint32_t us) {
+    furi_string_cat_printf(text, "%lu.%lu", us / 1000, (us % 1000) / 100);
+}
+
+static void flipper_wedge_scene_statistics_cat_row(
+    FuriString* text,
+    const char* name,
+    const FlipperWedgeLatencyStats* stats) {
+    furi_string_cat_printf(text, "\e#%s n=%lu\n", name, stats->count);
+    flipper_wedge_scene_statistics_cat_ms(text, stats->p50_us);
+    furi_string_cat_str(text, " / ");
+    flipper_wedge_scene_statistics_cat_ms(text, stats->p95_us);
+    furi_string_cat_str(text, " / ");
+    flipper_wedge_scene_statistics_cat_ms(text, stats->p99_us);
+    furi_string_cat_str(text, "\n");
+}
+
+static void flipper_wedge_scene_statistics_button_callback(
+    GuiButtonType result,
+    InputType type,
+    void* context) {
+    FlipperWedge* app = context;
+    if(type == InputTypeShort) {
+        view_dispatcher_send_custom_event(app->view_dispatcher, result);
+    }
+}
+
+static void flipper_wedge_scene_statistics_rebuild_widget(
+    FlipperWedge* app,
+    StatisticsSceneContext* scene_ctx) {
+    FuriString* text = scene_ctx->text;
+    FlipperWedgeLatencyStats stats;
+
+    furi_string_reset(text);
+    if(scene_ctx->status) {
+        furi_string_cat_printf(text, "%s\n", scene_ctx->status);
+    }
+    furi_string_cat_str(text, "p50 / p95 / p99 in ms\n");
+
+    // Scan rate under the current feedback profile (reset when it changes)
+    flipper_wedge_latency_get_cycle(app->latency, &stats);
+    bool any = stats.count > 0;
+    if(any) {
+        furi_string_cat_printf(
+            text,
+            "%lu scans/min (%s)\n",
+            flipper_wedge_latency_scans_per_minute(&stats),
+            flipper_wedge_feedback_profile_name(app->feedback_profile));
+        flipper_wedge_scene_statistics_cat_row(text, "Scan cycle", &stats);
+    }
+
+    flipper_wedge_latency_get_total(app->latency, &stats);
+    if(stats.count > 0) {
+        flipper_wedge_scene_statistics_cat_row(text, "Tag to last key", &stats);
+        any = true;
+    }
+
+    // Each stage is the time since the previous one the scan reached
+    for(int stage = 0; stage < FlipperWedgeLatencyStageCount; stage++) {
+        flipper_wedge_latency_get_stage(app->latency, stage, &stats);
+        if(stats.count == 0) continue;
+        flipper_wedge_scene_statistics_cat_row(text, flipper_wedge_latency_stage_name(stage), &stats);
+        any = true;
+    }
+
+    if(!any) {
+        furi_string_cat_str(text, "No scans timed yet.\nScan a tag, then come back.\n");
+    }
+
+    // BLE link, kept across output mode switches
+    FlipperWedgeHidBleStats ble_stats;
+    flipper_wedge_hid_get_ble_stats(flipper_wedge_get_hid(app), &ble_stats);
+    if(app->output_mode == FlipperWedgeOutputBle || ble_stats.connect_count > 0) {
+        furi_string_cat_printf(text, "\e#BLE connects=%lu\n", ble_stats.connect_count);
+        if(ble_stats.connect_count > 0) {
+            furi_string_cat_printf(text, "Connect: %lu ms\n", ble_stats.connect_ms);
+        }
+        if(ble_stats.notify_per_sec > 0) {
+            furi_string_cat_printf(text, "Typing: %lu notify/s\n", ble_stats.notify_per_sec);
+        }
+    }
+
+    widget_reset(scene_ctx->widget);
+    widget_add_text_scroll_element(scene_ctx->widget, 0, 0, 128, 52, furi_string_get_cstr(text));
+    widget_add_button_element(
+        scene_ctx->widget,
+        GuiButtonTypeLeft,
+        "Reset",
+        flipper_wedge_scene_statistics_button_callback,
+        app);
+    widget_add_button_element(
+        scene_ctx->widget,
+        GuiButtonTypeRight,
+        "Save",
+        flipper_wedge_scene_statistics_button_callback,
+        app);
+}
+
+void flipper_wedge_scene_statistics_on_enter(void* context) {
+    FlipperWedge* app = context;
+
+    // Keep display backlight on while reading the numbers
+    notification_message(app->notification, &sequence_display_backlight_enforce_on);
+
+    // Allocate scene context
+    StatisticsSceneContext* scene_ctx = malloc(sizeof(StatisticsSceneContext));
+    scene_ctx->widget = widget_alloc();
+    scene_ctx->text = furi_string_alloc();
+    scene_ctx->status = NULL;
+
+    flipper_wedge_scene_statistics_rebuild_widget(app, scene_ctx);
+
+    // Add view and switch to it
+    view_dispatcher_add_view(
+        app->view_dispatcher,
+        FlipperWedgeViewIdStatistics,
+        widget_get_view(scene_ctx->widget));
+    view_dispatcher_switch_to_view(app->view_dispatcher, FlipperWedgeViewIdStatistics);
+
+    // Store scene context
+    scene_manager_set_scene_state(
+        app->scene_manager,
+        FlipperWedgeSceneStatistics,
+        (uint32_t)scene_ctx);
+}
+
+bool flipper_wedge_scene_statistics_on_event(void* context, SceneManagerEvent event) {
+    FlipperWedge* app = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        StatisticsSceneContext* scene_ctx = (StatisticsSceneContext*)scene_manager_get_scene_state(
+            app->scene_manager,
+            FlipperWedgeSceneStatistics);
+
+        if(event.event == GuiButtonTypeRight) {
+            bool saved = flipper_wedge_latency_save(app->latency, FLIPPER_WEDGE_LATENCY_PATH);
+            scene_ctx->status = saved ? "Saved to latency.csv" : "Save failed";
+            consumed = true;
+        } else if(event.event == GuiButtonTypeLeft) {
+            flipper_wedge_latency_reset(app->latency);
+            scene_ctx->status = "Cleared";
+            consumed = true;
+        }
+
+        if(consumed) {
+            flipper_wedge_scene_statistics_rebuild_widget(app, scene_ctx);
+        }
+    }
+
+    return consumed;
+}
+
+void flipper_wedge_scene_statistics_on_exit(void* context) {
+    FlipperWedge* app = context;
+
+    // Retrieve scene context
+    StatisticsSceneContext* scene_ctx = (StatisticsSceneContext*)scene_manager_get_scene_state(
+        app->scene_manager,
+        FlipperWedgeSceneStatistics);
+
+    if(scene_ctx) {
+        view_dispatcher_remove_view(app->view_dispatcher, FlipperWedgeViewIdStatistics);
+        widget_free(scene_ctx->widget);
+        furi_string_free(scene_ctx->text);
+        free(scene_ctx);
+    }
+
+    scene_manager_set_scene_state(app->scene_manager, FlipperWedgeSceneStatistics, 0);
+
+    // Return backlight to auto mode
+    notification_message(app->notification, &sequence_display_backlight_enforce_auto);
+}
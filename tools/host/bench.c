@@ -0,0 +1,532 @@
+// Host benchmark suite for the Flipper Wedge helpers
+//
+// Every case is run in growing batches until one batch takes at least
+// BENCH_MIN_NS, then reported as ns/op. With --baseline, results are compared
+// against a previous run's output and the exit code is non-zero if any case
+// got slower than the threshold.
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <ctype.h>
+#include <time.h>
+
+#include "flipper_wedge_format.h"
+#include "flipper_wedge_template.h"
+#include "flipper_wedge_ndef_stream.h"
+#include "flipper_wedge_keyboard_layout.h"
+#include "flipper_wedge_layout_index.h"
+#include "flipper_wedge_unicode.h"
+#include "flipper_wedge_log.h"
+#include "flipper_wedge_scan_buffer.h"
+#include "flipper_wedge_lookup.h"
+#include "flipper_wedge_access.h"
+#include "flipper_wedge_latency.h"
+
+#ifndef BENCH_LAYOUT_PATH
+#define BENCH_LAYOUT_PATH "../../assets/layouts/azerty_fr.txt"
+#endif
+
+#define BENCH_MIN_NS 200000000ULL
+#define BENCH_MAX_RESULTS 32
+#define BENCH_NAME_MAX 32
+#define BENCH_TABLE_ENTRIES 10000
+#define BENCH_LAYOUT_FILES 64
+#define BENCH_DEFAULT_THRESHOLD 15.0
+
+#define BENCH_CSV_PATH APP_DATA_PATH("bench_lookup.csv")
+#define BENCH_CSV_INDEX_PATH APP_DATA_PATH("bench_lookup.idx")
+#define BENCH_LIST_PATH APP_DATA_PATH("bench_access.txt")
+#define BENCH_LIST_INDEX_PATH APP_DATA_PATH("bench_access.idx")
+#define BENCH_LAYOUTS_PATH APP_DATA_PATH("bench_layouts")
+#define BENCH_LAYOUTS_INDEX_PATH APP_DATA_PATH("bench_layouts.idx")
+
+typedef void (*BenchFn)(void* context);
+
+typedef struct {
+    char name[BENCH_NAME_MAX];
+    double ns_per_op;
+} BenchResult;
+
+static BenchResult results[BENCH_MAX_RESULTS];
+static size_t result_count = 0;
+
+// Keeps the optimizer from discarding benchmark results
+static volatile size_t bench_sink;
+
+static const uint8_t nfc_uid[] = {0x04, 0xA1, 0xB2, 0xC3, 0xD4, 0xE5, 0x80};
+static const uint8_t rfid_uid[] = {0x1A, 0x00, 0x2B, 0x3C, 0x4D};
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void bench_run(const char* name, BenchFn fn, void* context) {
+    uint64_t iterations = 1;
+    uint64_t elapsed = 0;
+
+    fn(context);  // Warm up caches and lazily built state
+    while(true) {
+        uint64_t start = bench_now_ns();
+        for(uint64_t i = 0; i < iterations; i++) {
+            fn(context);
+        }
+        elapsed = bench_now_ns() - start;
+        if(elapsed >= BENCH_MIN_NS) break;
+        iterations *= elapsed < BENCH_MIN_NS / 16 ? 8 : 2;
+    }
+
+    furi_check(result_count < BENCH_MAX_RESULTS);
+    BenchResult* result = &results[result_count++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->ns_per_op = (double)elapsed / iterations;
+    printf("%-24s %12.1f ns/op\n", result->name, result->ns_per_op);
+    fflush(stdout);
+}
+
+// Format
+
+static void bench_format_uid(void* context) {
+    UNUSED(context);
+    char output[FLIPPER_WEDGE_FORMAT_MAX_LEN];
+    flipper_wedge_format_uid(nfc_uid, sizeof(nfc_uid), ":", output, sizeof(output));
+    bench_sink += output[0];
+}
+
+static void bench_format_output(void* context) {
+    UNUSED(context);
+    char output[FLIPPER_WEDGE_FORMAT_MAX_LEN];
+    flipper_wedge_format_output(
+        nfc_uid, sizeof(nfc_uid), rfid_uid, sizeof(rfid_uid), NULL, ":", true, output, sizeof(output));
+    bench_sink += output[0];
+}
+
+static void bench_sanitize(void* context) {
+    const char* input = context;
+    char output[256];
+    bench_sink += flipper_wedge_sanitize_text(input, output, sizeof(output), 0);
+}
+
+// Template
+
+typedef struct {
+    FlipperWedgeTemplate* tpl;
+    FlipperWedgeTemplateData data;
+} BenchTemplate;
+
+static void bench_template_render(void* context) {
+    BenchTemplate* bench = context;
+    char output[FLIPPER_WEDGE_FORMAT_MAX_LEN];
+    bench_sink += flipper_wedge_template_render(bench->tpl, &bench->data, output, sizeof(output));
+}
+
+// Print how a case compares with another one already run
+static void bench_versus(const char* name, const char* reference) {
+    const BenchResult* result = NULL;
+    const BenchResult* against = NULL;
+    for(size_t i = 0; i < result_count; i++) {
+        if(strcmp(results[i].name, name) == 0) result = &results[i];
+        if(strcmp(results[i].name, reference) == 0) against = &results[i];
+    }
+    furi_check(result && against);
+    printf("  vs %s: %.2fx the time\n", reference, result->ns_per_op / against->ns_per_op);
+}
+
+// NDEF
+
+typedef struct {
+    FlipperWedgeNdefStream* stream;
+    uint8_t* message;
+    size_t message_len;
+} BenchNdef;
+
+static void bench_ndef_text(const uint8_t* text, size_t len, void* context) {
+    UNUSED(text);
+    UNUSED(context);
+    bench_sink += len;
+}
+
+// TLV-wrapped message with one Text record, as read from Type 2 tag memory
+static void bench_ndef_build(BenchNdef* bench, size_t text_len) {
+    size_t payload_len = 3 + text_len;  // Status byte + "en"
+    bool short_record = payload_len < 256;
+    size_t record_len = 3 + (short_record ? 1 : 4) + payload_len;
+
+    bench->message = malloc(4 + record_len + 1);
+    uint8_t* p = bench->message;
+    *p++ = 0x03;
+    if(record_len < 0xFF) {
+        *p++ = record_len;
+    } else {
+        *p++ = 0xFF;
+        *p++ = record_len >> 8;
+        *p++ = record_len;
+    }
+    *p++ = short_record ? 0xD1 : 0xC1;  // MB ME [SR] TNF=Well-known
+    *p++ = 0x01;
+    if(short_record) {
+        *p++ = payload_len;
+    } else {
+        *p++ = payload_len >> 24;
+        *p++ = payload_len >> 16;
+        *p++ = payload_len >> 8;
+        *p++ = payload_len;
+    }
+    *p++ = 'T';
+    *p++ = 0x02;
+    *p++ = 'e';
+    *p++ = 'n';
+    for(size_t i = 0; i < text_len; i++) {
+        *p++ = 'a' + (i % 26);
+    }
+    *p++ = 0xFE;
+    bench->message_len = p - bench->message;
+}
+
+static void bench_ndef_parse(void* context) {
+    BenchNdef* bench = context;
+    flipper_wedge_ndef_stream_reset(bench->stream, true, bench_ndef_text, NULL);
+    // 16-byte pieces, the size of one Type 2 READ response
+    for(size_t offset = 0; offset < bench->message_len; offset += 16) {
+        size_t len = MIN((size_t)16, bench->message_len - offset);
+        if(!flipper_wedge_ndef_stream_feed(bench->stream, bench->message + offset, len)) break;
+    }
+}
+
+// Keyboard layout
+
+static void bench_layout_load(void* context) {
+    FlipperWedgeKeyboardLayout* layout = context;
+    bench_sink += flipper_wedge_keyboard_layout_load(layout, BENCH_LAYOUT_PATH);
+}
+
+static void bench_layout_keycodes(void* context) {
+    FlipperWedgeKeyboardLayout* layout = context;
+    const char* text = "04:A1:B2:C3:D4:E5:80";
+    for(const char* c = text; *c; c++) {
+        bench_sink += flipper_wedge_keyboard_layout_get_keycode(layout, *c);
+    }
+}
+
+// Unicode
+
+typedef struct {
+    FlipperWedgeUnicode* unicode;
+    FlipperWedgeKeyboardLayout* layout;
+    const char* text;
+} BenchUnicode;
+
+// Keys of a string as the HID output works them out, without the reports
+static void bench_unicode_keys(void* context) {
+    BenchUnicode* bench = context;
+    const char* c = bench->text;
+    while(*c) {
+        if((uint8_t)*c < 0x80) {
+            bench_sink += flipper_wedge_keyboard_layout_get_keycode(bench->layout, *c);
+            c++;
+            continue;
+        }
+        uint32_t code_point;
+        size_t len = flipper_wedge_utf8_decode(c, &code_point);
+        const FlipperWedgeUnicodeSequence* sequence =
+            flipper_wedge_unicode_get_sequence(bench->unicode, code_point);
+        if(sequence) bench_sink += sequence->key_count;
+        c += len;
+    }
+}
+
+// Log
+
+// A layout pack of BENCH_LAYOUT_FILES copies of the sample layout
+static bool bench_layouts_write(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool dir_ok = storage_simply_mkdir(storage, BENCH_LAYOUTS_PATH);
+    furi_record_close(RECORD_STORAGE);
+    if(!dir_ok) return false;
+
+    FILE* in = fopen(BENCH_LAYOUT_PATH, "r");
+    if(!in) return false;
+    char content[4096];
+    size_t len = fread(content, 1, sizeof(content), in);
+    fclose(in);
+
+    for(size_t i = 0; i < BENCH_LAYOUT_FILES; i++) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/layout_%02zu.txt", BENCH_LAYOUTS_PATH, i);
+        FILE* out = fopen(path, "w");
+        if(!out) return false;
+        fwrite(content, 1, len, out);
+        fclose(out);
+    }
+    return true;
+}
+
+// Cold: no index, every layout file is opened (the old directory walk)
+static void bench_layout_index_build(void* context) {
+    FlipperWedgeLayoutIndex* index = context;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_common_remove(storage, BENCH_LAYOUTS_INDEX_PATH);
+    furi_record_close(RECORD_STORAGE);
+    bench_sink += flipper_wedge_layout_index_load(index, BENCH_LAYOUTS_PATH, BENCH_LAYOUTS_INDEX_PATH);
+}
+
+// Warm: the index is revalidated from the directory listing
+static void bench_layout_index_load(void* context) {
+    FlipperWedgeLayoutIndex* index = context;
+    bench_sink += flipper_wedge_layout_index_load(index, BENCH_LAYOUTS_PATH, BENCH_LAYOUTS_INDEX_PATH);
+}
+
+static void bench_log_append(void* context) {
+    UNUSED(context);
+    flipper_wedge_log_scan("04:A1:B2:C3:D4:E5:80");
+}
+
+// Scan buffer
+
+static void bench_scan_buffer(void* context) {
+    FlipperWedgeScanBufferPool* pool = context;
+    FlipperWedgeScanBuffer* buffer = flipper_wedge_scan_buffer_acquire(pool);
+    bench_sink += (size_t)flipper_wedge_scan_buffer_data(buffer);
+    flipper_wedge_scan_buffer_unref(buffer);
+}
+
+// Scan latency: every stage of one scan, then the re-arm that records it
+
+static void bench_latency_cycle(void* context) {
+    FlipperWedgeLatency* latency = context;
+    for(int stage = 0; stage < FlipperWedgeLatencyStageCount; stage++) {
+        flipper_wedge_latency_mark(latency, stage);
+    }
+}
+
+// Lookup and access list
+
+static void bench_table_uid(uint32_t i, uint8_t* uid) {
+    uint32_t x = i * 2654435761UL;
+    uid[0] = 0x04;
+    uid[1] = x >> 24;
+    uid[2] = x >> 16;
+    uid[3] = x >> 8;
+    uid[4] = x;
+    uid[5] = i >> 8;
+    uid[6] = i;
+}
+
+static bool bench_table_write(const char* path, bool with_values) {
+    FILE* file = fopen(path, "w");
+    if(!file) return false;
+    for(uint32_t i = 0; i < BENCH_TABLE_ENTRIES; i++) {
+        uint8_t uid[7];
+        bench_table_uid(i, uid);
+        for(size_t j = 0; j < sizeof(uid); j++) {
+            fprintf(file, "%02X", uid[j]);
+        }
+        if(with_values) {
+            fprintf(file, ",EMP%06u", i);
+        }
+        fputc('\n', file);
+    }
+    fclose(file);
+    return true;
+}
+
+typedef struct {
+    FlipperWedgeLookup* lookup;
+    FlipperWedgeAccess* access;
+    uint32_t next;
+} BenchTable;
+
+static void bench_lookup_find(void* context) {
+    BenchTable* bench = context;
+    uint8_t uid[7];
+    char value[64];
+    bench_table_uid(bench->next, uid);
+    bench->next = (bench->next + 7919) % BENCH_TABLE_ENTRIES;
+    bench_sink += flipper_wedge_lookup_find(bench->lookup, uid, sizeof(uid), value, sizeof(value));
+}
+
+static void bench_access_contains(void* context) {
+    BenchTable* bench = context;
+    uint8_t uid[7];
+    bench_table_uid(bench->next, uid);
+    uid[0] = bench->next & 1 ? 0x04 : 0x08;  // Half of the probes miss
+    bench->next = (bench->next + 7919) % BENCH_TABLE_ENTRIES;
+    bench_sink += flipper_wedge_access_contains(bench->access, uid, sizeof(uid));
+}
+
+// Baseline comparison
+
+static int bench_compare(const char* path, double threshold) {
+    FILE* file = fopen(path, "r");
+    if(!file) {
+        fprintf(stderr, "Cannot open baseline %s\n", path);
+        return 2;
+    }
+
+    int regressions = 0;
+    char line[128];
+    printf("\n%-24s %12s %12s %8s\n", "case", "baseline", "current", "delta");
+    while(fgets(line, sizeof(line), file)) {
+        char name[BENCH_NAME_MAX];
+        double baseline;
+        if(sscanf(line, "%31s %lf ns/op", name, &baseline) != 2 || baseline <= 0) continue;
+
+        for(size_t i = 0; i < result_count; i++) {
+            if(strcmp(results[i].name, name) != 0) continue;
+            double delta = (results[i].ns_per_op - baseline) * 100.0 / baseline;
+            bool regression = delta > threshold;
+            printf(
+                "%-24s %12.1f %12.1f %+7.1f%%%s\n",
+                name,
+                baseline,
+                results[i].ns_per_op,
+                delta,
+                regression ? "  REGRESSION" : "");
+            regressions += regression;
+        }
+    }
+    fclose(file);
+
+    if(regressions > 0) {
+        printf("%d case(s) slower than baseline by more than %.0f%%\n", regressions, threshold);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    const char* baseline = NULL;
+    double threshold = BENCH_DEFAULT_THRESHOLD;
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline = argv[++i];
+        } else if(strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--baseline FILE] [--threshold PERCENT]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(!storage_simply_mkdir(storage, APP_DATA_PATH(""))) {
+        fprintf(stderr, "Cannot create %s\n", APP_DATA_PATH(""));
+        return 2;
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    bench_run("format_uid", bench_format_uid, NULL);
+    bench_run("format_output", bench_format_output, NULL);
+
+    char sanitize_input[251];
+    for(size_t i = 0; i < sizeof(sanitize_input) - 1; i++) {
+        // Mostly printable text with a control byte every 16 characters
+        sanitize_input[i] = i % 16 == 15 ? 0x07 : ' ' + (i % 95);
+    }
+    sanitize_input[sizeof(sanitize_input) - 1] = '\0';
+    bench_run("sanitize_250", bench_sanitize, sanitize_input);
+
+    FlipperWedgeRfidDecoded decoded = {
+        .fields = FlipperWedgeRfidFieldFacility | FlipperWedgeRfidFieldCard,
+        .facility = 123,
+        .card = 45678,
+    };
+    BenchTemplate bench_template = {
+        .tpl = flipper_wedge_template_alloc(),
+        .data =
+            {
+                .nfc_uid = nfc_uid,
+                .nfc_uid_len = sizeof(nfc_uid),
+                .rfid_uid = rfid_uid,
+                .rfid_uid_len = sizeof(rfid_uid),
+                .rfid_decoded = &decoded,
+                .delimiter = ":",
+            },
+    };
+    // The old formatter's output as a template, checked to match format_output
+    char legacy[FLIPPER_WEDGE_FORMAT_MAX_LEN];
+    char rendered[FLIPPER_WEDGE_FORMAT_MAX_LEN];
+    flipper_wedge_format_output(
+        nfc_uid, sizeof(nfc_uid), rfid_uid, sizeof(rfid_uid), NULL, ":", true, legacy, sizeof(legacy));
+    furi_check(flipper_wedge_template_compile(bench_template.tpl, "{nfc}{ndef}{rfid}"));
+    flipper_wedge_template_render(bench_template.tpl, &bench_template.data, rendered, sizeof(rendered));
+    furi_check(strcmp(legacy, rendered) == 0);
+    bench_run("template_legacy", bench_template_render, &bench_template);
+    bench_versus("template_legacy", "format_output");
+
+    furi_check(flipper_wedge_template_compile(bench_template.tpl, "{nfc:rev:nosep}{sep}{rfid:dec}\\t"));
+    bench_run("template_render", bench_template_render, &bench_template);
+    bench_versus("template_render", "format_output");
+    flipper_wedge_template_free(bench_template.tpl);
+
+    BenchNdef bench_ndef = {.stream = flipper_wedge_ndef_stream_alloc()};
+    bench_ndef_build(&bench_ndef, 1024);
+    bench_run("ndef_parse_1k", bench_ndef_parse, &bench_ndef);
+    free(bench_ndef.message);
+    bench_ndef_build(&bench_ndef, 8192);
+    bench_run("ndef_parse_8k", bench_ndef_parse, &bench_ndef);
+    furi_check(flipper_wedge_ndef_stream_get_text_len(bench_ndef.stream) == 8192);
+    free(bench_ndef.message);
+    flipper_wedge_ndef_stream_free(bench_ndef.stream);
+
+    FlipperWedgeKeyboardLayout* layout = flipper_wedge_keyboard_layout_alloc();
+    furi_check(flipper_wedge_keyboard_layout_load(layout, BENCH_LAYOUT_PATH));
+    bench_run("layout_load", bench_layout_load, layout);
+    bench_run("layout_keycodes_20", bench_layout_keycodes, layout);
+
+    // Same name and address, accented (2-byte), symbols (3-byte), emoji (4-byte)
+    BenchUnicode bench_unicode = {
+        .unicode = flipper_wedge_unicode_alloc(),
+        .layout = layout,
+        .text = "Jose Muller, Strasse 12, 1040 Wien, Cafe No 42 - Zoe Lukasiewicz :)",
+    };
+    bench_run("unicode_keys_plain", bench_unicode_keys, &bench_unicode);
+    bench_unicode.text = "Jos\u00e9 M\u00fcller, Stra\u00dfe 12, 1040 Wien, Caf\u00e9 \u2116 42 \u2014 "
+                         "Zo\u00eb \u0141ukasiewicz \U0001F642";
+    for(FlipperWedgeUnicodeMethod method = 0; method < FlipperWedgeUnicodeMethodCount; method++) {
+        char name[BENCH_NAME_MAX];
+        snprintf(name, sizeof(name), "unicode_keys_%s", flipper_wedge_unicode_method_name(method));
+        for(char* n = name; *n; n++) {
+            *n = tolower((unsigned char)*n);
+        }
+        flipper_wedge_unicode_configure(bench_unicode.unicode, method, layout);
+        bench_run(name, bench_unicode_keys, &bench_unicode);
+    }
+    flipper_wedge_unicode_free(bench_unicode.unicode);
+    flipper_wedge_keyboard_layout_free(layout);
+
+    FlipperWedgeLayoutIndex* layout_index = flipper_wedge_layout_index_alloc();
+    furi_check(bench_layouts_write());
+    bench_run("layout_index_build_64", bench_layout_index_build, layout_index);
+    bench_run("layout_index_load_64", bench_layout_index_load, layout_index);
+    furi_check(flipper_wedge_layout_index_get_count(layout_index) == BENCH_LAYOUT_FILES);
+    flipper_wedge_layout_index_free(layout_index);
+
+    bench_run("log_append", bench_log_append, NULL);
+    flipper_wedge_log_close();
+
+    FlipperWedgeScanBufferPool* pool = flipper_wedge_scan_buffer_pool_alloc(4, 256);
+    bench_run("scan_buffer_cycle", bench_scan_buffer, pool);
+    flipper_wedge_scan_buffer_pool_free(pool);
+
+    FlipperWedgeLatency* latency = flipper_wedge_latency_alloc();
+    bench_run("latency_cycle", bench_latency_cycle, latency);
+    flipper_wedge_latency_free(latency);
+
+    BenchTable bench_table = {
+        .lookup = flipper_wedge_lookup_alloc(),
+        .access = flipper_wedge_access_alloc(),
+    };
+    furi_check(bench_table_write(BENCH_CSV_PATH, true));
+    furi_check(bench_table_write(BENCH_LIST_PATH, false));
+    furi_check(flipper_wedge_lookup_load(bench_table.lookup, BENCH_CSV_PATH, BENCH_CSV_INDEX_PATH));
+    furi_check(flipper_wedge_access_load(bench_table.access, BENCH_LIST_PATH, BENCH_LIST_INDEX_PATH));
+    bench_run("lookup_find_10k", bench_lookup_find, &bench_table);
+    bench_run("access_contains_10k", bench_access_contains, &bench_table);
+    flipper_wedge_access_free(bench_table.access);
+    flipper_wedge_lookup_free(bench_table.lookup);
+
+    return baseline ? bench_compare(baseline, threshold) : 0;
+}
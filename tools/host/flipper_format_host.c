@@ -0,0 +1,110 @@
+#include <flipper_format/flipper_format.h>
+
+struct FlipperFormat {
+    char* data;
+    size_t size;
+    size_t position;
+};
+
+FlipperFormat* flipper_format_file_alloc(Storage* storage) {
+    UNUSED(storage);
+    FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
+    flipper_format->data = NULL;
+    flipper_format->size = 0;
+    flipper_format->position = 0;
+    return flipper_format;
+}
+
+void flipper_format_free(FlipperFormat* flipper_format) {
+    furi_assert(flipper_format);
+    flipper_format_file_close(flipper_format);
+    free(flipper_format);
+}
+
+bool flipper_format_file_open_existing(FlipperFormat* flipper_format, const char* path) {
+    furi_assert(flipper_format);
+    flipper_format_file_close(flipper_format);
+
+    FILE* stream = fopen(path, "rb");
+    if(!stream) return false;
+    fseek(stream, 0, SEEK_END);
+    long size = ftell(stream);
+    fseek(stream, 0, SEEK_SET);
+
+    flipper_format->data = malloc(size + 1);
+    flipper_format->size = fread(flipper_format->data, 1, size, stream);
+    flipper_format->data[flipper_format->size] = '\0';
+    flipper_format->position = 0;
+    fclose(stream);
+    return true;
+}
+
+bool flipper_format_file_close(FlipperFormat* flipper_format) {
+    furi_assert(flipper_format);
+    free(flipper_format->data);
+    flipper_format->data = NULL;
+    flipper_format->size = 0;
+    flipper_format->position = 0;
+    return true;
+}
+
+bool flipper_format_rewind(FlipperFormat* flipper_format) {
+    furi_assert(flipper_format);
+    flipper_format->position = 0;
+    return flipper_format->data != NULL;
+}
+
+// Find "key: value" at the start of a line after the current position
+bool flipper_format_read_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
+    furi_assert(flipper_format);
+    if(!flipper_format->data) return false;
+
+    size_t key_len = strlen(key);
+    size_t position = flipper_format->position;
+
+    while(position < flipper_format->size) {
+        const char* line = flipper_format->data + position;
+        const char* end = strchr(line, '\n');
+        size_t line_len = end ? (size_t)(end - line) : strlen(line);
+        size_t next = position + line_len + (end ? 1 : 0);
+
+        if(line[0] != '#' && line_len > key_len && strncmp(line, key, key_len) == 0 &&
+           line[key_len] == ':') {
+            const char* value = line + key_len + 1;
+            size_t value_len = line_len - key_len - 1;
+            if(value_len > 0 && value[0] == ' ') {
+                value++;
+                value_len--;
+            }
+            if(value_len > 0 && value[value_len - 1] == '\r') {
+                value_len--;
+            }
+            furi_string_set_strn(data, value, value_len);
+            flipper_format->position = next;
+            return true;
+        }
+        position = next;
+    }
+    return false;
+}
+
+bool flipper_format_read_uint32(FlipperFormat* flipper_format, const char* key, uint32_t* data, uint16_t data_size) {
+    FuriString* value = furi_string_alloc();
+    bool success = flipper_format_read_string(flipper_format, key, value);
+    if(success) {
+        const char* cursor = furi_string_get_cstr(value);
+        for(uint16_t i = 0; i < data_size && success; i++) {
+            char* end;
+            data[i] = strtoul(cursor, &end, 10);
+            success = end != cursor;
+            cursor = end;
+        }
+    }
+    furi_string_free(value);
+    return success;
+}
+
+bool flipper_format_read_header(FlipperFormat* flipper_format, FuriString* filetype, uint32_t* version) {
+    return flipper_format_read_string(flipper_format, "Filetype", filetype) &&
+           flipper_format_read_uint32(flipper_format, "Version", version, 1);
+}
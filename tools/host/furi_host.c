@@ -0,0 +1,459 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <furi_hal_rtc.h>
+#include <furi_hal_usb_hid.h>
+#include <lib/toolbox/path.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <time.h>
+
+void furi_crash_host(const char* file, int line, const char* message) {
+    fprintf(stderr, "furi_crash at %s:%d: %s\n", file, line, message);
+    abort();
+}
+
+void furi_log_host(char level, const char* tag, const char* format, ...) {
+    static int enabled = -1;
+    if(enabled < 0) {
+        enabled = getenv("FURI_LOG") != NULL;
+    }
+    if(!enabled) return;
+
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "[%c][%s] ", level, tag);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+uint32_t furi_get_tick(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+void furi_delay_ms(uint32_t milliseconds) {
+    struct timespec ts = {
+        .tv_sec = milliseconds / 1000,
+        .tv_nsec = (long)(milliseconds % 1000) * 1000000,
+    };
+    nanosleep(&ts, NULL);
+}
+
+static void furi_host_deadline(uint32_t timeout, struct timespec* deadline) {
+    clock_gettime(CLOCK_REALTIME, deadline);
+    deadline->tv_sec += timeout / 1000;
+    deadline->tv_nsec += (long)(timeout % 1000) * 1000000;
+    if(deadline->tv_nsec >= 1000000000) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000;
+    }
+}
+
+struct FuriMutex {
+    pthread_mutex_t mutex;
+};
+
+FuriMutex* furi_mutex_alloc(FuriMutexType type) {
+    FuriMutex* mutex = malloc(sizeof(FuriMutex));
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    if(type == FuriMutexTypeRecursive) {
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    }
+    pthread_mutex_init(&mutex->mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    return mutex;
+}
+
+void furi_mutex_free(FuriMutex* mutex) {
+    furi_assert(mutex);
+    pthread_mutex_destroy(&mutex->mutex);
+    free(mutex);
+}
+
+FuriStatus furi_mutex_acquire(FuriMutex* mutex, uint32_t timeout) {
+    furi_assert(mutex);
+    int result;
+    if(timeout == FuriWaitForever) {
+        result = pthread_mutex_lock(&mutex->mutex);
+    } else if(timeout == 0) {
+        result = pthread_mutex_trylock(&mutex->mutex);
+    } else {
+        struct timespec deadline;
+        furi_host_deadline(timeout, &deadline);
+        result = pthread_mutex_timedlock(&mutex->mutex, &deadline);
+    }
+    if(result == 0) return FuriStatusOk;
+    return timeout == 0 ? FuriStatusErrorResource : FuriStatusErrorTimeout;
+}
+
+FuriStatus furi_mutex_release(FuriMutex* mutex) {
+    furi_assert(mutex);
+    return pthread_mutex_unlock(&mutex->mutex) == 0 ? FuriStatusOk : FuriStatusErrorResource;
+}
+
+struct FuriSemaphore {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t count;
+    uint32_t max_count;
+};
+
+FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count) {
+    furi_assert(initial_count <= max_count);
+    FuriSemaphore* semaphore = malloc(sizeof(FuriSemaphore));
+    pthread_mutex_init(&semaphore->mutex, NULL);
+    pthread_cond_init(&semaphore->cond, NULL);
+    semaphore->count = initial_count;
+    semaphore->max_count = max_count;
+    return semaphore;
+}
+
+void furi_semaphore_free(FuriSemaphore* semaphore) {
+    furi_assert(semaphore);
+    pthread_cond_destroy(&semaphore->cond);
+    pthread_mutex_destroy(&semaphore->mutex);
+    free(semaphore);
+}
+
+FuriStatus furi_semaphore_acquire(FuriSemaphore* semaphore, uint32_t timeout) {
+    furi_assert(semaphore);
+    FuriStatus status = FuriStatusOk;
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) {
+        furi_host_deadline(timeout, &deadline);
+    }
+
+    pthread_mutex_lock(&semaphore->mutex);
+    while(semaphore->count == 0) {
+        if(timeout == 0) {
+            status = FuriStatusErrorResource;
+            break;
+        } else if(timeout == FuriWaitForever) {
+            pthread_cond_wait(&semaphore->cond, &semaphore->mutex);
+        } else if(pthread_cond_timedwait(&semaphore->cond, &semaphore->mutex, &deadline) == ETIMEDOUT) {
+            status = FuriStatusErrorTimeout;
+            break;
+        }
+    }
+    if(status == FuriStatusOk) {
+        semaphore->count--;
+    }
+    pthread_mutex_unlock(&semaphore->mutex);
+    return status;
+}
+
+FuriStatus furi_semaphore_release(FuriSemaphore* semaphore) {
+    furi_assert(semaphore);
+    FuriStatus status = FuriStatusOk;
+    pthread_mutex_lock(&semaphore->mutex);
+    if(semaphore->count < semaphore->max_count) {
+        semaphore->count++;
+        pthread_cond_signal(&semaphore->cond);
+    } else {
+        status = FuriStatusErrorResource;
+    }
+    pthread_mutex_unlock(&semaphore->mutex);
+    return status;
+}
+
+FuriThreadId furi_thread_get_current_id(void) {
+    return (FuriThreadId)pthread_self();
+}
+
+const char* furi_thread_get_name(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+    return "host";
+}
+
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+    return 0;
+}
+
+struct FuriMessageQueue {
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    uint8_t* items;
+    uint32_t msg_count;
+    uint32_t msg_size;
+    uint32_t head;
+    uint32_t count;
+};
+
+FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size) {
+    furi_assert(msg_count > 0 && msg_size > 0);
+    FuriMessageQueue* instance = malloc(sizeof(FuriMessageQueue));
+    pthread_mutex_init(&instance->mutex, NULL);
+    pthread_cond_init(&instance->not_empty, NULL);
+    pthread_cond_init(&instance->not_full, NULL);
+    instance->items = malloc(msg_count * msg_size);
+    instance->msg_count = msg_count;
+    instance->msg_size = msg_size;
+    instance->head = 0;
+    instance->count = 0;
+    return instance;
+}
+
+void furi_message_queue_free(FuriMessageQueue* instance) {
+    furi_assert(instance);
+    pthread_cond_destroy(&instance->not_full);
+    pthread_cond_destroy(&instance->not_empty);
+    pthread_mutex_destroy(&instance->mutex);
+    free(instance->items);
+    free(instance);
+}
+
+// Wait on cond until ready() holds, mutex held by the caller
+static FuriStatus furi_host_wait(
+    pthread_cond_t* cond,
+    pthread_mutex_t* mutex,
+    uint32_t timeout,
+    bool (*ready)(FuriMessageQueue*),
+    FuriMessageQueue* instance) {
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) {
+        furi_host_deadline(timeout, &deadline);
+    }
+    while(!ready(instance)) {
+        if(timeout == 0) {
+            return FuriStatusErrorResource;
+        } else if(timeout == FuriWaitForever) {
+            pthread_cond_wait(cond, mutex);
+        } else if(pthread_cond_timedwait(cond, mutex, &deadline) == ETIMEDOUT) {
+            return FuriStatusErrorTimeout;
+        }
+    }
+    return FuriStatusOk;
+}
+
+static bool furi_message_queue_has_space(FuriMessageQueue* instance) {
+    return instance->count < instance->msg_count;
+}
+
+static bool furi_message_queue_has_item(FuriMessageQueue* instance) {
+    return instance->count > 0;
+}
+
+FuriStatus furi_message_queue_put(FuriMessageQueue* instance, const void* msg_ptr, uint32_t timeout) {
+    furi_assert(instance);
+    pthread_mutex_lock(&instance->mutex);
+    FuriStatus status = furi_host_wait(
+        &instance->not_full, &instance->mutex, timeout, furi_message_queue_has_space, instance);
+    if(status == FuriStatusOk) {
+        uint32_t tail = (instance->head + instance->count) % instance->msg_count;
+        memcpy(instance->items + tail * instance->msg_size, msg_ptr, instance->msg_size);
+        instance->count++;
+        pthread_cond_signal(&instance->not_empty);
+    }
+    pthread_mutex_unlock(&instance->mutex);
+    return status;
+}
+
+FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout) {
+    furi_assert(instance);
+    pthread_mutex_lock(&instance->mutex);
+    FuriStatus status = furi_host_wait(
+        &instance->not_empty, &instance->mutex, timeout, furi_message_queue_has_item, instance);
+    if(status == FuriStatusOk) {
+        memcpy(msg_ptr, instance->items + instance->head * instance->msg_size, instance->msg_size);
+        instance->head = (instance->head + 1) % instance->msg_count;
+        instance->count--;
+        pthread_cond_signal(&instance->not_full);
+    }
+    pthread_mutex_unlock(&instance->mutex);
+    return status;
+}
+
+uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
+    furi_assert(instance);
+    pthread_mutex_lock(&instance->mutex);
+    uint32_t count = instance->count;
+    pthread_mutex_unlock(&instance->mutex);
+    return count;
+}
+
+FuriStatus furi_message_queue_reset(FuriMessageQueue* instance) {
+    furi_assert(instance);
+    pthread_mutex_lock(&instance->mutex);
+    instance->head = 0;
+    instance->count = 0;
+    pthread_cond_broadcast(&instance->not_full);
+    pthread_mutex_unlock(&instance->mutex);
+    return FuriStatusOk;
+}
+
+void* furi_record_open(const char* name) {
+    furi_check(strcmp(name, RECORD_STORAGE) == 0);
+    static int storage_record;
+    return &storage_record;
+}
+
+void furi_record_close(const char* name) {
+    UNUSED(name);
+}
+
+struct FuriString {
+    char* data;
+    size_t size;
+    size_t capacity;
+};
+
+static void furi_string_reserve(FuriString* string, size_t size) {
+    if(size + 1 > string->capacity) {
+        string->capacity = MAX(size + 1, string->capacity * 2);
+        string->data = realloc(string->data, string->capacity);
+    }
+}
+
+FuriString* furi_string_alloc(void) {
+    FuriString* string = malloc(sizeof(FuriString));
+    string->capacity = 16;
+    string->data = malloc(string->capacity);
+    string->data[0] = '\0';
+    string->size = 0;
+    return string;
+}
+
+FuriString* furi_string_alloc_set_str(const char* cstr) {
+    FuriString* string = furi_string_alloc();
+    furi_string_set_str(string, cstr);
+    return string;
+}
+
+void furi_string_free(FuriString* string) {
+    furi_assert(string);
+    free(string->data);
+    free(string);
+}
+
+const char* furi_string_get_cstr(const FuriString* string) {
+    return string->data;
+}
+
+size_t furi_string_size(const FuriString* string) {
+    return string->size;
+}
+
+void furi_string_reset(FuriString* string) {
+    string->size = 0;
+    string->data[0] = '\0';
+}
+
+void furi_string_set_strn(FuriString* string, const char* cstr, size_t length) {
+    furi_string_reserve(string, length);
+    memmove(string->data, cstr, length);
+    string->size = length;
+    string->data[length] = '\0';
+}
+
+void furi_string_set_str(FuriString* string, const char* cstr) {
+    furi_string_set_strn(string, cstr, strlen(cstr));
+}
+
+void furi_string_cat_str(FuriString* string, const char* cstr) {
+    size_t length = strlen(cstr);
+    furi_string_reserve(string, string->size + length);
+    memcpy(string->data + string->size, cstr, length + 1);
+    string->size += length;
+}
+
+int furi_string_printf(FuriString* string, const char* format, ...) {
+    furi_assert(format);
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    if(length < 0) return length;
+
+    furi_string_reserve(string, length);
+    va_start(args, format);
+    vsnprintf(string->data, length + 1, format, args);
+    va_end(args);
+    string->size = length;
+    return length;
+}
+
+int furi_string_cmp_str(const FuriString* string, const char* cstr) {
+    return strcmp(string->data, cstr);
+}
+
+void furi_string_left(FuriString* string, size_t index) {
+    if(index < string->size) {
+        string->size = index;
+        string->data[index] = '\0';
+    }
+}
+
+void path_extract_filename_no_ext(const char* path, FuriString* filename) {
+    const char* start = strrchr(path, '/');
+    start = start ? start + 1 : path;
+    const char* end = strrchr(start, '.');
+    furi_string_set_strn(filename, start, end ? (size_t)(end - start) : strlen(start));
+}
+
+uint32_t furi_hal_cortex_instructions_per_microsecond(void) {
+    return FURI_HOST_CYCLES_PER_US;
+}
+
+FuriHalCortexTimer furi_hal_cortex_timer_get(uint32_t timeout_us) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t us = (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+    FuriHalCortexTimer timer = {
+        .start = (uint32_t)(us * FURI_HOST_CYCLES_PER_US),
+        .value = timeout_us * FURI_HOST_CYCLES_PER_US,
+    };
+    return timer;
+}
+
+void furi_hal_rtc_get_datetime(DateTime* datetime) {
+    time_t now = time(NULL);
+    struct tm tm;
+    localtime_r(&now, &tm);
+    datetime->hour = tm.tm_hour;
+    datetime->minute = tm.tm_min;
+    datetime->second = tm.tm_sec;
+    datetime->day = tm.tm_mday;
+    datetime->month = tm.tm_mon + 1;
+    datetime->year = tm.tm_year + 1900;
+    datetime->weekday = tm.tm_wday == 0 ? 7 : tm.tm_wday;
+}
+
+uint32_t furi_hal_rtc_get_timestamp(void) {
+    return (uint32_t)time(NULL);
+}
+
+#define SHIFT(key) ((key) | KEY_MOD_LEFT_SHIFT)
+
+const uint16_t hid_asciimap[128] = {
+    ['\t'] = 0x2B, ['\n'] = 0x28, [' '] = 0x2C,
+    ['!'] = SHIFT(0x1E), ['"'] = SHIFT(0x34), ['#'] = SHIFT(0x20), ['$'] = SHIFT(0x21),
+    ['%'] = SHIFT(0x22), ['&'] = SHIFT(0x24), ['\''] = 0x34, ['('] = SHIFT(0x26),
+    [')'] = SHIFT(0x27), ['*'] = SHIFT(0x25), ['+'] = SHIFT(0x2E), [','] = 0x36,
+    ['-'] = 0x2D, ['.'] = 0x37, ['/'] = 0x38,
+    ['0'] = 0x27, ['1'] = 0x1E, ['2'] = 0x1F, ['3'] = 0x20, ['4'] = 0x21,
+    ['5'] = 0x22, ['6'] = 0x23, ['7'] = 0x24, ['8'] = 0x25, ['9'] = 0x26,
+    [':'] = SHIFT(0x33), [';'] = 0x33, ['<'] = SHIFT(0x36), ['='] = 0x2E,
+    ['>'] = SHIFT(0x37), ['?'] = SHIFT(0x38), ['@'] = SHIFT(0x1F),
+    ['A'] = SHIFT(0x04), ['B'] = SHIFT(0x05), ['C'] = SHIFT(0x06), ['D'] = SHIFT(0x07),
+    ['E'] = SHIFT(0x08), ['F'] = SHIFT(0x09), ['G'] = SHIFT(0x0A), ['H'] = SHIFT(0x0B),
+    ['I'] = SHIFT(0x0C), ['J'] = SHIFT(0x0D), ['K'] = SHIFT(0x0E), ['L'] = SHIFT(0x0F),
+    ['M'] = SHIFT(0x10), ['N'] = SHIFT(0x11), ['O'] = SHIFT(0x12), ['P'] = SHIFT(0x13),
+    ['Q'] = SHIFT(0x14), ['R'] = SHIFT(0x15), ['S'] = SHIFT(0x16), ['T'] = SHIFT(0x17),
+    ['U'] = SHIFT(0x18), ['V'] = SHIFT(0x19), ['W'] = SHIFT(0x1A), ['X'] = SHIFT(0x1B),
+    ['Y'] = SHIFT(0x1C), ['Z'] = SHIFT(0x1D),
+    ['['] = 0x2F, ['\\'] = 0x31, [']'] = 0x30, ['^'] = SHIFT(0x23), ['_'] = SHIFT(0x2D),
+    ['`'] = 0x35,
+    ['a'] = 0x04, ['b'] = 0x05, ['c'] = 0x06, ['d'] = 0x07, ['e'] = 0x08, ['f'] = 0x09,
+    ['g'] = 0x0A, ['h'] = 0x0B, ['i'] = 0x0C, ['j'] = 0x0D, ['k'] = 0x0E, ['l'] = 0x0F,
+    ['m'] = 0x10, ['n'] = 0x11, ['o'] = 0x12, ['p'] = 0x13, ['q'] = 0x14, ['r'] = 0x15,
+    ['s'] = 0x16, ['t'] = 0x17, ['u'] = 0x18, ['v'] = 0x19, ['w'] = 0x1A, ['x'] = 0x1B,
+    ['y'] = 0x1C, ['z'] = 0x1D,
+    ['{'] = SHIFT(0x2F), ['|'] = SHIFT(0x31), ['}'] = SHIFT(0x30), ['~'] = SHIFT(0x35),
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+// Host stand-in for FlipperFormat files, read-only
+// Like the firmware, keys are searched forward from the current position
+
+#include <furi.h>
+#include <storage/storage.h>
+
+typedef struct FlipperFormat FlipperFormat;
+
+FlipperFormat* flipper_format_file_alloc(Storage* storage);
+void flipper_format_free(FlipperFormat* flipper_format);
+bool flipper_format_file_open_existing(FlipperFormat* flipper_format, const char* path);
+bool flipper_format_file_close(FlipperFormat* flipper_format);
+bool flipper_format_rewind(FlipperFormat* flipper_format);
+bool flipper_format_read_header(FlipperFormat* flipper_format, FuriString* filetype, uint32_t* version);
+bool flipper_format_read_string(FlipperFormat* flipper_format, const char* key, FuriString* data);
+bool flipper_format_read_uint32(FlipperFormat* flipper_format, const char* key, uint32_t* data, uint16_t data_size);
@@ -0,0 +1,138 @@
+#pragma once
+
+// Host stand-in for the parts of furi the helpers use
+// Logging goes to stderr when FURI_LOG is set in the environment
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef HOST_STORAGE_ROOT
+#define HOST_STORAGE_ROOT "/tmp/flipper_wedge_host"
+#endif
+
+#define EXT_PATH(path) HOST_STORAGE_ROOT "/" path
+#define APP_DATA_PATH(path) EXT_PATH("apps_data/flipper_wedge/" path)
+
+#define UNUSED(x) (void)(x)
+#define COUNT_OF(x) (sizeof(x) / sizeof(x[0]))
+
+#define MIN(a, b)               \
+    ({                          \
+        __typeof__(a) _a = (a); \
+        __typeof__(b) _b = (b); \
+        _a < _b ? _a : _b;      \
+    })
+#define MAX(a, b)               \
+    ({                          \
+        __typeof__(a) _a = (a); \
+        __typeof__(b) _b = (b); \
+        _a > _b ? _a : _b;      \
+    })
+#define CLAMP(x, upper, lower) (MIN(upper, MAX(x, lower)))
+
+void furi_crash_host(const char* file, int line, const char* message);
+
+#define furi_crash(message) furi_crash_host(__FILE__, __LINE__, message)
+#define furi_check(x)                      \
+    do {                                   \
+        if(!(x)) furi_crash("check: " #x); \
+    } while(0)
+#define furi_assert(x)                      \
+    do {                                    \
+        if(!(x)) furi_crash("assert: " #x); \
+    } while(0)
+
+// Logging
+// No printf format checking: log calls print uint32_t with %lu, which matches
+// the firmware toolchain where uint32_t is unsigned long. Text the helpers
+// build with snprintf() is checked, and uses PRIu32 to be right on both.
+void furi_log_host(char level, const char* tag, const char* format, ...);
+
+#define FURI_LOG_E(tag, ...) furi_log_host('E', tag, __VA_ARGS__)
+#define FURI_LOG_W(tag, ...) furi_log_host('W', tag, __VA_ARGS__)
+#define FURI_LOG_I(tag, ...) furi_log_host('I', tag, __VA_ARGS__)
+#define FURI_LOG_D(tag, ...) furi_log_host('D', tag, __VA_ARGS__)
+#define FURI_LOG_T(tag, ...) furi_log_host('T', tag, __VA_ARGS__)
+
+// Kernel: one tick is one millisecond
+#define FuriWaitForever 0xFFFFFFFFU
+
+typedef enum {
+    FuriStatusOk = 0,
+    FuriStatusError = -1,
+    FuriStatusErrorTimeout = -2,
+    FuriStatusErrorResource = -3,
+} FuriStatus;
+
+uint32_t furi_get_tick(void);
+void furi_delay_ms(uint32_t milliseconds);
+
+static inline uint32_t furi_ms_to_ticks(uint32_t milliseconds) {
+    return milliseconds;
+}
+
+static inline uint32_t furi_kernel_get_tick_frequency(void) {
+    return 1000;
+}
+
+// Mutex, semaphore and message queue, backed by pthreads
+typedef enum {
+    FuriMutexTypeNormal,
+    FuriMutexTypeRecursive,
+} FuriMutexType;
+
+typedef struct FuriMutex FuriMutex;
+typedef struct FuriSemaphore FuriSemaphore;
+
+FuriMutex* furi_mutex_alloc(FuriMutexType type);
+void furi_mutex_free(FuriMutex* mutex);
+FuriStatus furi_mutex_acquire(FuriMutex* mutex, uint32_t timeout);
+FuriStatus furi_mutex_release(FuriMutex* mutex);
+
+FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count);
+void furi_semaphore_free(FuriSemaphore* semaphore);
+FuriStatus furi_semaphore_acquire(FuriSemaphore* semaphore, uint32_t timeout);
+FuriStatus furi_semaphore_release(FuriSemaphore* semaphore);
+
+// Threads: only the identity queries, helpers do not create threads
+typedef void* FuriThreadId;
+
+FuriThreadId furi_thread_get_current_id(void);
+const char* furi_thread_get_name(FuriThreadId thread_id);
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id);
+
+// Message queue with fixed-size items
+typedef struct FuriMessageQueue FuriMessageQueue;
+
+FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size);
+void furi_message_queue_free(FuriMessageQueue* instance);
+FuriStatus furi_message_queue_put(FuriMessageQueue* instance, const void* msg_ptr, uint32_t timeout);
+FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout);
+uint32_t furi_message_queue_get_count(FuriMessageQueue* instance);
+FuriStatus furi_message_queue_reset(FuriMessageQueue* instance);
+
+// Records: only the storage record exists, as a dummy handle
+#define RECORD_STORAGE "storage"
+
+void* furi_record_open(const char* name);
+void furi_record_close(const char* name);
+
+// Strings
+typedef struct FuriString FuriString;
+
+FuriString* furi_string_alloc(void);
+FuriString* furi_string_alloc_set_str(const char* cstr);
+void furi_string_free(FuriString* string);
+const char* furi_string_get_cstr(const FuriString* string);
+size_t furi_string_size(const FuriString* string);
+void furi_string_reset(FuriString* string);
+void furi_string_set_str(FuriString* string, const char* cstr);
+void furi_string_set_strn(FuriString* string, const char* cstr, size_t length);
+void furi_string_cat_str(FuriString* string, const char* cstr);
+int furi_string_printf(FuriString* string, const char* format, ...);
+int furi_string_cmp_str(const FuriString* string, const char* cstr);
+void furi_string_left(FuriString* string, size_t index);
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <furi.h>
+#include <furi_hal_rtc.h>
+#include <furi_hal_usb_hid.h>
+
+// Cycle counter, derived from the monotonic clock at a nominal 64 MHz
+#define FURI_HOST_CYCLES_PER_US 64
+
+typedef struct {
+    uint32_t start;
+    uint32_t value;
+} FuriHalCortexTimer;
+
+uint32_t furi_hal_cortex_instructions_per_microsecond(void);
+FuriHalCortexTimer furi_hal_cortex_timer_get(uint32_t timeout_us);
@@ -0,0 +1,18 @@
+#pragma once
+
+// Host stand-in for the RTC, reads the system clock
+
+#include <furi.h>
+
+typedef struct {
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+    uint8_t day;
+    uint8_t month;
+    uint16_t year;
+    uint8_t weekday;
+} DateTime;
+
+void furi_hal_rtc_get_datetime(DateTime* datetime);
+uint32_t furi_hal_rtc_get_timestamp(void);
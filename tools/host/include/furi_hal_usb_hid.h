@@ -0,0 +1,51 @@
+#pragma once
+
+// Host stand-in for the HID keycodes the layouts use
+// Values match the firmware's HID usage table
+
+#include <furi.h>
+
+#define KEY_MOD_LEFT_CTRL (1 << 8)
+#define KEY_MOD_LEFT_SHIFT (1 << 9)
+#define KEY_MOD_LEFT_ALT (1 << 10)
+#define KEY_MOD_LEFT_GUI (1 << 11)
+
+#define HID_KEYBOARD_NONE 0x00
+#define HID_KEYBOARD_RETURN 0x28
+#define HID_KEYBOARD_ESCAPE 0x29
+#define HID_KEYBOARD_DELETE 0x2A
+#define HID_KEYBOARD_TAB 0x2B
+#define HID_KEYBOARD_SPACEBAR 0x2C
+#define HID_KEYBOARD_F1 0x3A
+#define HID_KEYBOARD_INSERT 0x49
+#define HID_KEYBOARD_HOME 0x4A
+#define HID_KEYBOARD_PAGE_UP 0x4B
+#define HID_KEYBOARD_DELETE_FORWARD 0x4C
+#define HID_KEYBOARD_END 0x4D
+#define HID_KEYBOARD_PAGE_DOWN 0x4E
+#define HID_KEYBOARD_RIGHT_ARROW 0x4F
+#define HID_KEYBOARD_LEFT_ARROW 0x50
+#define HID_KEYBOARD_DOWN_ARROW 0x51
+#define HID_KEYBOARD_UP_ARROW 0x52
+#define HID_KEYPAD_NUMLOCK 0x53
+#define HID_KEYPAD_1 0x59
+#define HID_KEYPAD_2 0x5A
+#define HID_KEYPAD_3 0x5B
+#define HID_KEYPAD_4 0x5C
+#define HID_KEYPAD_5 0x5D
+#define HID_KEYPAD_6 0x5E
+#define HID_KEYPAD_7 0x5F
+#define HID_KEYPAD_8 0x60
+#define HID_KEYPAD_9 0x61
+#define HID_KEYPAD_0 0x62
+#define HID_KEYPAD_A 0xBC
+#define HID_KEYPAD_B 0xBD
+#define HID_KEYPAD_C 0xBE
+#define HID_KEYPAD_D 0xBF
+#define HID_KEYPAD_E 0xC0
+#define HID_KEYPAD_F 0xC1
+
+// US QWERTY, like the firmware's hid_asciimap
+extern const uint16_t hid_asciimap[128];
+
+#define HID_ASCII_TO_KEY(x) (((uint8_t)(x) < 128) ? (hid_asciimap[(uint8_t)(x)]) : HID_KEYBOARD_NONE)
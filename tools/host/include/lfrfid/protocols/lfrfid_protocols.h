@@ -0,0 +1,15 @@
+#pragma once
+
+// Host stand-in for the LF protocol list, the protocols the helpers decode
+// Only the names are used, the values need not match the firmware's
+
+#include <furi.h>
+
+typedef int32_t ProtocolId;
+
+typedef enum {
+    LFRFIDProtocolEM4100,
+    LFRFIDProtocolH10301,
+    LFRFIDProtocolIndala26,
+    LFRFIDProtocolMax,
+} LFRFIDProtocol;
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <furi.h>
+
+void path_extract_filename_no_ext(const char* path, FuriString* filename);
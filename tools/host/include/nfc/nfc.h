@@ -0,0 +1,27 @@
+#pragma once
+
+// Host stand-in for the NFC controller: the field is simulated by the replay
+// backend (tools/host/nfc_replay.h), not by hardware
+
+#include <furi.h>
+#include <nfc/protocols/nfc_protocol.h>
+
+typedef struct Nfc Nfc;
+
+typedef enum {
+    NfcCommandContinue,
+    NfcCommandReset,
+    NfcCommandStop,
+    NfcCommandSleep,
+} NfcCommand;
+
+typedef struct {
+    NfcProtocol protocol;
+    void* instance;    // Protocol poller, e.g. Iso14443_4aPoller*
+    void* event_data;  // Protocol event, e.g. const Iso14443_4aPollerEvent*
+} NfcGenericEvent;
+
+typedef NfcCommand (*NfcGenericCallback)(NfcGenericEvent event, void* context);
+
+Nfc* nfc_alloc(void);
+void nfc_free(Nfc* instance);
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <nfc/nfc.h>
+
+typedef struct NfcPoller NfcPoller;
+
+NfcPoller* nfc_poller_alloc(Nfc* nfc, NfcProtocol protocol);
+void nfc_poller_free(NfcPoller* instance);
+void nfc_poller_start(NfcPoller* instance, NfcGenericCallback callback, void* context);
+void nfc_poller_stop(NfcPoller* instance);
+const void* nfc_poller_get_data(const NfcPoller* instance);
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <nfc/nfc.h>
+
+typedef struct NfcScanner NfcScanner;
+
+typedef enum {
+    NfcScannerEventTypeDetected,
+} NfcScannerEventType;
+
+typedef struct {
+    size_t protocol_num;
+    NfcProtocol* protocols;
+} NfcScannerEventData;
+
+typedef struct {
+    NfcScannerEventType type;
+    NfcScannerEventData data;
+} NfcScannerEvent;
+
+typedef void (*NfcScannerCallback)(NfcScannerEvent event, void* context);
+
+NfcScanner* nfc_scanner_alloc(Nfc* nfc);
+void nfc_scanner_free(NfcScanner* instance);
+void nfc_scanner_start(NfcScanner* instance, NfcScannerCallback callback, void* context);
+void nfc_scanner_stop(NfcScanner* instance);
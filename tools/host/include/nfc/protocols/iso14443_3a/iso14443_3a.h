@@ -0,0 +1,23 @@
+#pragma once
+
+#include <furi.h>
+
+#define ISO14443_3A_MAX_UID_SIZE 10
+
+typedef enum {
+    Iso14443_3aErrorNone,
+    Iso14443_3aErrorNotPresent,
+    Iso14443_3aErrorColResFailed,
+    Iso14443_3aErrorBufferOverflow,
+    Iso14443_3aErrorCommunication,
+    Iso14443_3aErrorFieldOff,
+    Iso14443_3aErrorWrongCrc,
+    Iso14443_3aErrorTimeout,
+} Iso14443_3aError;
+
+typedef struct {
+    uint8_t uid[ISO14443_3A_MAX_UID_SIZE];
+    uint8_t uid_len;
+    uint8_t atqa[2];
+    uint8_t sak;
+} Iso14443_3aData;
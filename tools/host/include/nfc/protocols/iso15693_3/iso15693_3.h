@@ -0,0 +1,40 @@
+#pragma once
+
+#include <furi.h>
+#include <toolbox/simple_array.h>
+
+#define ISO15693_3_UID_SIZE 8U
+
+typedef enum {
+    Iso15693_3ErrorNone,
+    Iso15693_3ErrorNotPresent,
+    Iso15693_3ErrorBufferEmpty,
+    Iso15693_3ErrorBufferOverflow,
+    Iso15693_3ErrorFieldOff,
+    Iso15693_3ErrorWrongCrc,
+    Iso15693_3ErrorTimeout,
+    Iso15693_3ErrorFormat,
+    Iso15693_3ErrorIgnore,
+    Iso15693_3ErrorNotSupported,
+    Iso15693_3ErrorUidMismatch,
+    Iso15693_3ErrorFullyHandled,
+    Iso15693_3ErrorUnexpectedResponse,
+    Iso15693_3ErrorInternal,
+    Iso15693_3ErrorCustom,
+    Iso15693_3ErrorUnknown,
+} Iso15693_3Error;
+
+typedef struct {
+    uint8_t flags;
+    uint8_t dsfid;
+    uint8_t afi;
+    uint8_t ic_ref;
+    uint16_t block_count;
+    uint8_t block_size;
+} Iso15693_3SystemInfo;
+
+typedef struct {
+    uint8_t uid[ISO15693_3_UID_SIZE];  // Display order, E0 manufacturer byte first
+    Iso15693_3SystemInfo system_info;
+    SimpleArray* block_data;
+} Iso15693_3Data;
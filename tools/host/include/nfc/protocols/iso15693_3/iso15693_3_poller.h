@@ -0,0 +1,26 @@
+#pragma once
+
+#include "iso15693_3.h"
+#include <toolbox/bit_buffer.h>
+
+typedef struct Iso15693_3Poller Iso15693_3Poller;
+
+typedef enum {
+    Iso15693_3PollerEventTypeError,
+    Iso15693_3PollerEventTypeReady,
+} Iso15693_3PollerEventType;
+
+typedef struct {
+    Iso15693_3Error error;
+} Iso15693_3PollerEventData;
+
+typedef struct {
+    Iso15693_3PollerEventType type;
+    Iso15693_3PollerEventData* data;
+} Iso15693_3PollerEvent;
+
+Iso15693_3Error iso15693_3_poller_send_frame(
+    Iso15693_3Poller* instance,
+    const BitBuffer* tx_buffer,
+    BitBuffer* rx_buffer,
+    uint32_t fwt);
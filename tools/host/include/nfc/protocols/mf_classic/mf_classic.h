@@ -0,0 +1,61 @@
+#pragma once
+
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
+
+#define MF_CLASSIC_BLOCK_SIZE 16
+#define MF_CLASSIC_KEY_SIZE 6
+#define MF_CLASSIC_TOTAL_SECTORS_MAX 40
+#define MF_CLASSIC_TOTAL_BLOCKS_MAX 256
+
+typedef enum {
+    MfClassicErrorNone,
+    MfClassicErrorNotPresent,
+    MfClassicErrorProtocol,
+    MfClassicErrorAuth,
+    MfClassicErrorPartialRead,
+    MfClassicErrorTimeout,
+} MfClassicError;
+
+typedef enum {
+    MfClassicTypeMini,
+    MfClassicType1k,
+    MfClassicType4k,
+    MfClassicTypeNum,
+} MfClassicType;
+
+typedef enum {
+    MfClassicKeyTypeA,
+    MfClassicKeyTypeB,
+} MfClassicKeyType;
+
+typedef struct {
+    uint8_t data[MF_CLASSIC_BLOCK_SIZE];
+} MfClassicBlock;
+
+typedef struct {
+    uint8_t data[MF_CLASSIC_KEY_SIZE];
+} MfClassicKey;
+
+typedef struct {
+    uint8_t data[4];
+} MfClassicNt;
+
+typedef struct {
+    uint8_t block_num;
+    MfClassicKey key;
+    MfClassicKeyType key_type;
+    MfClassicNt nt;
+} MfClassicAuthContext;
+
+typedef struct {
+    Iso14443_3aData* iso14443_3a_data;
+    MfClassicType type;
+    MfClassicBlock block[MF_CLASSIC_TOTAL_BLOCKS_MAX];
+    uint32_t block_read_mask[MF_CLASSIC_TOTAL_BLOCKS_MAX / 32];
+} MfClassicData;
+
+uint8_t mf_classic_get_total_sectors_num(MfClassicType type);
+uint8_t mf_classic_get_first_block_num_of_sector(uint8_t sector);
+uint8_t mf_classic_get_blocks_num_in_sector(uint8_t sector);
+bool mf_classic_is_block_read(const MfClassicData* data, uint8_t block_num);
+void mf_classic_set_block_read(MfClassicData* data, uint8_t block_num, MfClassicBlock* block_data);
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "mf_classic.h"
+
+typedef struct MfClassicPoller MfClassicPoller;
+
+// Only the events the app handles; the card is activated before RequestMode
+typedef enum {
+    MfClassicPollerEventTypeRequestMode,
+    MfClassicPollerEventTypeRequestReadSector,
+    MfClassicPollerEventTypeCardDetected,
+    MfClassicPollerEventTypeCardLost,
+    MfClassicPollerEventTypeSuccess,
+    MfClassicPollerEventTypeFail,
+} MfClassicPollerEventType;
+
+typedef enum {
+    MfClassicPollerModeRead,
+    MfClassicPollerModeWrite,
+    MfClassicPollerModeDictAttack,
+} MfClassicPollerMode;
+
+typedef struct {
+    MfClassicPollerMode mode;
+    const MfClassicData* data;
+} MfClassicPollerEventDataRequestMode;
+
+typedef struct {
+    uint8_t sector_num;
+    MfClassicKey key;
+    MfClassicKeyType key_type;
+    bool key_provided;
+} MfClassicPollerEventDataReadSectorRequest;
+
+typedef union {
+    MfClassicError error;
+    MfClassicPollerEventDataRequestMode poller_mode;
+    MfClassicPollerEventDataReadSectorRequest read_sector_request_data;
+} MfClassicPollerEventData;
+
+typedef struct {
+    MfClassicPollerEventType type;
+    MfClassicPollerEventData* data;
+} MfClassicPollerEvent;
+
+MfClassicError mf_classic_poller_auth(
+    MfClassicPoller* instance,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicAuthContext* data,
+    bool backdoor_auth);
+MfClassicError mf_classic_poller_read_block(MfClassicPoller* instance, uint8_t block_num, MfClassicBlock* data);
+MfClassicError mf_classic_poller_halt(MfClassicPoller* instance);
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
+
+#define MF_ULTRALIGHT_PAGE_SIZE 4U
+#define MF_ULTRALIGHT_MAX_PAGE_NUM 510U
+
+typedef struct {
+    uint8_t data[MF_ULTRALIGHT_PAGE_SIZE];
+} MfUltralightPage;
+
+typedef struct {
+    Iso14443_3aData* iso14443_3a_data;
+    uint16_t pages_read;
+    uint16_t pages_total;
+    MfUltralightPage page[MF_ULTRALIGHT_MAX_PAGE_NUM];
+} MfUltralightData;
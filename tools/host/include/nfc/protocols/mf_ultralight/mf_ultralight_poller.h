@@ -0,0 +1,26 @@
+#pragma once
+
+#include "mf_ultralight.h"
+
+typedef enum {
+    MfUltralightPollerEventTypeRequestMode,
+    MfUltralightPollerEventTypeAuthRequest,
+    MfUltralightPollerEventTypeAuthSuccess,
+    MfUltralightPollerEventTypeAuthFailed,
+    MfUltralightPollerEventTypeReadSuccess,
+    MfUltralightPollerEventTypeReadFailed,
+} MfUltralightPollerEventType;
+
+typedef enum {
+    MfUltralightPollerModeRead,
+    MfUltralightPollerModeWrite,
+} MfUltralightPollerMode;
+
+typedef struct {
+    MfUltralightPollerMode poller_mode;
+} MfUltralightPollerEventData;
+
+typedef struct {
+    MfUltralightPollerEventType type;
+    MfUltralightPollerEventData* data;
+} MfUltralightPollerEvent;
@@ -0,0 +1,18 @@
+#pragma once
+
+// Host stand-in for the firmware BitBuffer, byte-granular only
+
+#include <furi.h>
+
+typedef struct BitBuffer BitBuffer;
+
+BitBuffer* bit_buffer_alloc(size_t capacity_bytes);
+void bit_buffer_free(BitBuffer* buf);
+void bit_buffer_reset(BitBuffer* buf);
+void bit_buffer_copy_bytes(BitBuffer* buf, const uint8_t* data, size_t size_bytes);
+void bit_buffer_append_byte(BitBuffer* buf, uint8_t byte);
+void bit_buffer_append_bytes(BitBuffer* buf, const uint8_t* data, size_t size_bytes);
+size_t bit_buffer_get_capacity_bytes(const BitBuffer* buf);
+size_t bit_buffer_get_size_bytes(const BitBuffer* buf);
+uint8_t bit_buffer_get_byte(const BitBuffer* buf, size_t index);
+const uint8_t* bit_buffer_get_data(const BitBuffer* buf);
@@ -0,0 +1,14 @@
+#pragma once
+
+// Host stand-in for the firmware SimpleArray, byte elements only
+
+#include <furi.h>
+
+typedef struct SimpleArray SimpleArray;
+
+SimpleArray* simple_array_alloc_bytes(void);
+void simple_array_free(SimpleArray* instance);
+void simple_array_init(SimpleArray* instance, uint32_t count);
+uint32_t simple_array_get_count(const SimpleArray* instance);
+void* simple_array_get_data(SimpleArray* instance);
+const void* simple_array_cget_data(const SimpleArray* instance);
@@ -0,0 +1,257 @@
+// Host test for the post-scan macro compiler and runner
+//
+// Each case compiles a macro, runs it on a fixed scan and checks the stream
+// of USB boot keyboard reports it would produce: every key is a press report
+// (modifier byte and key) followed by an all-up report, field text is typed
+// through the keyboard layout like the HID output does, and delays are kept
+// in the stream. Malformed macros must be rejected at load with the expected
+// line, column and reason. Exit code is non-zero on any failure.
+//
+// The stream is written as "mm:kk" per report and "+Nms" per delay, e.g.
+// {ctrl+a}{delay:5} is "01:04 00:00 +5ms".
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#include "flipper_wedge_macro.h"
+
+#ifndef BENCH_LAYOUT_PATH
+#define BENCH_LAYOUT_PATH "../../assets/layouts/azerty_fr.txt"
+#endif
+
+#define MACRO_TEST_FILE_PATH APP_DATA_PATH("macro_test.txt")
+#define MACRO_TEST_STREAM_MAX 2048
+
+typedef struct {
+    FlipperWedgeKeyboardLayout* layout;
+    char stream[MACRO_TEST_STREAM_MAX];
+    size_t len;
+} MacroSink;
+
+static uint32_t failures = 0;
+static uint32_t passes = 0;
+
+static void macro_sink_append(MacroSink* sink, const char* text) {
+    size_t room = sizeof(sink->stream) - sink->len;
+    int written = snprintf(&sink->stream[sink->len], room, "%s%s", sink->len > 0 ? " " : "", text);
+    if(written > 0) sink->len += MIN((size_t)written, room - 1);
+}
+
+// One boot report for the press, one with every key up for the release
+static void macro_sink_key(uint16_t keycode, void* context) {
+    MacroSink* sink = context;
+    char report[16];
+    snprintf(report, sizeof(report), "%02x:%02x 00:00", keycode >> 8, keycode & 0xFF);
+    macro_sink_append(sink, report);
+}
+
+static void macro_sink_text(const char* text, void* context) {
+    MacroSink* sink = context;
+    for(const char* c = text; *c; c++) {
+        if((uint8_t)*c >= 0x80) {
+            // Goes to the Unicode input sequences, recorded as the text itself
+            char marker[MACRO_TEST_STREAM_MAX / 4];
+            snprintf(marker, sizeof(marker), "<%s>", c);
+            macro_sink_append(sink, marker);
+            return;
+        }
+        uint16_t keycode = sink->layout ? flipper_wedge_keyboard_layout_get_keycode(sink->layout, *c) :
+                                          HID_ASCII_TO_KEY(*c);
+        if(keycode != HID_KEYBOARD_NONE) {
+            macro_sink_key(keycode, sink);
+        }
+    }
+}
+
+static void macro_sink_delay(uint32_t ms, void* context) {
+    MacroSink* sink = context;
+    char delay[16];
+    snprintf(delay, sizeof(delay), "+%lums", (unsigned long)ms);
+    macro_sink_append(sink, delay);
+}
+
+static const uint8_t test_nfc_uid[] = {0x04, 0xA1};
+static const DateTime test_datetime = {
+    .hour = 9,
+    .minute = 5,
+    .second = 7,
+    .day = 3,
+    .month = 2,
+    .year = 2025,
+    .weekday = 1,
+};
+
+static const FlipperWedgeMacroData test_data = {
+    .output = "04:A1",
+    .nfc_uid = test_nfc_uid,
+    .nfc_uid_len = sizeof(test_nfc_uid),
+    .rfid_uid = NULL,
+    .rfid_uid_len = 0,
+    .ndef_text = "Jane\nDoe 42",
+    .delimiter = ":",
+    .datetime = &test_datetime,
+};
+
+static void macro_check(const char* name, bool ok, const char* expected, const char* got) {
+    if(ok) {
+        printf("ok   %s\n", name);
+        passes++;
+    } else {
+        printf("FAIL %s\n  expected: %s\n  got:      %s\n", name, expected, got);
+        failures++;
+    }
+}
+
+static void macro_expect_stream(
+    FlipperWedgeMacro* macro,
+    FlipperWedgeKeyboardLayout* layout,
+    const char* name,
+    const char* source,
+    const char* expected) {
+    MacroSink sink = {.layout = layout, .len = 0};
+    sink.stream[0] = '\0';
+
+    if(!flipper_wedge_macro_compile(macro, source, layout)) {
+        macro_check(name, false, expected, flipper_wedge_macro_get_error(macro));
+        return;
+    }
+    FlipperWedgeMacroOutput output = {
+        .key = macro_sink_key,
+        .text = macro_sink_text,
+        .delay = macro_sink_delay,
+        .context = &sink,
+    };
+    flipper_wedge_macro_run(macro, &test_data, &output);
+    macro_check(name, strcmp(sink.stream, expected) == 0, expected, sink.stream);
+}
+
+static void macro_expect_error(FlipperWedgeMacro* macro, const char* name, const char* source, const char* expected) {
+    bool compiled = flipper_wedge_macro_compile(macro, source, NULL);
+    const char* error = flipper_wedge_macro_get_error(macro);
+    macro_check(
+        name,
+        !compiled && !flipper_wedge_macro_is_loaded(macro) && strstr(error, expected) != NULL,
+        expected,
+        compiled ? "(compiled)" : error);
+}
+
+static bool macro_write_file(const char* text, size_t len) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool ok = storage_file_open(file, MACRO_TEST_FILE_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+              storage_file_write(file, text, len) == len;
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return ok;
+}
+
+int main(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(storage, EXT_PATH("apps_data"));
+    storage_simply_mkdir(storage, EXT_PATH("apps_data/flipper_wedge"));
+    furi_record_close(RECORD_STORAGE);
+
+    FlipperWedgeMacro* macro = flipper_wedge_macro_alloc();
+
+    // Keys, chords and delays
+    macro_expect_stream(
+        macro, NULL, "chord_text_delay", "{ctrl+a}x{delay:5}{enter}", "01:04 00:00 00:1b 00:00 +5ms 00:28 00:00");
+    macro_expect_stream(
+        macro,
+        NULL,
+        "chords",
+        "{ctrl+shift+esc}{gui+r}{alt+f4}{shift+tab}{ctrl++}{CTRL+Left}",
+        "03:29 00:00 08:15 00:00 04:3d 00:00 02:2b 00:00 03:2e 00:00 01:50 00:00");
+
+    // The form from the request: UID, Tab, NDEF line 2, Tab, time, Enter
+    macro_expect_stream(
+        macro,
+        NULL,
+        "form_fill",
+        "{nfc}{tab}{ndef:2}{tab}{time}{enter}",
+        "00:27 00:00 00:21 00:00 02:33 00:00 02:04 00:00 00:1e 00:00 "  // 04:A1
+        "00:2b 00:00 "  // Tab
+        "02:07 00:00 00:12 00:00 00:08 00:00 00:2c 00:00 00:21 00:00 00:1f 00:00 "  // Doe 42
+        "00:2b 00:00 "  // Tab
+        "00:27 00:00 00:26 00:00 02:33 00:00 00:27 00:00 00:22 00:00 02:33 00:00 00:27 00:00 00:24 00:00 "  // 09:05:07
+        "00:28 00:00");  // Enter
+    macro_expect_stream(
+        macro,
+        NULL,
+        "date_output",
+        "{date}{space}{output}",
+        "00:1f 00:00 00:27 00:00 00:1f 00:00 00:22 00:00 00:2d 00:00 00:27 00:00 00:1f 00:00 00:2d 00:00 "
+        "00:27 00:00 00:20 00:00 00:2c 00:00 "  // 2025-02-03 and Space
+        "00:27 00:00 00:21 00:00 02:33 00:00 02:04 00:00 00:1e 00:00");  // 04:A1
+
+    // Comments, line breaks, escapes and fields with no value
+    macro_expect_stream(
+        macro,
+        NULL,
+        "comments_escapes_empty_fields",
+        "# Badge in\r\nID \\{x\\}\n{ndef:3}{rfid}",
+        "02:0c 00:00 02:07 00:00 00:2c 00:00 02:2f 00:00 00:1b 00:00 02:30 00:00");
+    macro_expect_stream(macro, NULL, "unicode_literal", "Caf\xc3\xa9{tab}", "02:06 00:00 00:04 00:00 00:09 00:00 <\xc3\xa9> 00:2b 00:00");
+
+    // Text and chords follow the keyboard layout, also after a layout change
+    FlipperWedgeKeyboardLayout* azerty = flipper_wedge_keyboard_layout_alloc();
+    if(flipper_wedge_keyboard_layout_load(azerty, BENCH_LAYOUT_PATH)) {
+        macro_expect_stream(macro, azerty, "layout_azerty", "a{ctrl+a}", "00:14 00:00 01:14 00:00");
+
+        MacroSink sink = {.layout = NULL, .len = 0};
+        FlipperWedgeMacroOutput output = {macro_sink_key, macro_sink_text, macro_sink_delay, &sink};
+        bool relaid = flipper_wedge_macro_set_layout(macro, NULL);
+        flipper_wedge_macro_run(macro, &test_data, &output);
+        macro_check(
+            "layout_change", relaid && strcmp(sink.stream, "00:04 00:00 01:04 00:00") == 0,
+            "00:04 00:00 01:04 00:00", sink.stream);
+    } else {
+        macro_check("layout_azerty", false, "layout loaded", BENCH_LAYOUT_PATH);
+    }
+    flipper_wedge_keyboard_layout_free(azerty);
+
+    // Validation
+    macro_expect_error(macro, "err_unknown_key", "{nfc}{tabb}", "Line 1 col 6: unknown key");
+    macro_expect_error(macro, "err_delay_range", "ab\n  {delay:20000}", "Line 2 col 3: bad delay");
+    macro_expect_error(macro, "err_delay_total", "{delay:6000}{delay:5000}", "Line 1 col 13: delays over 10 s");
+    macro_expect_error(macro, "err_ndef_line", "{ndef:0}", "bad NDEF line");
+    macro_expect_error(macro, "err_field_arg", "{nfc:2}", "unknown field");
+    macro_expect_error(macro, "err_missing_brace", "{nfc\n}", "Line 1 col 1: missing }");
+    macro_expect_error(macro, "err_stray_brace", "x}", "Line 1 col 2: unexpected }");
+    macro_expect_error(macro, "err_modifier", "{hyper+a}", "unknown modifier");
+    macro_expect_error(macro, "err_escape", "\\n", "bad escape");
+    macro_expect_error(macro, "err_empty_token", "{}", "empty {}");
+    macro_expect_error(macro, "err_utf8", "\xff", "not UTF-8");
+    macro_expect_error(macro, "err_control", "a\x01", "Line 1 col 2: control character");
+    macro_expect_error(macro, "err_empty", "# Nothing but a comment\n", "Macro is empty");
+
+    char long_source[FLIPPER_WEDGE_MACRO_SOURCE_MAX_LEN];
+    memset(long_source, 'a', sizeof(long_source) - 1);
+    long_source[sizeof(long_source) - 1] = '\0';
+    macro_expect_error(macro, "err_too_long", long_source, "macro too long");
+
+    // Loading from a file
+    const char file_source[] = "# Check-in\n{nfc}{tab}{enter}\n";
+    bool loaded = macro_write_file(file_source, sizeof(file_source) - 1) &&
+                  flipper_wedge_macro_load(macro, MACRO_TEST_FILE_PATH, NULL);
+    macro_check("load_file", loaded, "loaded", flipper_wedge_macro_get_error(macro));
+
+    char big_file[FLIPPER_WEDGE_MACRO_SOURCE_MAX_LEN + 1];
+    memset(big_file, 'a', sizeof(big_file));
+    loaded = macro_write_file(big_file, sizeof(big_file)) &&
+             flipper_wedge_macro_load(macro, MACRO_TEST_FILE_PATH, NULL);
+    macro_check(
+        "load_file_too_big",
+        !loaded && strstr(flipper_wedge_macro_get_error(macro), "over") != NULL,
+        "Macro file over 1024 bytes",
+        flipper_wedge_macro_get_error(macro));
+
+    loaded = macro_write_file("{nfc}\0{tab}", 11) && flipper_wedge_macro_load(macro, MACRO_TEST_FILE_PATH, NULL);
+    macro_check("load_file_binary", !loaded, "Macro file is not text", flipper_wedge_macro_get_error(macro));
+
+    flipper_wedge_macro_free(macro);
+
+    printf("%lu passed, %lu failed\n", (unsigned long)passes, (unsigned long)failures);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,1005 @@
+#include "nfc_replay.h"
+
+#include <nfc/nfc_poller.h>
+#include <nfc/nfc_scanner.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a_poller.h>
+#include <nfc/protocols/iso14443_4a/iso14443_4a_poller.h>
+#include <nfc/protocols/mf_ultralight/mf_ultralight_poller.h>
+#include <nfc/protocols/mf_classic/mf_classic_poller.h>
+#include <nfc/protocols/iso15693_3/iso15693_3_poller.h>
+#include <flipper_format/flipper_format.h>
+
+#include <ctype.h>
+#include <pthread.h>
+#include <time.h>
+
+#define TAG "NfcReplay"
+
+#define NFC_REPLAY_APDU_MAX_LEN 261
+#define NFC_REPLAY_IDLE_US 1000  // Scanner and poller polling period with an empty field
+
+#define ISO15693_CMD_INVENTORY 0x01
+
+#define MF_CLASSIC_AUTH_FRAMES 2     // AUTH with the tag nonce, then the reader answer
+#define MF_CLASSIC_NO_SECTOR 0xFF   // No authenticated session
+
+typedef struct {
+    uint8_t command[NFC_REPLAY_APDU_MAX_LEN];
+    size_t command_len;
+    uint8_t response[NFC_REPLAY_APDU_MAX_LEN];
+    size_t response_len;
+} NfcReplayApdu;
+
+struct NfcReplayTag {
+    NfcProtocol protocol;
+    Iso14443_3aData iso14443_3a;
+    MfUltralightData* mf_ultralight;
+    MfClassicData* mf_classic;
+    Iso15693_3Data iso15693_3;
+    NfcReplayApdu* apdu;
+    size_t apdu_count;
+};
+
+struct Nfc {
+    uint32_t unused;
+};
+
+struct NfcScanner {
+    pthread_t thread;
+    bool started;
+    volatile bool running;
+    NfcScannerCallback callback;
+    void* context;
+};
+
+struct NfcPoller {
+    NfcProtocol protocol;
+    pthread_t thread;
+    bool started;
+    volatile bool running;
+    NfcGenericCallback callback;
+    void* context;
+
+    NfcReplayTag* tag;  // Tag being read, NULL if none is selected
+    NfcReplayTag* halted[NFC_REPLAY_FIELD_MAX];
+    size_t halted_count;
+    Iso14443_3aData iso14443_3a;
+    Iso14443_4aData iso14443_4a;
+    size_t apdu_cursor;
+    uint8_t mf_classic_sector;  // Sector of the authenticated session
+    MfClassicData mf_classic;   // Poller data: type, UID and the blocks read so far
+};
+
+static struct {
+    pthread_mutex_t mutex;
+    NfcReplayTag* tags[NFC_REPLAY_FIELD_MAX];
+    size_t count;
+    NfcReplayTiming timing;
+    uint32_t frames;
+} field = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .timing = {.detect_us = 30000, .activate_us = 5000, .frame_us = 1500},
+};
+
+static const NfcProtocol nfc_protocol_parents[NfcProtocolNum] = {
+    [NfcProtocolIso14443_3a] = NfcProtocolInvalid,
+    [NfcProtocolIso14443_3b] = NfcProtocolInvalid,
+    [NfcProtocolIso14443_4a] = NfcProtocolIso14443_3a,
+    [NfcProtocolIso14443_4b] = NfcProtocolIso14443_3b,
+    [NfcProtocolIso15693_3] = NfcProtocolInvalid,
+    [NfcProtocolFelica] = NfcProtocolInvalid,
+    [NfcProtocolMfUltralight] = NfcProtocolIso14443_3a,
+    [NfcProtocolMfClassic] = NfcProtocolIso14443_3a,
+    [NfcProtocolMfDesfire] = NfcProtocolIso14443_4a,
+    [NfcProtocolSlix] = NfcProtocolIso15693_3,
+    [NfcProtocolSt25tb] = NfcProtocolInvalid,
+};
+
+NfcProtocol nfc_protocol_get_parent(NfcProtocol protocol) {
+    furi_check(protocol < NfcProtocolNum);
+    return nfc_protocol_parents[protocol];
+}
+
+static bool nfc_replay_protocol_is(NfcProtocol protocol, NfcProtocol base) {
+    while(protocol != NfcProtocolInvalid) {
+        if(protocol == base) return true;
+        protocol = nfc_protocol_get_parent(protocol);
+    }
+    return false;
+}
+
+// Field
+
+static NfcReplayTiming nfc_replay_get_timing(void) {
+    pthread_mutex_lock(&field.mutex);
+    NfcReplayTiming timing = field.timing;
+    pthread_mutex_unlock(&field.mutex);
+    return timing;
+}
+
+static bool nfc_replay_field_has(const NfcReplayTag* tag) {
+    pthread_mutex_lock(&field.mutex);
+    bool found = false;
+    for(size_t i = 0; i < field.count && !found; i++) {
+        found = field.tags[i] == tag;
+    }
+    pthread_mutex_unlock(&field.mutex);
+    return found;
+}
+
+// First tag in the field speaking protocol that the poller has not halted
+static NfcReplayTag* nfc_replay_field_find(const NfcPoller* poller, NfcProtocol protocol) {
+    NfcReplayTag* found = NULL;
+    pthread_mutex_lock(&field.mutex);
+    for(size_t i = 0; i < field.count && !found; i++) {
+        NfcReplayTag* tag = field.tags[i];
+        bool halted = false;
+        for(size_t j = 0; poller && j < poller->halted_count && !halted; j++) {
+            halted = poller->halted[j] == tag;
+        }
+        if(!halted && nfc_replay_protocol_is(tag->protocol, protocol)) {
+            found = tag;
+        }
+    }
+    pthread_mutex_unlock(&field.mutex);
+    return found;
+}
+
+static void nfc_replay_count_frame(void) {
+    pthread_mutex_lock(&field.mutex);
+    field.frames++;
+    pthread_mutex_unlock(&field.mutex);
+}
+
+bool nfc_replay_field_add(NfcReplayTag* tag) {
+    furi_assert(tag);
+    pthread_mutex_lock(&field.mutex);
+    bool added = field.count < NFC_REPLAY_FIELD_MAX;
+    if(added) {
+        field.tags[field.count++] = tag;
+    }
+    pthread_mutex_unlock(&field.mutex);
+    return added;
+}
+
+void nfc_replay_field_clear(void) {
+    pthread_mutex_lock(&field.mutex);
+    field.count = 0;
+    pthread_mutex_unlock(&field.mutex);
+}
+
+void nfc_replay_set_timing(const NfcReplayTiming* timing) {
+    furi_assert(timing);
+    pthread_mutex_lock(&field.mutex);
+    field.timing = *timing;
+    pthread_mutex_unlock(&field.mutex);
+}
+
+uint32_t nfc_replay_take_frame_count(void) {
+    pthread_mutex_lock(&field.mutex);
+    uint32_t frames = field.frames;
+    field.frames = 0;
+    pthread_mutex_unlock(&field.mutex);
+    return frames;
+}
+
+// Sleep in short slices so stop requests are seen promptly
+// Returns false if running was cleared
+static bool nfc_replay_wait_us(uint32_t us, volatile bool* running) {
+    while(*running) {
+        uint32_t slice = MIN(us, (uint32_t)NFC_REPLAY_IDLE_US);
+        struct timespec ts = {.tv_sec = 0, .tv_nsec = (long)slice * 1000};
+        nanosleep(&ts, NULL);
+        us -= slice;
+        if(us == 0) break;
+    }
+    return *running;
+}
+
+// Dump loading
+
+// Parse "04 A1 B2" (spaces optional, "??" read as 00), returns the byte count
+static size_t nfc_replay_parse_hex(const char* text, uint8_t* out, size_t max) {
+    size_t count = 0;
+    while(*text && count < max) {
+        if(isspace((unsigned char)*text)) {
+            text++;
+            continue;
+        }
+        if(text[0] == '?' && text[1] == '?') {
+            out[count++] = 0;
+        } else if(isxdigit((unsigned char)text[0]) && isxdigit((unsigned char)text[1])) {
+            char byte[3] = {text[0], text[1], '\0'};
+            out[count++] = strtoul(byte, NULL, 16);
+        } else {
+            break;
+        }
+        text += 2;
+    }
+    return count;
+}
+
+static bool nfc_replay_read_hex(FlipperFormat* file, const char* key, uint8_t* out, size_t len, FuriString* value) {
+    return flipper_format_read_string(file, key, value) &&
+           nfc_replay_parse_hex(furi_string_get_cstr(value), out, len) == len;
+}
+
+static bool nfc_replay_read_number(FlipperFormat* file, const char* key, uint32_t* out, FuriString* value) {
+    if(!flipper_format_read_string(file, key, value)) return false;
+    char* end;
+    *out = strtoul(furi_string_get_cstr(value), &end, 10);
+    return end != furi_string_get_cstr(value);
+}
+
+static NfcProtocol nfc_replay_device_type(const char* name) {
+    static const struct {
+        const char* name;
+        NfcProtocol protocol;
+    } types[] = {
+        {"ISO14443-3A", NfcProtocolIso14443_3a},
+        {"ISO14443-4A", NfcProtocolIso14443_4a},
+        {"NTAG/Ultralight", NfcProtocolMfUltralight},
+        {"Mifare Classic", NfcProtocolMfClassic},
+        {"Mifare DESFire", NfcProtocolMfDesfire},
+        {"ISO15693-3", NfcProtocolIso15693_3},
+        {"SLIX", NfcProtocolSlix},
+    };
+    for(size_t i = 0; i < COUNT_OF(types); i++) {
+        if(strcmp(name, types[i].name) == 0) return types[i].protocol;
+    }
+    // Older dumps name the chip, e.g. "NTAG215" or "Mifare Ultralight 11"
+    if(strncmp(name, "NTAG", 4) == 0 || strncmp(name, "Mifare Ultralight", 17) == 0) {
+        return NfcProtocolMfUltralight;
+    }
+    return NfcProtocolInvalid;
+}
+
+static bool nfc_replay_load_iso14443_3a(NfcReplayTag* tag, FlipperFormat* file, FuriString* value) {
+    if(!flipper_format_read_string(file, "UID", value)) return false;
+    tag->iso14443_3a.uid_len =
+        nfc_replay_parse_hex(furi_string_get_cstr(value), tag->iso14443_3a.uid, ISO14443_3A_MAX_UID_SIZE);
+    if(tag->iso14443_3a.uid_len == 0) return false;
+
+    // ATQA and SAK are not used by the app, keep whatever the dump has
+    nfc_replay_read_hex(file, "ATQA", tag->iso14443_3a.atqa, 2, value);
+    nfc_replay_read_hex(file, "SAK", &tag->iso14443_3a.sak, 1, value);
+    return true;
+}
+
+static bool nfc_replay_load_apdu(NfcReplayTag* tag, FlipperFormat* file, FuriString* value) {
+    size_t capacity = 0;
+    flipper_format_rewind(file);
+    while(flipper_format_read_string(file, "C-APDU", value)) {
+        if(tag->apdu_count == capacity) {
+            capacity = capacity ? capacity * 2 : 8;
+            tag->apdu = realloc(tag->apdu, capacity * sizeof(NfcReplayApdu));
+        }
+        NfcReplayApdu* apdu = &tag->apdu[tag->apdu_count];
+        apdu->command_len =
+            nfc_replay_parse_hex(furi_string_get_cstr(value), apdu->command, NFC_REPLAY_APDU_MAX_LEN);
+        if(!flipper_format_read_string(file, "R-APDU", value)) {
+            FURI_LOG_E(TAG, "C-APDU without R-APDU");
+            return false;
+        }
+        apdu->response_len =
+            nfc_replay_parse_hex(furi_string_get_cstr(value), apdu->response, NFC_REPLAY_APDU_MAX_LEN);
+        tag->apdu_count++;
+    }
+    return true;
+}
+
+static bool nfc_replay_load_mf_ultralight(NfcReplayTag* tag, FlipperFormat* file, FuriString* value) {
+    MfUltralightData* data = malloc(sizeof(MfUltralightData));
+    memset(data, 0, sizeof(MfUltralightData));
+    data->iso14443_3a_data = &tag->iso14443_3a;
+    tag->mf_ultralight = data;
+
+    uint32_t pages_total = 0;
+    uint32_t pages_read = 0;
+    if(!nfc_replay_read_number(file, "Pages total", &pages_total, value) ||
+       !nfc_replay_read_number(file, "Pages read", &pages_read, value) ||
+       pages_total > MF_ULTRALIGHT_MAX_PAGE_NUM || pages_read > pages_total) {
+        FURI_LOG_E(TAG, "Bad page count");
+        return false;
+    }
+    data->pages_total = pages_total;
+    data->pages_read = pages_read;
+
+    for(uint32_t i = 0; i < pages_read; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "Page %u", i);
+        if(!nfc_replay_read_hex(file, key, data->page[i].data, MF_ULTRALIGHT_PAGE_SIZE, value)) {
+            FURI_LOG_E(TAG, "Missing %s", key);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool nfc_replay_load_mf_classic(NfcReplayTag* tag, FlipperFormat* file, FuriString* value) {
+    MfClassicData* data = malloc(sizeof(MfClassicData));
+    memset(data, 0, sizeof(MfClassicData));
+    data->iso14443_3a_data = &tag->iso14443_3a;
+    tag->mf_classic = data;
+
+    if(!flipper_format_read_string(file, "Mifare Classic type", value)) return false;
+    if(furi_string_cmp_str(value, "MINI") == 0) {
+        data->type = MfClassicTypeMini;
+    } else if(furi_string_cmp_str(value, "1K") == 0) {
+        data->type = MfClassicType1k;
+    } else if(furi_string_cmp_str(value, "4K") == 0) {
+        data->type = MfClassicType4k;
+    } else {
+        FURI_LOG_E(TAG, "Unknown Mifare Classic type %s", furi_string_get_cstr(value));
+        return false;
+    }
+
+    // Sector trailers hold the keys authentication is checked against, so
+    // every block is needed ("??" bytes, unread by the dumping reader, are 00)
+    uint8_t sectors = mf_classic_get_total_sectors_num(data->type);
+    uint16_t blocks = mf_classic_get_first_block_num_of_sector(sectors - 1) +
+                      mf_classic_get_blocks_num_in_sector(sectors - 1);
+    for(uint16_t i = 0; i < blocks; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "Block %u", i);
+        if(!nfc_replay_read_hex(file, key, data->block[i].data, MF_CLASSIC_BLOCK_SIZE, value)) {
+            FURI_LOG_E(TAG, "Missing %s", key);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool nfc_replay_load_iso15693_3(NfcReplayTag* tag, FlipperFormat* file, FuriString* value) {
+    Iso15693_3Data* data = &tag->iso15693_3;
+    Iso15693_3SystemInfo* info = &data->system_info;
+    uint32_t number = 0;
+
+    if(!nfc_replay_read_hex(file, "UID", data->uid, ISO15693_3_UID_SIZE, value)) return false;
+    nfc_replay_read_hex(file, "DSFID", &info->dsfid, 1, value);
+    nfc_replay_read_hex(file, "AFI", &info->afi, 1, value);
+    nfc_replay_read_hex(file, "IC Reference", &info->ic_ref, 1, value);
+    if(nfc_replay_read_number(file, "Block Count", &number, value)) {
+        info->block_count = number;
+    }
+    nfc_replay_read_hex(file, "Block Size", &info->block_size, 1, value);
+
+    size_t size = info->block_count * info->block_size;
+    data->block_data = simple_array_alloc_bytes();
+    simple_array_init(data->block_data, size);
+    if(size > 0 && !nfc_replay_read_hex(file, "Data Content", simple_array_get_data(data->block_data), size, value)) {
+        FURI_LOG_E(TAG, "Data Content does not match %u blocks of %u bytes", info->block_count, info->block_size);
+        return false;
+    }
+    return true;
+}
+
+NfcReplayTag* nfc_replay_tag_load(const char* path) {
+    furi_assert(path);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* value = furi_string_alloc();
+    NfcReplayTag* tag = malloc(sizeof(NfcReplayTag));
+    memset(tag, 0, sizeof(NfcReplayTag));
+    bool success = false;
+
+    do {
+        uint32_t version = 0;
+        if(!flipper_format_file_open_existing(file, path) ||
+           !flipper_format_read_header(file, value, &version) ||
+           furi_string_cmp_str(value, "Flipper NFC device") != 0) {
+            FURI_LOG_E(TAG, "%s is not a Flipper NFC device file", path);
+            break;
+        }
+        if(!flipper_format_read_string(file, "Device type", value)) break;
+        tag->protocol = nfc_replay_device_type(furi_string_get_cstr(value));
+        if(tag->protocol == NfcProtocolInvalid) {
+            FURI_LOG_E(TAG, "Unsupported device type %s", furi_string_get_cstr(value));
+            break;
+        }
+
+        if(nfc_replay_protocol_is(tag->protocol, NfcProtocolIso15693_3)) {
+            success = nfc_replay_load_iso15693_3(tag, file, value);
+            break;
+        }
+        if(!nfc_replay_load_iso14443_3a(tag, file, value)) break;
+        if(tag->protocol == NfcProtocolMfUltralight) {
+            success = nfc_replay_load_mf_ultralight(tag, file, value);
+        } else if(tag->protocol == NfcProtocolMfClassic) {
+            success = nfc_replay_load_mf_classic(tag, file, value);
+        } else if(nfc_replay_protocol_is(tag->protocol, NfcProtocolIso14443_4a)) {
+            success = nfc_replay_load_apdu(tag, file, value);
+        } else {
+            success = true;
+        }
+    } while(false);
+
+    furi_string_free(value);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    if(!success) {
+        nfc_replay_tag_free(tag);
+        return NULL;
+    }
+    return tag;
+}
+
+void nfc_replay_tag_free(NfcReplayTag* tag) {
+    furi_assert(tag);
+    furi_assert(!nfc_replay_field_has(tag));
+    if(tag->iso15693_3.block_data) {
+        simple_array_free(tag->iso15693_3.block_data);
+    }
+    free(tag->mf_ultralight);
+    free(tag->mf_classic);
+    free(tag->apdu);
+    free(tag);
+}
+
+NfcProtocol nfc_replay_tag_get_protocol(const NfcReplayTag* tag) {
+    furi_assert(tag);
+    return tag->protocol;
+}
+
+// Nfc
+
+Nfc* nfc_alloc(void) {
+    return malloc(sizeof(Nfc));
+}
+
+void nfc_free(Nfc* instance) {
+    furi_assert(instance);
+    free(instance);
+}
+
+// Scanner: reports the first tag in the field once, then waits to be stopped
+
+static void* nfc_scanner_thread(void* context) {
+    NfcScanner* instance = context;
+
+    while(instance->running) {
+        NfcReplayTag* tag = nfc_replay_field_find(NULL, NfcProtocolIso14443_3a);
+        if(!tag) tag = nfc_replay_field_find(NULL, NfcProtocolIso15693_3);
+        if(!tag) {
+            nfc_replay_wait_us(NFC_REPLAY_IDLE_US, &instance->running);
+            continue;
+        }
+
+        if(!nfc_replay_wait_us(nfc_replay_get_timing().detect_us, &instance->running)) break;
+        if(!nfc_replay_field_has(tag)) continue;
+
+        NfcProtocol protocol = tag->protocol;
+        NfcScannerEvent event = {
+            .type = NfcScannerEventTypeDetected,
+            .data = {.protocol_num = 1, .protocols = &protocol},
+        };
+        instance->callback(event, instance->context);
+        while(nfc_replay_wait_us(NFC_REPLAY_IDLE_US, &instance->running)) {
+        }
+    }
+    return NULL;
+}
+
+NfcScanner* nfc_scanner_alloc(Nfc* nfc) {
+    furi_assert(nfc);
+    NfcScanner* instance = malloc(sizeof(NfcScanner));
+    memset(instance, 0, sizeof(NfcScanner));
+    return instance;
+}
+
+void nfc_scanner_free(NfcScanner* instance) {
+    furi_assert(instance);
+    furi_assert(!instance->started);
+    free(instance);
+}
+
+void nfc_scanner_start(NfcScanner* instance, NfcScannerCallback callback, void* context) {
+    furi_assert(instance);
+    furi_assert(!instance->started);
+    instance->callback = callback;
+    instance->context = context;
+    instance->running = true;
+    instance->started = pthread_create(&instance->thread, NULL, nfc_scanner_thread, instance) == 0;
+    furi_check(instance->started);
+}
+
+void nfc_scanner_stop(NfcScanner* instance) {
+    furi_assert(instance);
+    if(!instance->started) return;
+    instance->running = false;
+    pthread_join(instance->thread, NULL);
+    instance->started = false;
+}
+
+// Pollers
+
+static NfcCommand nfc_poller_notify(NfcPoller* instance, NfcProtocol protocol, void* event_data) {
+    NfcGenericEvent event = {
+        .protocol = protocol,
+        .instance = instance,
+        .event_data = event_data,
+    };
+    return instance->callback(event, instance->context);
+}
+
+// Wait one frame, false if the poller was stopped or its tag left the field
+static bool nfc_poller_frame(NfcPoller* instance) {
+    if(!nfc_replay_wait_us(nfc_replay_get_timing().frame_us, &instance->running)) return false;
+    nfc_replay_count_frame();
+    return instance->tag && nfc_replay_field_has(instance->tag);
+}
+
+static void nfc_poller_run_iso14443_3a(NfcPoller* instance) {
+    Iso14443_3aPollerEventData data = {.error = Iso14443_3aErrorNone};
+    Iso14443_3aPollerEvent event = {.data = &data};
+
+    while(instance->running) {
+        instance->tag = nfc_replay_field_find(instance, NfcProtocolIso14443_3a);
+        if(!nfc_replay_wait_us(nfc_replay_get_timing().activate_us, &instance->running)) break;
+
+        if(instance->tag) {
+            instance->iso14443_3a = instance->tag->iso14443_3a;
+            event.type = Iso14443_3aPollerEventTypeReady;
+        } else {
+            data.error = Iso14443_3aErrorTimeout;
+            event.type = Iso14443_3aPollerEventTypeError;
+        }
+        if(nfc_poller_notify(instance, NfcProtocolIso14443_3a, &event) == NfcCommandStop) break;
+    }
+}
+
+static void nfc_poller_run_iso14443_4a(NfcPoller* instance) {
+    Iso14443_4aPollerEventData data = {.error = Iso14443_4aErrorNone};
+    Iso14443_4aPollerEvent event = {.data = &data};
+
+    while(instance->running) {
+        instance->tag = nfc_replay_field_find(instance, NfcProtocolIso14443_4a);
+        if(!nfc_replay_wait_us(nfc_replay_get_timing().activate_us, &instance->running)) break;
+
+        if(instance->tag) {
+            instance->iso14443_3a = instance->tag->iso14443_3a;
+            instance->iso14443_4a.iso14443_3a_data = &instance->iso14443_3a;
+            instance->apdu_cursor = 0;
+            event.type = Iso14443_4aPollerEventTypeReady;
+        } else {
+            data.error = Iso14443_4aErrorTimeout;
+            event.type = Iso14443_4aPollerEventTypeError;
+        }
+        if(nfc_poller_notify(instance, NfcProtocolIso14443_4a, &event) == NfcCommandStop) break;
+    }
+}
+
+static void nfc_poller_run_mf_ultralight(NfcPoller* instance) {
+    MfUltralightPollerEventData data = {.poller_mode = MfUltralightPollerModeRead};
+    MfUltralightPollerEvent event = {.data = &data};
+
+    while(instance->running) {
+        instance->tag = nfc_replay_field_find(instance, NfcProtocolMfUltralight);
+        if(!nfc_replay_wait_us(nfc_replay_get_timing().activate_us, &instance->running)) break;
+
+        if(instance->tag) {
+            event.type = MfUltralightPollerEventTypeRequestMode;
+            if(nfc_poller_notify(instance, NfcProtocolMfUltralight, &event) == NfcCommandStop) break;
+
+            // READ returns 4 pages per frame
+            bool read = true;
+            for(uint16_t page = 0; page < instance->tag->mf_ultralight->pages_read && read; page += 4) {
+                read = nfc_poller_frame(instance);
+            }
+            if(!instance->running) break;
+            event.type = read ? MfUltralightPollerEventTypeReadSuccess :
+                                MfUltralightPollerEventTypeReadFailed;
+        } else {
+            event.type = MfUltralightPollerEventTypeReadFailed;
+        }
+        if(nfc_poller_notify(instance, NfcProtocolMfUltralight, &event) == NfcCommandStop) break;
+    }
+}
+
+static void nfc_poller_run_iso15693_3(NfcPoller* instance) {
+    Iso15693_3PollerEventData data = {.error = Iso15693_3ErrorNone};
+    Iso15693_3PollerEvent event = {.data = &data};
+
+    while(instance->running) {
+        instance->tag = nfc_replay_field_find(instance, NfcProtocolIso15693_3);
+        if(!nfc_replay_wait_us(nfc_replay_get_timing().activate_us, &instance->running)) break;
+
+        // Get System Info, then one Read Single Block per block
+        bool read = instance->tag != NULL;
+        uint32_t frames = read ? 1 + instance->tag->iso15693_3.system_info.block_count : 0;
+        for(uint32_t i = 0; i < frames && read; i++) {
+            read = nfc_poller_frame(instance);
+        }
+        if(!instance->running) break;
+
+        if(read) {
+            event.type = Iso15693_3PollerEventTypeReady;
+        } else {
+            data.error = Iso15693_3ErrorTimeout;
+            event.type = Iso15693_3PollerEventTypeError;
+        }
+        if(nfc_poller_notify(instance, NfcProtocolIso15693_3, &event) == NfcCommandStop) break;
+    }
+}
+
+// The firmware poller's read mode: the state survives Continue and Reset, only
+// the card is selected again, so RequestMode comes once per poller start. Each
+// step below is one handler run of the firmware poller
+typedef enum {
+    NfcReplayMfClassicStateStart,
+    NfcReplayMfClassicStateRequestReadSector,
+    NfcReplayMfClassicStateReadSectorBlocks,
+    NfcReplayMfClassicStateSuccess,
+} NfcReplayMfClassicState;
+
+static void nfc_poller_run_mf_classic(NfcPoller* instance) {
+    MfClassicPollerEventData data;
+    MfClassicPollerEvent event = {.data = &data};
+    MfClassicPollerEventDataReadSectorRequest request = {0};
+    NfcReplayMfClassicState state = NfcReplayMfClassicStateStart;
+    uint8_t block = 0;
+    bool auth_passed = false;
+    bool selected = false;
+    bool detected = false;
+
+    while(instance->running) {
+        if(!selected) {
+            instance->tag = nfc_replay_field_find(instance, NfcProtocolMfClassic);
+            instance->mf_classic_sector = MF_CLASSIC_NO_SECTOR;
+            if(!nfc_replay_wait_us(nfc_replay_get_timing().activate_us, &instance->running)) break;
+            if(!instance->tag) {
+                memset(&data, 0, sizeof(data));
+                data.error = MfClassicErrorNotPresent;
+                event.type = detected ? MfClassicPollerEventTypeCardLost : MfClassicPollerEventTypeFail;
+                if(nfc_poller_notify(instance, NfcProtocolMfClassic, &event) == NfcCommandStop) break;
+                continue;
+            }
+            if(!detected) {
+                instance->iso14443_3a = instance->tag->iso14443_3a;
+                memset(&instance->mf_classic, 0, sizeof(MfClassicData));
+                instance->mf_classic.iso14443_3a_data = &instance->iso14443_3a;
+                instance->mf_classic.type = instance->tag->mf_classic->type;
+                detected = true;
+            }
+            selected = true;
+        }
+
+        NfcCommand command = NfcCommandContinue;
+        switch(state) {
+        case NfcReplayMfClassicStateStart:
+            memset(&data, 0, sizeof(data));
+            data.poller_mode.mode = MfClassicPollerModeRead;
+            event.type = MfClassicPollerEventTypeRequestMode;
+            command = nfc_poller_notify(instance, NfcProtocolMfClassic, &event);
+            state = NfcReplayMfClassicStateRequestReadSector;
+            break;
+        case NfcReplayMfClassicStateRequestReadSector:
+            memset(&data, 0, sizeof(data));
+            event.type = MfClassicPollerEventTypeRequestReadSector;
+            command = nfc_poller_notify(instance, NfcProtocolMfClassic, &event);
+            request = data.read_sector_request_data;
+            if(!request.key_provided) {
+                state = NfcReplayMfClassicStateSuccess;
+            } else {
+                block = mf_classic_get_first_block_num_of_sector(request.sector_num);
+                auth_passed = false;
+                state = NfcReplayMfClassicStateReadSectorBlocks;
+            }
+            break;
+        case NfcReplayMfClassicStateReadSectorBlocks: {
+            // One block per step: authenticate if needed, then read it
+            MfClassicError error = MfClassicErrorNone;
+            if(!auth_passed) {
+                error = mf_classic_poller_auth(
+                    (MfClassicPoller*)instance, block, &request.key, request.key_type, NULL, false);
+                // A failed AUTH leaves the card idle, it is selected again
+                if(error != MfClassicErrorNone) selected = false;
+                auth_passed = error == MfClassicErrorNone;
+            }
+            if(error == MfClassicErrorNone) {
+                MfClassicBlock block_data;
+                if(mf_classic_poller_read_block((MfClassicPoller*)instance, block, &block_data) ==
+                   MfClassicErrorNone) {
+                    mf_classic_set_block_read(&instance->mf_classic, block, &block_data);
+                } else {
+                    mf_classic_poller_halt((MfClassicPoller*)instance);
+                    auth_passed = false;
+                }
+            }
+            uint8_t trailer = mf_classic_get_first_block_num_of_sector(request.sector_num) +
+                              mf_classic_get_blocks_num_in_sector(request.sector_num) - 1;
+            if(++block > trailer) {
+                mf_classic_poller_halt((MfClassicPoller*)instance);
+                state = NfcReplayMfClassicStateRequestReadSector;
+            }
+            break;
+        }
+        case NfcReplayMfClassicStateSuccess:
+            memset(&data, 0, sizeof(data));
+            event.type = MfClassicPollerEventTypeSuccess;
+            command = nfc_poller_notify(instance, NfcProtocolMfClassic, &event);
+            break;
+        }
+
+        if(command == NfcCommandStop) break;
+        if(command == NfcCommandReset) selected = false;
+        if(instance->tag && !nfc_replay_field_has(instance->tag)) selected = false;
+    }
+}
+
+static void* nfc_poller_thread(void* context) {
+    NfcPoller* instance = context;
+
+    switch(instance->protocol) {
+    case NfcProtocolIso14443_3a:
+        nfc_poller_run_iso14443_3a(instance);
+        break;
+    case NfcProtocolIso14443_4a:
+        nfc_poller_run_iso14443_4a(instance);
+        break;
+    case NfcProtocolMfUltralight:
+        nfc_poller_run_mf_ultralight(instance);
+        break;
+    case NfcProtocolIso15693_3:
+        nfc_poller_run_iso15693_3(instance);
+        break;
+    case NfcProtocolMfClassic:
+        nfc_poller_run_mf_classic(instance);
+        break;
+    default:
+        FURI_LOG_E(TAG, "No replay poller for protocol %d", instance->protocol);
+        break;
+    }
+
+    // Like the firmware, a stopped poller stays alive until nfc_poller_stop()
+    while(nfc_replay_wait_us(NFC_REPLAY_IDLE_US, &instance->running)) {
+    }
+    return NULL;
+}
+
+NfcPoller* nfc_poller_alloc(Nfc* nfc, NfcProtocol protocol) {
+    furi_assert(nfc);
+    NfcPoller* instance = malloc(sizeof(NfcPoller));
+    memset(instance, 0, sizeof(NfcPoller));
+    instance->protocol = protocol;
+    return instance;
+}
+
+void nfc_poller_free(NfcPoller* instance) {
+    furi_assert(instance);
+    furi_assert(!instance->started);
+    free(instance);
+}
+
+void nfc_poller_start(NfcPoller* instance, NfcGenericCallback callback, void* context) {
+    furi_assert(instance);
+    furi_assert(!instance->started);
+    instance->callback = callback;
+    instance->context = context;
+    instance->running = true;
+    instance->started = pthread_create(&instance->thread, NULL, nfc_poller_thread, instance) == 0;
+    furi_check(instance->started);
+}
+
+void nfc_poller_stop(NfcPoller* instance) {
+    furi_assert(instance);
+    if(!instance->started) return;
+    instance->running = false;
+    pthread_join(instance->thread, NULL);
+    instance->started = false;
+}
+
+const void* nfc_poller_get_data(const NfcPoller* instance) {
+    furi_assert(instance);
+    switch(instance->protocol) {
+    case NfcProtocolIso14443_3a:
+        return &instance->iso14443_3a;
+    case NfcProtocolIso14443_4a:
+        return &instance->iso14443_4a;
+    case NfcProtocolMfUltralight:
+        return instance->tag ? instance->tag->mf_ultralight : NULL;
+    case NfcProtocolIso15693_3:
+        return instance->tag ? &instance->tag->iso15693_3 : NULL;
+    case NfcProtocolMfClassic:
+        return &instance->mf_classic;
+    default:
+        return NULL;
+    }
+}
+
+// ISO14443-3A: every activation halts the selected tag and selects the next one
+
+Iso14443_3aError iso14443_3a_poller_halt(Iso14443_3aPoller* instance) {
+    NfcPoller* poller = (NfcPoller*)instance;
+    if(poller->tag && poller->halted_count < NFC_REPLAY_FIELD_MAX) {
+        poller->halted[poller->halted_count++] = poller->tag;
+    }
+    poller->tag = NULL;
+    return Iso14443_3aErrorNone;
+}
+
+Iso14443_3aError iso14443_3a_poller_activate(Iso14443_3aPoller* instance, Iso14443_3aData* iso14443_3a_data) {
+    NfcPoller* poller = (NfcPoller*)instance;
+    iso14443_3a_poller_halt(instance);
+
+    if(!nfc_replay_wait_us(nfc_replay_get_timing().activate_us, &poller->running)) {
+        return Iso14443_3aErrorFieldOff;
+    }
+    poller->tag = nfc_replay_field_find(poller, NfcProtocolIso14443_3a);
+    if(!poller->tag) return Iso14443_3aErrorTimeout;
+
+    poller->iso14443_3a = poller->tag->iso14443_3a;
+    *iso14443_3a_data = poller->iso14443_3a;
+    return Iso14443_3aErrorNone;
+}
+
+// ISO14443-4A: responses come from the transcript, searched from the last match on
+
+Iso14443_4aError iso14443_4a_poller_send_block(
+    Iso14443_4aPoller* instance,
+    const BitBuffer* tx_buffer,
+    BitBuffer* rx_buffer) {
+    NfcPoller* poller = (NfcPoller*)instance;
+    if(!nfc_poller_frame(poller)) return Iso14443_4aErrorTimeout;
+
+    const NfcReplayTag* tag = poller->tag;
+    const uint8_t* command = bit_buffer_get_data(tx_buffer);
+    size_t command_len = bit_buffer_get_size_bytes(tx_buffer);
+
+    for(size_t n = 0; n < tag->apdu_count; n++) {
+        size_t i = (poller->apdu_cursor + n) % tag->apdu_count;
+        const NfcReplayApdu* apdu = &tag->apdu[i];
+        if(apdu->command_len == command_len && memcmp(apdu->command, command, command_len) == 0) {
+            bit_buffer_copy_bytes(rx_buffer, apdu->response, apdu->response_len);
+            poller->apdu_cursor = i + 1;
+            return Iso14443_4aErrorNone;
+        }
+    }
+
+    static const uint8_t not_found[] = {0x6A, 0x82};
+    bit_buffer_copy_bytes(rx_buffer, not_found, sizeof(not_found));
+    return Iso14443_4aErrorNone;
+}
+
+// ISO15693-3: single-slot Inventory, every tag matching the mask answers
+
+Iso15693_3Error iso15693_3_poller_send_frame(
+    Iso15693_3Poller* instance,
+    const BitBuffer* tx_buffer,
+    BitBuffer* rx_buffer,
+    uint32_t fwt) {
+    UNUSED(fwt);
+    NfcPoller* poller = (NfcPoller*)instance;
+    if(!nfc_replay_wait_us(nfc_replay_get_timing().frame_us, &poller->running)) {
+        return Iso15693_3ErrorFieldOff;
+    }
+    nfc_replay_count_frame();
+
+    size_t tx_len = bit_buffer_get_size_bytes(tx_buffer);
+    if(tx_len < 3 || bit_buffer_get_byte(tx_buffer, 1) != ISO15693_CMD_INVENTORY) {
+        return Iso15693_3ErrorNotSupported;
+    }
+    uint8_t mask_len = bit_buffer_get_byte(tx_buffer, 2);
+    uint64_t mask = 0;
+    for(size_t i = 0; i < (size_t)(mask_len + 7) / 8 && 3 + i < tx_len; i++) {
+        mask |= (uint64_t)bit_buffer_get_byte(tx_buffer, 3 + i) << (8 * i);
+    }
+    uint64_t mask_bits = mask_len >= 64 ? UINT64_MAX : (1ULL << mask_len) - 1;
+
+    size_t answers = 0;
+    const Iso15693_3Data* answer = NULL;
+    pthread_mutex_lock(&field.mutex);
+    for(size_t i = 0; i < field.count; i++) {
+        const NfcReplayTag* tag = field.tags[i];
+        if(!nfc_replay_protocol_is(tag->protocol, NfcProtocolIso15693_3)) continue;
+        // The mask is compared against the UID least significant byte first
+        uint64_t uid = 0;
+        for(size_t j = 0; j < ISO15693_3_UID_SIZE; j++) {
+            uid |= (uint64_t)tag->iso15693_3.uid[ISO15693_3_UID_SIZE - 1 - j] << (8 * j);
+        }
+        if((uid & mask_bits) == (mask & mask_bits)) {
+            answers++;
+            answer = &tag->iso15693_3;
+        }
+    }
+
+    Iso15693_3Error error = Iso15693_3ErrorNone;
+    if(answers == 0) {
+        error = Iso15693_3ErrorTimeout;
+    } else if(answers > 1) {
+        error = Iso15693_3ErrorWrongCrc;
+    } else {
+        bit_buffer_reset(rx_buffer);
+        bit_buffer_append_byte(rx_buffer, 0x00);
+        bit_buffer_append_byte(rx_buffer, answer->system_info.dsfid);
+        for(size_t j = 0; j < ISO15693_3_UID_SIZE; j++) {
+            bit_buffer_append_byte(rx_buffer, answer->uid[ISO15693_3_UID_SIZE - 1 - j]);
+        }
+    }
+    pthread_mutex_unlock(&field.mutex);
+    return error;
+}
+
+// MIFARE Classic: keys are checked against the dump's sector trailers, no
+// Crypto1; access bits are not enforced, either key reads every data block
+
+uint8_t mf_classic_get_total_sectors_num(MfClassicType type) {
+    static const uint8_t sectors[MfClassicTypeNum] = {
+        [MfClassicTypeMini] = 5,
+        [MfClassicType1k] = 16,
+        [MfClassicType4k] = 40,
+    };
+    return type < MfClassicTypeNum ? sectors[type] : 0;
+}
+
+uint8_t mf_classic_get_first_block_num_of_sector(uint8_t sector) {
+    return sector < 32 ? sector * 4 : 128 + (sector - 32) * 16;
+}
+
+uint8_t mf_classic_get_blocks_num_in_sector(uint8_t sector) {
+    return sector < 32 ? 4 : 16;
+}
+
+static uint8_t mf_classic_get_sector_by_block(uint8_t block_num) {
+    return block_num < 128 ? block_num / 4 : 32 + (block_num - 128) / 16;
+}
+
+MfClassicError mf_classic_poller_auth(
+    MfClassicPoller* instance,
+    uint8_t block_num,
+    MfClassicKey* key,
+    MfClassicKeyType key_type,
+    MfClassicAuthContext* data,
+    bool backdoor_auth) {
+    UNUSED(backdoor_auth);
+    NfcPoller* poller = (NfcPoller*)instance;
+    poller->mf_classic_sector = MF_CLASSIC_NO_SECTOR;
+    for(size_t i = 0; i < MF_CLASSIC_AUTH_FRAMES; i++) {
+        if(!nfc_poller_frame(poller)) return MfClassicErrorNotPresent;
+    }
+
+    uint8_t sector = mf_classic_get_sector_by_block(block_num);
+    uint8_t trailer = mf_classic_get_first_block_num_of_sector(sector) +
+                      mf_classic_get_blocks_num_in_sector(sector) - 1;
+    const uint8_t* trailer_data = poller->tag->mf_classic->block[trailer].data;
+    const uint8_t* expected = key_type == MfClassicKeyTypeA ? trailer_data : trailer_data + 10;
+    if(memcmp(key->data, expected, MF_CLASSIC_KEY_SIZE) != 0) {
+        return MfClassicErrorAuth;
+    }
+
+    if(data) {
+        memset(data, 0, sizeof(MfClassicAuthContext));
+        data->block_num = block_num;
+        data->key = *key;
+        data->key_type = key_type;
+    }
+    poller->mf_classic_sector = sector;
+    return MfClassicErrorNone;
+}
+
+MfClassicError mf_classic_poller_read_block(MfClassicPoller* instance, uint8_t block_num, MfClassicBlock* data) {
+    NfcPoller* poller = (NfcPoller*)instance;
+    if(!nfc_poller_frame(poller)) return MfClassicErrorNotPresent;
+    if(poller->mf_classic_sector != mf_classic_get_sector_by_block(block_num)) {
+        return MfClassicErrorProtocol;
+    }
+    *data = poller->tag->mf_classic->block[block_num];
+    return MfClassicErrorNone;
+}
+
+bool mf_classic_is_block_read(const MfClassicData* data, uint8_t block_num) {
+    return data->block_read_mask[block_num / 32] & (1UL << (block_num % 32));
+}
+
+void mf_classic_set_block_read(MfClassicData* data, uint8_t block_num, MfClassicBlock* block_data) {
+    data->block[block_num] = *block_data;
+    data->block_read_mask[block_num / 32] |= 1UL << (block_num % 32);
+}
+
+MfClassicError mf_classic_poller_halt(MfClassicPoller* instance) {
+    NfcPoller* poller = (NfcPoller*)instance;
+    poller->mf_classic_sector = MF_CLASSIC_NO_SECTOR;
+    return MfClassicErrorNone;
+}
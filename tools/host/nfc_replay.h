@@ -0,0 +1,81 @@
+#pragma once
+
+// NFC replay backend
+//
+// Implements the nfc.h, nfc_scanner.h and nfc_poller.h stand-ins on top of a
+// simulated field holding tags loaded from dump files. The scanner and the
+// pollers run on their own threads and call the same callbacks, with the same
+// event sequence, as the firmware NFC stack:
+//   scanner   Detected with the tag's protocol (e.g. MfDesfire, parent ISO14443-4A)
+//   3A        Ready, then iso14443_3a_poller_activate()/halt() walk the field
+//   4A        Ready, then iso14443_4a_poller_send_block() answers from the transcript
+//   Ultralight RequestMode, then ReadSuccess with every page of the dump
+//   Classic   RequestMode on every selection (again after Continue or Reset),
+//             then mf_classic_poller_auth()/read_block() against the dump's
+//             blocks, keys checked against its sector trailers
+//   15693     Ready with system info and blocks, iso15693_3_poller_send_frame()
+//             answers Inventory requests from every ISO15693 tag in the field
+// Every step waits for the configured radio time, so a read takes about as
+// long as on the air.
+//
+// Dumps are Flipper .nfc files (ISO14443-3A, ISO14443-4A, NTAG/Ultralight,
+// Mifare Classic, Mifare DESFire, ISO15693-3, SLIX). ISO14443-4A and DESFire
+// dumps may carry an APDU transcript as "C-APDU:"/"R-APDU:" line pairs;
+// commands without a matching pair are answered with 6A 82 (not found).
+
+#include <nfc/nfc.h>
+
+#define NFC_REPLAY_FIELD_MAX 64  // Tags in the field at once
+
+typedef struct NfcReplayTag NfcReplayTag;
+
+// Simulated radio time, in microseconds
+typedef struct {
+    uint32_t detect_us;    // Tag entering the field until the scanner reports it
+    uint32_t activate_us;  // Anticollision and select (plus RATS for ISO14443-4A)
+    uint32_t frame_us;     // Each command/response exchange after activation
+} NfcReplayTiming;
+
+/** Load a tag from a dump file
+ *
+ * @param path Path to a .nfc file
+ * @return NfcReplayTag instance, NULL if the file could not be used
+ */
+NfcReplayTag* nfc_replay_tag_load(const char* path);
+
+/** Free a tag, it must not be in the field
+ *
+ * @param tag NfcReplayTag instance
+ */
+void nfc_replay_tag_free(NfcReplayTag* tag);
+
+/** Get the protocol the scanner reports for a tag
+ *
+ * @param tag NfcReplayTag instance
+ * @return Protocol
+ */
+NfcProtocol nfc_replay_tag_get_protocol(const NfcReplayTag* tag);
+
+/** Put a tag in the field
+ *
+ * @param tag NfcReplayTag instance
+ * @return false if the field is full
+ */
+bool nfc_replay_field_add(NfcReplayTag* tag);
+
+/** Take every tag out of the field
+ * A read in progress fails at its next frame, like a tag pulled away.
+ */
+void nfc_replay_field_clear(void);
+
+/** Set the simulated radio time
+ *
+ * @param timing Timing, copied
+ */
+void nfc_replay_set_timing(const NfcReplayTiming* timing);
+
+/** Get the number of frames exchanged since the last call
+ *
+ * @return Frame count
+ */
+uint32_t nfc_replay_take_frame_count(void);
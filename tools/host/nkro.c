@@ -0,0 +1,188 @@
+// Host test for the NKRO report batching
+//
+// Each case packs a string into reports with helpers/flipper_wedge_nkro_batch.c
+// as the NKRO typing path does (a press report per batch, then an all-up
+// report) and decodes them the way a host keyboard driver does: the keys set
+// in a report and not in the previous one are pressed in usage order, with the
+// report's modifiers. The decoded key presses must be the keycodes of the
+// typeable characters in their original order, with no key pressed twice in
+// one report. Cases run in report protocol (up to 32 keys per report, as
+// flipper_wedge_hid.c caps it) and boot protocol (6 keys).
+// Exit code is non-zero on any failure.
+
+#include <furi.h>
+
+#include "flipper_wedge_nkro_batch.h"
+
+#ifndef BENCH_LAYOUT_PATH
+#define BENCH_LAYOUT_PATH "../../assets/layouts/azerty_fr.txt"
+#endif
+
+#define NKRO_TEST_TEXT_MAX 512
+#define NKRO_TEST_REPORT_KEYS 32  // HID_NKRO_BATCH_MAX in flipper_wedge_hid.c
+#define NKRO_TEST_BOOT_KEYS 6
+#define NKRO_TEST_RANDOM_CASES 2000
+
+typedef struct {
+    uint8_t modifiers;
+    uint8_t bitmap[FLIPPER_WEDGE_NKRO_BITMAP_SIZE];
+} NkroTestReport;
+
+typedef struct {
+    uint16_t presses[NKRO_TEST_TEXT_MAX];
+    size_t press_count;
+    size_t report_count;
+    bool repeated;  // A key was pressed twice in one report
+} NkroTestHost;
+
+static uint32_t failures = 0;
+static uint32_t passes = 0;
+
+// What a host driver reports for one incoming report
+static void nkro_host_receive(NkroTestHost* host, const NkroTestReport* previous, const NkroTestReport* report) {
+    host->report_count++;
+    for(uint16_t usage = 0; usage <= FLIPPER_WEDGE_NKRO_MAX_USAGE; usage++) {
+        bool down = report->bitmap[usage / 8] & (1 << (usage % 8));
+        bool was_down = previous->bitmap[usage / 8] & (1 << (usage % 8));
+        if(down && !was_down && host->press_count < NKRO_TEST_TEXT_MAX) {
+            host->presses[host->press_count++] = (report->modifiers << 8) | usage;
+        }
+    }
+}
+
+// Type text as flipper_wedge_hid_type_string_nkro() does, non-ASCII bytes skipped
+static void nkro_type(FlipperWedgeKeyboardLayout* layout, const char* text, size_t max_keys, NkroTestHost* host) {
+    uint8_t keys[NKRO_TEST_REPORT_KEYS];
+    NkroTestReport up = {0};
+    NkroTestReport press;
+
+    memset(host, 0, sizeof(*host));
+    while(*text) {
+        uint8_t modifiers;
+        size_t count = flipper_wedge_nkro_batch_next(layout, &text, max_keys, &modifiers, keys);
+        if(count == 0) {
+            if(*text) text++;
+            continue;
+        }
+
+        for(size_t i = 0; i < count; i++) {
+            for(size_t j = 0; j < i; j++) {
+                if(keys[i] == keys[j]) host->repeated = true;
+            }
+        }
+        press.modifiers = modifiers;
+        flipper_wedge_nkro_batch_bitmap(keys, count, press.bitmap);
+        nkro_host_receive(host, &up, &press);
+        nkro_host_receive(host, &press, &up);
+    }
+}
+
+static size_t nkro_expected(FlipperWedgeKeyboardLayout* layout, const char* text, uint16_t* keycodes) {
+    size_t count = 0;
+    for(; *text; text++) {
+        if((uint8_t)*text >= 0x80) continue;
+        uint16_t keycode = layout ? flipper_wedge_keyboard_layout_get_keycode(layout, *text) :
+                                    HID_ASCII_TO_KEY(*text);
+        if(keycode == HID_KEYBOARD_NONE || (keycode & 0xFF) > FLIPPER_WEDGE_NKRO_MAX_USAGE) continue;
+        keycodes[count++] = keycode;
+    }
+    return count;
+}
+
+static void nkro_format(const uint16_t* keycodes, size_t count, char* out, size_t size) {
+    size_t len = 0;
+    out[0] = '\0';
+    for(size_t i = 0; i < count && len + 7 < size; i++) {
+        len += snprintf(&out[len], size - len, "%s%02x:%02x", i ? " " : "", keycodes[i] >> 8, keycodes[i] & 0xFF);
+    }
+}
+
+static bool nkro_check(FlipperWedgeKeyboardLayout* layout, const char* name, const char* text, size_t max_keys, bool print) {
+    uint16_t expected[NKRO_TEST_TEXT_MAX];
+    size_t expected_count = nkro_expected(layout, text, expected);
+    NkroTestHost host;
+    nkro_type(layout, text, max_keys, &host);
+
+    bool ok = !host.repeated && host.press_count == expected_count &&
+              memcmp(host.presses, expected, expected_count * sizeof(uint16_t)) == 0;
+    if(!ok) {
+        char expected_text[NKRO_TEST_TEXT_MAX * 6];
+        char got_text[NKRO_TEST_TEXT_MAX * 6];
+        nkro_format(expected, expected_count, expected_text, sizeof(expected_text));
+        nkro_format(host.presses, host.press_count, got_text, sizeof(got_text));
+        printf(
+            "FAIL %s (%zu keys/report)%s\n  expected: %s\n  got:      %s\n",
+            name,
+            max_keys,
+            host.repeated ? " key repeated in a report" : "",
+            expected_text,
+            got_text);
+        failures++;
+    } else if(print) {
+        // Against a 6KRO keyboard: a press and a release report per character
+        printf(
+            "ok   %-24s %2zu keys/report: %3zu reports for %3zu keys (6KRO %3zu)\n",
+            name,
+            max_keys,
+            host.report_count,
+            expected_count,
+            expected_count * 2);
+        passes++;
+    }
+    return ok;
+}
+
+static void nkro_check_both(FlipperWedgeKeyboardLayout* layout, const char* name, const char* text) {
+    nkro_check(layout, name, text, NKRO_TEST_REPORT_KEYS, true);
+    nkro_check(layout, name, text, NKRO_TEST_BOOT_KEYS, true);
+}
+
+// Printable ASCII with runs that ascend, descend and repeat
+static void nkro_check_random(FlipperWedgeKeyboardLayout* layout, const char* name) {
+    char text[64];
+    uint32_t seed = 0x5EED;
+    uint32_t failed_before = failures;
+
+    for(uint32_t i = 0; i < NKRO_TEST_RANDOM_CASES; i++) {
+        size_t len = 1 + i % (sizeof(text) - 1);
+        for(size_t c = 0; c < len; c++) {
+            seed = seed * 1103515245 + 12345;
+            text[c] = 0x20 + (seed >> 16) % 95;
+        }
+        text[len] = '\0';
+        if(!nkro_check(layout, name, text, i % 2 ? NKRO_TEST_BOOT_KEYS : NKRO_TEST_REPORT_KEYS, false)) {
+            printf("  text:     \"%s\"\n", text);
+            break;
+        }
+    }
+    if(failures == failed_before) {
+        printf("ok   %-24s %u strings\n", name, NKRO_TEST_RANDOM_CASES);
+        passes++;
+    }
+}
+
+int main(void) {
+    nkro_check_both(NULL, "hex_uid", "04A1B2C3D4E5F6");
+    nkro_check_both(NULL, "hex_uid_delimited", "04:A1:B2:C3:D4:E5:F6");
+    nkro_check_both(NULL, "ascending_run", "abcdefghijklmnopqrstuvwxyz0123456789");
+    nkro_check_both(NULL, "descending_run", "zyxwvutsrqponmlkjihgfedcba");
+    nkro_check_both(NULL, "repeated_keys", "aabbccddeeff1122");
+    nkro_check_both(NULL, "shift_changes", "Hello from Flipper Wedge");
+    nkro_check_both(NULL, "control_chars", "line one\nline\ttwo\n");
+    nkro_check_both(NULL, "non_ascii_skipped", "Caf\xc3\xa9 cr\xc3\xa8me");
+    nkro_check_random(NULL, "random_qwerty");
+
+    FlipperWedgeKeyboardLayout* azerty = flipper_wedge_keyboard_layout_alloc();
+    if(flipper_wedge_keyboard_layout_load(azerty, BENCH_LAYOUT_PATH)) {
+        nkro_check_both(azerty, "hex_uid_azerty", "04A1B2C3D4E5F6");
+        nkro_check_both(azerty, "text_azerty", "Hello from Flipper Wedge");
+        nkro_check_random(azerty, "random_azerty");
+    } else {
+        printf("FAIL layout_azerty\n  could not load %s\n", BENCH_LAYOUT_PATH);
+        failures++;
+    }
+    flipper_wedge_keyboard_layout_free(azerty);
+
+    printf("%lu passed, %lu failed\n", (unsigned long)passes, (unsigned long)failures);
+    return failures > 0 ? 1 : 0;
+}
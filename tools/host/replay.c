@@ -0,0 +1,516 @@
+// Host NFC replay for the Flipper Wedge reader
+//
+// Runs helpers/flipper_wedge_nfc.c unchanged against the NFC replay backend:
+// each dump is put in the simulated field, the reader is ticked like the start
+// screen does, and the result is printed one line per read on stdout (stable,
+// for diffing against a previous run). Timing goes to stderr, including the
+// reader stages of helpers/flipper_wedge_latency.c (detect, poller start, read,
+// callback) over every read.
+//
+//   replay [options] DUMP...
+//     --ndef          read NDEF text (NDEF mode) instead of the UID only
+//     --stream        deliver NDEF text in chunks while the tag is read
+//     --inventory     put every dump in the field and read them in one inventory
+//     --presence MS   put every dump in the field and run presence rounds for MS
+//     --repeat N      read each dump N times (default 1)
+//     --hold N        leave up to N reads in a scan queue that is never drained,
+//                     as reads wait while a long scan is output; prints every read
+//     --tick-ms N     reader tick period (default 100, the app's tick)
+//     --feedback P    hold the reader after each read as feedback profile P
+//                     (standard or fast) does, and report scans per minute
+//     --classic S     read MIFARE Classic sector S as the tag's text, each dump
+//                     --repeat times with a cold key cache, then as many warm
+//     --classic-keys F   key set file for --classic (default: built-in keys)
+//     --detect-us N, --activate-us N, --frame-us N   simulated radio time
+
+#include <furi.h>
+#include <time.h>
+
+#include "nfc_replay.h"
+#include "flipper_wedge_nfc.h"
+#include "flipper_wedge_iso15693.h"
+#include "flipper_wedge_format.h"
+#include "flipper_wedge_latency.h"
+#include "flipper_wedge_feedback.h"
+#include "flipper_wedge_classic_keys.h"
+#include "flipper_wedge_scan_queue.h"
+
+#define REPLAY_TICK_MS_DEFAULT 100
+#define REPLAY_READ_TIMEOUT_MS 5000
+#define REPLAY_TEXT_MAX 4096
+#define REPLAY_PRESENCE_MAX 256
+#define REPLAY_CLASSIC_CACHE_PATH HOST_STORAGE_ROOT "/replay_classic_keys.cache"
+
+typedef struct {
+    FlipperWedgeLatency* latency;
+    FlipperWedgeScanQueue* held;  // --hold: reads waiting for output, NULL otherwise
+    bool done;
+    FlipperWedgeNfcData data;  // Copy without the NDEF buffer
+    char text[REPLAY_TEXT_MAX];
+    size_t text_len;
+    uint64_t first_output_ns;  // First NDEF chunk or the result, 0 until then
+} ReplayRead;
+
+typedef struct {
+    bool ndef;
+    bool stream;
+    bool inventory;
+    uint32_t presence_ms;
+    uint32_t repeat;
+    uint32_t hold;
+    uint32_t tick_ms;
+    bool feedback;
+    FlipperWedgeFeedbackProfile feedback_profile;
+    bool classic;
+    uint8_t classic_sector;
+    const char* classic_keys_path;
+} ReplayOptions;
+
+typedef struct {
+    double min_ms;
+    double max_ms;
+    double total_ms;
+    uint32_t count;
+} ReplayStat;
+
+static uint64_t replay_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void replay_stat_add(ReplayStat* stat, double ms) {
+    if(stat->count == 0 || ms < stat->min_ms) stat->min_ms = ms;
+    if(stat->count == 0 || ms > stat->max_ms) stat->max_ms = ms;
+    stat->total_ms += ms;
+    stat->count++;
+}
+
+static void replay_text_append(ReplayRead* read, const char* text) {
+    size_t len = strlen(text);
+    if(read->text_len + len >= sizeof(read->text)) {
+        len = sizeof(read->text) - read->text_len - 1;
+    }
+    memcpy(read->text + read->text_len, text, len);
+    read->text_len += len;
+    read->text[read->text_len] = '\0';
+}
+
+static void replay_nfc_callback(FlipperWedgeNfcData* data, void* context) {
+    ReplayRead* read = context;
+
+    flipper_wedge_latency_mark(read->latency, FlipperWedgeLatencyStageCallback);
+    if(read->held) {
+        // Holds its own NDEF buffer reference, like a read the scene has not taken yet
+        FlipperWedgeScanRecord record;
+        flipper_wedge_scan_record_from_nfc(&record, data);
+        flipper_wedge_scan_queue_put(read->held, &record, 0);
+    }
+    read->data = *data;
+    read->data.ndef = NULL;
+    if(data->has_ndef && !data->ndef_streamed && data->ndef) {
+        replay_text_append(read, flipper_wedge_scan_buffer_data(data->ndef));
+    }
+    if(read->first_output_ns == 0) {
+        read->first_output_ns = replay_now_ns();
+    }
+    read->done = true;
+}
+
+static void replay_drain_stream(FlipperWedgeNfc* nfc, ReplayRead* read) {
+    FlipperWedgeScanBuffer* chunk;
+
+    while(flipper_wedge_nfc_stream_pending(nfc) &&
+          (chunk = flipper_wedge_nfc_stream_next(nfc, FLIPPER_WEDGE_NDEF_STREAM_WAIT_MS))) {
+        if(read->first_output_ns == 0) {
+            read->first_output_ns = replay_now_ns();
+        }
+        replay_text_append(read, flipper_wedge_scan_buffer_data(chunk));
+        flipper_wedge_scan_buffer_unref(chunk);
+    }
+}
+
+static void replay_print_uid(const uint8_t* uid, uint8_t uid_len) {
+    char uid_text[FLIPPER_WEDGE_NFC_UID_MAX_LEN * 3 + 1];
+    flipper_wedge_format_uid(uid, uid_len, ":", uid_text, sizeof(uid_text));
+    printf("%s", uid_text);
+}
+
+static void replay_print_read(const char* name, const ReplayRead* read, const ReplayOptions* options) {
+    printf("%s ", name);
+    if(!read->done) {
+        printf("timeout\n");
+        return;
+    }
+
+    if(options->inventory) {
+        printf("inventory:%u", read->data.inventory_count);
+        for(uint8_t i = 0; i < read->data.inventory_count; i++) {
+            printf(" ");
+            replay_print_uid(read->data.inventory[i].uid, read->data.inventory[i].uid_len);
+        }
+    } else {
+        replay_print_uid(read->data.uid, read->data.uid_len);
+    }
+    if(read->data.has_ndef) {
+        printf(" ndef:\"%s\"", read->text);
+    }
+    if(read->data.error != FlipperWedgeNfcErrorNone) {
+        printf(" error:%d", read->data.error);
+    }
+    printf("\n");
+}
+
+// One read with the given tags in the field, as the start screen runs it
+static bool replay_read(
+    FlipperWedgeNfc* nfc,
+    NfcReplayTag** tags,
+    size_t tag_count,
+    const ReplayOptions* options,
+    ReplayRead* read,
+    ReplayStat* first_stat,
+    ReplayStat* done_stat) {
+    FlipperWedgeLatency* latency = read->latency;
+    FlipperWedgeScanQueue* held = read->held;
+    memset(read, 0, sizeof(*read));
+    read->latency = latency;
+    read->held = held;
+    flipper_wedge_nfc_set_callback(nfc, replay_nfc_callback, read);
+    flipper_wedge_nfc_start(nfc, options->ndef);
+
+    uint64_t start_ns = replay_now_ns();
+    for(size_t i = 0; i < tag_count; i++) {
+        nfc_replay_field_add(tags[i]);
+    }
+
+    while(!read->done && replay_now_ns() - start_ns < REPLAY_READ_TIMEOUT_MS * 1000000ULL) {
+        furi_delay_ms(options->tick_ms);
+        replay_drain_stream(nfc, read);
+        flipper_wedge_nfc_tick(nfc);
+    }
+    // The callback can land between ticks with text still queued
+    replay_drain_stream(nfc, read);
+
+    if(read->done) {
+        replay_stat_add(first_stat, (read->first_output_ns - start_ns) / 1e6);
+        replay_stat_add(done_stat, (replay_now_ns() - start_ns) / 1e6);
+    }
+
+    flipper_wedge_nfc_stop(nfc);
+    nfc_replay_field_clear();
+    if(read->done && options->feedback) {
+        // The printed line stands for the output, then the feedback gate holds the reader
+        flipper_wedge_latency_mark(latency, FlipperWedgeLatencyStageFormat);
+        furi_delay_ms(flipper_wedge_feedback_gate_ms(flipper_wedge_feedback_get_timeline(
+            options->feedback_profile, FlipperWedgeFeedbackOutcomeSent)));
+    }
+    flipper_wedge_latency_mark(latency, FlipperWedgeLatencyStageRearm);
+    return read->done;
+}
+
+static void replay_print_stat(const char* name, const ReplayStat* first, const ReplayStat* done) {
+    if(done->count == 0) return;
+    fflush(stdout);
+    fprintf(
+        stderr,
+        "%-24s first output %7.1f ms (min %.1f max %.1f), complete %7.1f ms (min %.1f max %.1f), "
+        "%lu frames/read\n",
+        name,
+        first->total_ms / first->count,
+        first->min_ms,
+        first->max_ms,
+        done->total_ms / done->count,
+        done->min_ms,
+        done->max_ms,
+        (unsigned long)(nfc_replay_take_frame_count() / done->count));
+}
+
+// Reader stages as the Statistics scene shows them, over every read
+static void replay_print_stages(FlipperWedgeLatency* latency) {
+    FlipperWedgeLatencyStats stats;
+    for(int stage = 0; stage < FlipperWedgeLatencyStageCount; stage++) {
+        flipper_wedge_latency_get_stage(latency, stage, &stats);
+        if(stats.count == 0) continue;
+        fprintf(
+            stderr,
+            "stage %-18s n=%-4lu p50 %8.1f p95 %8.1f p99 %8.1f max %8.1f ms\n",
+            flipper_wedge_latency_stage_name(stage),
+            (unsigned long)stats.count,
+            stats.p50_us / 1000.0,
+            stats.p95_us / 1000.0,
+            stats.p99_us / 1000.0,
+            stats.max_us / 1000.0);
+    }
+}
+
+// Read to re-arm time under the feedback profile, as the Statistics scene shows it
+static void replay_print_cycle(FlipperWedgeLatency* latency, const ReplayOptions* options) {
+    FlipperWedgeLatencyStats stats;
+    flipper_wedge_latency_get_cycle(latency, &stats);
+    if(stats.count == 0) return;
+    fprintf(
+        stderr,
+        "cycle %-18s n=%-4lu p50 %8.1f p95 %8.1f max %8.1f ms, %lu scans/min\n",
+        flipper_wedge_feedback_profile_name(options->feedback_profile),
+        (unsigned long)stats.count,
+        stats.p50_us / 1000.0,
+        stats.p95_us / 1000.0,
+        stats.max_us / 1000.0,
+        (unsigned long)flipper_wedge_latency_scans_per_minute(&stats));
+}
+
+static int replay_compare_uid(const void* a, const void* b) {
+    uint64_t ua = *(const uint64_t*)a;
+    uint64_t ub = *(const uint64_t*)b;
+    return (ua > ub) - (ua < ub);
+}
+
+static void replay_presence(
+    FlipperWedgeNfc* nfc,
+    NfcReplayTag** tags,
+    size_t tag_count,
+    const ReplayOptions* options) {
+    uint32_t duration_ms = options->presence_ms;
+    uint64_t seen[REPLAY_PRESENCE_MAX];
+    size_t seen_count = 0;
+    uint32_t reports = 0;
+
+    flipper_wedge_nfc_set_presence(nfc, true);
+    flipper_wedge_nfc_start(nfc, false);
+    for(size_t i = 0; i < tag_count; i++) {
+        nfc_replay_field_add(tags[i]);
+    }
+
+    uint64_t start_ns = replay_now_ns();
+    while(replay_now_ns() - start_ns < duration_ms * 1000000ULL) {
+        furi_delay_ms(options->tick_ms);
+        flipper_wedge_nfc_tick(nfc);
+
+        uint64_t uid;
+        while(flipper_wedge_nfc_presence_next(nfc, &uid)) {
+            reports++;
+            bool known = false;
+            for(size_t i = 0; i < seen_count; i++) {
+                if(seen[i] == uid) known = true;
+            }
+            if(!known && seen_count < REPLAY_PRESENCE_MAX) {
+                seen[seen_count++] = uid;
+            }
+        }
+    }
+
+    flipper_wedge_nfc_stop(nfc);
+    nfc_replay_field_clear();
+    flipper_wedge_nfc_set_presence(nfc, false);
+
+    qsort(seen, seen_count, sizeof(seen[0]), replay_compare_uid);
+    printf("presence:%zu", seen_count);
+    for(size_t i = 0; i < seen_count; i++) {
+        uint8_t bytes[FLIPPER_WEDGE_ISO15693_UID_LEN];
+        flipper_wedge_iso15693_uid_to_bytes(seen[i], bytes);
+        printf(" ");
+        replay_print_uid(bytes, sizeof(bytes));
+    }
+    printf("\n");
+    fflush(stdout);
+    fprintf(
+        stderr,
+        "presence                 %lu reports in %lu ms, %lu frames\n",
+        (unsigned long)reports,
+        (unsigned long)duration_ms,
+        (unsigned long)nfc_replay_take_frame_count());
+}
+
+// Classic reads: the cache is cleared before every cold read, so each one
+// walks the key set, then the warm reads start from the key the last one found
+static bool replay_classic(
+    FlipperWedgeNfc* nfc,
+    FlipperWedgeClassicKeys* keys,
+    NfcReplayTag* tag,
+    const char* name,
+    const ReplayOptions* options,
+    ReplayRead* read) {
+    static const char* passes[] = {"cold", "warm"};
+    bool success = true;
+
+    for(size_t pass = 0; pass < COUNT_OF(passes); pass++) {
+        ReplayStat first = {0}, done = {0};
+        FlipperWedgeClassicKeysStats stats;
+        flipper_wedge_classic_keys_get_stats(keys, &stats, true);
+        nfc_replay_take_frame_count();
+
+        for(uint32_t r = 0; r < options->repeat; r++) {
+            if(pass == 0) flipper_wedge_classic_keys_clear_cache(keys);
+            if(!replay_read(nfc, &tag, 1, options, read, &first, &done)) success = false;
+            if(r == 0) replay_print_read(name, read, options);
+        }
+
+        flipper_wedge_classic_keys_get_stats(keys, &stats, true);
+        char stat_name[48];
+        snprintf(stat_name, sizeof(stat_name), "%s %s", name, passes[pass]);
+        uint32_t frames = nfc_replay_take_frame_count();
+        fflush(stdout);
+        fprintf(
+            stderr,
+            "%-24s complete %7.1f ms (min %.1f max %.1f), %5.2f reads/s, "
+            "%.1f auths/read, %lu/%lu cache hits, %lu frames/read\n",
+            stat_name,
+            done.count ? done.total_ms / done.count : 0.0,
+            done.min_ms,
+            done.max_ms,
+            done.total_ms > 0 ? done.count * 1000.0 / done.total_ms : 0.0,
+            stats.walks ? (double)stats.attempts / stats.walks : 0.0,
+            (unsigned long)stats.hits,
+            (unsigned long)stats.walks,
+            (unsigned long)(done.count ? frames / done.count : 0));
+    }
+    return success;
+}
+
+static const char* replay_basename(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+static void replay_usage(void) {
+    fprintf(
+        stderr,
+        "usage: replay [--ndef] [--stream] [--inventory] [--presence MS] [--repeat N] [--hold N]\n"
+        "              [--tick-ms N] [--feedback standard|fast]\n"
+        "              [--classic SECTOR] [--classic-keys FILE]\n"
+        "              [--detect-us N] [--activate-us N] [--frame-us N] DUMP...\n");
+}
+
+int main(int argc, char** argv) {
+    ReplayOptions options = {.repeat = 1, .tick_ms = REPLAY_TICK_MS_DEFAULT};
+    NfcReplayTiming timing = {.detect_us = 30000, .activate_us = 5000, .frame_us = 1500};
+    NfcReplayTag* tags[NFC_REPLAY_FIELD_MAX];
+    const char* names[NFC_REPLAY_FIELD_MAX];
+    size_t tag_count = 0;
+    int status = 0;
+
+    for(int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if(strcmp(arg, "--ndef") == 0) {
+            options.ndef = true;
+        } else if(strcmp(arg, "--stream") == 0) {
+            options.ndef = true;
+            options.stream = true;
+        } else if(strcmp(arg, "--inventory") == 0) {
+            options.inventory = true;
+        } else if(strcmp(arg, "--presence") == 0 && has_value) {
+            options.presence_ms = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(arg, "--repeat") == 0 && has_value) {
+            options.repeat = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(arg, "--hold") == 0 && has_value) {
+            options.hold = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(arg, "--tick-ms") == 0 && has_value) {
+            options.tick_ms = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(arg, "--feedback") == 0 && has_value) {
+            const char* profile = argv[++i];
+            options.feedback = true;
+            if(strcmp(profile, "standard") == 0) {
+                options.feedback_profile = FlipperWedgeFeedbackProfileStandard;
+            } else if(strcmp(profile, "fast") == 0) {
+                options.feedback_profile = FlipperWedgeFeedbackProfileThroughput;
+            } else {
+                replay_usage();
+                return 2;
+            }
+        } else if(strcmp(arg, "--classic") == 0 && has_value) {
+            options.classic = true;
+            options.classic_sector = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(arg, "--classic-keys") == 0 && has_value) {
+            options.classic_keys_path = argv[++i];
+        } else if(strcmp(arg, "--detect-us") == 0 && has_value) {
+            timing.detect_us = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(arg, "--activate-us") == 0 && has_value) {
+            timing.activate_us = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(arg, "--frame-us") == 0 && has_value) {
+            timing.frame_us = strtoul(argv[++i], NULL, 10);
+        } else if(arg[0] == '-') {
+            replay_usage();
+            return 2;
+        } else if(tag_count < NFC_REPLAY_FIELD_MAX) {
+            tags[tag_count] = nfc_replay_tag_load(arg);
+            if(!tags[tag_count]) {
+                fprintf(stderr, "%s: not a usable NFC dump\n", arg);
+                status = 1;
+                continue;
+            }
+            names[tag_count++] = replay_basename(arg);
+        }
+    }
+    if(tag_count == 0 || options.repeat == 0 || options.tick_ms == 0) {
+        replay_usage();
+        return 2;
+    }
+
+    nfc_replay_set_timing(&timing);
+
+    FlipperWedgeNfc* nfc = flipper_wedge_nfc_alloc();
+    flipper_wedge_nfc_set_ndef_stream(nfc, options.stream);
+    flipper_wedge_nfc_set_inventory(nfc, options.inventory);
+
+    FlipperWedgeLatency* latency = flipper_wedge_latency_alloc();
+    flipper_wedge_nfc_set_latency(nfc, latency);
+
+    ReplayRead* read = malloc(sizeof(ReplayRead));
+    read->latency = latency;
+    read->held = options.hold ? flipper_wedge_scan_queue_alloc(options.hold) : NULL;
+
+    FlipperWedgeClassicKeys* classic_keys = NULL;
+    if(options.classic) {
+        classic_keys = flipper_wedge_classic_keys_alloc();
+        // Without --classic-keys the missing file keeps the built-in keys
+        size_t key_count = flipper_wedge_classic_keys_load(
+            classic_keys,
+            options.classic_keys_path ? options.classic_keys_path : "",
+            REPLAY_CLASSIC_CACHE_PATH);
+        fprintf(stderr, "classic sector %u, %zu keys\n", options.classic_sector, key_count);
+        flipper_wedge_nfc_set_classic(nfc, classic_keys, options.classic_sector);
+    }
+
+    if(options.presence_ms) {
+        replay_presence(nfc, tags, tag_count, &options);
+    } else if(options.inventory) {
+        ReplayStat first = {0}, done = {0};
+        for(uint32_t r = 0; r < options.repeat; r++) {
+            if(!replay_read(nfc, tags, tag_count, &options, read, &first, &done)) status = 1;
+            if(r == 0) replay_print_read("field", read, &options);
+        }
+        replay_print_stat("field", &first, &done);
+    } else if(options.classic) {
+        for(size_t t = 0; t < tag_count; t++) {
+            if(!replay_classic(nfc, classic_keys, tags[t], names[t], &options, read)) status = 1;
+        }
+    } else {
+        for(size_t t = 0; t < tag_count; t++) {
+            ReplayStat first = {0}, done = {0};
+            nfc_replay_take_frame_count();
+            for(uint32_t r = 0; r < options.repeat; r++) {
+                if(!replay_read(nfc, &tags[t], 1, &options, read, &first, &done)) status = 1;
+                if(r == 0 || options.hold) replay_print_read(names[t], read, &options);
+            }
+            replay_print_stat(names[t], &first, &done);
+        }
+    }
+
+    if(!options.presence_ms) {
+        replay_print_stages(latency);
+        replay_print_cycle(latency, &options);
+    }
+
+    if(read->held) flipper_wedge_scan_queue_free(read->held);
+    free(read);
+    flipper_wedge_nfc_free(nfc);
+    if(classic_keys) flipper_wedge_classic_keys_free(classic_keys);
+    flipper_wedge_latency_free(latency);
+    for(size_t i = 0; i < tag_count; i++) {
+        nfc_replay_tag_free(tags[i]);
+    }
+
+    return status;
+}
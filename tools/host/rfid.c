@@ -0,0 +1,173 @@
+// Host test vectors for the LF decoder table
+//
+// Each vector is a raw frame as it comes off the air: EM4100 as its 64-bit
+// frame (9 header ones, 10 rows of 4 data bits and even parity, 4 column
+// parity bits, stop bit), H10301 as its 26-bit Wiegand word (even parity,
+// 8-bit facility, 16-bit card, odd parity). The frame is checked and turned
+// into the protocol data the firmware demodulator reports, then decoded with
+// helpers/flipper_wedge_rfid_decode.c and compared with the number, facility
+// code and card number printed on the card. Frames with a flipped bit must be
+// rejected, and data too short or of a protocol without a decoder must give
+// no fields. Exit code is non-zero on any failure.
+
+#include <furi.h>
+#include <inttypes.h>
+
+#include "flipper_wedge_rfid_decode.h"
+
+#define EM4100_FRAME_BITS 64
+#define EM4100_DATA_SIZE 5
+#define H10301_FRAME_BITS 26
+#define H10301_DATA_SIZE 3
+
+typedef struct {
+    const char* name;
+    ProtocolId protocol;
+    uint64_t frame;
+    const char* number;  // NULL if the protocol has none
+    uint32_t facility;
+    uint32_t card;
+} RfidVector;
+
+static const RfidVector rfid_vectors[] = {
+    // Fob printed 0012345678, version byte 01
+    {"em4100_0012345678", LFRFIDProtocolEM4100, 0xFF806005F0C1A7B6ULL, "0012345678", 188, 24910},
+    {"em4100_max_id", LFRFIDProtocolEM4100, 0xFF801EF7BDEF7BC0ULL, "4294967295", 255, 65535},
+    {"em4100_version_1a", LFRFIDProtocolEM4100, 0xFF8E800000000074ULL, "0000000001", 0, 1},
+    {"h10301_1_1", LFRFIDProtocolH10301, 0x2020002, NULL, 1, 1},
+    {"h10301_123_4567", LFRFIDProtocolH10301, 0x2F623AE, NULL, 123, 4567},
+    {"h10301_255_65535", LFRFIDProtocolH10301, 0x1FFFFFF, NULL, 255, 65535},
+    {"h10301_0_0", LFRFIDProtocolH10301, 0x0000001, NULL, 0, 0},
+};
+
+static uint32_t failures = 0;
+static uint32_t passes = 0;
+
+static void rfid_check(const char* name, bool ok, const char* expected, const char* got) {
+    if(ok) {
+        printf("ok   %s\n", name);
+        passes++;
+    } else {
+        printf("FAIL %s\n  expected: %s\n  got:      %s\n", name, expected, got);
+        failures++;
+    }
+}
+
+static uint8_t rfid_frame_bit(uint64_t frame, size_t bits, size_t index) {
+    return (frame >> (bits - 1 - index)) & 1;
+}
+
+static bool rfid_em4100_data(uint64_t frame, uint8_t* data) {
+    for(size_t i = 0; i < 9; i++) {
+        if(!rfid_frame_bit(frame, EM4100_FRAME_BITS, i)) return false;
+    }
+    if(rfid_frame_bit(frame, EM4100_FRAME_BITS, EM4100_FRAME_BITS - 1)) return false;
+
+    uint64_t value = 0;
+    uint8_t columns[4] = {0};
+    for(size_t row = 0; row < 10; row++) {
+        uint8_t parity = 0;
+        for(size_t column = 0; column < 4; column++) {
+            uint8_t bit = rfid_frame_bit(frame, EM4100_FRAME_BITS, 9 + row * 5 + column);
+            value = (value << 1) | bit;
+            parity ^= bit;
+            columns[column] ^= bit;
+        }
+        if(parity != rfid_frame_bit(frame, EM4100_FRAME_BITS, 9 + row * 5 + 4)) return false;
+    }
+    for(size_t column = 0; column < 4; column++) {
+        if(columns[column] != rfid_frame_bit(frame, EM4100_FRAME_BITS, 59 + column)) return false;
+    }
+
+    for(size_t i = 0; i < EM4100_DATA_SIZE; i++) {
+        data[i] = value >> (8 * (EM4100_DATA_SIZE - 1 - i));
+    }
+    return true;
+}
+
+static bool rfid_h10301_data(uint64_t frame, uint8_t* data) {
+    uint8_t even = 0;
+    uint8_t odd = 0;
+    for(size_t i = 0; i < 13; i++) even ^= rfid_frame_bit(frame, H10301_FRAME_BITS, i);
+    for(size_t i = 13; i < H10301_FRAME_BITS; i++) odd ^= rfid_frame_bit(frame, H10301_FRAME_BITS, i);
+    if(even != 0 || odd != 1) return false;
+
+    uint32_t value = (frame >> 1) & 0xFFFFFF;
+    data[0] = value >> 16;
+    data[1] = value >> 8;
+    data[2] = value;
+    return true;
+}
+
+static bool rfid_frame_data(const RfidVector* vector, uint64_t frame, uint8_t* data, size_t* data_size) {
+    if(vector->protocol == LFRFIDProtocolEM4100) {
+        *data_size = EM4100_DATA_SIZE;
+        return rfid_em4100_data(frame, data);
+    }
+    *data_size = H10301_DATA_SIZE;
+    return rfid_h10301_data(frame, data);
+}
+
+static void rfid_check_vector(const RfidVector* vector) {
+    uint8_t data[EM4100_DATA_SIZE];
+    size_t data_size;
+    char expected[64];
+    char got[64];
+
+    uint8_t fields = FlipperWedgeRfidFieldFacility | FlipperWedgeRfidFieldCard;
+    if(vector->number) fields |= FlipperWedgeRfidFieldNumber;
+    snprintf(
+        expected,
+        sizeof(expected),
+        "%s fc %" PRIu32 " card %" PRIu32 " fields %02x",
+        vector->number ? vector->number : "-",
+        vector->facility,
+        vector->card,
+        fields);
+
+    if(!rfid_frame_data(vector, vector->frame, data, &data_size)) {
+        rfid_check(vector->name, false, expected, "frame rejected");
+        return;
+    }
+    FlipperWedgeRfidDecoded decoded;
+    flipper_wedge_rfid_decode(vector->protocol, data, data_size, &decoded);
+    snprintf(
+        got,
+        sizeof(got),
+        "%s fc %" PRIu32 " card %" PRIu32 " fields %02x",
+        (decoded.fields & FlipperWedgeRfidFieldNumber) ? decoded.number : "-",
+        decoded.facility,
+        decoded.card,
+        decoded.fields);
+    rfid_check(vector->name, strcmp(expected, got) == 0, expected, got);
+
+    // Any single flipped bit breaks a parity (or the EM4100 header/stop bit)
+    size_t bits = vector->protocol == LFRFIDProtocolEM4100 ? EM4100_FRAME_BITS : H10301_FRAME_BITS;
+    size_t accepted = 0;
+    for(size_t bit = 0; bit < bits; bit++) {
+        if(rfid_frame_data(vector, vector->frame ^ (1ULL << bit), data, &data_size)) accepted++;
+    }
+    snprintf(got, sizeof(got), "%zu flipped frames accepted", accepted);
+    char name[64];
+    snprintf(name, sizeof(name), "%s_bit_flips", vector->name);
+    rfid_check(name, accepted == 0, "0 flipped frames accepted", got);
+}
+
+int main(void) {
+    for(size_t i = 0; i < COUNT_OF(rfid_vectors); i++) {
+        rfid_check_vector(&rfid_vectors[i]);
+    }
+
+    // Data the table must not decode
+    const uint8_t short_em4100[] = {0x01, 0x00, 0xBC, 0x61};
+    FlipperWedgeRfidDecoded decoded;
+    flipper_wedge_rfid_decode(LFRFIDProtocolEM4100, short_em4100, sizeof(short_em4100), &decoded);
+    rfid_check("em4100_short_data", decoded.fields == 0, "no fields", "decoded");
+
+    const uint8_t indala[] = {0x12, 0x34, 0x56, 0x78};
+    flipper_wedge_rfid_decode(LFRFIDProtocolIndala26, indala, sizeof(indala), &decoded);
+    rfid_check("no_decoder", decoded.fields == 0, "no fields", "decoded");
+
+    printf("%lu passed, %lu failed\n", (unsigned long)passes, (unsigned long)failures);
+    return failures > 0 ? 1 : 0;
+}
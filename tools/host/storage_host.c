@@ -0,0 +1,202 @@
+#include <storage/storage.h>
+
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+struct File {
+    FILE* stream;
+    DIR* dir;
+    char dir_path[256];
+};
+
+File* storage_file_alloc(Storage* storage) {
+    UNUSED(storage);
+    File* file = malloc(sizeof(File));
+    file->stream = NULL;
+    file->dir = NULL;
+    return file;
+}
+
+void storage_file_free(File* file) {
+    furi_assert(file);
+    storage_file_close(file);
+    storage_dir_close(file);
+    free(file);
+}
+
+bool storage_file_open(File* file, const char* path, FS_AccessMode access_mode, FS_OpenMode open_mode) {
+    furi_assert(file);
+    storage_file_close(file);
+
+    bool write = access_mode & FSAM_WRITE;
+    bool read = access_mode & FSAM_READ;
+    const char* mode = NULL;
+
+    switch(open_mode) {
+    case FSOM_OPEN_EXISTING:
+        mode = write ? "r+b" : "rb";
+        break;
+    case FSOM_OPEN_ALWAYS:
+        file->stream = fopen(path, write ? "r+b" : "rb");
+        mode = write ? "w+b" : NULL;
+        break;
+    case FSOM_OPEN_APPEND:
+        mode = read ? "a+b" : "ab";
+        break;
+    case FSOM_CREATE_NEW:
+        mode = read ? "w+bx" : "wbx";
+        break;
+    case FSOM_CREATE_ALWAYS:
+        mode = read ? "w+b" : "wb";
+        break;
+    }
+
+    if(!file->stream && mode) {
+        file->stream = fopen(path, mode);
+    }
+    return file->stream != NULL;
+}
+
+bool storage_file_close(File* file) {
+    furi_assert(file);
+    if(!file->stream) return false;
+    fclose(file->stream);
+    file->stream = NULL;
+    return true;
+}
+
+size_t storage_file_read(File* file, void* buff, size_t bytes_to_read) {
+    if(!file->stream) return 0;
+    return fread(buff, 1, bytes_to_read, file->stream);
+}
+
+size_t storage_file_write(File* file, const void* buff, size_t bytes_to_write) {
+    if(!file->stream) return 0;
+    return fwrite(buff, 1, bytes_to_write, file->stream);
+}
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    if(!file->stream) return false;
+    return fseek(file->stream, offset, from_start ? SEEK_SET : SEEK_CUR) == 0;
+}
+
+uint64_t storage_file_tell(File* file) {
+    if(!file->stream) return 0;
+    return ftell(file->stream);
+}
+
+uint64_t storage_file_size(File* file) {
+    if(!file->stream) return 0;
+    struct stat st;
+    fflush(file->stream);
+    if(fstat(fileno(file->stream), &st) != 0) return 0;
+    return st.st_size;
+}
+
+bool storage_file_sync(File* file) {
+    if(!file->stream) return false;
+    return fflush(file->stream) == 0;
+}
+
+bool storage_file_eof(File* file) {
+    if(!file->stream) return true;
+    return storage_file_tell(file) >= storage_file_size(file);
+}
+
+bool storage_file_exists(Storage* storage, const char* path) {
+    FileInfo info;
+    return storage_common_stat(storage, path, &info) == FSE_OK && !(info.flags & FSF_DIRECTORY);
+}
+
+bool storage_dir_open(File* file, const char* path) {
+    furi_assert(file);
+    storage_dir_close(file);
+    file->dir = opendir(path);
+    snprintf(file->dir_path, sizeof(file->dir_path), "%s", path);
+    return file->dir != NULL;
+}
+
+bool storage_dir_close(File* file) {
+    furi_assert(file);
+    if(!file->dir) return false;
+    closedir(file->dir);
+    file->dir = NULL;
+    return true;
+}
+
+bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length) {
+    if(!file->dir) return false;
+
+    struct dirent* entry;
+    while((entry = readdir(file->dir)) != NULL) {
+        if(strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", file->dir_path, entry->d_name);
+        if(fileinfo) {
+            storage_common_stat(NULL, path, fileinfo);
+        }
+        if(name) {
+            snprintf(name, name_length, "%s", entry->d_name);
+        }
+        return true;
+    }
+    return false;
+}
+
+bool storage_dir_exists(Storage* storage, const char* path) {
+    FileInfo info;
+    return storage_common_stat(storage, path, &info) == FSE_OK && (info.flags & FSF_DIRECTORY);
+}
+
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo) {
+    UNUSED(storage);
+    struct stat st;
+    if(stat(path, &st) != 0) return FSE_NOT_EXIST;
+    if(fileinfo) {
+        fileinfo->flags = S_ISDIR(st.st_mode) ? FSF_DIRECTORY : 0;
+        fileinfo->size = st.st_size;
+    }
+    return FSE_OK;
+}
+
+FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t* timestamp) {
+    UNUSED(storage);
+    struct stat st;
+    if(stat(path, &st) != 0) return FSE_NOT_EXIST;
+    *timestamp = (uint32_t)st.st_mtime;
+    return FSE_OK;
+}
+
+FS_Error storage_common_remove(Storage* storage, const char* path) {
+    UNUSED(storage);
+    if(remove(path) == 0) return FSE_OK;
+    return errno == ENOENT ? FSE_NOT_EXIST : FSE_DENIED;
+}
+
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path) {
+    UNUSED(storage);
+    if(rename(old_path, new_path) == 0) return FSE_OK;
+    return errno == ENOENT ? FSE_NOT_EXIST : FSE_DENIED;
+}
+
+FS_Error storage_common_mkdir(Storage* storage, const char* path) {
+    UNUSED(storage);
+    if(mkdir(path, 0755) == 0) return FSE_OK;
+    return errno == EEXIST ? FSE_EXIST : FSE_NOT_EXIST;
+}
+
+bool storage_simply_mkdir(Storage* storage, const char* path) {
+    char partial[512];
+    snprintf(partial, sizeof(partial), "%s", path);
+    for(char* p = partial + 1; *p; p++) {
+        if(*p == '/') {
+            *p = '\0';
+            storage_common_mkdir(storage, partial);
+            *p = '/';
+        }
+    }
+    FS_Error error = storage_common_mkdir(storage, partial);
+    return error == FSE_OK || error == FSE_EXIST;
+}
@@ -0,0 +1,316 @@
+// Host stress test for the scan queue between the readers and the start screen
+//
+// Two producer threads stand in for the NFC reader and the LF worker: each
+// fills scan records the way the start screen callbacks do (NFC reads with
+// NDEF text from a scan buffer pool and the odd inventory batch, RFID reads
+// with decoded fields) and puts them as fast as the queue takes them. The main
+// thread plays the GUI thread: it waits for the "custom event", drains the
+// queue, and every so often stalls as if it were typing a long output.
+//
+// Every record carries its sequence number in the UID, the NDEF text, the
+// inventory and the decoded card number, so a record that was torn (fields
+// from two reads), duplicated, reordered or lost shows up. At the end the
+// scan buffer pool must be whole again. Exit code is non-zero on any failure.
+//
+//   stress [options]
+//     --reads N        reads per producer (default 20000)
+//     --stall-ms N     consumer stall length (default 20)
+//     --stall-every N  records between stalls (default 256)
+//     --allow-drops    do not fail on reads dropped with the queue full
+
+#include <furi.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "flipper_wedge_scan_queue.h"
+
+#define STRESS_READS_DEFAULT 20000
+#define STRESS_STALL_MS_DEFAULT 20
+#define STRESS_STALL_EVERY_DEFAULT 256
+#define STRESS_POOL_COUNT (FLIPPER_WEDGE_SCAN_QUEUE_DEPTH + 2)
+#define STRESS_NDEF_LEN 32
+#define STRESS_INVENTORY_EVERY 16
+
+typedef struct {
+    FlipperWedgeScanQueue* queue;
+    FlipperWedgeScanBufferPool* pool;
+    FuriSemaphore* events;  // One per queued record, like the view dispatcher's custom events
+    FlipperWedgeScanSource source;
+    uint32_t reads;
+    uint32_t put;
+    uint32_t dropped;
+    uint32_t failed;  // Reads that could not be built (no NDEF buffer)
+    bool done;        // Set once the last read was put
+} StressProducer;
+
+typedef struct {
+    uint32_t taken;
+    uint32_t next_seq;  // Lowest sequence number still expected
+    uint32_t errors;
+} StressSink;
+
+static uint64_t stress_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// UID bytes derived from the sequence number, so every byte can be checked
+static void stress_fill_uid(uint8_t* uid, uint8_t uid_len, uint8_t source, uint32_t seq) {
+    uid[0] = source;
+    for(uint8_t i = 1; i < uid_len; i++) {
+        uid[i] = i <= 4 ? (uint8_t)(seq >> (8 * (i - 1))) : (uint8_t)(uid[i - 1] * 31 + 7);
+    }
+}
+
+static bool stress_check_uid(const uint8_t* uid, uint8_t uid_len, uint8_t source, uint32_t* seq) {
+    if(uid_len < 5) return false;
+    *seq = uid[1] | (uid[2] << 8) | (uid[3] << 16) | ((uint32_t)uid[4] << 24);
+
+    uint8_t expected[FLIPPER_WEDGE_NFC_UID_MAX_LEN];
+    stress_fill_uid(expected, uid_len, source, *seq);
+    return memcmp(uid, expected, uid_len) == 0;
+}
+
+static void stress_put(StressProducer* producer, FlipperWedgeScanRecord* record) {
+    // Same wait as the LF worker callback
+    if(flipper_wedge_scan_queue_put(producer->queue, record, FLIPPER_WEDGE_SCAN_QUEUE_WAIT_MS)) {
+        producer->put++;
+        furi_semaphore_release(producer->events);
+    } else {
+        producer->dropped++;
+    }
+}
+
+static void stress_nfc_read(StressProducer* producer, uint32_t seq) {
+    FlipperWedgeNfcData data;
+    memset(&data, 0, sizeof(data));
+    data.uid_len = 7;
+    stress_fill_uid(data.uid, data.uid_len, 'N', seq);
+    snprintf(data.protocol_name, sizeof(data.protocol_name), "NTAG215");
+
+    // The reader waits for a buffer the same way it waits for stream chunks
+    data.ndef = flipper_wedge_scan_buffer_acquire_timeout(producer->pool, FLIPPER_WEDGE_NDEF_STREAM_WAIT_MS);
+    if(!data.ndef) {
+        producer->failed++;
+        return;
+    }
+    snprintf(flipper_wedge_scan_buffer_data(data.ndef), STRESS_NDEF_LEN, "text %08lx", (unsigned long)seq);
+    data.has_ndef = true;
+
+    if(seq % STRESS_INVENTORY_EVERY == 0) {
+        data.inventory_count = 1 + seq % FLIPPER_WEDGE_NFC_INVENTORY_MAX;
+        for(uint8_t i = 0; i < data.inventory_count; i++) {
+            data.inventory[i].uid_len = 7;
+            stress_fill_uid(data.inventory[i].uid, 7, 'I', seq + i);
+        }
+    }
+
+    FlipperWedgeScanRecord record;
+    flipper_wedge_scan_record_from_nfc(&record, &data);
+    // The reader drops its own reference once the callback returns
+    flipper_wedge_scan_buffer_unref(data.ndef);
+    stress_put(producer, &record);
+}
+
+static void stress_rfid_read(StressProducer* producer, uint32_t seq) {
+    FlipperWedgeRfidData data;
+    memset(&data, 0, sizeof(data));
+    data.uid_len = 5;
+    stress_fill_uid(data.uid, data.uid_len, 'R', seq);
+    snprintf(data.protocol_name, sizeof(data.protocol_name), "EM4100");
+    data.decoded.fields = FlipperWedgeRfidFieldCard;
+    data.decoded.card = seq;
+
+    FlipperWedgeScanRecord record;
+    flipper_wedge_scan_record_from_rfid(&record, &data);
+    stress_put(producer, &record);
+}
+
+static void* stress_producer_thread(void* context) {
+    StressProducer* producer = context;
+
+    for(uint32_t seq = 0; seq < producer->reads; seq++) {
+        if(producer->source == FlipperWedgeScanSourceNfc) {
+            stress_nfc_read(producer, seq);
+        } else {
+            stress_rfid_read(producer, seq);
+        }
+    }
+    __atomic_store_n(&producer->done, true, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static bool stress_check_record(const FlipperWedgeScanRecord* record, uint32_t* seq) {
+    if(record->source == FlipperWedgeScanSourceNfc) {
+        if(!stress_check_uid(record->uid, record->uid_len, 'N', seq)) return false;
+        if(strcmp(record->protocol, "NTAG215") != 0) return false;
+
+        char text[STRESS_NDEF_LEN];
+        snprintf(text, sizeof(text), "text %08lx", (unsigned long)*seq);
+        if(!record->ndef || strcmp(flipper_wedge_scan_buffer_data(record->ndef), text) != 0) return false;
+
+        uint8_t inventory_count = *seq % STRESS_INVENTORY_EVERY == 0 ?
+                                      1 + *seq % FLIPPER_WEDGE_NFC_INVENTORY_MAX :
+                                      0;
+        if(record->inventory_count != inventory_count) return false;
+        for(uint8_t i = 0; i < inventory_count; i++) {
+            uint32_t tag_seq;
+            if(!stress_check_uid(record->inventory[i].uid, record->inventory[i].uid_len, 'I', &tag_seq) ||
+               tag_seq != *seq + i) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return stress_check_uid(record->uid, record->uid_len, 'R', seq) &&
+           strcmp(record->protocol, "EM4100") == 0 && record->decoded.card == *seq &&
+           record->ndef == NULL && record->inventory == NULL;
+}
+
+static void stress_take(StressSink* sinks, FlipperWedgeScanRecord* record) {
+    StressSink* sink = &sinks[record->source];
+    uint32_t seq = 0;
+
+    if(!stress_check_record(record, &seq)) {
+        fprintf(stderr, "torn record: source %d, seq %lu\n", record->source, (unsigned long)seq);
+        sink->errors++;
+    } else if(seq < sink->next_seq) {
+        fprintf(
+            stderr,
+            "out of order: source %d, seq %lu after %lu\n",
+            record->source,
+            (unsigned long)seq,
+            (unsigned long)sink->next_seq - 1);
+        sink->errors++;
+    } else {
+        sink->next_seq = seq + 1;
+    }
+
+    sink->taken++;
+    flipper_wedge_scan_record_clear(record);
+}
+
+static void stress_usage(void) {
+    fprintf(stderr, "usage: stress [--reads N] [--stall-ms N] [--stall-every N] [--allow-drops]\n");
+}
+
+int main(int argc, char** argv) {
+    uint32_t reads = STRESS_READS_DEFAULT;
+    uint32_t stall_ms = STRESS_STALL_MS_DEFAULT;
+    uint32_t stall_every = STRESS_STALL_EVERY_DEFAULT;
+    bool allow_drops = false;
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--reads") == 0 && i + 1 < argc) {
+            reads = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--stall-ms") == 0 && i + 1 < argc) {
+            stall_ms = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--stall-every") == 0 && i + 1 < argc) {
+            stall_every = strtoul(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--allow-drops") == 0) {
+            allow_drops = true;
+        } else {
+            stress_usage();
+            return 2;
+        }
+    }
+    if(stall_every == 0) stall_every = 1;
+
+    FlipperWedgeScanQueue* queue = flipper_wedge_scan_queue_alloc(FLIPPER_WEDGE_SCAN_QUEUE_DEPTH);
+    FlipperWedgeScanBufferPool* pool = flipper_wedge_scan_buffer_pool_alloc(STRESS_POOL_COUNT, STRESS_NDEF_LEN);
+    FuriSemaphore* events = furi_semaphore_alloc(2 * reads + 1, 0);
+
+    StressProducer producers[2] = {
+        {.queue = queue, .pool = pool, .events = events, .source = FlipperWedgeScanSourceNfc, .reads = reads},
+        {.queue = queue, .pool = pool, .events = events, .source = FlipperWedgeScanSourceRfid, .reads = reads},
+    };
+    StressSink sinks[2];
+    memset(sinks, 0, sizeof(sinks));
+
+    uint64_t start_ns = stress_now_ns();
+    pthread_t threads[2];
+    for(size_t i = 0; i < 2; i++) {
+        pthread_create(&threads[i], NULL, stress_producer_thread, &producers[i]);
+    }
+
+    // GUI thread: one event per queued record, each drain may take several
+    uint32_t taken = 0;
+    uint32_t stalls = 0;
+    uint32_t max_depth = 0;
+    for(;;) {
+        bool done = __atomic_load_n(&producers[0].done, __ATOMIC_ACQUIRE) &&
+                    __atomic_load_n(&producers[1].done, __ATOMIC_ACQUIRE);
+        if(done && flipper_wedge_scan_queue_count(queue) == 0) break;
+
+        if(furi_semaphore_acquire(events, 100) != FuriStatusOk) continue;
+
+        max_depth = MAX(max_depth, (uint32_t)flipper_wedge_scan_queue_count(queue));
+        FlipperWedgeScanRecord record;
+        while(flipper_wedge_scan_queue_get(queue, &record)) {
+            stress_take(sinks, &record);
+            taken++;
+            if(taken % stall_every == 0) {
+                // Typing a long output: the readers run into a full queue
+                furi_delay_ms(stall_ms);
+                stalls++;
+            }
+        }
+    }
+
+    for(size_t i = 0; i < 2; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed_ms = (stress_now_ns() - start_ns) / 1e6;
+
+    // Every NDEF buffer has to be back in the pool
+    FlipperWedgeScanBuffer* buffers[STRESS_POOL_COUNT];
+    size_t returned = 0;
+    while(returned < STRESS_POOL_COUNT && (buffers[returned] = flipper_wedge_scan_buffer_acquire(pool))) {
+        returned++;
+    }
+    for(size_t i = 0; i < returned; i++) {
+        flipper_wedge_scan_buffer_unref(buffers[i]);
+    }
+
+    bool failed = false;
+    static const char* const names[] = {"nfc", "rfid"};
+    for(size_t i = 0; i < 2; i++) {
+        StressProducer* producer = &producers[i];
+        StressSink* sink = &sinks[i];
+        printf(
+            "%-4s %lu reads, %lu queued, %lu taken, %lu dropped, %lu not built, %lu bad\n",
+            names[i],
+            (unsigned long)producer->reads,
+            (unsigned long)producer->put,
+            (unsigned long)sink->taken,
+            (unsigned long)producer->dropped,
+            (unsigned long)producer->failed,
+            (unsigned long)sink->errors);
+        failed |= sink->taken != producer->put || sink->errors > 0 || producer->failed > 0;
+        failed |= !allow_drops && producer->dropped > 0;
+    }
+    uint32_t dropped = producers[0].dropped + producers[1].dropped;
+    if(flipper_wedge_scan_queue_get_dropped(queue) != dropped) {
+        printf("queue counted %lu drops\n", (unsigned long)flipper_wedge_scan_queue_get_dropped(queue));
+        failed = true;
+    }
+    if(returned != STRESS_POOL_COUNT) {
+        printf("%zu of %d NDEF buffers leaked\n", STRESS_POOL_COUNT - returned, STRESS_POOL_COUNT);
+        failed = true;
+    }
+    printf(
+        "%lu stalls of %lu ms, max depth %lu of %d, %.1f ms: %s\n",
+        (unsigned long)stalls,
+        (unsigned long)stall_ms,
+        (unsigned long)max_depth,
+        FLIPPER_WEDGE_SCAN_QUEUE_DEPTH,
+        elapsed_ms,
+        failed ? "FAIL" : "ok");
+
+    furi_semaphore_free(events);
+    flipper_wedge_scan_queue_free(queue);
+    flipper_wedge_scan_buffer_pool_free(pool);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,97 @@
+#include <toolbox/bit_buffer.h>
+#include <toolbox/simple_array.h>
+
+struct BitBuffer {
+    uint8_t* data;
+    size_t capacity;
+    size_t size;
+};
+
+BitBuffer* bit_buffer_alloc(size_t capacity_bytes) {
+    furi_assert(capacity_bytes);
+    BitBuffer* buf = malloc(sizeof(BitBuffer));
+    buf->data = malloc(capacity_bytes);
+    buf->capacity = capacity_bytes;
+    buf->size = 0;
+    return buf;
+}
+
+void bit_buffer_free(BitBuffer* buf) {
+    furi_assert(buf);
+    free(buf->data);
+    free(buf);
+}
+
+void bit_buffer_reset(BitBuffer* buf) {
+    buf->size = 0;
+}
+
+void bit_buffer_copy_bytes(BitBuffer* buf, const uint8_t* data, size_t size_bytes) {
+    furi_check(size_bytes <= buf->capacity);
+    memcpy(buf->data, data, size_bytes);
+    buf->size = size_bytes;
+}
+
+void bit_buffer_append_byte(BitBuffer* buf, uint8_t byte) {
+    furi_check(buf->size < buf->capacity);
+    buf->data[buf->size++] = byte;
+}
+
+void bit_buffer_append_bytes(BitBuffer* buf, const uint8_t* data, size_t size_bytes) {
+    furi_check(buf->size + size_bytes <= buf->capacity);
+    memcpy(buf->data + buf->size, data, size_bytes);
+    buf->size += size_bytes;
+}
+
+size_t bit_buffer_get_capacity_bytes(const BitBuffer* buf) {
+    return buf->capacity;
+}
+
+size_t bit_buffer_get_size_bytes(const BitBuffer* buf) {
+    return buf->size;
+}
+
+uint8_t bit_buffer_get_byte(const BitBuffer* buf, size_t index) {
+    furi_check(index < buf->size);
+    return buf->data[index];
+}
+
+const uint8_t* bit_buffer_get_data(const BitBuffer* buf) {
+    return buf->data;
+}
+
+struct SimpleArray {
+    uint8_t* data;
+    uint32_t count;
+};
+
+SimpleArray* simple_array_alloc_bytes(void) {
+    SimpleArray* instance = malloc(sizeof(SimpleArray));
+    instance->data = NULL;
+    instance->count = 0;
+    return instance;
+}
+
+void simple_array_free(SimpleArray* instance) {
+    furi_assert(instance);
+    free(instance->data);
+    free(instance);
+}
+
+void simple_array_init(SimpleArray* instance, uint32_t count) {
+    free(instance->data);
+    instance->data = count ? calloc(count, 1) : NULL;
+    instance->count = count;
+}
+
+uint32_t simple_array_get_count(const SimpleArray* instance) {
+    return instance->count;
+}
+
+void* simple_array_get_data(SimpleArray* instance) {
+    return instance->data;
+}
+
+const void* simple_array_cget_data(const SimpleArray* instance) {
+    return instance->data;
+}
@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""Reference receiver for Flipper Wedge "USB Serial" output mode.
+
+In USB Serial mode the Flipper enumerates as a CDC ACM port and sends one
+newline-terminated JSON object per scan:
+
+    {"ts":1718000000,"nfc_uid":"04A1B2C3D4E5F6","nfc_proto":"MIFARE Ultralight","ndef":"Hello"}
+
+Fields: ts (unix seconds), nfc_uid / nfc_proto, rfid_uid / rfid_proto, ndef.
+Decoded RFID tags add rfid_num (string) and rfid_fc / rfid_card (numbers).
+NFC-V Presence mode adds event ("arrive" or "depart").
+Absent data is omitted.
+
+Usage:
+    ./tools/wedge_receiver.py [/dev/ttyACM0]            # print records
+    ./tools/wedge_receiver.py /dev/ttyACM0 --bench 200  # USB Serial throughput
+    ./tools/wedge_receiver.py --keyboard-bench 20       # keyboard throughput
+
+Both benchmarks need a debug build of the app with an empty `output_bench`
+file in its data folder (/ext/apps_data/flipper_wedge/). Each scan is then
+followed by 200 copies of its USB Serial record, or 20 copies of its typed
+text with Enter after each, sent back to back. --bench times the records on
+the port; --keyboard-bench times the lines typed into this terminal (keep it
+focused). Scan the same tag in both output modes to compare the two paths.
+
+Linux only, standard library only.
+"""
+
+import argparse
+import json
+import os
+import sys
+import termios
+import time
+
+def open_port(path):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    attrs = termios.tcgetattr(fd)
+    # Raw mode: no echo, no line editing, no CR/LF translation
+    attrs[0] = 0
+    attrs[1] = 0
+    attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+    attrs[3] = 0
+    attrs[6][termios.VMIN] = 1
+    attrs[6][termios.VTIME] = 0
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    # Opening the tty raises DTR, which the app treats as "connected"
+    return os.fdopen(fd, "rb", buffering=0)
+
+
+def read_records(port):
+    buffer = b""
+    while True:
+        chunk = port.read(512)
+        if not chunk:
+            return
+        buffer += chunk
+        while b"\n" in buffer:
+            line, buffer = buffer.split(b"\n", 1)
+            line = line.strip()
+            if not line:
+                continue
+            try:
+                yield json.loads(line.decode("utf-8")), len(line) + 1
+            except (UnicodeDecodeError, json.JSONDecodeError) as err:
+                print(f"malformed frame ({err}): {line!r}", file=sys.stderr)
+
+
+def typed_length(record):
+    """Characters the keyboard path would type for the same scan."""
+    return sum(len(record.get(key, "")) for key in ("nfc_uid", "rfid_uid", "ndef"))
+
+
+def run_print(port):
+    for record, _ in read_records(port):
+        print(json.dumps(record, ensure_ascii=False), flush=True)
+
+
+def print_rate(received, elapsed, payload_bytes, chars):
+    """Rates over the time from the first to the last record, at the mean record size."""
+    elapsed = max(elapsed, 1e-6)
+    intervals = received - 1
+    print(f"records:            {received}")
+    print(f"elapsed:            {elapsed:.3f} s")
+    print(f"records/s:          {intervals / elapsed:.1f}")
+    print(f"payload bytes/s:    {payload_bytes * intervals / received / elapsed:.0f}")
+    print(f"scan chars/s:       {chars * intervals / received / elapsed:.0f}")
+
+
+def run_bench(port, count):
+    received = 0
+    payload_bytes = 0
+    chars = 0
+    first = None
+    last = None
+
+    for record, size in read_records(port):
+        now = time.monotonic()
+        if first is None:
+            first = now
+        last = now
+        received += 1
+        payload_bytes += size
+        chars += typed_length(record)
+        if received >= count:
+            break
+
+    if received < 2:
+        print("need at least 2 records for a throughput figure", file=sys.stderr)
+        return 1
+
+    print_rate(received, last - first, payload_bytes, chars)
+    return 0
+
+
+def run_keyboard_bench(count):
+    """Time lines typed by the app into this terminal (the keyboard path)."""
+    received = 0
+    payload_bytes = 0
+    chars = 0
+    first = None
+    last = None
+
+    print(f"waiting for {count} typed lines, scan a tag...", file=sys.stderr)
+    for line in sys.stdin.buffer:
+        now = time.monotonic()
+        text = line.rstrip(b"\r\n")
+        if not text:
+            continue
+        if first is None:
+            first = now
+        last = now
+        received += 1
+        payload_bytes += len(text) + 1
+        chars += len(text.decode("utf-8", errors="replace"))
+        if received >= count:
+            break
+
+    if received < 2:
+        print("need at least 2 lines for a throughput figure", file=sys.stderr)
+        return 1
+
+    print_rate(received, last - first, payload_bytes, chars)
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port", nargs="?", default="/dev/ttyACM0")
+    parser.add_argument(
+        "--bench", type=int, metavar="N", help="measure throughput over N records and exit"
+    )
+    parser.add_argument(
+        "--keyboard-bench",
+        type=int,
+        metavar="N",
+        help="measure throughput over N lines typed into this terminal and exit",
+    )
+    args = parser.parse_args()
+
+    if args.keyboard_bench:
+        try:
+            return run_keyboard_bench(args.keyboard_bench)
+        except KeyboardInterrupt:
+            return 1
+
+    with open_port(args.port) as port:
+        try:
+            if args.bench:
+                return run_bench(port, args.bench)
+            run_print(port)
+        except KeyboardInterrupt:
+            pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
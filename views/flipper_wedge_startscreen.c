@@ -4,7 +4,7 @@
 #include <input/input.h>
 #include <gui/elements.h>
 
-#define MODE_COUNT 5
+#define MODE_COUNT FlipperWedgeModeCount
 
 static const char* mode_names[] = {
     "NFC",
@@ -12,12 +12,18 @@ static const char* mode_names[] = {
     "NDEF",
     "NFC -> RFID",
     "RFID -> NFC",
+    "NFC | RFID",
+    "NFC + RFID",
+    "NFC Inventory",
+    "NFC-V Presence",
 };
 
 struct FlipperWedgeStartscreen {
     View* view;
     FlipperWedgeStartscreenCallback callback;
     void* context;
+    uint32_t redraw_tick;  // Last update that redrew, for rate-limited progress
+    bool redraw_pending;   // A progress change was not drawn yet
 };
 
 typedef struct {
@@ -186,6 +192,8 @@ FlipperWedgeStartscreen* flipper_wedge_startscreen_alloc() {
     instance->view = view_alloc();
     view_allocate_model(instance->view, ViewModelTypeLocking, sizeof(FlipperWedgeStartscreenModel));
     view_set_context(instance->view, instance);
+    instance->redraw_tick = 0;
+    instance->redraw_pending = false;
     view_set_draw_callback(instance->view, (ViewDrawCallback)flipper_wedge_startscreen_draw);
     view_set_input_callback(instance->view, flipper_wedge_startscreen_input);
     view_set_enter_callback(instance->view, flipper_wedge_startscreen_enter);
@@ -214,19 +222,71 @@ View* flipper_wedge_startscreen_get_view(FlipperWedgeStartscreen* instance) {
     return instance->view;
 }
 
+// Copy text into a model field, returns true if it changed
+static bool flipper_wedge_startscreen_copy_text(char* field, size_t size, const char* text) {
+    char copy[64];
+    furi_assert(size <= sizeof(copy));
+    snprintf(copy, size, "%s", text ? text : "");
+    if(strcmp(field, copy) == 0) return false;
+    memcpy(field, copy, size);
+    return true;
+}
+
+void flipper_wedge_startscreen_update(
+    FlipperWedgeStartscreen* instance,
+    const FlipperWedgeStartscreenUpdate* update) {
+    furi_assert(instance);
+    furi_assert(update);
+
+    bool changed = false;
+    with_view_model(
+        instance->view,
+        FlipperWedgeStartscreenModel * model,
+        {
+            if((update->fields & FlipperWedgeStartscreenFieldDisplayState) &&
+               model->display_state != update->display_state) {
+                model->display_state = update->display_state;
+                changed = true;
+            }
+            if(update->fields & FlipperWedgeStartscreenFieldStatusText) {
+                changed |= flipper_wedge_startscreen_copy_text(
+                    model->status_text, sizeof(model->status_text), update->status_text);
+            }
+            if(update->fields & FlipperWedgeStartscreenFieldUidText) {
+                changed |= flipper_wedge_startscreen_copy_text(
+                    model->uid_text, sizeof(model->uid_text), update->uid_text);
+            }
+            changed |= instance->redraw_pending;
+            if(changed && update->progress &&
+               furi_get_tick() - instance->redraw_tick < furi_ms_to_ticks(FLIPPER_WEDGE_STARTSCREEN_PROGRESS_MS)) {
+                instance->redraw_pending = true;
+                changed = false;
+            }
+        },
+        changed);
+
+    if(changed) {
+        instance->redraw_tick = furi_get_tick();
+        instance->redraw_pending = false;
+    }
+}
+
 void flipper_wedge_startscreen_set_connected_status(
     FlipperWedgeStartscreen* instance,
     bool usb_connected,
     bool bt_connected) {
     furi_assert(instance);
+    // Polled every tick, only redraw when it changes
+    bool changed = false;
     with_view_model(
         instance->view,
         FlipperWedgeStartscreenModel * model,
         {
+            changed = model->usb_connected != usb_connected || model->bt_connected != bt_connected;
             model->usb_connected = usb_connected;
             model->bt_connected = bt_connected;
         },
-        true);
+        changed);
 }
 
 void flipper_wedge_startscreen_set_mode(
@@ -258,46 +318,29 @@ uint8_t flipper_wedge_startscreen_get_mode(FlipperWedgeStartscreen* instance) {
 void flipper_wedge_startscreen_set_display_state(
     FlipperWedgeStartscreen* instance,
     FlipperWedgeDisplayState state) {
-    furi_assert(instance);
-    with_view_model(
-        instance->view,
-        FlipperWedgeStartscreenModel * model,
-        {
-            model->display_state = state;
-        },
-        true);
+    FlipperWedgeStartscreenUpdate update = {
+        .fields = FlipperWedgeStartscreenFieldDisplayState,
+        .display_state = state,
+    };
+    flipper_wedge_startscreen_update(instance, &update);
 }
 
 void flipper_wedge_startscreen_set_status_text(
     FlipperWedgeStartscreen* instance,
     const char* text) {
-    furi_assert(instance);
-    with_view_model(
-        instance->view,
-        FlipperWedgeStartscreenModel * model,
-        {
-            if(text) {
-                snprintf(model->status_text, sizeof(model->status_text), "%s", text);
-            } else {
-                model->status_text[0] = '\0';
-            }
-        },
-        true);
+    FlipperWedgeStartscreenUpdate update = {
+        .fields = FlipperWedgeStartscreenFieldStatusText,
+        .status_text = text,
+    };
+    flipper_wedge_startscreen_update(instance, &update);
 }
 
 void flipper_wedge_startscreen_set_uid_text(
     FlipperWedgeStartscreen* instance,
     const char* text) {
-    furi_assert(instance);
-    with_view_model(
-        instance->view,
-        FlipperWedgeStartscreenModel * model,
-        {
-            if(text) {
-                snprintf(model->uid_text, sizeof(model->uid_text), "%s", text);
-            } else {
-                model->uid_text[0] = '\0';
-            }
-        },
-        true);
+    FlipperWedgeStartscreenUpdate update = {
+        .fields = FlipperWedgeStartscreenFieldUidText,
+        .uid_text = text,
+    };
+    flipper_wedge_startscreen_update(instance, &update);
 }
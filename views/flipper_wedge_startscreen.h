@@ -15,6 +15,24 @@ typedef enum {
     FlipperWedgeDisplayStateSent,
 } FlipperWedgeDisplayState;
 
+// Minimum time between redraws for progress updates while typing
+#define FLIPPER_WEDGE_STARTSCREEN_PROGRESS_MS 250
+
+// Fields set by flipper_wedge_startscreen_update()
+typedef enum {
+    FlipperWedgeStartscreenFieldDisplayState = (1 << 0),
+    FlipperWedgeStartscreenFieldStatusText = (1 << 1),
+    FlipperWedgeStartscreenFieldUidText = (1 << 2),
+} FlipperWedgeStartscreenField;
+
+typedef struct {
+    uint8_t fields;  // FlipperWedgeStartscreenField bits to apply, others are left as they are
+    FlipperWedgeDisplayState display_state;
+    const char* status_text;  // NULL clears
+    const char* uid_text;     // NULL clears
+    bool progress;  // Rate-limited: no redraw within FLIPPER_WEDGE_STARTSCREEN_PROGRESS_MS of the last one
+} FlipperWedgeStartscreenUpdate;
+
 typedef void (*FlipperWedgeStartscreenCallback)(FlipperWedgeCustomEvent event, void* context);
 
 void flipper_wedge_startscreen_set_callback(
@@ -39,6 +57,17 @@ void flipper_wedge_startscreen_set_mode(
 
 uint8_t flipper_wedge_startscreen_get_mode(FlipperWedgeStartscreen* instance);
 
+/** Apply several field changes under one model lock
+ * The screen is redrawn once, and only if a field changed. A progress update
+ * that is not redrawn stays in the model and is drawn by the next update.
+ *
+ * @param instance FlipperWedgeStartscreen instance
+ * @param update Fields to change
+ */
+void flipper_wedge_startscreen_update(
+    FlipperWedgeStartscreen* instance,
+    const FlipperWedgeStartscreenUpdate* update);
+
 void flipper_wedge_startscreen_set_display_state(
     FlipperWedgeStartscreen* instance,
     FlipperWedgeDisplayState state);